@@ -24,6 +24,9 @@ public:
     // Audio loading
     AudioBuffer* loadSound(const std::string& filename);
     AudioBuffer* loadMusic(const std::string& filename);
+    // Mono 16-bit PCM (procedural sounds), playable afterwards by `name`
+    AudioBuffer* loadSamples(const std::string& name, const short* samples, size_t count, int sampleRate);
+    bool hasSound(const std::string& name) const { return buffers.count(name) > 0; }
 
     // 3D audio
     void setListenerPosition(float x, float y, float z);
@@ -57,6 +60,7 @@ private:
 class AudioBuffer {
 public:
     AudioBuffer(const std::string& filename);
+    AudioBuffer(const short* samples, size_t count, int sampleRate);
     ~AudioBuffer();
 
     ALuint getBufferID() const { return buffer; }
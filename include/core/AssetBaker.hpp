@@ -0,0 +1,77 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace BVA {
+
+// Read-only view of a baked asset (either freshly generated or mapped from
+// the disk cache). Valid for the lifetime of the AssetBaker.
+struct BakedAsset {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+// Startup asset-baking stage. Procedural generators register jobs, start()
+// runs them on worker threads and results are cached on disk keyed by the
+// job's name, parameters and generator version. On later launches a valid
+// cache file is memory-mapped instead of regenerating the asset.
+class AssetBaker {
+public:
+    using Generator = std::function<std::vector<uint8_t>()>;
+
+    // Bump to invalidate every cached asset (cache file layout changes)
+    static constexpr uint32_t CACHE_FORMAT = 1;
+
+    explicit AssetBaker(std::string cacheDirectory);
+    ~AssetBaker();
+
+    // Jobs must be added before start(). Change `params` or `version` whenever
+    // the generator's output would change.
+    void addJob(const std::string& name, const std::string& params, uint32_t version, Generator generate);
+
+    // Starts baking in the background; 0 threads = one per spare core
+    void start(unsigned threadCount = 0);
+    void wait();
+
+    // Blocks until the named job has finished; empty if unknown or failed
+    BakedAsset get(const std::string& name) const;
+
+    size_t getJobCount() const { return jobs.size(); }
+    size_t getCacheHits() const;
+
+    template <typename T>
+    static std::vector<uint8_t> toBytes(const std::vector<T>& values) {
+        const uint8_t* begin = reinterpret_cast<const uint8_t*>(values.data());
+        return std::vector<uint8_t>(begin, begin + values.size() * sizeof(T));
+    }
+
+private:
+    struct Job;
+
+    void workerLoop();
+    void runJob(Job& job);
+    std::string cachePath(const Job& job) const;
+
+    std::string cacheDirectory;
+    std::vector<std::unique_ptr<Job>> jobs;
+    std::unordered_map<std::string, size_t> jobIndices;
+
+    std::vector<std::thread> workers;
+    size_t nextJob = 0;
+    bool started = false;
+
+    mutable std::mutex mutex;
+    mutable std::condition_variable jobFinished;
+};
+
+} // namespace BVA
@@ -12,6 +12,9 @@ class AudioEngine;
 class InputManager;
 class GameStateManager;
 class NetworkManager;
+class ReplaySystem;
+class AssetBaker;
+class UIManager;
 
 class Engine {
 public:
@@ -28,12 +31,20 @@ public:
     InputManager* getInput() { return input.get(); }
     GameStateManager* getGameState() { return gameState.get(); }
     NetworkManager* getNetwork() { return network.get(); }
+    ReplaySystem* getReplay() { return replay.get(); }
+    AssetBaker* getAssets() { return assets.get(); }
+    // Overlays: render thread only
+    UIManager* getUI() { return ui.get(); }
 
     float getDeltaTime() const { return deltaTime; }
     uint64_t getFrameCount() const { return frameCount; }
     bool isRunning() const { return running; }
     void quit() { running = false; }
 
+    // One fixed step of gameplay and physics only (no input, audio or
+    // rendering). Replay playback and seeking run the simulation through this.
+    void simulateTick(float dt);
+
 private:
     Engine() = default;
     ~Engine() = default;
@@ -43,12 +54,15 @@ private:
     void update(float dt);
     void render();
 
+    std::unique_ptr<AssetBaker> assets;
     std::unique_ptr<GraphicsEngine> graphics;
+    std::unique_ptr<UIManager> ui;
     std::unique_ptr<PhysicsEngine> physics;
     std::unique_ptr<AudioEngine> audio;
     std::unique_ptr<InputManager> input;
     std::unique_ptr<GameStateManager> gameState;
     std::unique_ptr<NetworkManager> network;
+    std::unique_ptr<ReplaySystem> replay;
 
     bool running = false;
     float deltaTime = 0.0f;
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Kept free of Ogre/Bullet so the offline data compiler (tools/datac) can
+// build without the engine dependencies.
+
+namespace BVA {
+
+enum class CharacterID : uint32_t {
+    Bas,
+    Berkay,
+    Luca,
+    Gefferinho,
+    Hadi,
+    Nitin,
+    PalaBaba,
+    Fufinho,
+    EfeAbi,
+    Jad,
+    Umut,
+    KeizerBomTaha,
+    GoonLordTobese,
+    Count
+};
+
+enum class BossType : uint32_t {
+    Bastiaan,
+    KeizerBomTaha,
+    Mees,
+    PrincipalVanDerBerg,
+    JanitorKing,
+    HeadChef,
+    Count
+};
+
+enum class AbilityEffect : uint32_t {
+    DamageBoost,
+    SpeedBoost,
+    HealthBoost,
+    SplashDamage,
+    FireDamage,
+    Projectile,
+    PlaneSummon,
+    Count
+};
+
+struct CharacterStats {
+    float maxHealth = 100.0f;
+    float moveSpeed = 5.0f;
+    float attackDamage = 10.0f;
+    float attackSpeed = 1.0f;
+    float defense = 0.0f;
+};
+
+// ===== Compiled table layout =====
+// Every record is fixed-size POD and refers to other records and strings by
+// index/offset, never by pointer, so the file is used in place after loading
+// (or memory-mapping). Strings are offsets into a NUL-terminated pool where
+// offset 0 is the empty string.
+
+constexpr uint32_t GAMEDATA_MAGIC = 0x44415642;  // "BVAD"
+constexpr uint32_t GAMEDATA_VERSION = 1;
+
+struct ProjectileRecord {
+    float speed = 20.0f;
+    float radius = 0.3f;
+    float lifetime = 3.0f;
+    float gravityScale = 0.0f;
+    float fireDPS = 0.0f;
+    float fireDuration = 0.0f;
+    float splashRadius = 0.0f;
+    float scale = 1.0f;
+    float color[3] = {1.0f, 1.0f, 1.0f};
+    uint32_t count = 1;           // Projectiles per launch, fanned out
+    float spreadDegrees = 0.0f;   // Angle between neighbouring projectiles
+    float loft = 0.0f;            // Added to the aim direction's y
+};
+
+struct EffectRecord {
+    AbilityEffect effect;
+    float value;
+    float param;  // Duration override, or radius for SplashDamage (0 = default)
+};
+
+struct CharacterRecord {
+    uint32_t name;
+    CharacterStats stats;
+    uint32_t abilityName;
+    uint32_t voiceLine;
+    uint32_t description;
+    uint32_t activationMessage;
+    float abilityDuration;
+    float abilityCooldown;
+    uint32_t firstEffect;
+    uint32_t effectCount;
+    ProjectileRecord projectile;
+};
+
+struct BossAttackRecord {
+    static constexpr uint32_t FLAG_AOE = 1u << 0;
+    static constexpr uint32_t FLAG_PROJECTILE = 1u << 1;
+
+    uint32_t name;
+    uint32_t message;
+    float damage;
+    float range;
+    float cooldown;
+    float windupTime;
+    uint32_t flags;
+    float slowMultiplier;  // Speed multiplier applied to the target on hit
+    float slowDuration;    // 0 = no slow
+    ProjectileRecord projectile;
+
+    bool isAOE() const { return (flags & FLAG_AOE) != 0; }
+    bool isProjectile() const { return (flags & FLAG_PROJECTILE) != 0; }
+};
+
+struct BossRecord {
+    uint32_t name;
+    uint32_t introText;
+    CharacterStats stats;
+    float phase2HealthPercent;
+    float phase3HealthPercent;
+    uint32_t firstAttack;
+    uint32_t attackCount;
+};
+
+struct GameDataHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t characterCount;
+    uint32_t characterOffset;
+    uint32_t bossCount;
+    uint32_t bossOffset;
+    uint32_t attackCount;
+    uint32_t attackOffset;
+    uint32_t effectCount;
+    uint32_t effectOffset;
+    uint32_t stringsSize;
+    uint32_t stringsOffset;
+};
+
+// Character and boss definitions, compiled from assets/data/gamedata.txt.
+// Characters hold a pointer to their record instead of copying names,
+// ability text and effect lists into every instance.
+class GameData {
+public:
+    // Loads the compiled table. When sourcePath is given and is newer than
+    // the binary (or the binary is missing), it is recompiled first so
+    // balance edits apply without rebuilding the game.
+    static bool load(const std::string& binaryPath, const std::string& sourcePath = "");
+    static void unload();
+    static bool isLoaded() { return header != nullptr; }
+
+    // Always valid; falls back to default records when nothing is loaded
+    static const CharacterRecord& getCharacter(CharacterID id);
+    static const BossRecord& getBoss(BossType type);
+    static const EffectRecord* getEffects(const CharacterRecord& character);
+    static const BossAttackRecord* getAttacks(const BossRecord& boss);
+    static const char* getString(uint32_t offset);
+
+    // Text -> binary. Errors are reported with line numbers.
+    static bool compile(const std::string& sourcePath, std::vector<uint8_t>& output);
+    static bool compileFile(const std::string& sourcePath, const std::string& binaryPath);
+
+private:
+    static bool validate(const uint8_t* data, size_t size);
+
+    static std::vector<uint64_t> storage;  // 8-byte aligned backing for the table
+    static const GameDataHeader* header;
+};
+
+} // namespace BVA
@@ -3,11 +3,21 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include "core/InputManager.hpp"
 #include "gameplay/Character.hpp"
 #include "gameplay/Boss.hpp"
+#include "gameplay/ProjectileSystem.hpp"
+#include "gameplay/EnemySpawner.hpp"
+#include "gameplay/AIScheduler.hpp"
 
 namespace BVA {
 
+class LevelStreamer;
+class UIManager;
+
 enum class GameMode {
     None,
     StoryMode,
@@ -36,10 +46,28 @@ struct LevelData {
     BossType bossType;
     std::string cutsceneBefore;
     std::string cutsceneAfter;
+    int enemyPoolSize;  // Pre-initialized instances per enemy archetype
+};
+
+class StateBuffer;
+
+// Everything needed to start a match from scratch. Together with the
+// per-tick player inputs this reproduces the match exactly (replays).
+struct MatchSetup {
+    uint32_t seed = 1;
+    GameMode mode = GameMode::None;
+    int32_t levelIndex = 0;
+    int8_t characters[4] = {-1, -1, -1, -1};  // CharacterID per player slot, -1 = empty
+    // AI scheduling decides which agents think on a tick, so it is part of
+    // the match rather than a machine setting
+    float aiBudget = 500.0f;       // Estimated microseconds per tick
+    uint16_t aiMaxThinks = 16;     // think() calls per tick
 };
 
 class GameStateManager {
 public:
+    static constexpr int MAX_PLAYERS = 4;
+
     GameStateManager();
     ~GameStateManager();
 
@@ -72,16 +100,48 @@ public:
     Character* getPlayer(int playerIndex);
     int getPlayerCount() const { return players.size(); }
 
-    // Enemy management
+    // Enemy management (instances are pooled by EnemySpawner)
     void spawnEnemy(const std::string& enemyType, const Ogre::Vector3& position);
+    int spawnWave(const std::string& enemyType, int count, const Ogre::Vector3& center, float radius);
     void removeEnemy(Character* enemy);
-    const std::vector<std::unique_ptr<Character>>& getEnemies() const { return enemies; }
+    const std::vector<EnemyCharacter*>& getEnemies() const { return enemies; }
 
     // Boss management
     void spawnBoss(BossType bossType);
     Boss* getCurrentBoss() { return currentBoss.get(); }
     bool isBossFight() const { return currentBoss != nullptr; }
 
+    // Projectiles
+    ProjectileSystem* getProjectiles() { return projectiles.get(); }
+
+    // AI decision scheduling
+    AIScheduler* getAIScheduler() { return aiScheduler.get(); }
+
+    // Match setup and per-tick inputs. Gameplay only reads player input
+    // through here, so recorded inputs drive the simulation the same way.
+    MatchSetup getMatchSetup() const;
+    void beginMatch(const MatchSetup& setup);
+    void setPlayerInput(int playerIndex, const PlayerInput& input);
+    const PlayerInput& getPlayerInput(int playerIndex) const;
+    bool isRemotePlayer(int playerIndex) const;
+
+    // Gameplay randomness; seeded per match so replays stay in sync
+    uint32_t nextRandom();
+    float randomRange(float min, float max);
+
+    // Stable character ids for snapshots (-1 for null)
+    int32_t encodeCharacter(const Character* character) const;
+    Character* decodeCharacter(int32_t id);
+
+    // Full simulation state (replay keyframes)
+    void saveState(StateBuffer& buffer) const;
+    void loadState(StateBuffer& buffer);
+
+    // Level streaming: the next story level loads in the background and
+    // loading progress is shown on `ui` (owned by the engine, render thread)
+    LevelStreamer* getLevelStreamer() { return levelStreamer.get(); }
+    void setUI(UIManager* uiManager) { ui = uiManager; }
+
     // Cutscenes
     void playCutscene(const std::string& cutsceneName);
     void skipCutscene();
@@ -104,8 +164,32 @@ public:
 private:
     void setupStoryLevels();
     void cleanupLevel();
+    // Begins a match from the current players, recorded for replay
+    void startMatch(GameMode mode, int levelIndex);
+    // Saves the match being recorded, if any
+    void finishRecording();
+    // Shows the scene's static geometry with warm shaders and full enemy
+    // pools. Instant if it was streamed already; otherwise the rest loads
+    // now in the Loading state.
+    void prepareScene(const std::string& sceneName, const std::vector<std::string>& archetypes = {},
+                      int poolSize = 0);
+    // Starts streaming a story level unless it already is
+    void streamLevel(int levelIndex);
+    // Creates, places and schedules the boss without starting its fight
+    // (snapshot restores); false if the type has no boss
+    bool restoreBoss(BossType bossType);
+    // Calls into the UI with the next frame, since overlays belong to the
+    // render thread
+    void queueUI(std::function<void(UIManager&)> call);
+    // The level's enemy archetypes plus its boss's summons
+    static std::vector<std::string> getLevelArchetypes(const LevelData& level);
     void updateCombatLogic(float dt);
     void updateCombo(float dt);
+    void updateProjectiles(float dt);
+    void updateCamera();
+    void updateAI(float dt);
+    void applyPlayerInputs();
+    void reclaimDeadEnemies();
     void checkVictoryCondition();
     void checkDefeatCondition();
 
@@ -118,9 +202,27 @@ private:
 
     // Players and enemies
     std::vector<std::unique_ptr<Character>> players;
-    std::vector<std::unique_ptr<Character>> enemies;
+    std::vector<EnemyCharacter*> enemies;
+    std::unique_ptr<EnemySpawner> enemySpawner;
     std::unique_ptr<Boss> currentBoss;
 
+    // Level streaming
+    std::unique_ptr<LevelStreamer> levelStreamer;
+    UIManager* ui = nullptr;
+    // The outro cutscene is playing; the next level follows it
+    bool advanceAfterCutscene = false;
+
+    // Projectiles
+    std::unique_ptr<ProjectileSystem> projectiles;
+    std::vector<Character*> projectileTargets;
+
+    // AI
+    std::unique_ptr<AIScheduler> aiScheduler;
+    std::vector<Character*> aiTargets;
+
+    // Camera
+    std::vector<Ogre::Vector3> cameraTargets;
+
     // Game stats
     int totalScore = 0;
     float playTime = 0.0f;
@@ -131,6 +233,17 @@ private:
     // Match state
     bool matchActive = false;
     float matchTime = 0.0f;
+    uint32_t matchSeed = 1;
+    uint64_t rngState = 1;
+
+    // Player input for the current tick (and the previous one, for presses)
+    std::array<PlayerInput, MAX_PLAYERS> playerInputs{};
+    std::array<PlayerInput, MAX_PLAYERS> prevPlayerInputs{};
+    std::array<bool, MAX_PLAYERS> remoteInputs{};
+
+    // Stable id ranges used by encodeCharacter()
+    static constexpr int32_t BOSS_ID = 100;
+    static constexpr int32_t ENEMY_ID_BASE = 1000;
 };
 
 } // namespace BVA
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <functional>
 #include <vector>
+#include <cstdint>
 
 namespace BVA {
 
@@ -25,6 +26,28 @@ enum class GamepadButton {
     DPadUp, DPadDown, DPadLeft, DPadRight
 };
 
+// One player's input for one simulation tick. This is what gameplay
+// consumes and what replays record, so it is kept small and quantized.
+struct PlayerInput {
+    static constexpr uint8_t JUMP = 1 << 0;
+    static constexpr uint8_t ATTACK = 1 << 1;
+    static constexpr uint8_t ABILITY = 1 << 2;
+
+    int8_t moveX = 0;  // -MOVE_STEPS..MOVE_STEPS
+    int8_t moveZ = 0;
+    uint8_t buttons = 0;
+
+    static constexpr int MOVE_STEPS = 16;
+
+    bool isDown(uint8_t button) const { return (buttons & button) != 0; }
+    Ogre::Vector3 getMoveDirection() const;
+
+    bool operator==(const PlayerInput& other) const {
+        return moveX == other.moveX && moveZ == other.moveZ && buttons == other.buttons;
+    }
+    bool operator!=(const PlayerInput& other) const { return !(*this == other); }
+};
+
 struct InputAction {
     std::string name;
     std::vector<KeyCode> keys;
@@ -66,6 +89,10 @@ public:
     bool isActionPressed(const std::string& actionName) const;
     bool isActionReleased(const std::string& actionName) const;
 
+    // Samples the current device state as a tick input. Player 0 uses the
+    // keyboard and first gamepad, other players their own gamepad.
+    PlayerInput samplePlayerInput(int playerIndex) const;
+
     // Gamepad detection
     int getConnectedGamepadCount() const { return connectedGamepads; }
     bool isGamepadConnected(int playerIndex) const;
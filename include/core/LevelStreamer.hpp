@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BVA {
+
+class EnemySpawner;
+
+// Loads a level in the background while something else is on screen (the
+// current level's boss fight and outro, or the main menu), so starting the
+// level only swaps it in. Each step runs on the thread allowed to do it:
+//  - a worker waits for the level's baked layout, meshes and sounds
+//  - the render thread loads the level's resource group, builds the level
+//    geometry hidden and warms shaders,
+//    a slice per frame queued with the frame packet, so neither the
+//    simulation nor the frame being drawn waits on a whole stage
+//  - update() uploads sounds and grows the enemy pools a few instances at a
+//    time, since enemies own physics bodies. Pools wait while a match is
+//    live: growing them at a tick that depends on render timing would change
+//    which pool slots spawns get, and replays would diverge.
+// Progress (0..1) goes to the progress callback as steps complete.
+// Simulation thread only.
+class LevelStreamer {
+public:
+    using ProgressCallback = std::function<void(float)>;
+
+    // Enemies created per update() while streaming in the background
+    static constexpr int ENEMIES_PER_UPDATE = 2;
+    // Render-thread work per frame: props placed, materials warmed
+    static constexpr size_t PROPS_PER_SLICE = 16;
+    static constexpr size_t MATERIALS_PER_SLICE = 4;
+
+    explicit LevelStreamer(EnemySpawner* spawner);
+    ~LevelStreamer();
+
+    // Starts streaming a scene, dropping whatever was streamed before
+    void begin(const std::string& sceneName, const std::vector<std::string>& enemyArchetypes, int enemyPoolSize);
+    void cancel();
+
+    // Advances the background steps; call once per tick. Enemy pools only
+    // grow while `growPools` (no match live)
+    void update(bool growPools);
+    // Runs every remaining step now, submitting frames in between so the
+    // loading screen keeps drawing
+    void finish();
+    // Shows the streamed level (finishing it first if needed); the streamer
+    // is idle afterwards
+    void activate();
+
+    bool isStreaming(const std::string& sceneName) const;
+    bool isReady() const { return stage == Stage::Ready; }
+    float getProgress() const;
+
+    void setProgressCallback(ProgressCallback callback) { onProgress = std::move(callback); }
+
+private:
+    enum class Stage { Idle, Fetching, Geometry, Shaders, Sounds, EnemyPools, Ready };
+
+    // One step of the current stage; `blocking` waits for steps running on
+    // other threads instead of checking back next update
+    void step(bool blocking);
+    // Runs `start` and then `slice` on the render thread, one slice per
+    // frame until a slice returns true; true once that has happened
+    bool runRenderSlices(std::function<void()> start, std::function<bool()> slice, bool blocking);
+    void completeUnits(int units);
+    void joinWorker();
+
+    EnemySpawner* spawner;
+    ProgressCallback onProgress;
+
+    Stage stage = Stage::Idle;
+    bool poolsAllowed = true;
+    std::string sceneName;
+    std::vector<std::string> archetypes;
+    int poolSize = 0;
+    std::vector<std::string> sounds;  // Not uploaded yet
+
+    std::thread worker;
+    std::atomic<bool> fetched{false};
+    bool renderQueued = false;
+    bool slicesStarted = false;
+    std::atomic<bool> renderDone{false};
+    std::atomic<bool> renderFinished{false};
+
+    int totalUnits = 0;
+    int doneUnits = 0;
+};
+
+} // namespace BVA
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <string>
+#include <cstdint>
+#include "core/InputManager.hpp"
+#include "core/GameStateManager.hpp"
+#include "core/StateBuffer.hpp"
+
+namespace BVA {
+
+// Records matches as their setup plus per-tick input changes, and plays
+// them back by re-running the simulation. Relies on the fixed timestep, on
+// gameplay only reading input/randomness through GameStateManager, and on
+// the AI scheduler's budget and think cap, which are part of the setup.
+//
+// Recording and playback keep keyframes (full simulation snapshots) every
+// KEYFRAME_INTERVAL ticks, so seeking restores the nearest keyframe and
+// simulates forward headless instead of replaying from the start. Recorded
+// keyframes are saved next to the replay (<path>.keys) and loaded with it
+// when they match this build; otherwise they are rebuilt as playback runs.
+class ReplaySystem {
+public:
+    static constexpr uint32_t TICK_RATE = 60;
+    static constexpr uint32_t KEYFRAME_INTERVAL = 300;  // 5 seconds
+    static constexpr uint32_t SEEK_STEP = 300;
+    // Every match is recorded here when it ends
+    static constexpr const char* LAST_REPLAY_PATH = "replays/last.bvr";
+
+    ReplaySystem();
+    ~ReplaySystem();
+
+    // Recording: (re)starts a match from the setup with a fresh seed
+    void startRecording();
+    void startRecording(const MatchSetup& setup);
+    void recordTick(const std::array<PlayerInput, GameStateManager::MAX_PLAYERS>& inputs);
+    bool stopRecording(const std::string& path);
+    bool isRecording() const { return mode == Mode::Recording; }
+
+    // Playback
+    bool startPlayback(const std::string& path);
+    void updatePlayback(float dt);
+    // Space pauses, Left/Right seek by SEEK_STEP ticks, Up/Down double or
+    // halve the speed, Escape stops
+    void handlePlaybackControls(const InputManager& input);
+    void seek(uint32_t tick);
+    void stopPlayback();
+    bool isPlaying() const { return mode == Mode::Playback; }
+
+    // 1 = real time; fast-forward runs extra ticks per frame
+    void setPlaybackSpeed(float speed) { playbackSpeed = speed; }
+    float getPlaybackSpeed() const { return playbackSpeed; }
+    void setPaused(bool paused) { playbackPaused = paused; }
+    bool isPaused() const { return playbackPaused; }
+
+    uint32_t getCurrentTick() const { return currentTick; }
+    uint32_t getTickCount() const { return tickCount; }
+
+private:
+    enum class Mode { Idle, Recording, Playback };
+
+    struct InputChange {
+        uint32_t tick;
+        uint8_t playerIndex;
+        PlayerInput input;
+    };
+
+    struct Keyframe {
+        uint32_t tick;
+        size_t changeCursor;
+        std::array<PlayerInput, GameStateManager::MAX_PLAYERS> inputs;
+        StateBuffer state;
+    };
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+    bool saveKeyframes(const std::string& path) const;
+    // Replaces the keyframes if the file belongs to the loaded replay and
+    // its first snapshot matches the one just taken
+    bool loadKeyframes(const std::string& path);
+    static std::string keyframePath(const std::string& replayPath) { return replayPath + ".keys"; }
+
+    void stepPlayback();
+    void captureKeyframe(uint32_t tick, size_t cursor);
+    void restoreKeyframe(const Keyframe& keyframe);
+
+    Mode mode = Mode::Idle;
+    MatchSetup setup;
+
+    // Input changes in tick order; unchanged ticks are not stored
+    std::vector<InputChange> changes;
+    std::array<PlayerInput, GameStateManager::MAX_PLAYERS> currentInputs{};
+    uint32_t tickCount = 0;
+
+    uint32_t currentTick = 0;
+    size_t changeCursor = 0;
+    float playbackSpeed = 1.0f;
+    float playbackAccumulator = 0.0f;
+    bool playbackPaused = false;
+    std::vector<Keyframe> keyframes;
+    std::string recordedPath;  // Where the keyframes' match was saved
+
+    // Caps fast-forward work per frame; seeking is not capped
+    static constexpr int MAX_TICKS_PER_UPDATE = 240;
+};
+
+} // namespace BVA
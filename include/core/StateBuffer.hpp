@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace BVA {
+
+class Character;
+class GameStateManager;
+
+// Binary buffer for simulation snapshots (replay keyframes). Values are
+// copied raw, so snapshots are only valid within the same build.
+// Character pointers are written as stable ids resolved by GameStateManager.
+class StateBuffer {
+public:
+    explicit StateBuffer(GameStateManager* characters = nullptr) : characters(characters) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "StateBuffer only stores trivially copyable types");
+        size_t offset = data.size();
+        data.resize(offset + sizeof(T));
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+    }
+
+    // Returns a value-initialized T when reading past the end
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "StateBuffer only stores trivially copyable types");
+        T value{};
+        if (readOffset + sizeof(T) <= data.size()) {
+            std::memcpy(&value, data.data() + readOffset, sizeof(T));
+            readOffset += sizeof(T);
+        } else {
+            overflow = true;
+        }
+        return value;
+    }
+
+    template <typename T>
+    void read(T& value) { value = read<T>(); }
+
+    // For Ogre vectors/colours: write(v.ptr(), 3) / read(v.ptr(), 3)
+    void write(const float* values, size_t count) {
+        for (size_t i = 0; i < count; i++) write(values[i]);
+    }
+    void read(float* values, size_t count) {
+        for (size_t i = 0; i < count; i++) values[i] = read<float>();
+    }
+
+    void writeCharacter(const Character* character);
+    Character* readCharacter();
+
+    void rewind() { readOffset = 0; overflow = false; }
+    void clear() { data.clear(); rewind(); }
+    bool hasOverflowed() const { return overflow; }
+    size_t size() const { return data.size(); }
+
+    // Raw bytes, for storing snapshots on disk
+    const std::vector<uint8_t>& getData() const { return data; }
+    void assign(std::vector<uint8_t> bytes) {
+        data = std::move(bytes);
+        rewind();
+    }
+
+    void setCharacters(GameStateManager* manager) { characters = manager; }
+
+private:
+    std::vector<uint8_t> data;
+    size_t readOffset = 0;
+    bool overflow = false;
+    GameStateManager* characters;
+};
+
+} // namespace BVA
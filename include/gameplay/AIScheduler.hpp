@@ -0,0 +1,101 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+namespace BVA {
+
+class Character;
+class StateBuffer;
+
+// Per-frame cache of the positions AI agents query (living players).
+// Built once per frame so each agent's queries are a flat array walk
+// instead of repeated getPosition() calls into the physics world.
+class AIWorldSnapshot {
+public:
+    void build(const std::vector<Character*>& targets);
+
+    // Nearest target to position within maxDistance (nullptr if none)
+    Character* findNearest(const Ogre::Vector3& position, float maxDistance,
+                           float* outDistance = nullptr) const;
+    int countWithin(const Ogre::Vector3& position, float radius) const;
+    bool contains(const Character* target) const;
+    Ogre::Vector3 getPosition(const Character* target) const;
+
+    size_t size() const { return characters.size(); }
+
+private:
+    std::vector<Character*> characters;
+    std::vector<float> posX, posY, posZ;
+};
+
+// Anything that makes decisions through the scheduler
+class AIAgent {
+public:
+    virtual ~AIAgent() = default;
+
+    // Expensive decision making; elapsed is the time since this agent last thought
+    virtual void think(const AIWorldSnapshot& world, float elapsed) = 0;
+
+    // What one think() costs, in microseconds. Derived from the work it does
+    // (targets scanned, options scored), never measured, so the scheduler's
+    // budget gives the same result on every machine and in every replay.
+    virtual float estimateThinkCost(const AIWorldSnapshot& world) const = 0;
+
+    // Called when a character the agent may be tracking leaves the game
+    virtual void forgetTarget(Character* target) = 0;
+};
+
+// Round-robin scheduler that runs agent think() calls within a fixed CPU
+// budget per frame. Agents that don't get a slot keep acting on their last
+// decision, so the per-frame AI cost stays bounded regardless of agent count.
+// The budget is spent by each agent's cost estimate rather than the clock,
+// so which agents think on a tick never depends on timing.
+class AIScheduler {
+public:
+    AIScheduler();
+
+    void update(float dt, const std::vector<Character*>& targets);
+
+    void registerAgent(AIAgent* agent);
+    void unregisterAgent(AIAgent* agent);
+    void forgetTarget(Character* target);
+    void clear();
+
+    // Budget in estimated microseconds; at least one agent thinks every frame
+    void setBudget(float microseconds) { budgetMicroseconds = microseconds; }
+    float getBudget() const { return budgetMicroseconds; }
+
+    // Hard cap on think() calls per frame
+    void setMaxThinksPerFrame(size_t count) { maxThinksPerFrame = std::max<size_t>(1, count); }
+    size_t getMaxThinksPerFrame() const { return maxThinksPerFrame; }
+
+    const AIWorldSnapshot& getWorld() const { return world; }
+    size_t getAgentCount() const { return agents.size(); }
+    size_t getLastThinkCount() const { return lastThinkCount; }
+    // Measured time of the last frame's thinks, to check the estimates
+    float getLastThinkMicroseconds() const { return lastThinkMicroseconds; }
+
+    // Agent order and think timers, so a restored keyframe schedules the
+    // same agents on the same ticks. Agents must be Characters.
+    void saveState(StateBuffer& buffer) const;
+    void loadState(StateBuffer& buffer);
+
+private:
+    struct AgentSlot {
+        AIAgent* agent;
+        float sinceLastThink;
+    };
+
+    AIWorldSnapshot world;
+    std::vector<AgentSlot> agents;
+    size_t cursor = 0;
+    size_t lastThinkCount = 0;
+    float lastThinkMicroseconds = 0.0f;
+    float budgetMicroseconds = 500.0f;
+    size_t maxThinksPerFrame = 16;
+};
+
+} // namespace BVA
@@ -1,38 +1,18 @@
 #pragma once
 
 #include "Character.hpp"
+#include "AIScheduler.hpp"
 #include <vector>
-#include <functional>
 
 namespace BVA {
 
-enum class BossType {
-    Bastiaan,
-    KeizerBomTaha,
-    Mees,
-    PrincipalVanDerBerg,
-    JanitorKing,
-    HeadChef
-};
-
 enum class BossPhase {
     Phase1,
     Phase2,
     Phase3
 };
 
-struct BossAttack {
-    std::string name;
-    float damage;
-    float range;
-    float cooldown;
-    float windupTime;
-    bool isAOE;
-    bool isProjectile;
-    std::function<void(class Boss*, Character*)> executeFunc;
-};
-
-class Boss : public Character {
+class Boss : public Character, public AIAgent {
 public:
     Boss(BossType type);
     virtual ~Boss() = default;
@@ -40,32 +20,51 @@ public:
     void update(float dt) override;
     void takeDamage(float damage, Character* attacker = nullptr) override;
 
+    // AIAgent: utility-scored attack selection, time-sliced by AIScheduler
+    void think(const AIWorldSnapshot& world, float elapsed) override;
+    float estimateThinkCost(const AIWorldSnapshot& world) const override;
+    void forgetTarget(Character* target) override;
+
+    void saveState(StateBuffer& buffer) const override;
+    void loadState(StateBuffer& buffer) override;
+
     // Boss-specific
     BossType getBossType() const { return bossType; }
     BossPhase getCurrentPhase() const { return currentPhase; }
-    const std::string& getIntroText() const { return introText; }
+    const char* getIntroText() const { return GameData::getString(bossDefinition->introText); }
     bool isInIntro() const { return inIntro; }
     void startBattle();
 
 protected:
+    const char* getRenderGroup() const override { return "Boss"; }
     virtual void updateAI(float dt);
     virtual void selectNextAttack();
-    virtual void executeAttack(const BossAttack& attack);
+    virtual void executeAttack(const BossAttackRecord& attack);
     virtual void onPhaseChange(BossPhase newPhase);
     virtual void playIntro();
+    virtual float scoreAttack(size_t index, const AIWorldSnapshot& world,
+                              const Ogre::Vector3& position) const;
 
-    void addAttack(const BossAttack& attack);
     void transitionToPhase(BossPhase phase);
 
     BossType bossType;
+    const BossRecord* bossDefinition;  // Shared, owned by GameData
     BossPhase currentPhase = BossPhase::Phase1;
-    std::string introText;
 
-    std::vector<BossAttack> availableAttacks;
-    BossAttack* currentAttack = nullptr;
+    // Attack table slice from GameData
+    const BossAttackRecord* attacks = nullptr;
+    uint32_t attackCount = 0;
+    int currentAttackIndex = -1;  // Attack in windup, -1 if none
     float attackCooldown = 0.0f;
     float attackWindup = 0.0f;
 
+    // Latest AI decision (refreshed by think())
+    int plannedAttackIndex = -1;
+    int lastAttackIndex = -1;
+    bool approachTarget = false;
+    float targetDistance = 0.0f;
+    static constexpr float AGGRO_RANGE = 60.0f;
+
     bool inIntro = true;
     float introTimer = 0.0f;
     Character* targetPlayer = nullptr;
@@ -99,12 +98,13 @@ public:
     MeesBoss();
 protected:
     void updateAI(float dt) override;
-    void throwPitaSirracha();
 };
 
 class PrincipalVanDerBergBoss : public Boss {
 public:
     PrincipalVanDerBergBoss();
+    void saveState(StateBuffer& buffer) const override;
+    void loadState(StateBuffer& buffer) override;
 protected:
     void updateAI(float dt) override;
     void onPhaseChange(BossPhase newPhase) override;
@@ -117,6 +117,8 @@ private:
 class JanitorKingBoss : public Boss {
 public:
     JanitorKingBoss();
+    void saveState(StateBuffer& buffer) const override;
+    void loadState(StateBuffer& buffer) override;
 protected:
     void updateAI(float dt) override;
     void onPhaseChange(BossPhase newPhase) override;
@@ -128,6 +130,8 @@ private:
 class HeadChefBoss : public Boss {
 public:
     HeadChefBoss();
+    void saveState(StateBuffer& buffer) const override;
+    void loadState(StateBuffer& buffer) override;
 protected:
     void updateAI(float dt) override;
     void onPhaseChange(BossPhase newPhase) override;
@@ -139,4 +143,8 @@ private:
 // Boss factory
 std::unique_ptr<Boss> createBoss(BossType type);
 
+// Enemy archetype a boss summons mid-fight (nullptr if none), so levels can
+// size their enemy pools up front
+const char* getBossSummonArchetype(BossType type);
+
 } // namespace BVA
@@ -1,56 +1,19 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <OGRE/Ogre.h>
 #include "physics/PhysicsEngine.hpp"
+#include "gameplay/ProjectileSystem.hpp"
+#include "core/GameData.hpp"
+#include "graphics/AnimationClip.hpp"
 
 namespace BVA {
 
-enum class CharacterID {
-    Bas,
-    Berkay,
-    Luca,
-    Gefferinho,
-    Hadi,
-    Nitin,
-    PalaBaba,
-    Fufinho,
-    EfeAbi,
-    Jad,
-    Umut,
-    KeizerBomTaha,
-    GoonLordTobese
-};
-
-enum class AbilityEffect {
-    DamageBoost,
-    SpeedBoost,
-    HealthBoost,
-    SplashDamage,
-    FireDamage,
-    Projectile,
-    PlaneSummon
-};
-
-struct AbilityData {
-    std::string name;
-    std::string voiceLine;
-    std::vector<std::pair<AbilityEffect, float>> effects;
-    float duration;
-    float cooldown;
-    std::string description;
-};
-
-struct CharacterStats {
-    float maxHealth = 100.0f;
-    float moveSpeed = 5.0f;
-    float attackDamage = 10.0f;
-    float attackSpeed = 1.0f;
-    float defense = 0.0f;
-};
+class StateBuffer;
 
 class Character {
 public:
@@ -74,7 +37,7 @@ public:
     // Combat
     void attack();
     void useAbility();
-    void takeDamage(float damage, Character* attacker = nullptr);
+    virtual void takeDamage(float damage, Character* attacker = nullptr);
     void heal(float amount);
     bool isAlive() const { return currentHealth > 0.0f; }
 
@@ -84,33 +47,59 @@ public:
     void applySplashDamage(float damage, float radius);
     void applyFireDamage(float dps, float duration);
 
+    // Projectiles (pooled in ProjectileSystem)
+    bool launchProjectile(const Ogre::Vector3& direction, const ProjectileDesc& desc);
+    // Launches record.count projectiles fanned around direction
+    int launchProjectiles(const Ogre::Vector3& direction, const ProjectileRecord& record, float damage);
+
+    // Snapshot of simulation state (replay keyframes)
+    virtual void saveState(StateBuffer& buffer) const;
+    virtual void loadState(StateBuffer& buffer);
+
     // Getters
     CharacterID getID() const { return id; }
-    const std::string& getName() const { return name; }
+    const char* getName() const { return name; }
+    const CharacterRecord& getDefinition() const { return *definition; }
     float getHealth() const { return currentHealth; }
     float getMaxHealth() const { return stats.maxHealth; }
     float getHealthPercent() const { return currentHealth / stats.maxHealth; }
     bool canUseAbility() const { return abilityCooldownTimer <= 0.0f; }
     float getAbilityCooldownPercent() const;
     const CharacterStats& getStats() const { return stats; }
-    Ogre::SceneNode* getSceneNode() { return sceneNode; }
+    // Null until the render thread has created it
+    Ogre::SceneNode* getSceneNode() { return renderReady ? sceneNode : nullptr; }
+    void setVisible(bool visible);
+    const Ogre::Vector3& getFacing() const { return facing; }
+    bool isHostile() const { return hostile; }
+    void setHostile(bool value) { hostile = value; }
 
 protected:
+    // Applies the ability effects from the definition table
     virtual void onAbilityActivated();
     virtual void updateAbility(float dt);
-    void playVoiceLine(const std::string& line);
-    void playAnimation(const std::string& animName, bool loop = false);
+    virtual Ogre::ColourValue getBodyColor() const;
+    // Characters in the same group are drawn in one instanced batch
+    virtual const char* getRenderGroup() const { return "Players"; }
+    void playVoiceLine(const char* line);
+    // duration > 0 stretches the clip to fit (e.g. an attack windup). One-shot
+    // clips hold off the idle/run locomotion clips until they finish.
+    void playAnimation(const std::string& animName, bool loop = false, float duration = 0.0f);
+    void playAnimation(AnimationClipId clip, bool loop = false, float duration = 0.0f);
+    // Moves the scene node with the next frame, even before it exists
+    void queuePosition(const Ogre::Vector3& pos);
 
     CharacterID id;
-    std::string name;
+    const CharacterRecord* definition;  // Shared, owned by GameData
+    const char* name;
     CharacterStats stats;
-    AbilityData ability;
 
     // Current state
     float currentHealth;
     bool isJumping = false;
     bool isAttacking = false;
     bool isUsingAbility = false;
+    bool hostile = false;
+    Ogre::Vector3 facing = Ogre::Vector3::UNIT_Z;
 
     // Cooldowns
     float attackCooldownTimer = 0.0f;
@@ -125,10 +114,17 @@ protected:
     float fireDamageTimer = 0.0f;
     float fireDPS = 0.0f;
 
-    // Graphics and physics
+    // Graphics and physics. The render objects are created and destroyed on
+    // the render thread; the simulation reads them only once renderReady is
+    // set and otherwise reaches them through queued commands.
     Ogre::SceneNode* sceneNode = nullptr;
     Ogre::Entity* entity = nullptr;
-    Ogre::AnimationState* currentAnimation = nullptr;
+    int renderInstance = -1;     // CharacterInstancer id
+    int animationInstance = -1;  // AnimationSystem id
+    bool renderQueued = false;   // Creation command sent
+    std::atomic<bool> renderReady{false};
+    AnimationClipId currentAnimation = AnimationClipId::Count;
+    float animationLock = 0.0f;  // Time left on the current one-shot clip
     PhysicsBody* physicsBody = nullptr;
 
     // Particle effects
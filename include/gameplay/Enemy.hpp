@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Character.hpp"
+#include "AIScheduler.hpp"
+#include <string>
+
+namespace BVA {
+
+// Static description of a regular (non-boss) enemy type
+struct EnemyArchetype {
+    const char* name;
+    CharacterStats stats;
+    Ogre::ColourValue color;
+    float scale;
+    float aggroRange;
+    float attackRange;
+};
+
+// Returns nullptr for unknown archetype names
+const EnemyArchetype* findEnemyArchetype(const std::string& name);
+
+// Stable position in the archetype table (for snapshots); nullptr/-1 if out of range
+const EnemyArchetype* getEnemyArchetype(int index);
+int getEnemyArchetypeIndex(const EnemyArchetype& archetype);
+
+// Pooled enemy instance. Created and initialized once per pool slot, then
+// activated/deactivated by EnemySpawner instead of being constructed and
+// destroyed during gameplay.
+class EnemyCharacter : public Character, public AIAgent {
+public:
+    EnemyCharacter(const EnemyArchetype& archetype);
+
+    void initialize(Ogre::SceneManager* sceneManager, PhysicsEngine* physics) override;
+    void update(float dt) override;
+
+    // AIAgent: target selection runs in scheduler slices
+    void think(const AIWorldSnapshot& world, float elapsed) override;
+    float estimateThinkCost(const AIWorldSnapshot& world) const override;
+    void forgetTarget(Character* target) override;
+
+    // Pool lifecycle
+    void activate(const Ogre::Vector3& position);
+    void deactivate();
+    bool isActive() const { return active; }
+
+    const EnemyArchetype& getArchetype() const { return archetype; }
+
+    // Slot in the spawner's pool for this archetype
+    void setPoolIndex(int index) { poolIndex = index; }
+    int getPoolIndex() const { return poolIndex; }
+
+    void saveState(StateBuffer& buffer) const override;
+    void loadState(StateBuffer& buffer) override;
+
+protected:
+    Ogre::ColourValue getBodyColor() const override { return archetype.color; }
+    const char* getRenderGroup() const override { return archetype.name; }
+
+private:
+    void updateAI(float dt);
+
+    const EnemyArchetype& archetype;
+    bool active = false;
+    int poolIndex = 0;
+    Character* target = nullptr;  // Chosen by think()
+};
+
+} // namespace BVA
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Enemy.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace BVA {
+
+class PhysicsEngine;
+
+// Owns per-archetype pools of pre-initialized enemies. Pools are filled at
+// level load (mesh, scene node and physics body created up front), so
+// spawning mid-fight only flips an instance from the free list to active.
+class EnemySpawner {
+public:
+    EnemySpawner();
+    ~EnemySpawner();
+
+    bool initialize(Ogre::SceneManager* sceneManager, PhysicsEngine* physics);
+    void shutdown();
+
+    // Grows the pool of each archetype to at least poolSize instances.
+    // Pools are kept across levels and never shrink.
+    void prepareLevel(const std::vector<std::string>& archetypes, int poolSize);
+
+    // Returns nullptr if the archetype is unknown or its pool is exhausted
+    EnemyCharacter* spawn(const std::string& archetypeName, const Ogre::Vector3& position);
+
+    // Spawns up to count enemies on a ring, the first at startAngle
+    // (radians); returns the number spawned
+    int spawnWave(const std::string& archetypeName, int count, const Ogre::Vector3& center,
+                  float radius, std::vector<EnemyCharacter*>& spawned, float startAngle = 0.0f);
+
+    void despawn(EnemyCharacter* enemy);
+    void despawnAll();
+
+    int getFreeCount(const std::string& archetypeName) const;
+    // Instances created so far, free or active
+    int getPoolSize(const std::string& archetypeName) const;
+
+    // Stable ids (archetype table index + pool slot) for snapshots
+    int getInstanceId(const EnemyCharacter* enemy) const;
+    EnemyCharacter* getInstance(int id);
+
+    // Pool occupancy and the state of every active instance
+    void saveState(StateBuffer& buffer) const;
+    void loadState(StateBuffer& buffer);
+
+private:
+    struct Pool {
+        const EnemyArchetype* archetype = nullptr;
+        std::vector<std::unique_ptr<EnemyCharacter>> instances;
+        std::vector<EnemyCharacter*> freeList;
+    };
+
+    Pool* findPool(const std::string& archetypeName);
+    const Pool* findPool(const std::string& archetypeName) const;
+
+    Ogre::SceneManager* sceneManager = nullptr;
+    PhysicsEngine* physics = nullptr;
+    std::unordered_map<std::string, Pool> pools;
+};
+
+} // namespace BVA
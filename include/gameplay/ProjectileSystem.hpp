@@ -0,0 +1,112 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "core/GameData.hpp"
+
+namespace BVA {
+
+class Character;
+class GraphicsEngine;
+class InstanceBatch;
+class StateBuffer;
+
+enum class ProjectileTeam : uint8_t {
+    Players,
+    Enemies
+};
+
+struct ProjectileDesc {
+    float speed = 20.0f;
+    float damage = 10.0f;
+    float radius = 0.3f;
+    float lifetime = 3.0f;
+    float gravityScale = 0.0f;
+    float fireDPS = 0.0f;
+    float fireDuration = 0.0f;
+    float splashRadius = 0.0f;
+    float scale = 1.0f;
+    Ogre::ColourValue color = Ogre::ColourValue::White;
+};
+
+// Desc for a projectile defined in the game data table
+ProjectileDesc makeProjectileDesc(const ProjectileRecord& record, float damage);
+
+// Fixed-capacity projectile pool stored as structure-of-arrays. Live
+// projectiles are kept packed at the front of every array (swap-remove on
+// expiry) so integration and collision walk contiguous memory.
+class ProjectileSystem {
+public:
+    static constexpr size_t MAX_PROJECTILES = 2048;
+
+    ProjectileSystem();
+    ~ProjectileSystem();
+
+    // sceneManager may be null for headless simulation
+    bool initialize(Ogre::SceneManager* sceneManager);
+    void shutdown();
+
+    // Integrates, collides against the given characters and renders
+    void update(float dt, const std::vector<Character*>& targets);
+
+    // Returns false if the pool is full
+    bool spawn(Character* owner, ProjectileTeam team, const Ogre::Vector3& position,
+               const Ogre::Vector3& direction, const ProjectileDesc& desc);
+
+    // Clears dangling owner references when a character is removed
+    void forgetOwner(Character* owner);
+    void clear();
+
+    size_t getActiveCount() const { return activeCount; }
+
+    // Live projectiles for replay keyframes
+    void saveState(StateBuffer& buffer) const;
+    void loadState(StateBuffer& buffer);
+
+    // Character collision capsule (matches Character::initialize)
+    static constexpr float CAPSULE_RADIUS = 0.5f;
+    static constexpr float CAPSULE_HALF_HEIGHT = 0.5f;
+
+private:
+    void integrate(float dt);
+    void collide(const std::vector<Character*>& targets);
+    void applyHit(size_t index, Character* target);
+    void applySplash(size_t index, const std::vector<Character*>& targets, Character* directHit);
+    void kill(size_t index);
+    void updateRendering();
+
+    // SoA storage, live entries in [0, activeCount)
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> prevX, prevY, prevZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> damage;
+    std::vector<float> radius;
+    std::vector<float> lifetime;
+    std::vector<float> gravity;
+    std::vector<float> fireDPS;
+    std::vector<float> fireDuration;
+    std::vector<float> splashRadius;
+    std::vector<float> scale;
+    std::vector<Ogre::ColourValue> color;
+    std::vector<Character*> owner;
+    std::vector<ProjectileTeam> team;
+    std::vector<uint8_t> dead;
+    size_t activeCount = 0;
+
+    // Target capsules gathered once per update
+    std::vector<float> targetX, targetY, targetZ;
+    std::vector<ProjectileTeam> targetTeam;
+
+    // Rendering
+    Ogre::SceneManager* sceneManager = nullptr;
+    GraphicsEngine* graphics = nullptr;  // Owns the render thread the batch lives on
+    Ogre::SceneNode* batchNode = nullptr;
+    std::unique_ptr<InstanceBatch> batch;
+};
+
+// Team of a character for projectile filtering
+ProjectileTeam getProjectileTeam(const Character* character);
+
+} // namespace BVA
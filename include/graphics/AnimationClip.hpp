@@ -0,0 +1,124 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace BVA {
+
+// Bones of the procedural humanoid. The shared character mesh is rigidly
+// skinned: every vertex follows exactly one of these.
+enum class HumanoidBone : uint8_t {
+    Root,
+    Spine,
+    Head,
+    ArmLeft,
+    ArmRight,
+    LegLeft,
+    LegRight,
+    Count
+};
+
+constexpr int HUMANOID_BONE_COUNT = static_cast<int>(HumanoidBone::Count);
+// Poses are padded to one 8-wide SIMD batch of bones
+constexpr int POSE_BONES = 8;
+static_assert(HUMANOID_BONE_COUNT <= POSE_BONES, "humanoid must fit one pose batch");
+
+// Bind pose of the 2-unit humanoid ProceduralMeshGenerator builds: parent
+// bone (-1 for the root) and joint position in model space
+struct HumanoidSkeleton {
+    static int parent(int bone);
+    static Ogre::Vector3 joint(int bone);
+};
+
+enum class AnimationClipId : uint8_t {
+    Idle,
+    Run,
+    Attack,
+    Windup,
+    Ability,
+    Hit,
+    Death,
+    Count
+};
+
+struct AnimationClipInfo {
+    const char* name;
+    float length;  // Seconds at speed 1
+    bool loop;
+};
+
+// Static clip table, safe to read from the simulation thread
+const AnimationClipInfo& getAnimationClipInfo(AnimationClipId clip);
+// Count for unknown names
+AnimationClipId findAnimationClip(const std::string& name);
+
+// Local pose: a rotation per bone (SoA, padding bones stay identity) and the
+// root's offset from its bind position
+struct Pose {
+    alignas(32) float qx[POSE_BONES];
+    alignas(32) float qy[POSE_BONES];
+    alignas(32) float qz[POSE_BONES];
+    alignas(32) float qw[POSE_BONES];
+    Ogre::Vector3 rootOffset;
+
+    void setIdentity();
+    void setRotation(HumanoidBone bone, const Ogre::Quaternion& q);
+};
+
+// Keyframe-reduced, quantized clip. Authored by sampling a function at
+// SAMPLE_RATE; each track then keeps only the keys that linear
+// interpolation between its neighbours cannot reproduce within tolerance.
+// Rotations are stored as four int16 components, root offsets as three
+// int16 over +-ROOT_RANGE. Clips are immutable and shared by every
+// character playing them.
+class AnimationClip {
+public:
+    static constexpr float SAMPLE_RATE = 30.0f;
+    static constexpr float ROOT_RANGE = 2.0f;
+
+    using Sampler = std::function<void(float time, Pose& pose)>;
+
+    AnimationClip() = default;
+    static AnimationClip build(float length, bool loop, const Sampler& sampler);
+
+    // Procedural humanoid clips for the static clip table
+    static AnimationClip buildHumanoid(AnimationClipId clip);
+
+    // time is wrapped for looping clips and clamped otherwise
+    void sample(float time, Pose& pose) const;
+
+    float getLength() const { return length; }
+    bool isLooping() const { return loop; }
+    size_t getKeyCount() const { return rotationKeys.size() + rootKeys.size(); }
+    size_t getSampledKeyCount() const { return sampledKeys; }
+    size_t getByteSize() const;
+
+private:
+    struct Track {
+        uint16_t first = 0;  // Into the key arrays
+        uint16_t count = 0;
+    };
+
+    using RotationKey = std::array<int16_t, 4>;
+    using RootKey = std::array<int16_t, 3>;
+
+    float length = 0.0f;
+    bool loop = false;
+    uint16_t frameCount = 0;  // Sampled frames, last one at `length`
+
+    std::array<Track, HUMANOID_BONE_COUNT> rotationTracks;
+    Track rootTrack;
+
+    std::vector<uint16_t> rotationFrames;  // Frame of each key
+    std::vector<RotationKey> rotationKeys;
+    std::vector<uint16_t> rootFrames;
+    std::vector<RootKey> rootKeys;
+
+    size_t sampledKeys = 0;
+};
+
+} // namespace BVA
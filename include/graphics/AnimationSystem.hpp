@@ -0,0 +1,134 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "graphics/AnimationClip.hpp"
+
+namespace BVA {
+
+// Skeletal animation for the instanced characters. Clips are built once and
+// shared; each character only owns a small playback state (clip, clock,
+// cross-fade), so there is no per-bone object or virtual call anywhere.
+// Every frame the instancer reserves one palette row per character it
+// draws, in draw order; the poses due this frame are then evaluated in
+// parallel (8 bones per SIMD batch), turned into 3x4 skin matrices and
+// uploaded as one float texture that the skinned instanced shaders index
+// with gl_InstanceID. Small or distant characters are re-evaluated every
+// second or fourth frame and reuse their previous matrices in between.
+class AnimationSystem {
+public:
+    static constexpr int INVALID_INSTANCE = -1;
+
+    // One palette row per drawn character: 3 RGBA32F texels per bone
+    static constexpr const char* PALETTE_TEXTURE = "CharacterBonePalette";
+    static constexpr int PALETTE_WIDTH = POSE_BONES * 3;
+    static constexpr int MAX_PALETTE_ROWS = 1024;
+
+    // Renderable custom parameter holding a batch's first palette row
+    static constexpr size_t BONE_ROW_PARAM = 0;
+
+    // Projected radius (fraction of the half screen height) above which a
+    // pose is evaluated every frame, or every second frame
+    static constexpr float FULL_RATE_SCREEN_SIZE = 0.1f;
+    static constexpr float HALF_RATE_SCREEN_SIZE = 0.04f;
+
+    AnimationSystem();
+    ~AnimationSystem();
+
+    // 0 threads = one per core left over by the simulation and render threads
+    bool initialize(unsigned threadCount = 0);
+    void shutdown();
+
+    int addInstance();
+    void removeInstance(int instance);
+
+    // Cross-fades from whatever is playing. Replaying the looping clip that
+    // is already playing keeps its clock.
+    void play(int instance, AnimationClipId clip, bool loop, float speed = 1.0f, float blendTime = 0.15f);
+
+    // Advances every clock; call once per frame
+    void update(float dt);
+
+    // Palette for one frame: begin, one row per drawn character, commit
+    void beginPalette(const Ogre::Camera* camera);
+    // Returns the row, or -1 when the palette is full. Invalid instances get
+    // the bind pose.
+    int addToPalette(int instance, const Ogre::Vector3& position, float radius);
+    void commitPalette();
+
+    // Adds the palette texture and row base to a pass running a SKINNED
+    // instanced vertex program
+    static void bindPalette(Ogre::Pass* pass);
+
+    const AnimationClip& getClip(AnimationClipId clip) const;
+
+    // Stats for the last palette
+    size_t getPaletteRows() const { return paletteRows; }
+    size_t getEvaluatedCount() const { return evaluated; }
+    size_t getClipBytes() const;
+
+private:
+    struct Instance {
+        AnimationClipId clip = AnimationClipId::Idle;
+        AnimationClipId fromClip = AnimationClipId::Idle;
+        float time = 0.0f;
+        float fromTime = 0.0f;
+        float speed = 1.0f;
+        float fromSpeed = 1.0f;
+        float blend = 1.0f;      // Weight of clip over fromClip
+        float blendRate = 0.0f;  // Per second
+        bool loop = true;
+        bool fromLoop = true;
+        bool dirty = true;       // Evaluate at the next palette whatever its LOD
+        bool used = false;
+        uint64_t paletteFrame = 0;
+    };
+
+    // Skin matrices of one character, as they go into its palette row
+    using SkinRow = std::array<float, PALETTE_WIDTH * 4>;
+
+    void evaluate(int instance);
+    void runEvaluations();
+    void drainJobs();
+    void workerMain();
+
+    std::array<AnimationClip, static_cast<size_t>(AnimationClipId::Count)> clips;
+
+    std::vector<Instance> instances;
+    std::vector<SkinRow> skins;
+    std::vector<int> freeSlots;
+
+    // This frame's palette
+    std::vector<float> paletteData;
+    std::vector<int> paletteInstances;  // Instance per row, -1 for bind pose
+    std::vector<int> dueInstances;
+    size_t paletteRows = 0;
+    size_t evaluated = 0;
+    uint64_t frameIndex = 0;
+    Ogre::Vector3 cameraPosition = Ogre::Vector3::ZERO;
+    float screenScale = 1.0f;  // 1 / tan(fovY / 2)
+
+    Ogre::TexturePtr paletteTexture;
+    SkinRow bindPose;
+
+    // Persistent evaluation workers; the render thread takes a share too
+    std::vector<std::thread> workers;
+    std::mutex jobMutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobDone;
+    uint64_t jobGeneration = 0;
+    size_t workersBusy = 0;
+    bool stopping = false;
+    std::atomic<size_t> nextJob{0};
+
+    static constexpr size_t JOB_BATCH = 8;
+    // Fewer due poses than this are evaluated on the render thread alone
+    static constexpr size_t MIN_PARALLEL_POSES = 32;
+};
+
+} // namespace BVA
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <array>
+#include <vector>
+
+namespace BVA {
+
+// Drives the main camera: frames every tracked player (co-op and versus
+// keep all of them in view) and adds screen shake on top. Shake follows a
+// trauma model: each source adds trauma that fades out linearly over its
+// duration, the sources are summed (clamped to 1), and the offset scales
+// with trauma squared, so small hits stay subtle. Offsets come from smooth
+// gradient noise sampled by time, and smoothing uses exponential decay per
+// second, so the camera moves the same at any frame rate.
+// Render thread only; the simulation sends targets and shakes through the
+// frame packet.
+class CameraController {
+public:
+    explicit CameraController(Ogre::Camera* camera);
+
+    void update(float dt);
+
+    // Players to keep in frame; none frames the arena centre
+    void setTargets(const std::vector<Ogre::Vector3>& positions);
+
+    // trauma in [0, 1], fading to nothing over duration seconds
+    void addTrauma(float trauma, float duration);
+    void clearShake();
+
+    float getTrauma() const;
+    Ogre::Camera* getCamera() { return camera; }
+
+    // Tuning
+    static constexpr size_t MAX_TRAUMA_SOURCES = 8;
+    static constexpr float MAX_SHAKE_OFFSET = 0.5f;      // World units at trauma 1
+    static constexpr float MAX_SHAKE_ANGLE = 3.0f;       // Degrees at trauma 1
+    static constexpr float SHAKE_FREQUENCY = 15.0f;      // Noise cells per second
+    static constexpr float FOLLOW_SHARPNESS = 4.0f;      // 1/s; higher follows faster
+    static constexpr float FRAME_MARGIN = 4.0f;          // World units around the targets
+
+private:
+    struct TraumaSource {
+        float trauma = 0.0f;
+        float decayPerSecond = 0.0f;
+    };
+
+    void updateRig(float dt);
+    void applyShake();
+
+    Ogre::Camera* camera;
+
+    // Unshaken placement: the view direction is the camera's initial one,
+    // the focus and distance are smoothed towards framing the targets
+    Ogre::Vector3 viewDirection;   // From focus to camera, unit length
+    float baseDistance;            // Initial distance; the closest it gets
+    Ogre::Vector3 focus = Ogre::Vector3::ZERO;
+    float distance;
+    Ogre::Vector3 rigPosition;
+    Ogre::Quaternion rigOrientation;
+
+    std::vector<Ogre::Vector3> targets;
+    std::array<TraumaSource, MAX_TRAUMA_SOURCES> sources{};
+    float time = 0.0f;
+};
+
+} // namespace BVA
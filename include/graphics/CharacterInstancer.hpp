@@ -0,0 +1,94 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "graphics/InstanceBatch.hpp"
+
+namespace BVA {
+
+class ShadowCascades;
+class VisibilityCuller;
+class AnimationSystem;
+
+// Draws every character with the shared humanoid mesh through hardware
+// instancing. Characters are grouped (players, boss, one group per enemy
+// archetype) and each group has one InstanceBatch per mesh LOD level, so a
+// whole enemy wave is at most one draw call per level. Every frame each
+// instance goes into the batch of the LOD its screen size selects. Instances
+// follow their scene node's transform and carry their own body colour.
+// Batches cast shadows and are registered with the shadow cascades as
+// dynamic casters. With a culler, instances it finds invisible are left out
+// of the batches. With an animation system, each drawn instance takes a
+// bone palette row (consecutive per batch, in instance order) and the batch
+// is told where its rows start.
+class CharacterInstancer {
+public:
+    static constexpr int INVALID_INSTANCE = -1;
+
+    CharacterInstancer(Ogre::SceneManager* sceneManager, ShadowCascades* shadows = nullptr,
+                       VisibilityCuller* culler = nullptr, AnimationSystem* animations = nullptr);
+    ~CharacterInstancer();
+
+    bool initialize();
+    void shutdown();
+
+    // Gathers node transforms into the instance buffers; call once per frame
+    // after gameplay has moved the nodes and the culler has run, between the
+    // animation system's beginPalette and commitPalette. LODs are picked
+    // for `camera`; without one everything draws at full detail.
+    void update(const Ogre::Camera* camera);
+
+    // animation is an AnimationSystem instance; -1 draws the bind pose
+    int addInstance(const std::string& group, Ogre::SceneNode* node, const Ogre::ColourValue& colour,
+                    int animation = -1);
+    void removeInstance(int instanceId);
+    void setInstanceVisible(int instanceId, bool visible);
+    void setInstanceColour(int instanceId, const Ogre::ColourValue& colour);
+
+    // For inspecting the generated instance buffers
+    const InstanceBatch* getBatch(const std::string& group, size_t lod = 0) const;
+    size_t getLodCount() const { return lodCount; }
+    size_t getGroupCount() const { return groups.size(); }
+
+private:
+    struct Instance {
+        Ogre::SceneNode* node = nullptr;
+        Ogre::ColourValue colour;
+        int cullEntity = -1;
+        int animation = -1;
+        bool visible = true;
+        bool used = false;
+    };
+
+    struct Group {
+        std::string name;
+        std::vector<std::unique_ptr<InstanceBatch>> batches;  // One per LOD level
+        Ogre::SceneNode* batchNode = nullptr;
+        std::vector<Instance> instances;
+        std::vector<int> freeSlots;
+    };
+
+    Group& getGroup(const std::string& name);
+    void createBatches(Group& group, size_t capacity);
+    Instance* findInstance(int instanceId);
+
+    Ogre::SceneManager* sceneManager;
+    ShadowCascades* shadows;
+    VisibilityCuller* culler;
+    AnimationSystem* animations;
+    Ogre::MeshPtr mesh;
+    Ogre::AxisAlignedBox posedBounds;  // Mesh bounds with room for posed limbs
+    float meshRadius = 1.0f;
+    size_t lodCount = 1;
+    std::vector<std::unique_ptr<Group>> groups;
+    std::vector<uint8_t> instanceLods;  // Per-frame scratch, NOT_DRAWN when skipped
+    std::unordered_map<std::string, size_t> groupIndices;
+
+    static constexpr size_t INITIAL_CAPACITY = 64;
+    static constexpr uint8_t NOT_DRAWN = 0xff;
+};
+
+} // namespace BVA
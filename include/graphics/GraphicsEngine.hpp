@@ -3,15 +3,32 @@
 #include <OGRE/Ogre.h>
 #include <OGRE/RTShaderSystem/OgreRTShaderSystem.h>
 #include <OGRE/Bites/OgreApplicationContext.h>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace BVA {
 
 class PostProcessManager;
+class CameraController;
 class ParticleManager;
 class LightingManager;
+class CharacterInstancer;
+class VisibilityCuller;
+class AnimationSystem;
+class LevelGeometry;
+class ShaderCache;
+class RenderThread;
+struct FramePacket;
+enum class GraphicsQuality;
 
+// Ogre lives on a dedicated render thread: the window, GL context and every
+// scene change are created and touched only there. The simulation writes
+// what changed into the frame packet and submits it once per frame; changes
+// that must take effect immediately (creating or destroying nodes and
+// batches) go through runOnRenderThread, which waits for them.
 class GraphicsEngine {
 public:
     GraphicsEngine();
@@ -19,8 +36,15 @@ public:
 
     bool initialize();
     void shutdown();
-    void render();
-    void update(float dt);
+
+    // Simulation thread: this frame's render work, and handing it over
+    FramePacket& getFramePacket();
+    void submitFrame(float dt);
+    void runOnRenderThread(std::function<void()> task);
+
+    bool isWindowClosed() const { return windowClosed; }
+    // How long the last submit waited for the previous frame to finish
+    float getRenderWaitMs() const;
 
     // Scene management
     Ogre::SceneManager* getSceneManager() { return sceneManager; }
@@ -31,17 +55,35 @@ public:
     Ogre::SceneNode* createSceneNode(const std::string& name = "");
     Ogre::Entity* createEntity(const std::string& meshName);
 
-    // Material system (PBR)
-    Ogre::MaterialPtr createPBRMaterial(const std::string& name,
-                                         const std::string& albedoTexture,
-                                         const std::string& normalTexture,
-                                         const std::string& metallicTexture,
-                                         const std::string& roughnessTexture);
+    // Material system (PBR): lit by the sun and the clustered point/spot
+    // lights, albedo from the vertex colours. Emissive materials add their
+    // colour on top and blend additively. Needs the lighting manager.
+    Ogre::MaterialPtr createPBRMaterial(const std::string& name, float metallic, float roughness,
+                                         float emissive = 0.0f);
+
+    // Quality preset for post-processing and the particle budget; any thread
+    void setGraphicsQuality(GraphicsQuality quality);
 
     // Subsystem accessors
     PostProcessManager* getPostProcess() { return postProcess.get(); }
+    // Render thread only; targets and shakes arrive with the frame packet
+    CameraController* getCameraController() { return cameraController.get(); }
+    // Render thread only; effects are spawned from frame commands
     ParticleManager* getParticles() { return particles.get(); }
     LightingManager* getLighting() { return lighting.get(); }
+    CharacterInstancer* getCharacterInstancer() { return characterInstancer.get(); }
+    VisibilityCuller* getCuller() { return culler.get(); }
+    // Render thread only; the simulation reaches it through frame commands
+    AnimationSystem* getAnimations() { return animations.get(); }
+    // Render thread only (load levels through runOnRenderThread)
+    LevelGeometry* getLevelGeometry() { return levelGeometry.get(); }
+    ShaderCache* getShaderCache() { return shaderCache.get(); }
+
+    // A level's files (assets/levels/<scene>) get their own resource group,
+    // so startup only initialises what the menu uses. Loading prepares the
+    // group; activating unloads every other level's. Render thread only.
+    void prepareLevelResources(const std::string& sceneName);
+    void activateLevelResources(const std::string& sceneName);
 
     // Window management
     Ogre::RenderWindow* getWindow() { return window; }
@@ -49,6 +91,12 @@ public:
     void toggleFullscreen();
 
 private:
+    // Render thread
+    bool setup();
+    void teardown();
+    void renderFrame(FramePacket& packet);
+    void update(float dt);
+
     void setupResources();
     void createScene();
     void setupCamera();
@@ -62,9 +110,20 @@ private:
     Ogre::Viewport* viewport = nullptr;
     Ogre::RTShader::ShaderGenerator* shaderGenerator = nullptr;
 
+    std::unique_ptr<CameraController> cameraController;
     std::unique_ptr<PostProcessManager> postProcess;
     std::unique_ptr<ParticleManager> particles;
     std::unique_ptr<LightingManager> lighting;
+    std::unique_ptr<CharacterInstancer> characterInstancer;
+    std::unique_ptr<VisibilityCuller> culler;
+    std::unique_ptr<AnimationSystem> animations;
+    std::unique_ptr<LevelGeometry> levelGeometry;
+    std::unique_ptr<ShaderCache> shaderCache;
+
+    std::vector<std::string> levelResourceGroups;  // Created, not yet destroyed
+
+    std::unique_ptr<RenderThread> renderThread;
+    std::atomic<bool> windowClosed{false};
 
     int entityCounter = 0;
     int nodeCounter = 0;
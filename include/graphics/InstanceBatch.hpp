@@ -0,0 +1,57 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <string>
+#include <vector>
+
+namespace BVA {
+
+// Draws up to maxInstances copies of one mesh in a single hardware-instanced
+// draw call. Per-instance data (3x4 world matrix + colour) is built on the CPU
+// each frame and uploaded to one dynamic vertex buffer bound as instance data.
+// A batch draws one LOD level of the mesh's first submesh.
+class InstanceBatch : public Ogre::SimpleRenderable {
+public:
+    static constexpr size_t FLOATS_PER_INSTANCE = 16;
+
+    InstanceBatch(const std::string& name, const Ogre::MeshPtr& mesh,
+                  const std::string& materialName, size_t maxInstances,
+                  unsigned short lodIndex = 0);
+    ~InstanceBatch();
+
+    // Per-frame instance submission
+    void beginUpdate();
+    bool addInstance(const Ogre::Vector3& position, const Ogre::Quaternion& orientation,
+                     float scale, const Ogre::ColourValue& colour);
+    void commit();
+
+    // Instance data packed elsewhere (e.g. by the simulation into a frame
+    // packet); replaces the current instances, commit() still uploads them
+    static void packInstance(float* dst, const Ogre::Vector3& position,
+                             const Ogre::Quaternion& orientation, float scale,
+                             const Ogre::ColourValue& colour);
+    void assignInstances(const float* data, size_t count);
+
+    size_t getInstanceCount() const { return instanceCount; }
+    size_t getMaxInstances() const { return maxInstances; }
+    unsigned short getLodIndex() const { return lodIndex; }
+    const std::vector<float>& getInstanceData() const { return instanceData; }
+
+    // SimpleRenderable
+    Ogre::Real getSquaredViewDepth(const Ogre::Camera* cam) const override;
+    Ogre::Real getBoundingRadius() const override { return boundingRadius; }
+
+private:
+    Ogre::MeshPtr mesh;
+    Ogre::HardwareVertexBufferSharedPtr instanceBuffer;
+
+    std::vector<float> instanceData;
+    size_t instanceCount = 0;
+    size_t maxInstances;
+    unsigned short lodIndex;
+
+    float meshRadius = 1.0f;
+    Ogre::Real boundingRadius = 0.0f;
+};
+
+} // namespace BVA
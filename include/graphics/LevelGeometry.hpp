@@ -0,0 +1,118 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BVA {
+
+class AssetBaker;
+class ShadowCascades;
+
+// ===== Baked level layout =====
+// A header followed by propCount fixed-size placements, used in place from
+// the baked blob like the game data table.
+
+constexpr uint32_t LEVEL_LAYOUT_MAGIC = 0x4c415642;  // "BVAL"
+
+struct PropPlacement {
+    uint32_t kind;  // PropKind
+    float position[3];
+    float yaw;      // Radians about +Y
+    float scale;
+};
+
+struct LevelLayoutHeader {
+    uint32_t magic;
+    uint32_t propCount;
+    float arenaSize;
+};
+
+// Non-moving level geometry: the arena floor and walls plus the props of the
+// level's scene (LevelData::sceneName). Every known scene's layout is baked
+// to a binary by the asset baker; loading a level places its props and the
+// arena into one Ogre StaticGeometry, which merges them into one vertex
+// buffer per material per region. Level draw calls therefore depend on the
+// region and material counts, not on how many props there are. Regions cast
+// shadows and are registered with the cascades as static casters.
+// The next level can be built while the current one is still shown:
+// prepare() builds it hidden, activate() swaps it in. The build can also be
+// spread over frames (beginPrepare/continuePrepare), so streaming a level
+// never takes one long render-thread step.
+// Render thread only, except prefetch().
+class LevelGeometry {
+public:
+    static constexpr float REGION_SIZE = 32.0f;
+
+    LevelGeometry(Ogre::SceneManager* sceneManager, ShadowCascades* shadows = nullptr);
+    ~LevelGeometry();
+
+    // Queues one layout job per known scene; loaded levels take their layout
+    // from `assets`
+    static void registerBakeJobs(AssetBaker& assets);
+
+    // Blocks until the scene's layout and every mesh it places are baked, so
+    // prepare() does not wait on the baker. Any thread.
+    static void prefetch(const std::string& sceneName);
+
+    // Replaces the current level. Unknown scenes (e.g. versus) get the bare
+    // arena.
+    bool load(const std::string& sceneName);
+    void unload();
+
+    // Builds a scene hidden, replacing any earlier prepared one
+    bool prepare(const std::string& sceneName);
+    // prepare() in slices: beginPrepare() places the arena, then each
+    // continuePrepare() places up to maxProps props; the call that places
+    // the last one builds the geometry and returns true
+    void beginPrepare(const std::string& sceneName);
+    bool continuePrepare(size_t maxProps);
+    // Shows the prepared scene in place of the current one; false if none
+    bool activate();
+    void discardPrepared();
+    bool hasPrepared() const { return pending != nullptr && !pendingLayout; }
+    const std::string& getPreparedSceneName() const { return pendingSceneName; }
+
+    const std::string& getSceneName() const { return sceneName; }
+    // World bounds of everything loaded
+    const Ogre::AxisAlignedBox& getBounds() const { return bounds; }
+    size_t getPropCount() const { return propCount; }
+    size_t getRegionCount() const { return regions.size(); }
+
+    // The layout blob for a scene, as the bake job produces it
+    static std::vector<uint8_t> buildLayout(const std::string& sceneName);
+
+private:
+    static bool validate(const uint8_t* data, size_t size);
+    // The scene's baked layout, or one built into `built` if there is none
+    static const LevelLayoutHeader* resolveLayout(const std::string& sceneName, std::vector<uint8_t>& built);
+    // Adds one placement to the pending build, sharing an entity per mesh
+    void addPending(const Ogre::MeshPtr& mesh, const Ogre::Vector3& position, const Ogre::Quaternion& orientation,
+                    float scale);
+    void destroyPendingEntities();
+
+    Ogre::SceneManager* sceneManager;
+    ShadowCascades* shadows;
+    Ogre::StaticGeometry* geometry = nullptr;
+    std::vector<Ogre::MovableObject*> regions;
+    Ogre::AxisAlignedBox bounds;
+    std::string sceneName;
+    size_t propCount = 0;
+
+    Ogre::StaticGeometry* pending = nullptr;
+    std::string pendingSceneName;
+    size_t pendingPropCount = 0;
+    // While a prepare is in progress: its layout, the next prop to place and
+    // the entities the build copies from
+    const LevelLayoutHeader* pendingLayout = nullptr;
+    std::vector<uint8_t> pendingLayoutData;  // Layouts that were not baked
+    uint32_t nextProp = 0;
+    std::vector<Ogre::Entity*> pendingEntities;
+    // StaticGeometry names are unique; a scene can be prepared while shown
+    unsigned buildCounter = 0;
+
+    static const AssetBaker* baked;
+};
+
+} // namespace BVA
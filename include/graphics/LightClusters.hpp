@@ -0,0 +1,100 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <cstdint>
+#include <vector>
+
+namespace BVA {
+
+// A point or spot light as the clustered shader sees it (world space)
+struct ClusterLight {
+    Ogre::Vector3 position;
+    float range;
+    Ogre::ColourValue colour;
+    Ogre::Vector3 direction;  // Spot lights only
+    float cosInner;
+    float cosOuter;
+    float linear;             // Ogre attenuation terms
+    float quadratic;
+    bool spot;
+};
+
+// Clustered forward light assignment. The view frustum is split into a
+// froxel grid (screen tiles x exponential depth slices); every frame each
+// light's bounding sphere is tested against the clusters of the slices it
+// overlaps, 8 clusters at a time, and the result is packed into compact
+// per-cluster index lists. Lights, lists and cluster ranges go to the GPU as
+// float textures that the lit shaders walk per fragment (ClusteredLighting.glsl),
+// so a fragment only pays for the lights that actually reach its cluster.
+class LightClusterGrid {
+public:
+    static constexpr int TILES_X = 16;
+    static constexpr int TILES_Y = 9;
+    static constexpr int SLICES = 24;
+    static constexpr int TILE_COUNT = TILES_X * TILES_Y;
+    static constexpr int CLUSTER_COUNT = TILE_COUNT * SLICES;
+
+    static constexpr size_t MAX_LIGHTS = 256;
+    static constexpr int INDEX_TEXTURE_WIDTH = 1024;
+    static constexpr size_t MAX_INDICES = INDEX_TEXTURE_WIDTH * 64;
+
+    // Depth slicing range; nearer fragments use slice 0, further the last
+    static constexpr float CLUSTER_NEAR = 1.0f;
+    static constexpr float CLUSTER_FAR = 200.0f;
+
+    LightClusterGrid();
+    ~LightClusterGrid();
+
+    bool initialize();
+    void shutdown();
+
+    // Bins the lights for this camera and uploads the cluster textures
+    void update(const Ogre::Camera* camera, const std::vector<ClusterLight>& lights);
+
+    // Adds the cluster textures and parameters to a pass whose fragment
+    // program includes ClusteredLighting.glsl
+    void bindToPass(Ogre::Pass* pass) const;
+
+    // Stats for the last update
+    size_t getLightCount() const { return lightCount; }
+    size_t getAssignedIndexCount() const { return assignedIndices; }
+    uint32_t getMaxLightsPerCluster() const { return maxPerCluster; }
+
+private:
+    void buildClusterBounds(const Ogre::Camera* camera);
+    void assignLights(const Ogre::Matrix4& view, const std::vector<ClusterLight>& lights);
+    void packLights(const std::vector<ClusterLight>& lights);
+    void upload();
+    int sliceForDepth(float depth) const;
+
+    // View-space AABB of every cluster, SoA, slice-major (TILE_COUNT is a
+    // multiple of 8 so every slice starts a fresh SIMD batch)
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+    float boundsFovY = 0.0f;
+    float boundsAspect = 0.0f;
+    float boundsNear = 0.0f;
+    float boundsFar = 0.0f;
+
+    float sliceScale = 0.0f;  // slice = log(depth) * scale + bias
+    float sliceBias = 0.0f;
+
+    // CPU copies of the GPU data
+    std::vector<float> lightData;    // 4 RGBA rows of MAX_LIGHTS texels
+    std::vector<float> clusterData;  // (offset, count) per cluster
+    std::vector<float> indexData;    // Light indices, INDEX_TEXTURE_WIDTH per row
+
+    std::vector<uint32_t> clusterCounts;
+    std::vector<uint32_t> clusterOffsets;
+    std::vector<uint32_t> hits;  // cluster << 8 | light
+
+    size_t lightCount = 0;
+    size_t assignedIndices = 0;
+    uint32_t maxPerCluster = 0;
+
+    Ogre::TexturePtr lightTexture;
+    Ogre::TexturePtr gridTexture;
+    Ogre::TexturePtr indexTexture;
+    Ogre::GpuSharedParametersPtr sharedParams;
+};
+
+} // namespace BVA
@@ -1,14 +1,41 @@
 #pragma once
 
 #include <OGRE/Ogre.h>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
 namespace BVA {
 
+class LightClusterGrid;
+class ShadowCascades;
+struct ClusterLight;
+
+// How a temporary light's intensity falls off over its lifetime
+enum class LightFade {
+    Linear,     // Straight ramp to zero
+    EaseOut,    // Holds brightness, drops off at the end
+    Flash,      // Fast decay for muzzle flashes and impacts
+    Constant    // Full brightness until it expires
+};
+
+// Refers to one temporary light. Stays safe to use after its pool slot has
+// been reused (it then simply no longer matches).
+struct LightHandle {
+    uint32_t slot = UINT32_MAX;
+    uint64_t serial = 0;
+
+    bool isValid() const { return slot != UINT32_MAX; }
+};
+
+// Temporary lights come from a fixed pool of slots that are recoloured,
+// moved and freed. They are not Ogre lights: they only feed the light
+// clusters, so a burst of flashes never enters Ogre's per-object light lists.
+// When the pool is exhausted the dimmest live light (oldest on ties) is
+// recycled.
 class LightingManager {
 public:
-    LightingManager(Ogre::SceneManager* sceneManager);
+    LightingManager(Ogre::SceneManager* sceneManager, Ogre::Camera* camera);
     ~LightingManager();
 
     bool initialize();
@@ -28,10 +55,16 @@ public:
                                   float angle = 45.0f);
 
     // Dynamic lighting for effects
-    Ogre::Light* createTemporaryLight(const Ogre::Vector3& position,
-                                       const Ogre::ColourValue& color,
-                                       float duration,
-                                       float range = 5.0f);
+    LightHandle createTemporaryLight(const Ogre::Vector3& position,
+                                     const Ogre::ColourValue& color,
+                                     float duration,
+                                     float range = 5.0f,
+                                     LightFade fade = LightFade::Linear);
+    bool isTemporaryLightActive(const LightHandle& handle) const;
+    void moveTemporaryLight(const LightHandle& handle, const Ogre::Vector3& position);
+    void stopTemporaryLight(const LightHandle& handle);
+
+    size_t getActiveTemporaryLightCount() const { return activeTemporaryLights; }
 
     // Environment
     void setAmbientLight(const Ogre::ColourValue& color);
@@ -41,22 +74,50 @@ public:
     void setShadowTechnique(Ogre::ShadowTechnique technique);
     void setShadowQuality(int textureSize, int numCascades = 3);
     void setShadowEnabled(bool enabled);
+    // Cascaded sun shadows; register moving casters here
+    ShadowCascades* getShadows() const { return shadows.get(); }
+
+    // Clustered point/spot light assignment for the lit materials
+    LightClusterGrid* getClusters() const { return clusters.get(); }
 
 private:
+    struct TemporaryLight {
+        Ogre::Vector3 position = Ogre::Vector3::ZERO;
+        float range = 0.0f;
+        Ogre::ColourValue colour = Ogre::ColourValue::Black;  // At full intensity
+        float duration = 0.0f;
+        float age = 0.0f;
+        float intensity = 0.0f;    // Current fade factor
+        uint64_t spawnSerial = 0;  // Lower is older
+        LightFade fade = LightFade::Linear;
+        bool active = false;
+    };
+
+    TemporaryLight* resolve(const LightHandle& handle);
+    const TemporaryLight* resolve(const LightHandle& handle) const;
+    void release(TemporaryLight& tempLight);
     void updateTemporaryLights(float dt);
+    void updateClusters();
 
-    Ogre::SceneManager* sceneManager;
+    static float evaluateFade(LightFade fade, float t);
 
-    struct TemporaryLight {
-        Ogre::Light* light;
-        Ogre::SceneNode* node;
-        float timeRemaining;
-    };
+    Ogre::SceneManager* sceneManager;
+    Ogre::Camera* camera;
+    std::unique_ptr<LightClusterGrid> clusters;
+    std::unique_ptr<ShadowCascades> shadows;
+    std::vector<ClusterLight> clusterLights;
 
     std::vector<TemporaryLight> temporaryLights;
     std::vector<Ogre::Light*> persistentLights;
+    std::vector<Ogre::SceneNode*> persistentNodes;
 
+    uint64_t spawnCounter = 0;
+    size_t activeTemporaryLights = 0;
     int lightCounter = 0;
+
+    static constexpr size_t TEMPORARY_LIGHT_POOL_SIZE = 64;
+    static constexpr float TEMPORARY_LIGHT_LINEAR = 0.09f;
+    static constexpr float TEMPORARY_LIGHT_QUADRATIC = 0.032f;
 };
 
 } // namespace BVA
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BVA {
+
+// Sin/cos of `steps + 1` evenly spaced angles over [0, range], so loops can
+// look up both i and i + 1 without calling the trig functions per vertex
+class TrigTable {
+public:
+    TrigTable(int steps, float range);
+
+    float sin(int i) const { return sines[i]; }
+    float cos(int i) const { return cosines[i]; }
+    int getSteps() const { return static_cast<int>(sines.size()) - 1; }
+
+private:
+    std::vector<float> sines;
+    std::vector<float> cosines;
+};
+
+// CPU-side indexed mesh. Vertices with the same (quantized) position, normal,
+// colour and UV are welded into one, so shared ring/grid corners are stored
+// once and triangles reference them with 16-bit indices. The result is
+// written into a ManualObject with commit().
+class MeshBuilder {
+public:
+    using Index = std::uint16_t;
+
+    struct Vertex {
+        Ogre::Vector3 position;
+        Ogre::Vector3 normal;
+        Ogre::ColourValue colour;
+        Ogre::Vector2 uv;
+    };
+
+    static constexpr size_t MAX_VERTICES = 65536;
+    static constexpr size_t MAX_LOD_LEVELS = 4;
+
+    explicit MeshBuilder(size_t expectedVertices = 0, size_t expectedIndices = 0);
+
+    // Returns the index of an existing identical vertex when there is one
+    Index addVertex(const Ogre::Vector3& position, const Ogre::Vector3& normal,
+                    const Ogre::ColourValue& colour, const Ogre::Vector2& uv);
+    // Planar UV from the XZ position, as the old generators used, or the
+    // current bone index while one is set
+    Index addVertex(const Ogre::Vector3& position, const Ogre::Vector3& normal,
+                    const Ogre::ColourValue& colour);
+
+    // Rigidly skinned meshes: vertices added without an explicit UV carry
+    // (bone, 0) in their UV instead. -1 goes back to planar UVs.
+    void setBoneIndex(int bone) { boneIndex = bone; }
+
+    // Degenerate triangles (welded poles, collapsed edges) are dropped
+    void addTriangle(Index a, Index b, Index c);
+    // Triangles (a, b, c) and (c, d, a), same winding as ManualObject::quad
+    void addQuad(Index a, Index b, Index c, Index d);
+    // Flat-shaded quad with the face normal of (v1, v2, v3)
+    void addFlatQuad(const Ogre::Vector3& v1, const Ogre::Vector3& v2, const Ogre::Vector3& v3,
+                     const Ogre::Vector3& v4, const Ogre::ColourValue& colour);
+
+    // Starts the next, coarser level of detail: triangles added from here on
+    // belong to it and may reuse any vertex added so far. False once
+    // MAX_LOD_LEVELS are in use.
+    bool beginLodLevel();
+    size_t getLodLevelCount() const { return lodCount; }
+    size_t getLodIndexCount(size_t level) const;
+
+    void clear();
+
+    // Writes level 0 as one indexed triangle-list section (with every
+    // vertex, so coarser levels can index the same buffer)
+    void commit(Ogre::ManualObject* obj, const std::string& material) const;
+
+    // Registers levels 1.. as Ogre LOD levels of the mesh converted from the
+    // committed object, switching at the given screen area ratios (one per
+    // level, decreasing). Only the first submesh is given levels.
+    void addLodLevels(const Ogre::MeshPtr& mesh, const std::vector<float>& screenRatios) const;
+
+    // Flat copy of the vertex and index arrays for the asset cache, and the
+    // matching commit/addLodLevels straight from such a blob (e.g. a mapped
+    // cache file)
+    std::vector<uint8_t> serialize() const;
+    static bool commitSerialized(Ogre::ManualObject* obj, const std::string& material,
+                                 const uint8_t* data, size_t size);
+    static bool addSerializedLodLevels(const Ogre::MeshPtr& mesh, const std::vector<float>& screenRatios,
+                                       const uint8_t* data, size_t size);
+
+    const std::vector<Vertex>& getVertices() const { return vertices; }
+    const std::vector<Index>& getIndices() const { return indices; }
+    size_t getVertexCount() const { return vertices.size(); }
+    size_t getIndexCount() const { return indices.size(); }
+    // Vertices requested before welding (what an unindexed mesh would store)
+    size_t getSubmittedVertexCount() const { return submittedVertices; }
+    bool hasOverflowed() const { return overflowed; }
+
+private:
+    using WeldKey = std::array<std::int32_t, 12>;
+
+    struct WeldKeyHash {
+        size_t operator()(const WeldKey& key) const;
+    };
+
+    static WeldKey makeKey(const Vertex& vertex);
+    static void commitArrays(Ogre::ManualObject* obj, const std::string& material,
+                             const Vertex* vertices, size_t vertexCount,
+                             const Index* indices, size_t indexCount);
+    static void addLodArrays(const Ogre::MeshPtr& mesh, const std::vector<float>& screenRatios,
+                             const Index* indices, size_t indexCount,
+                             const std::uint32_t* lodStarts, size_t lodCount);
+
+    std::vector<Vertex> vertices;
+    std::vector<Index> indices;
+    std::unordered_map<WeldKey, Index, WeldKeyHash> weldMap;
+    std::array<std::uint32_t, MAX_LOD_LEVELS> lodStarts{};  // First index of each level
+    size_t lodCount = 1;
+    size_t submittedVertices = 0;
+    int boneIndex = -1;
+    bool overflowed = false;
+};
+
+} // namespace BVA
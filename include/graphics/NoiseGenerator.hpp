@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+// Kept free of Ogre so the kernels can be timed (and reused) without a
+// render system.
+
+namespace BVA {
+
+struct NoiseParams {
+    float frequency = 4.0f;    // Noise cells across the texture at the first octave
+    int octaves = 5;
+    float lacunarity = 2.0f;   // Frequency multiplier per octave
+    float gain = 0.5f;         // Amplitude multiplier per octave
+    uint32_t seed = 1337;
+};
+
+// Tileable 2D gradient noise and fBm. Each octave's lattice wraps at a
+// whole number of cells, so generated textures repeat seamlessly. Rows are
+// evaluated 8 pixels at a time with AVX2 (scalar fallback otherwise) and
+// split into bands across threads.
+class NoiseGenerator {
+public:
+    // Single gradient-noise sample in roughly [-1, 1]; the lattice wraps
+    // every `period` cells
+    static float gradientNoise(float x, float y, int period, uint32_t seed);
+
+    // fBm over the unit square, remapped to [0, 1]
+    static float fbm(float u, float v, const NoiseParams& params);
+
+    // Fills width * height values in [0, 1], row-major. threadCount 0 = one
+    // per core.
+    static void fill(float* out, int width, int height, const NoiseParams& params, unsigned threadCount = 0);
+
+    // Reference path: one thread, no SIMD
+    static void fillScalar(float* out, int width, int height, const NoiseParams& params);
+
+    // Times fill() for 256^2 to 4096^2 against the scalar path and prints
+    // the results
+    static void runBenchmark();
+
+private:
+    static void fillRows(float* out, int width, int height, int firstRow, int lastRow,
+                         const NoiseParams& params);
+};
+
+} // namespace BVA
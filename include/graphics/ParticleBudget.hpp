@@ -0,0 +1,59 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include "graphics/PostProcessManager.hpp"
+
+namespace BVA {
+
+// Limits per quality preset
+struct ParticleBudgetSettings {
+    size_t maxPooledParticles;     // Ogre particle systems (ParticleManager pools)
+    size_t maxSimulatedParticles;  // SIMD simulator
+    float cullDistance;            // Effects further away are stopped
+    float fullDetailScreenSize;    // Fraction of screen height at which emission is full
+    float minEmissionScale;        // Floor for small/distant on-screen effects
+};
+
+// Global particle budget and effect LOD. Once per frame it is told how many
+// particles are alive; effects then ask it how much they may emit based on
+// their screen-space size, visibility and the overall budget pressure.
+class ParticleBudget {
+public:
+    struct EffectLOD {
+        bool cull;            // Too far away, stop the effect
+        bool visible;         // Inside the camera frustum
+        float emissionScale;  // Multiplier for the effect's emission rate
+    };
+
+    ParticleBudget();
+
+    void setQuality(GraphicsQuality quality);
+    const ParticleBudgetSettings& getSettings() const { return settings; }
+
+    void beginFrame(const Ogre::Camera* camera, size_t pooledParticles, size_t simulatedParticles);
+    EffectLOD evaluate(const Ogre::Vector3& position, float radius) const;
+
+    // How many of the requested simulator particles fit in the budget,
+    // given the simulator's current live count
+    size_t clampBurst(size_t requested, const Ogre::Vector3& position, size_t liveSimulated) const;
+
+    // 1 = plenty of room, 0 = at the ceiling (no new particles)
+    float getPressure() const { return pressure; }
+    size_t getPooledParticles() const { return pooledParticles; }
+    size_t getSimulatedParticles() const { return simulatedParticles; }
+
+private:
+    ParticleBudgetSettings settings;
+    const Ogre::Camera* camera = nullptr;
+    Ogre::Vector3 cameraPosition = Ogre::Vector3::ZERO;
+    float projectionScale = 1.0f;  // 1 / tan(fovY / 2)
+
+    size_t pooledParticles = 0;
+    size_t simulatedParticles = 0;
+    float pressure = 1.0f;
+
+    // Emission starts dropping once this fraction of the budget is used
+    static constexpr float SOFT_LIMIT = 0.75f;
+};
+
+} // namespace BVA
@@ -4,6 +4,9 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <cstdint>
+#include "graphics/ParticleSimulator.hpp"
+#include "graphics/ParticleBudget.hpp"
 
 namespace BVA {
 
@@ -19,21 +22,56 @@ enum class ParticleEffect {
     Dust,
     Blood,
     Sparkles,
-    AbilityActivation
+    AbilityActivation,
+    Count
 };
 
+// Per-spawn parameters. Defaults come from the effect's compiled description.
+struct EffectParams {
+    float duration = -1.0f;               // Seconds; < 0 uses the effect's default
+    float scale = 1.0f;                   // Particle size and spread
+    float emissionScale = 1.0f;           // Multiplies the emission rate
+    Ogre::ColourValue tint = Ogre::ColourValue::White;
+    Ogre::SceneNode* attachTo = nullptr;  // Follow this node; position is then a local offset
+};
+
+// Refers to one spawned effect. Stays safe to use after its pool slot has
+// been reused (it then simply no longer matches).
+struct EffectHandle {
+    uint32_t pool = UINT32_MAX;
+    uint32_t slot = 0;
+    uint64_t serial = 0;
+
+    bool isValid() const { return pool != UINT32_MAX; }
+};
+
+// Particle effects are pooled per template: every system and scene node is
+// created (and warmed up) once, then reset and reused. When a pool is
+// exhausted the oldest live effect of that type is recycled.
 class ParticleManager {
 public:
-    ParticleManager(Ogre::SceneManager* sceneManager);
+    ParticleManager(Ogre::SceneManager* sceneManager, Ogre::Camera* camera);
     ~ParticleManager();
 
     bool initialize();
     void shutdown();
     void update(float dt);
 
-    // Particle effect creation
+    // Parameterized effect instances
+    EffectHandle playEffect(ParticleEffect effect, const Ogre::Vector3& position,
+                            const EffectParams& params = {});
+    // Any registered particle template; its pool is created on first use
+    EffectHandle playCustomEffect(const std::string& templateName, const Ogre::Vector3& position,
+                                  const EffectParams& params = {});
+    bool isEffectActive(const EffectHandle& handle) const;
+    void stopEffect(const EffectHandle& handle);
+
+    // Stops effects following a node; call before destroying the node
+    void detachEffectsFrom(Ogre::SceneNode* node);
+
+    // Particle effect creation; a negative duration uses the effect's own
     Ogre::ParticleSystem* createEffect(ParticleEffect effect, const Ogre::Vector3& position,
-                                        float duration = 2.0f);
+                                        float duration = -1.0f);
     Ogre::ParticleSystem* createCustomEffect(const std::string& templateName,
                                               const Ogre::Vector3& position);
 
@@ -45,24 +83,87 @@ public:
     void playExplosionEffect(const Ogre::Vector3& position, float radius = 5.0f);
     void playHealEffect(const Ogre::Vector3& position);
 
+    // High-volume effects through the SIMD particle simulator
+    void playShockwave(const Ogre::Vector3& position, float radius);
+    size_t emitBurst(const ParticleBurst& burst);
+    ParticleSimulator* getSimulator() { return simulator.get(); }
+
     // Cleanup
     void stopEffect(Ogre::ParticleSystem* effect);
     void stopAllEffects();
 
+    size_t getActiveEffectCount() const { return activeCount; }
+
+    // Particle budget and effect LOD follow the graphics quality preset
+    void setGraphicsQuality(GraphicsQuality quality) { budget.setQuality(quality); }
+    const ParticleBudget& getBudget() const { return budget; }
+
 private:
+    struct PooledEffect {
+        Ogre::ParticleSystem* system = nullptr;
+        Ogre::SceneNode* node = nullptr;
+        float timeRemaining = 0.0f;
+        uint64_t spawnSerial = 0;  // Lower is older, used for eviction
+        bool active = false;
+        Ogre::ColourValue appliedTint = Ogre::ColourValue::White;
+        float scale = 1.0f;
+        float emissionScale = 1.0f;    // Requested by the spawner
+        float appliedEmission = 1.0f;  // After LOD and budget
+    };
+
+    // Base values read once from the template, so spawning applies
+    // parameters with numeric setters instead of parsing strings
+    struct EffectDescription {
+        struct Emitter {
+            float emissionRate;
+            float minVelocity;
+            float maxVelocity;
+        };
+
+        float defaultDuration = 2.0f;
+        float width = 1.0f;
+        float height = 1.0f;
+        std::vector<Emitter> emitters;
+        bool hasColourGradient = false;
+        Ogre::ColourValue startColour = Ogre::ColourValue::White;
+        Ogre::ColourValue endColour = Ogre::ColourValue::White;
+    };
+
+    struct EffectPool {
+        std::string templateName;
+        EffectDescription description;
+        std::vector<PooledEffect> effects;
+    };
+
     void createParticleTemplates();
+    EffectPool* createPool(const std::string& templateName, size_t size, float defaultDuration);
+    EffectHandle spawnFromPool(uint32_t poolIndex, const Ogre::Vector3& position, const EffectParams& params);
+    void applyParams(const EffectDescription& description, PooledEffect& effect, const EffectParams& params);
+    void applyEmission(const EffectDescription& description, PooledEffect& effect, float emission);
+    size_t countPooledParticles() const;
+    PooledEffect* resolve(const EffectHandle& handle) const;
+    void release(PooledEffect& effect);
+    void destroyPools();
     void updateActiveEffects(float dt);
 
     Ogre::SceneManager* sceneManager;
+    Ogre::Camera* camera;
 
-    struct ActiveEffect {
-        Ogre::ParticleSystem* system;
-        Ogre::SceneNode* node;
-        float timeRemaining;
-    };
+    std::unique_ptr<ParticleSimulator> simulator;
+    Ogre::SceneNode* simulatorNode = nullptr;
+
+    ParticleBudget budget;
+
+    // Built-in effects are indexed by ParticleEffect, custom templates follow
+    std::vector<std::unique_ptr<EffectPool>> pools;
+    std::unordered_map<std::string, EffectPool*> poolsByTemplate;
+
+    uint64_t spawnCounter = 0;
+    size_t activeCount = 0;
+    int poolCounter = 0;
 
-    std::vector<ActiveEffect> activeEffects;
-    int effectCounter = 0;
+    static constexpr size_t CUSTOM_POOL_SIZE = 8;
+    static constexpr size_t MAX_SIMULATED_PARTICLES = 131072;
 };
 
 } // namespace BVA
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace BVA {
+
+// One emission of simple billboard particles
+struct ParticleBurst {
+    Ogre::Vector3 position = Ogre::Vector3::ZERO;
+    Ogre::Vector3 direction = Ogre::Vector3::UNIT_Y;
+    float spreadDegrees = 180.0f;   // Cone half-angle around direction
+    float verticalScale = 1.0f;     // < 1 flattens the burst into a ring
+    float speedMin = 5.0f;
+    float speedMax = 10.0f;
+    float lifetimeMin = 0.5f;
+    float lifetimeMax = 1.0f;
+    float sizeStart = 0.3f;
+    float sizeEnd = 0.0f;
+    Ogre::ColourValue colourStart = Ogre::ColourValue::White;
+    Ogre::ColourValue colourEnd = Ogre::ColourValue(1.0f, 1.0f, 1.0f, 0.0f);
+    float gravity = -9.8f;
+    float drag = 0.0f;              // Fraction of velocity lost per second
+    size_t count = 32;
+};
+
+// Custom particle simulator for high-volume combat effects (shockwaves,
+// debris). Particles live in SoA float arrays and are integrated 8 at a
+// time with AVX2 when available, instead of going through Ogre's virtual
+// per-particle affectors. All live particles are drawn as one instanced quad
+// (one 20 byte record per particle) with the Particle.vert/.frag billboard
+// shaders.
+class ParticleSimulator : public Ogre::SimpleRenderable {
+public:
+    ParticleSimulator(const std::string& name, const std::string& materialName, size_t maxParticles);
+    ~ParticleSimulator();
+
+    // Returns the number of particles actually emitted (capped by capacity)
+    size_t emit(const ParticleBurst& burst);
+    void clear();
+
+    // Integrates, drops expired particles and refills the vertex buffer
+    void update(float dt, const Ogre::Camera* camera);
+
+    size_t getParticleCount() const { return count; }
+    size_t getMaxParticles() const { return maxParticles; }
+
+    // Times the CPU side of a frame (simulation, instance data, bounds) for
+    // a steady particle count; needs no render system
+    static void runBenchmark(size_t particleCount = 100000, int frames = 300);
+
+    // SimpleRenderable
+    Ogre::Real getSquaredViewDepth(const Ogre::Camera* cam) const override;
+    Ogre::Real getBoundingRadius() const override { return boundingRadius; }
+
+private:
+    void createBuffers(const std::string& materialName);
+    void integrate(float dt);
+    void removeExpired();
+    void writeVertices();
+    void writeInstances(uint8_t* dst) const;
+    void updateBounds();
+    float random01();
+
+    size_t maxParticles;
+    size_t count = 0;
+
+    // Simulation state
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> age, invLifetime;
+    std::vector<float> gravity, damping;
+    std::vector<float> sizeStart, sizeDelta;
+    std::vector<float> colR, colG, colB, colA;       // Start colour
+    std::vector<float> colDR, colDG, colDB, colDA;   // End - start
+
+    // Per-frame outputs of integrate()
+    std::vector<float> size;
+    std::vector<uint32_t> packedColour;              // RGBA8 for the vertex stream
+
+    Ogre::HardwareVertexBufferSharedPtr instanceBuffer;
+    Ogre::MaterialPtr material;
+    Ogre::Real boundingRadius = 0.0f;
+
+    // Cosmetic only, so it stays separate from the gameplay RNG
+    uint32_t randomState = 0x9E3779B9u;
+};
+
+} // namespace BVA
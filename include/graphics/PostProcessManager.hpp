@@ -12,7 +12,15 @@ enum class GraphicsQuality {
     Ultra
 };
 
-class PostProcessManager {
+// Post-processing as an Ogre compositor built in code. The scene renders to
+// an offscreen target at the current render scale (with MSAA when enabled);
+// bloom is a downsampled mip chain with separable blurs, SSAO runs at half
+// resolution on a linear depth pass and is upsampled bilaterally, and one
+// composite pass resolves everything to the viewport. The chain is
+// reassembled when an effect or the render scale changes, and dynamic
+// resolution steps the scale between a few fixed tiers while frames run
+// over (or well under) budget.
+class PostProcessManager : public Ogre::CompositorInstance::Listener {
 public:
     PostProcessManager(Ogre::Viewport* viewport, Ogre::SceneManager* sceneManager);
     ~PostProcessManager();
@@ -39,12 +47,38 @@ public:
     void setSaturation(float saturation);
     void setContrast(float contrast);
 
-    // Screen shake (for combat feedback)
-    void addScreenShake(float intensity, float duration);
+    // Internal resolution as a fraction of the viewport. With dynamic
+    // resolution on, the scale moves one fixed tier at a time between the
+    // quality preset's minimum and 1 to keep frames within the budget.
+    void setRenderScale(float scale);
+    float getRenderScale() const { return renderScale; }
+    void setDynamicResolution(bool enabled, float frameBudgetMs = 16.7f);
+    // Render time of the last frame; call once per frame
+    void reportFrameTime(float milliseconds);
+
+    // Ogre::CompositorInstance::Listener
+    void notifyMaterialRender(Ogre::uint32 passId, Ogre::MaterialPtr& material) override;
 
 private:
+    // Renders the depth scheme with linear view depth materials
+    class DepthSchemeListener : public Ogre::MaterialManager::Listener {
+    public:
+        Ogre::Technique* handleSchemeNotFound(unsigned short schemeIndex, const Ogre::String& schemeName,
+                                              Ogre::Material* originalMaterial, unsigned short lodIndex,
+                                              const Ogre::Renderable* rend) override;
+    };
+
+    enum PassId : Ogre::uint32 {
+        PASS_BLOOM_BRIGHT = 1,
+        PASS_SSAO,
+        PASS_COMPOSITE
+    };
+
     void createCompositors();
-    void updateScreenShake(float dt);
+    void createMaterials();
+    void buildChain();
+    void destroyChain();
+    void updateDynamicResolution(float milliseconds);
 
     Ogre::Viewport* viewport;
     Ogre::SceneManager* sceneManager;
@@ -54,6 +88,7 @@ private:
     bool ssaoEnabled = true;
     bool motionBlurEnabled = false;
     bool aaEnabled = true;
+    int aaSamples = 4;
 
     float bloomIntensity = 1.0f;
     float exposure = 1.0f;
@@ -63,10 +98,25 @@ private:
 
     GraphicsQuality currentQuality = GraphicsQuality::High;
 
-    // Screen shake
-    float shakeIntensity = 0.0f;
-    float shakeDuration = 0.0f;
-    Ogre::Vector3 originalCameraPosition;
+    // Compositor chain
+    Ogre::CompositorPtr compositor;
+    Ogre::CompositorInstance* chain = nullptr;
+    std::unique_ptr<DepthSchemeListener> depthListener;
+    bool chainDirty = false;   // Rebuilt on the next update
+    int bloomLevels = 4;
+    int ssaoSamples = 8;
+    float time = 0.0f;
+    Ogre::Matrix4 previousViewProj = Ogre::Matrix4::IDENTITY;
+
+    // Render scale and dynamic resolution
+    float renderScale = 1.0f;
+    float minRenderScale = 0.7f;
+    bool dynamicResolution = true;
+    float frameBudget = 16.7f;          // Milliseconds
+    float averageFrameTime = 0.0f;
+    float timeSinceScaleChange = 0.0f;  // Seconds
+    float probeInterval = 4.0f;         // Seconds within budget before trying a higher scale
+    bool probing = false;               // Last change was an upward probe
 };
 
 } // namespace BVA
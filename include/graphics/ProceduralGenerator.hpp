@@ -13,17 +13,41 @@
 #pragma once
 
 #include <OGRE/Ogre.h>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 
 namespace BVA {
 
+class MeshBuilder;
+class AssetBaker;
+class AudioEngine;
+
+// Static level props, placed by LevelGeometry
+enum class PropKind : uint32_t {
+    Desk,
+    Table,
+    Shelf,
+    Crate,
+    Pillar,
+    Bench,
+    Count
+};
+
+const char* getPropName(PropKind kind);
+
 // Procedural mesh generation - creates all game geometry in code
 class ProceduralMeshGenerator {
 public:
     static void initialize(Ogre::SceneManager* sceneManager);
 
+    // Queues the startup meshes (character, projectile, arena, sky) for
+    // baking; the shared/arena/sky meshes are then taken from `assets`
+    static void registerBakeJobs(AssetBaker& assets);
+
     // Character mesh generation
     static Ogre::ManualObject* createCharacterMesh(const std::string& name, const Ogre::ColourValue& color);
     static Ogre::ManualObject* createBossMesh(const std::string& name, float scale, const Ogre::ColourValue& color);
@@ -33,14 +57,57 @@ public:
     static Ogre::ManualObject* createWeaponEffect(const std::string& name, const Ogre::ColourValue& color);
     static Ogre::ManualObject* createProjectile(const std::string& name, const Ogre::ColourValue& color);
 
+    // Shared meshes (built once, reused by instanced renderers)
+    static Ogre::MeshPtr getProjectileMesh();
+    static Ogre::MeshPtr getCharacterMesh();
+    // Level meshes, batched by LevelGeometry: the arena floor and walls use
+    // separate materials, props share PropMaterial
+    static Ogre::MeshPtr getArenaFloorMesh(float size = 50.0f);
+    static Ogre::MeshPtr getArenaWallMesh(float size = 50.0f);
+    static Ogre::MeshPtr getPropMesh(PropKind kind);
+    // Blocks until those meshes are baked (no Ogre calls, any thread)
+    static void waitForLevelMeshes(float arenaSize, const std::vector<PropKind>& props);
+
     // Environment
-    static Ogre::ManualObject* createArena(const std::string& name, float size = 50.0f);
     static Ogre::ManualObject* createSkyDome(const std::string& name);
+    // The arena's opaque surfaces (the floor; the glowing wall is
+    // see-through) as world-space quads, for CPU occlusion culling
+    static std::vector<std::array<Ogre::Vector3, 4>> getArenaOccluders(float size = 50.0f);
+
+    // Times the CPU side of every generator and prints vertex counts (before
+    // and after welding) and build time; needs no scene manager
+    static void runBenchmark(int iterations = 200);
 
 private:
     static Ogre::SceneManager* sm;
-    static void addVertex(Ogre::ManualObject* obj, const Ogre::Vector3& pos, const Ogre::Vector3& normal, const Ogre::ColourValue& color);
-    static void addQuad(Ogre::ManualObject* obj, const Ogre::Vector3& v1, const Ogre::Vector3& v2, const Ogre::Vector3& v3, const Ogre::Vector3& v4, const Ogre::ColourValue& color);
+    static const AssetBaker* baked;
+
+    // Commits the baked mesh under `key`, or builds it now if there is none
+    static Ogre::ManualObject* createBakedObject(const std::string& name, const std::string& material,
+                                                 const std::string& key,
+                                                 const std::function<void(MeshBuilder&)>& build);
+    // Same, converted to a mesh whose coarser builder levels (if any) are
+    // registered as LOD levels switching at `lodRatios`
+    static Ogre::MeshPtr createBakedMesh(const std::string& meshName, const std::string& material,
+                                         const std::string& key,
+                                         const std::function<void(MeshBuilder&)>& build,
+                                         const std::vector<float>& lodRatios = {});
+
+    // Geometry only, shared by the create* functions and the benchmark.
+    // A skinned humanoid tags each part with its HumanoidBone in uv0; higher
+    // lod values build the limbs and head with fewer prism sides.
+    static void buildStylizedHumanoid(MeshBuilder& builder, const Ogre::ColourValue& color, float height,
+                                      bool skinned = false, int lod = 0);
+    // Every humanoid LOD in one builder, one builder level each
+    static void buildHumanoidLods(MeshBuilder& builder, const Ogre::ColourValue& color, float height,
+                                  bool skinned);
+    static void buildWeaponEffect(MeshBuilder& builder, const Ogre::ColourValue& color);
+    static void buildProjectile(MeshBuilder& builder, const Ogre::ColourValue& color);
+    static void buildArena(MeshBuilder& builder, float size);
+    static void buildArenaFloor(MeshBuilder& builder, float size);
+    static void buildArenaWalls(MeshBuilder& builder, float size);
+    static void buildProp(MeshBuilder& builder, PropKind kind);
+    static void buildSkyDome(MeshBuilder& builder);
 };
 
 // Procedural texture generation - creates all textures in code
@@ -48,20 +115,39 @@ class ProceduralTextureGenerator {
 public:
     static void initialize();
 
+    // Queues the standard texture set for baking; the generators below read
+    // the baked pixels when asked for the same name, size and colours
+    static void registerBakeJobs(AssetBaker& assets);
+
     // Material creation
     static Ogre::MaterialPtr createCharacterMaterial(const std::string& name, const Ogre::ColourValue& baseColor);
     static Ogre::MaterialPtr createGlowingMaterial(const std::string& name, const Ogre::ColourValue& glowColor);
-    static Ogre::MaterialPtr createMetallicMaterial(const std::string& name, const Ogre::ColourValue& color);
     static Ogre::MaterialPtr createEnergyMaterial(const std::string& name, const Ogre::ColourValue& color);
-
-    // Texture generation
+    // Skinned materials read the bone palette (AnimationSystem) per instance
+    static Ogre::MaterialPtr createInstancedMaterial(const std::string& name, bool glowing, bool skinned = false);
+    static Ogre::MaterialPtr createParticleMaterial(const std::string& name);
+    // Depth-only material for the shadow cascades
+    static Ogre::MaterialPtr createShadowCasterMaterial(const std::string& name, bool instanced,
+                                                        bool skinned = false);
+
+    // Texture generation (tileable, noise from NoiseGenerator)
     static Ogre::TexturePtr generateNoiseTexture(const std::string& name, int width = 256, int height = 256);
     static Ogre::TexturePtr generateGradientTexture(const std::string& name, const Ogre::ColourValue& color1, const Ogre::ColourValue& color2);
     static Ogre::TexturePtr generatePatternTexture(const std::string& name, const Ogre::ColourValue& color);
 
 private:
-    static float perlinNoise(float x, float y);
-    static float smoothNoise(int x, int y);
+    static const AssetBaker* baked;
+
+    static Ogre::TexturePtr createTexture(const std::string& name, int width, int height, const uint8_t* rgba);
+    // Uploads the baked pixels under `key`, or generates them now if there are none
+    static Ogre::TexturePtr createBakedTexture(const std::string& name, const std::string& key, int width,
+                                               int height, const std::function<std::vector<uint8_t>()>& build);
+
+    // RGBA8 pixels only (no Ogre calls), shared by the generators and the bake jobs
+    static std::vector<uint8_t> buildNoiseTexture(const std::string& name, int width, int height);
+    static std::vector<uint8_t> buildGradientTexture(const std::string& name, const Ogre::ColourValue& color1,
+                                                     const Ogre::ColourValue& color2);
+    static std::vector<uint8_t> buildPatternTexture(const std::string& name, const Ogre::ColourValue& color);
 };
 
 // Procedural audio generation - creates all sounds in code
@@ -70,6 +156,14 @@ public:
     static void initialize();
     static void shutdown();
 
+    // Queues the game's sound set for baking, and later hands the baked
+    // samples to the audio engine as named sounds ("proc/hit", ...)
+    static void registerBakeJobs(AssetBaker& assets);
+    static void loadBakedSounds(const AssetBaker& assets, AudioEngine& audio);
+    // One sound at a time, for loading them as they are needed
+    static std::vector<std::string> getBakedSoundNames();
+    static bool loadBakedSound(const AssetBaker& assets, AudioEngine& audio, const std::string& name);
+
     // Sound effect generation
     static std::vector<short> generateHitSound(float pitch = 1.0f);
     static std::vector<short> generateExplosionSound();
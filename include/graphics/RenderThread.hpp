@@ -0,0 +1,130 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BVA {
+
+class InstanceBatch;
+
+// Everything the simulation wants the renderer to do for one frame. The
+// simulation only appends to it; the render thread applies it before
+// drawing, one kind at a time rather than interleaved as recorded:
+//  1. node positions (the last one set for a node wins)
+//  2. instance uploads (the last one per batch wins)
+//  3. commands, in the order they were enqueued
+//  4. camera targets and shakes
+// So a command always sees this frame's positions and instances, and a
+// position can never refer to a node a command creates later in the same
+// packet. Create nodes through GraphicsEngine::runOnRenderThread instead;
+// it flushes the packet first, so order relative to it is kept.
+struct FramePacket {
+    struct NodePosition {
+        Ogre::SceneNode* node;
+        Ogre::Vector3 position;
+    };
+
+    struct InstanceUpload {
+        InstanceBatch* batch;
+        size_t count;
+        std::vector<float> data;  // count * InstanceBatch::FLOATS_PER_INSTANCE
+    };
+
+    struct CameraShake {
+        float trauma;    // 0..1
+        float duration;  // Seconds to fade out
+    };
+
+    float dt = 0.0f;
+    bool render = false;  // False for packets flushed only to run commands
+
+    std::vector<NodePosition> positions;
+    std::vector<InstanceUpload> uploads;
+    std::vector<std::function<void()>> commands;
+
+    // Players the camera frames; only applied when set this frame
+    std::vector<Ogre::Vector3> cameraTargets;
+    bool cameraTargetsSet = false;
+    std::vector<CameraShake> cameraShakes;
+
+    void setPosition(Ogre::SceneNode* node, const Ogre::Vector3& position) {
+        positions.push_back({node, position});
+    }
+
+    // Replaces the batch's instances for this frame; returns the buffer to
+    // pack them into
+    std::vector<float>& uploadInstances(InstanceBatch* batch, size_t count);
+
+    // Replaces the camera's targets; an empty set frames the arena centre
+    void setCameraTargets(const std::vector<Ogre::Vector3>& positions) {
+        cameraTargets.assign(positions.begin(), positions.end());
+        cameraTargetsSet = true;
+    }
+    void addCameraShake(float trauma, float duration) { cameraShakes.push_back({trauma, duration}); }
+
+    // Effect spawns, light changes and anything else touching Ogre objects
+    void enqueue(std::function<void()> command) { commands.push_back(std::move(command)); }
+
+    // Keeps the allocations so steady-state frames do not allocate
+    void clear();
+};
+
+// Owns the thread all Ogre work happens on. The simulation fills the write
+// packet and submits it; the render thread applies and draws it while the
+// simulation fills the other packet, so simulating frame N+1 overlaps
+// rendering frame N. At most one frame is in flight: submitting blocks until
+// the render thread has finished with the previous packet.
+class RenderThread {
+public:
+    using FrameFunction = std::function<void(FramePacket&)>;
+
+    RenderThread();
+    ~RenderThread();
+
+    // applyFrame runs on the render thread for every submitted packet
+    void start(FrameFunction applyFrame);
+    void stop();
+
+    bool isRunning() const { return thread.joinable(); }
+    bool isRenderThread() const { return std::this_thread::get_id() == renderThreadId; }
+
+    // Simulation side; only valid on the thread that submits
+    FramePacket& getPacket() { return packets[writeIndex]; }
+
+    // Hands the write packet over to be drawn
+    void submit(float dt);
+
+    // Runs task on the render thread after everything written to the packet
+    // so far and waits for it. Runs inline on the render thread itself, or
+    // when the thread is not running.
+    void runAndWait(std::function<void()> task);
+
+    // Time the simulation spent blocked on the render thread, last submit
+    float getLastWaitMs() const { return lastWaitMs; }
+
+private:
+    void threadMain();
+    void handOver(float dt, bool render);
+
+    std::array<FramePacket, 2> packets;
+    int writeIndex = 0;
+    bool pending = false;   // packets[writeIndex ^ 1] is waiting or being drawn
+    bool stopping = false;
+
+    std::mutex mutex;
+    std::condition_variable packetReady;
+    std::condition_variable packetDone;
+
+    std::thread thread;
+    std::thread::id renderThreadId;
+    FrameFunction applyFrame;
+
+    float lastWaitMs = 0.0f;
+};
+
+} // namespace BVA
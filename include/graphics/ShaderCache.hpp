@@ -0,0 +1,75 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <OGRE/RTShaderSystem/OgreRTShaderSystem.h>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace BVA {
+
+// Compiles shader permutations ahead of use and keeps them across runs.
+// Ogre compiles a GLSL program when a material using it first loads and
+// links each vertex/fragment pair the first time a pass with that pair is
+// drawn, so without a warmup the first ability effect of a match stalls the
+// frame. A permutation is one (scheme, vertex program, fragment program)
+// combination; warmup() draws one pass per permutation not warmed yet into
+// a tiny offscreen target, during loading. beginWarmup/continueWarmup do the
+// same a few materials per call, so streaming can spread it over frames. Linked program binaries go into
+// Ogre's microcode cache, which is saved to the cache directory and loaded
+// on the next run; RTSS-generated shaders are written there as well.
+// Render thread only.
+class ShaderCache {
+public:
+    explicit ShaderCache(Ogre::RTShader::ShaderGenerator* shaderGenerator = nullptr);
+    ~ShaderCache();
+
+    bool initialize(const std::string& cacheDirectory);
+    // Saves the microcode cache if anything was added to it
+    void shutdown();
+
+    // Every material that exists now; returns the permutations compiled
+    size_t warmup();
+    size_t warmup(const std::vector<std::string>& materialNames);
+    // warmup() in slices: each continueWarmup() warms up to maxMaterials and
+    // returns true once every material queued by beginWarmup() is done
+    void beginWarmup();
+    void beginWarmup(const std::vector<std::string>& materialNames);
+    bool continueWarmup(size_t maxMaterials);
+
+    size_t getPermutationCount() const { return warmed.size(); }
+    float getLastWarmupMs() const { return lastWarmupMs; }
+
+private:
+    bool createTarget();
+    void destroyTarget();
+    // Passes without programs get RTSS shaders generated
+    void generateShaders(Ogre::Material* material);
+    bool warmMaterial(const Ogre::MaterialPtr& material);
+    static std::vector<std::string> allMaterialNames();
+    static std::string permutationKey(const Ogre::Technique* technique, const Ogre::Pass* pass);
+
+    Ogre::RTShader::ShaderGenerator* shaderGenerator;
+    std::string microcodePath;
+
+    std::unordered_set<std::string> warmed;
+    float lastWarmupMs = 0.0f;
+
+    // The warmup in progress
+    std::vector<std::string> queued;
+    size_t nextQueued = 0;
+    size_t warmedBefore = 0;
+    float queuedMs = 0.0f;
+    bool warming = false;
+
+    // Offscreen warmup scene: a fullscreen quad drawn with each material
+    Ogre::SceneManager* warmupScene = nullptr;
+    Ogre::Camera* warmupCamera = nullptr;
+    Ogre::Rectangle2D* quad = nullptr;
+    Ogre::TexturePtr target;
+    Ogre::Viewport* viewport = nullptr;
+
+    static constexpr unsigned TARGET_SIZE = 4;
+};
+
+} // namespace BVA
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <array>
+#include <vector>
+
+namespace BVA {
+
+// Cascaded shadow maps for the sun. The camera range that overlaps the
+// shadow bounds (the arena) is split with the practical split scheme and each
+// cascade gets an orthographic shadow camera of constant size, snapped to
+// whole texels so shadows do not shimmer as the view moves. Cascades that
+// outgrow the bounds are clamped to them, which makes the far cascades
+// static. Registered casters are culled per cascade on the CPU, and a
+// cascade whose camera did not change is only re-rendered when a caster
+// inside it moved.
+class ShadowCascades : public Ogre::SceneManager::Listener {
+public:
+    static constexpr int MAX_CASCADES = 4;
+
+    ShadowCascades(Ogre::SceneManager* sceneManager, Ogre::Camera* camera);
+    ~ShadowCascades();
+
+    // Safe to call again to change the cascade count or resolution
+    bool initialize(int cascadeCount, int textureSize);
+    void shutdown();
+
+    // World-space region that casts and receives shadows
+    void setBounds(const Ogre::AxisAlignedBox& bounds);
+    // 0 = uniform splits, 1 = logarithmic
+    void setSplitLambda(float lambda) { splitLambda = lambda; }
+
+    // Objects tracked for per-cascade culling and movement. Anything else
+    // that casts shadows is drawn into every cascade it touches but treated
+    // as static, so it must not move. Dynamic
+    // casters (instance batches whose contents move without their bounds
+    // necessarily changing) count as moved every frame they are visible;
+    // static ones only when their world bounds change.
+    void addCaster(Ogre::MovableObject* caster, bool dynamic);
+    void removeCaster(Ogre::MovableObject* caster);
+
+    // Splits and caster movement; call once per frame before rendering
+    void update();
+
+    // Adds the cascade shadow textures and parameters to a pass whose
+    // fragment program includes ShadowCascades.glsl
+    void bindToPass(Ogre::Pass* pass) const;
+
+    int getCascadeCount() const { return cascadeCount; }
+    float getSplitDistance(int cascade) const { return cascades[cascade].farSplit; }
+
+    // Stats for the last rendered frame
+    int getCascadesRendered() const { return cascadesRendered; }
+    size_t getCastersCulled() const { return castersCulled; }
+
+    // Ogre::SceneManager::Listener
+    void shadowTextureCasterPreViewProj(Ogre::Light* light, Ogre::Camera* shadowCamera,
+                                        size_t iteration) override;
+    void shadowTexturesUpdated(size_t numberOfShadowTextures) override;
+
+private:
+    class CameraSetup : public Ogre::ShadowCameraSetup {
+    public:
+        explicit CameraSetup(ShadowCascades& owner) : owner(owner) {}
+        void getShadowCamera(const Ogre::SceneManager* sm, const Ogre::Camera* cam,
+                             const Ogre::Viewport* vp, const Ogre::Light* light,
+                             Ogre::Camera* texCam, size_t iteration) const override;
+
+    private:
+        ShadowCascades& owner;
+    };
+
+    struct Cascade {
+        float nearSplit = 0.0f;
+        float farSplit = 0.0f;
+
+        // Light-space window (x, y) and depth range (z, towards the light)
+        Ogre::Vector3 minimum = Ogre::Vector3::ZERO;
+        Ogre::Vector3 maximum = Ogre::Vector3::ZERO;
+        float texelSize = 0.0f;
+
+        Ogre::Matrix4 renderedViewProj = Ogre::Matrix4::ZERO;  // At the last render
+        bool valid = false;    // Texture holds a render for renderedViewProj
+        bool rendered = false; // Re-rendered this frame
+    };
+
+    struct Caster {
+        Ogre::MovableObject* object = nullptr;
+        Ogre::AxisAlignedBox bounds;  // World bounds at the last update
+        bool dynamic = false;
+        bool castShadows = true;      // Owner's setting, restored after culling
+    };
+
+    void fitCascade(Cascade& cascade, const Ogre::Vector3* frustumCorners) const;
+    void setupShadowCamera(const Ogre::Light* light, Ogre::Camera* texCam, size_t iteration);
+    bool overlapsCascade(const Cascade& cascade, const Ogre::AxisAlignedBox& worldBounds) const;
+    Ogre::AxisAlignedBox toLightSpace(const Ogre::AxisAlignedBox& worldBounds) const;
+    Ogre::Viewport* getShadowViewport(size_t iteration) const;
+
+    Ogre::SceneManager* sceneManager;
+    Ogre::Camera* camera;
+    Ogre::ShadowCameraSetupPtr cameraSetup;
+
+    std::array<Cascade, MAX_CASCADES> cascades;
+    int cascadeCount = 0;
+    int textureSize = 0;
+    float splitLambda = 0.8f;
+
+    Ogre::AxisAlignedBox bounds;
+    Ogre::Vector3 lightDirection = Ogre::Vector3::ZERO;
+    Ogre::Matrix3 lightRotation;  // World to light space, rows are the axes
+
+    std::vector<Caster> casters;
+    std::vector<Ogre::AxisAlignedBox> movedBounds;  // Old and new bounds since the last render
+
+    int cascadesRendered = 0;
+    size_t castersCulled = 0;
+    size_t castersCulledThisFrame = 0;
+
+    // Casters covering fewer texels than this are skipped beyond cascade 0
+    static constexpr float MIN_CASTER_TEXELS = 2.0f;
+};
+
+} // namespace BVA
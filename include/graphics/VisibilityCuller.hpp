@@ -0,0 +1,100 @@
+#pragma once
+
+#include <OGRE/Ogre.h>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace BVA {
+
+// Gameplay-side visibility for entities that would otherwise be moved and
+// gathered every frame whether they are seen or not. World bounds live in a
+// flat SoA array and are tested against the camera frustum 8 at a time, then
+// against a coarse CPU depth buffer rasterized from a few large opaque
+// occluders (the arena floor). A tracked node only receives position
+// updates while it is visible; positions reported while it is culled are
+// kept and applied the frame it comes back into view.
+class VisibilityCuller {
+public:
+    static constexpr int INVALID_ENTITY = -1;
+
+    // Coarse occlusion buffer; occluders only cover pixels they fully cover
+    static constexpr int OCCLUSION_WIDTH = 64;
+    static constexpr int OCCLUSION_HEIGHT = 32;
+
+    using OccluderQuad = std::array<Ogre::Vector3, 4>;  // Convex, any winding
+
+    VisibilityCuller();
+    ~VisibilityCuller();
+
+    // localBounds are in the node's space; the node must be a child of the
+    // root so its local transform is its world transform
+    int addEntity(Ogre::SceneNode* node, const Ogre::AxisAlignedBox& localBounds);
+    void removeEntity(int entity);
+
+    // Records where a tracked node should be. Returns false for untracked
+    // nodes, which the caller moves itself.
+    bool moveNode(Ogre::SceneNode* node, const Ogre::Vector3& position);
+
+    bool isVisible(int entity) const;
+
+    void addOccluder(const OccluderQuad& quad);
+    void clearOccluders() { occluders.clear(); }
+    void setOcclusionEnabled(bool enabled) { occlusionEnabled = enabled; }
+
+    // Offscreen shadow casters can still shade what is on screen: bounds are
+    // swept along the sun's direction down to the ground (y = 0) before
+    // they are tested. Zero disables the sweep.
+    void setShadowDirection(const Ogre::Vector3& direction) { shadowDirection = direction.normalisedCopy(); }
+
+    // Culls every entity for this camera, then moves newly visible nodes to
+    // their latest position. Call once per frame before anything reads the
+    // tracked nodes.
+    void cull(const Ogre::Camera* camera);
+
+    // Stats for the last cull
+    size_t getEntityCount() const { return entityCount; }
+    size_t getVisibleCount() const { return visibleCount; }
+    size_t getFrustumCulledCount() const { return frustumCulled; }
+    size_t getOccludedCount() const { return occluded; }
+
+private:
+    struct Entity {
+        Ogre::SceneNode* node = nullptr;
+        Ogre::Vector3 position = Ogre::Vector3::ZERO;  // Latest reported
+        Ogre::Vector3 centre = Ogre::Vector3::ZERO;    // Local bounds
+        Ogre::Vector3 halfSize = Ogre::Vector3::ZERO;
+        bool used = false;
+        bool visible = true;
+        bool positionDirty = false;  // Node not yet moved to position
+    };
+
+    void gatherBounds();
+    void frustumTest(const Ogre::Camera* camera);
+    void rasterizeOccluders(const Ogre::Matrix4& view, const Ogre::Matrix4& projection, float nearDistance);
+    bool isOccluded(size_t slot, const Ogre::Matrix4& view, const Ogre::Matrix4& projection,
+                    float nearDistance) const;
+
+    std::vector<Entity> entities;
+    std::vector<int> freeSlots;
+    std::unordered_map<Ogre::SceneNode*, int> nodeEntities;
+
+    // World bounds per slot, padded to a multiple of 8; unused slots are
+    // never reported visible whatever their bounds
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+    std::vector<uint8_t> inFrustum;
+
+    std::vector<OccluderQuad> occluders;
+    std::vector<float> occlusionDepth;  // View depth, OCCLUSION_WIDTH * OCCLUSION_HEIGHT
+    bool occlusionEnabled = true;
+
+    Ogre::Vector3 shadowDirection = Ogre::Vector3::ZERO;
+
+    size_t entityCount = 0;
+    size_t visibleCount = 0;
+    size_t frustumCulled = 0;
+    size_t occluded = 0;
+};
+
+} // namespace BVA
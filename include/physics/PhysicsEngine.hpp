@@ -76,12 +76,18 @@ public:
     void setVelocity(const btVector3& velocity);
     btVector3 getVelocity() const;
 
+    // Disabled bodies stay in the world (no re-allocation) but neither
+    // simulate nor generate contacts; used by pooled entities
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+
     void setUserData(void* data) { userData = data; }
     void* getUserData() const { return userData; }
 
 private:
     std::unique_ptr<btRigidBody> rigidBody;
     void* userData = nullptr;
+    bool enabled = true;
 };
 
 } // namespace BVA
@@ -0,0 +1,27 @@
+// Licensed under the Apache License, Version 2.0
+// Separable Bloom Blur for Bas Veeg Arc 3D
+// 9-tap Gaussian in 5 bilinear fetches along one axis
+
+#version 330 core
+
+in vec2 TexCoord;
+out vec4 FragColor;
+
+uniform sampler2D sourceTexture;
+uniform vec2 direction;  // (1, 0) or (0, 1)
+
+void main() {
+    vec2 step = direction / textureSize(sourceTexture, 0);
+
+    // Adjacent Gaussian weights merged into linearly interpolated taps
+    const float weights[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+    const float offsets[3] = float[](0.0, 1.3846153846, 3.2307692308);
+
+    vec3 color = texture(sourceTexture, TexCoord).rgb * weights[0];
+    for (int i = 1; i < 3; i++) {
+        color += texture(sourceTexture, TexCoord + step * offsets[i]).rgb * weights[i];
+        color += texture(sourceTexture, TexCoord - step * offsets[i]).rgb * weights[i];
+    }
+
+    FragColor = vec4(color, 1.0);
+}
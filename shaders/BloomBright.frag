@@ -0,0 +1,26 @@
+// Licensed under the Apache License, Version 2.0
+// Bloom Bright Pass for Bas Veeg Arc 3D
+// Extracts the bright part of the scene into the first (half size) bloom level
+
+#version 330 core
+
+in vec2 TexCoord;
+out vec4 FragColor;
+
+uniform sampler2D sceneTexture;
+uniform float threshold;
+
+void main() {
+    // 4 bilinear taps cover the 4x4 source texels behind this half-size texel
+    vec2 texel = 1.0 / textureSize(sceneTexture, 0);
+    vec3 color = texture(sceneTexture, TexCoord + texel * vec2(-1.0, -1.0)).rgb;
+    color += texture(sceneTexture, TexCoord + texel * vec2(1.0, -1.0)).rgb;
+    color += texture(sceneTexture, TexCoord + texel * vec2(-1.0, 1.0)).rgb;
+    color += texture(sceneTexture, TexCoord + texel * vec2(1.0, 1.0)).rgb;
+    color *= 0.25;
+
+    // Soft knee so highlights do not pop in and out
+    float brightness = max(color.r, max(color.g, color.b));
+    float contribution = max(brightness - threshold, 0.0) / max(brightness, 1e-4);
+    FragColor = vec4(color * contribution, 1.0);
+}
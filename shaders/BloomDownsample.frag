@@ -0,0 +1,19 @@
+// Licensed under the Apache License, Version 2.0
+// Bloom Downsample for Bas Veeg Arc 3D
+// Halves the previous bloom level with a 4-tap bilinear box filter
+
+#version 330 core
+
+in vec2 TexCoord;
+out vec4 FragColor;
+
+uniform sampler2D sourceTexture;
+
+void main() {
+    vec2 texel = 1.0 / textureSize(sourceTexture, 0);
+    vec3 color = texture(sourceTexture, TexCoord + texel * vec2(-1.0, -1.0)).rgb;
+    color += texture(sourceTexture, TexCoord + texel * vec2(1.0, -1.0)).rgb;
+    color += texture(sourceTexture, TexCoord + texel * vec2(-1.0, 1.0)).rgb;
+    color += texture(sourceTexture, TexCoord + texel * vec2(1.0, 1.0)).rgb;
+    FragColor = vec4(color * 0.25, 1.0);
+}
@@ -0,0 +1,22 @@
+// Licensed under the Apache License, Version 2.0
+// Bloom Upsample for Bas Veeg Arc 3D
+// Adds the next coarser (already accumulated) level onto this one
+
+#version 330 core
+
+in vec2 TexCoord;
+out vec4 FragColor;
+
+uniform sampler2D levelTexture;
+uniform sampler2D coarserTexture;
+
+void main() {
+    // 4-tap tent over the coarser level hides its blockiness
+    vec2 texel = 0.5 / textureSize(coarserTexture, 0);
+    vec3 coarser = texture(coarserTexture, TexCoord + vec2(-texel.x, -texel.y)).rgb;
+    coarser += texture(coarserTexture, TexCoord + vec2(texel.x, -texel.y)).rgb;
+    coarser += texture(coarserTexture, TexCoord + vec2(-texel.x, texel.y)).rgb;
+    coarser += texture(coarserTexture, TexCoord + vec2(texel.x, texel.y)).rgb;
+
+    FragColor = vec4(texture(levelTexture, TexCoord).rgb + coarser * 0.25, 1.0);
+}
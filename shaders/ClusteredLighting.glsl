@@ -0,0 +1,62 @@
+// Clustered point/spot lights (see LightClusterGrid), shared by the lit
+// fragment programs. The pass must be bound with
+// LightClusterGrid::bindToPass. Walk the lights reaching a fragment with
+//
+//     int first, count;
+//     clusterLightRange(viewDepth, first, count);
+//     for (int i = first; i < first + count; i++) {
+//         vec3 L, radiance;
+//         if (clusterLight(i, worldPos, L, radiance)) ...
+//     }
+
+uniform vec4 clusterParams;           // sliceScale, sliceBias, tilesX, tilesY
+uniform vec2 viewportSize;
+uniform sampler2D clusterGrid;        // (offset, count) per cluster
+uniform sampler2D clusterLightIndices;
+uniform sampler2D clusterLights;      // 4 rows per light
+
+const int CLUSTER_SLICES = 24;
+const int INDEX_TEXTURE_WIDTH = 1024;
+
+// Index list range of the cluster this fragment falls in
+void clusterLightRange(float viewDepth, out int first, out int count) {
+    vec2 tile = floor(gl_FragCoord.xy / viewportSize * clusterParams.zw);
+    int slice = int(log(max(viewDepth, 1e-4)) * clusterParams.x + clusterParams.y);
+    slice = clamp(slice, 0, CLUSTER_SLICES - 1);
+
+    ivec2 clusterCoord = ivec2(clamp(tile, vec2(0.0), clusterParams.zw - 1.0));
+    clusterCoord.x += clusterCoord.y * int(clusterParams.z);
+    vec2 range = texelFetch(clusterGrid, ivec2(clusterCoord.x, slice), 0).rg;
+
+    first = int(range.x);
+    count = int(range.y);
+}
+
+// Direction to the i-th listed light and its attenuated colour; false when
+// the fragment is out of its range
+bool clusterLight(int i, vec3 worldPos, out vec3 L, out vec3 radiance) {
+    int light = int(texelFetch(clusterLightIndices, ivec2(i % INDEX_TEXTURE_WIDTH, i / INDEX_TEXTURE_WIDTH), 0).r);
+    vec4 posRange = texelFetch(clusterLights, ivec2(light, 0), 0);
+    vec4 colourSpot = texelFetch(clusterLights, ivec2(light, 1), 0);
+    vec4 dirOuter = texelFetch(clusterLights, ivec2(light, 2), 0);
+    vec4 attenuation = texelFetch(clusterLights, ivec2(light, 3), 0);
+
+    vec3 toLight = posRange.xyz - worldPos;
+    float dist = length(toLight);
+    L = toLight / max(dist, 1e-4);
+    radiance = vec3(0.0);
+    if (dist >= posRange.w) return false;
+
+    // Ogre's attenuation, windowed to reach zero at the cluster radius
+    float falloff = 1.0 / (1.0 + attenuation.y * dist + attenuation.z * dist * dist);
+    float window = clamp(1.0 - pow(dist / posRange.w, 4.0), 0.0, 1.0);
+    falloff *= window * window;
+
+    if (colourSpot.w > 0.5) {
+        float cosAngle = dot(-L, dirOuter.xyz);
+        falloff *= smoothstep(dirOuter.w, attenuation.x, cosAngle);
+    }
+
+    radiance = colourSpot.rgb * falloff;
+    return true;
+}
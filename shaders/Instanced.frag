@@ -0,0 +1,50 @@
+// Licensed under the Apache License, Version 2.0
+// Hardware Instancing Fragment Shader for Bas Veeg Arc 3D
+
+#version 330 core
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec4 Color;
+in vec3 ViewDir;
+in float ViewDepth;
+
+uniform vec4 lightDir;
+uniform vec4 lightColor;
+uniform vec4 ambientColor;
+uniform float emissive;
+
+#include "ClusteredLighting.glsl"
+#include "ShadowCascades.glsl"
+
+out vec4 FragColor;
+
+void main() {
+    vec3 N = normalize(Normal);
+    vec3 L = normalize(-lightDir.xyz);
+    vec3 V = normalize(ViewDir);
+    vec3 H = normalize(L + V);
+
+    float NdotL = max(dot(N, L), 0.0);
+    float spec = pow(max(dot(N, H), 0.0), 32.0);
+
+    vec3 sun = lightColor.rgb * sunShadow(FragPos, ViewDepth);
+    vec3 lit = Color.rgb * (ambientColor.rgb + sun * NdotL) + sun * spec * 0.25;
+
+    // Point and spot lights (impact flashes) reaching this fragment's cluster
+    int first, count;
+    clusterLightRange(ViewDepth, first, count);
+    for (int i = first; i < first + count; i++) {
+        vec3 pointL, radiance;
+        if (!clusterLight(i, FragPos, pointL, radiance)) continue;
+
+        vec3 pointH = normalize(pointL + V);
+        float pointSpec = pow(max(dot(N, pointH), 0.0), 32.0);
+        lit += radiance * (Color.rgb * max(dot(N, pointL), 0.0) + pointSpec * 0.25);
+    }
+
+    // Glowing instances (projectiles) ignore lighting
+    vec3 finalColor = mix(lit, Color.rgb * 2.0, emissive);
+
+    FragColor = vec4(finalColor, Color.a);
+}
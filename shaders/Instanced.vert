@@ -0,0 +1,63 @@
+// Licensed under the Apache License, Version 2.0
+// Hardware Instancing Vertex Shader for Bas Veeg Arc 3D
+
+#version 330 core
+
+in vec4 vertex;
+in vec3 normal;
+in vec4 colour;
+
+// Per-instance data: rows of the 3x4 world matrix, then instance colour
+in vec4 uv1;
+in vec4 uv2;
+in vec4 uv3;
+in vec4 uv4;
+
+uniform mat4 viewProj;
+uniform mat4 view;
+uniform vec3 cameraPos;
+
+#ifdef SKINNED
+// Rigid skinning: uv0.x is the vertex's bone; each instance reads its bone
+// matrices (3 texels per bone) from its own palette row
+in vec2 uv0;
+
+uniform sampler2D bonePalette;
+uniform vec4 boneRowBase;
+
+mat4 boneMatrix() {
+    ivec2 texel = ivec2(int(uv0.x + 0.5) * 3, int(boneRowBase.x) + gl_InstanceID);
+    vec4 row0 = texelFetch(bonePalette, texel, 0);
+    vec4 row1 = texelFetch(bonePalette, texel + ivec2(1, 0), 0);
+    vec4 row2 = texelFetch(bonePalette, texel + ivec2(2, 0), 0);
+    return transpose(mat4(row0, row1, row2, vec4(0.0, 0.0, 0.0, 1.0)));
+}
+#endif
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec4 Color;
+out vec3 ViewDir;
+out float ViewDepth;
+
+void main() {
+    mat4 world = transpose(mat4(uv1, uv2, uv3, vec4(0.0, 0.0, 0.0, 1.0)));
+
+#ifdef SKINNED
+    mat4 skin = boneMatrix();
+    vec4 localPos = skin * vertex;
+    vec3 localNormal = mat3(skin) * normal;
+#else
+    vec4 localPos = vertex;
+    vec3 localNormal = normal;
+#endif
+
+    vec4 worldPos = world * localPos;
+    FragPos = worldPos.xyz;
+    Normal = normalize(mat3(world) * localNormal);
+    Color = colour * uv4;
+    ViewDir = normalize(cameraPos - FragPos);
+    ViewDepth = -(view * worldPos).z;
+
+    gl_Position = viewProj * worldPos;
+}
@@ -0,0 +1,44 @@
+// Licensed under the Apache License, Version 2.0
+// Instanced Linear View Depth Vertex Shader for Bas Veeg Arc 3D
+
+#version 330 core
+
+in vec4 vertex;
+
+// Per-instance data, laid out as in Instanced.vert
+in vec4 uv1;
+in vec4 uv2;
+in vec4 uv3;
+
+uniform mat4 viewProj;
+uniform mat4 view;
+
+#ifdef SKINNED
+// Rigid skinning, as in Instanced.vert
+in vec2 uv0;
+
+uniform sampler2D bonePalette;
+uniform vec4 boneRowBase;
+
+mat4 boneMatrix() {
+    ivec2 texel = ivec2(int(uv0.x + 0.5) * 3, int(boneRowBase.x) + gl_InstanceID);
+    vec4 row0 = texelFetch(bonePalette, texel, 0);
+    vec4 row1 = texelFetch(bonePalette, texel + ivec2(1, 0), 0);
+    vec4 row2 = texelFetch(bonePalette, texel + ivec2(2, 0), 0);
+    return transpose(mat4(row0, row1, row2, vec4(0.0, 0.0, 0.0, 1.0)));
+}
+#endif
+
+out float ViewDepth;
+
+void main() {
+    mat4 world = transpose(mat4(uv1, uv2, uv3, vec4(0.0, 0.0, 0.0, 1.0)));
+#ifdef SKINNED
+    vec4 worldPos = world * (boneMatrix() * vertex);
+#else
+    vec4 worldPos = world * vertex;
+#endif
+
+    gl_Position = viewProj * worldPos;
+    ViewDepth = -(view * worldPos).z;
+}
@@ -9,12 +9,17 @@ in vec4 Color;
 in vec2 TexCoord;
 in vec3 LightDir;
 in vec3 ViewDir;
+in float ViewDepth;
 
 uniform vec3 lightColor;
 uniform float metallic;
 uniform float roughness;
+uniform float emissive;               // Self-lit share of the vertex colour
 uniform float time;
 
+#include "ClusteredLighting.glsl"
+#include "ShadowCascades.glsl"
+
 out vec4 FragColor;
 
 const float PI = 3.14159265359;
@@ -54,17 +59,10 @@ float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
     return ggx1 * ggx2;
 }
 
-void main() {
-    vec3 N = normalize(Normal);
-    vec3 V = normalize(ViewDir);
-    vec3 L = normalize(LightDir);
+// Cook-Torrance BRDF for one light, times N.L
+vec3 shadeLight(vec3 N, vec3 V, vec3 L, vec3 radiance, vec3 F0) {
     vec3 H = normalize(V + L);
 
-    // Base reflectivity
-    vec3 F0 = vec3(0.04);
-    F0 = mix(F0, Color.rgb, metallic);
-
-    // Cook-Torrance BRDF
     float NDF = DistributionGGX(N, H, roughness);
     float G = GeometrySmith(N, V, L, roughness);
     vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
@@ -78,25 +76,46 @@ void main() {
     kD *= 1.0 - metallic;
 
     float NdotL = max(dot(N, L), 0.0);
+    return (kD * Color.rgb / PI + specular) * radiance * NdotL;
+}
+
+vec3 shadeClusteredLights(vec3 N, vec3 V, vec3 F0) {
+    int first, count;
+    clusterLightRange(ViewDepth, first, count);
+
+    vec3 Lo = vec3(0.0);
+    for (int i = first; i < first + count; i++) {
+        vec3 L, radiance;
+        if (clusterLight(i, FragPos, L, radiance)) {
+            Lo += shadeLight(N, V, L, radiance, F0);
+        }
+    }
+    return Lo;
+}
+
+void main() {
+    vec3 N = normalize(Normal);
+    vec3 V = normalize(ViewDir);
+    vec3 L = normalize(LightDir);
+
+    // Base reflectivity
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, Color.rgb, metallic);
 
     // Add ambient light
     vec3 ambient = vec3(0.15, 0.15, 0.2) * Color.rgb;
 
-    // Calculate radiance
-    vec3 radiance = lightColor * 2.0;
-    vec3 Lo = (kD * Color.rgb / PI + specular) * radiance * NdotL;
+    // Main light, then every clustered light reaching this fragment
+    vec3 radiance = lightColor * 2.0 * sunShadow(FragPos, ViewDepth);
+    vec3 Lo = shadeLight(N, V, L, radiance, F0);
+    Lo += shadeClusteredLights(N, V, F0);
 
     vec3 finalColor = ambient + Lo;
 
-    // Add animated glow effect
+    // Energy surfaces glow on top of the lighting, pulsing slowly
     float glow = sin(time * 2.0 + FragPos.y) * 0.1 + 0.9;
-    finalColor *= glow;
-
-    // HDR tonemapping
-    finalColor = finalColor / (finalColor + vec3(1.0));
-
-    // Gamma correction
-    finalColor = pow(finalColor, vec3(1.0/2.2));
+    finalColor += Color.rgb * emissive * glow;
 
+    // HDR; the compositor tonemaps and gamma-corrects
     FragColor = vec4(finalColor, Color.a);
 }
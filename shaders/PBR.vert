@@ -3,14 +3,15 @@
 
 #version 330 core
 
-layout(location = 0) in vec3 vertex;
-layout(location = 1) in vec3 normal;
-layout(location = 2) in vec4 color;
-layout(location = 3) in vec2 uv;
+in vec4 vertex;
+in vec3 normal;
+in vec4 colour;
+in vec2 uv0;
 
 uniform mat4 worldViewProj;
 uniform mat4 world;
-uniform vec3 lightPos;
+uniform mat4 worldView;
+uniform vec4 lightPos;   // w = 0 for directional lights
 uniform vec3 cameraPos;
 
 out vec3 FragPos;
@@ -19,16 +20,18 @@ out vec4 Color;
 out vec2 TexCoord;
 out vec3 LightDir;
 out vec3 ViewDir;
+out float ViewDepth;
 
 void main() {
-    vec4 worldPos = world * vec4(vertex, 1.0);
+    vec4 worldPos = world * vertex;
     FragPos = worldPos.xyz;
     Normal = mat3(transpose(inverse(world))) * normal;
-    Color = color;
-    TexCoord = uv;
+    Color = colour;
+    TexCoord = uv0;
 
-    LightDir = normalize(lightPos - FragPos);
+    LightDir = normalize(lightPos.xyz - FragPos * lightPos.w);
     ViewDir = normalize(cameraPos - FragPos);
+    ViewDepth = -(worldView * vertex).z;
 
-    gl_Position = worldViewProj * vec4(vertex, 1.0);
+    gl_Position = worldViewProj * vertex;
 }
@@ -5,11 +5,15 @@
 
 in vec4 ParticleColor;
 in vec2 TexCoord;
+in vec3 FragPos;
+in float ViewDepth;
 
 out vec4 FragColor;
 
 uniform float time;
 
+#include "ClusteredLighting.glsl"
+
 void main() {
     // Circular particle shape with soft edges
     vec2 center = vec2(0.5);
@@ -19,6 +23,18 @@ void main() {
     // Add animated glow
     float glow = sin(time * 10.0) * 0.3 + 0.7;
 
-    vec3 color = ParticleColor.rgb * glow;
+    // Nearby flashes and lamps brighten the particle; it has no normal, so
+    // every direction counts as facing the light
+    vec3 light = vec3(1.0);
+    int first, count;
+    clusterLightRange(ViewDepth, first, count);
+    for (int i = first; i < first + count; i++) {
+        vec3 L, radiance;
+        if (clusterLight(i, FragPos, L, radiance)) {
+            light += radiance;
+        }
+    }
+
+    vec3 color = ParticleColor.rgb * glow * light;
     FragColor = vec4(color, ParticleColor.a * alpha);
 }
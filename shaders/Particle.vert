@@ -3,26 +3,35 @@
 
 #version 330 core
 
-layout(location = 0) in vec3 vertex;
-layout(location = 1) in vec4 color;
-layout(location = 2) in vec2 uv;
-layout(location = 3) in float size;
+// Ogre binds attributes by name. Per vertex: the quad corner (0..1).
+// Per instance: particle position, packed colour and size.
+in vec4 vertex;
+in vec4 colour;
+in vec2 uv0;
+in float uv1;
 
 uniform mat4 worldViewProj;
+uniform mat4 world;
+uniform mat4 worldView;
 uniform vec3 cameraPos;
 uniform vec3 cameraUp;
 uniform vec3 cameraRight;
 
 out vec4 ParticleColor;
 out vec2 TexCoord;
+out vec3 FragPos;
+out float ViewDepth;
 
 void main() {
-    // Billboard particles to face camera
-    vec3 particlePos = vertex;
-    particlePos += cameraRight * uv.x * size;
-    particlePos += cameraUp * uv.y * size;
+    // Billboard particles to face camera, centred on the particle
+    vec2 corner = uv0 - vec2(0.5);
+    vec3 particlePos = vertex.xyz;
+    particlePos += cameraRight * corner.x * uv1;
+    particlePos += cameraUp * corner.y * uv1;
 
     gl_Position = worldViewProj * vec4(particlePos, 1.0);
-    ParticleColor = color;
-    TexCoord = uv;
+    ParticleColor = colour;
+    TexCoord = uv0;
+    FragPos = (world * vec4(particlePos, 1.0)).xyz;
+    ViewDepth = -(worldView * vec4(particlePos, 1.0)).z;
 }
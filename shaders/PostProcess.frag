@@ -1,6 +1,8 @@
 // Licensed under the Apache License, Version 2.0
 // Post-Processing Shader for Bas Veeg Arc 3D
-// Includes: Bloom, HDR, Motion Blur effects
+// Composite pass of the post-process chain: bloom, SSAO, motion blur, tone
+// mapping and grading. Bloom and SSAO arrive from their own (lower
+// resolution) passes, see PostProcessManager.
 
 #version 330 core
 
@@ -8,11 +10,20 @@ in vec2 TexCoord;
 out vec4 FragColor;
 
 uniform sampler2D sceneTexture;
-uniform sampler2D brightTexture;
+uniform sampler2D bloomTexture;   // Accumulated bloom mip chain
+uniform sampler2D ssaoTexture;    // Half resolution (occlusion, depth)
+uniform sampler2D depthTexture;   // Linear view depth at scene resolution
+uniform vec4 effects;             // bloom, ssao, motion blur, hdr (0 or 1)
 uniform float time;
 uniform float bloomStrength;
 uniform float exposure;
+uniform float gamma;
 uniform float saturation;
+uniform float contrast;
+
+// Motion blur: reprojects view positions into last frame's clip space
+uniform vec4 projParams;          // tan(fovX / 2), tan(fovY / 2)
+uniform mat4 viewToPrevClip;
 
 // Chromatic aberration parameters
 const float aberrationStrength = 0.002;
@@ -25,21 +36,44 @@ vec3 chromaticAberration(sampler2D tex, vec2 uv) {
     return vec3(r, g, b);
 }
 
-vec3 bloom(sampler2D tex, vec2 uv, float strength) {
-    vec3 result = vec3(0.0);
-    float weights[5] = float[](0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+// Bilateral upsample: the four nearest half-resolution samples, weighted
+// by bilinear position and by how close their depth is to this pixel's
+float upsampleOcclusion(vec2 uv) {
+    float depth = texture(depthTexture, uv).r;
+    vec2 size = vec2(textureSize(ssaoTexture, 0));
+    vec2 position = uv * size - 0.5;
+    vec2 base = floor(position);
+    vec2 f = position - base;
+
+    float total = 0.0;
+    float weightSum = 0.0;
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 2; x++) {
+            vec2 sampleUV = (base + vec2(x, y) + 0.5) / size;
+            vec2 ssao = texture(ssaoTexture, sampleUV).rg;
+
+            float bilinear = (x == 0 ? 1.0 - f.x : f.x) * (y == 0 ? 1.0 - f.y : f.y);
+            float depthWeight = 1.0 / (abs(ssao.g - depth) / max(depth, 1e-3) * 50.0 + 1e-3);
+            float weight = bilinear * depthWeight;
+
+            total += ssao.r * weight;
+            weightSum += weight;
+        }
+    }
+    return weightSum > 0.0 ? total / weightSum : 1.0;
+}
 
-    vec2 texOffset = 1.0 / textureSize(tex, 0);
-    result += texture(tex, uv).rgb * weights[0];
+vec3 motionBlur(vec3 color, vec2 uv) {
+    float depth = texture(depthTexture, uv).r;
+    vec3 viewPos = vec3((uv * 2.0 - 1.0) * projParams.xy * depth, -depth);
+    vec4 prevClip = viewToPrevClip * vec4(viewPos, 1.0);
+    vec2 prevUV = prevClip.xy / prevClip.w * 0.5 + 0.5;
 
-    for(int i = 1; i < 5; ++i) {
-        result += texture(tex, uv + vec2(texOffset.x * i, 0.0)).rgb * weights[i];
-        result += texture(tex, uv - vec2(texOffset.x * i, 0.0)).rgb * weights[i];
-        result += texture(tex, uv + vec2(0.0, texOffset.y * i)).rgb * weights[i];
-        result += texture(tex, uv - vec2(0.0, texOffset.y * i)).rgb * weights[i];
+    vec2 velocity = clamp(uv - prevUV, vec2(-0.05), vec2(0.05));
+    for (int i = 1; i < 6; i++) {
+        color += texture(sceneTexture, uv - velocity * (float(i) / 6.0)).rgb;
     }
-
-    return result * strength;
+    return color / 6.0;
 }
 
 vec3 adjustSaturation(vec3 color, float saturation) {
@@ -59,15 +93,29 @@ void main() {
     // Chromatic aberration
     vec3 color = chromaticAberration(sceneTexture, uv);
 
+    if (effects.z > 0.5) {
+        color = motionBlur(color, uv);
+    }
+
+    if (effects.y > 0.5) {
+        color *= upsampleOcclusion(uv);
+    }
+
     // Add bloom
-    vec3 bloomColor = bloom(brightTexture, uv, bloomStrength);
-    color += bloomColor;
+    if (effects.x > 0.5) {
+        color += texture(bloomTexture, uv).rgb * bloomStrength;
+    }
 
-    // HDR tone mapping (Reinhard)
-    color = vec3(1.0) - exp(-color * exposure);
+    // HDR tone mapping (exponential), otherwise just clamp
+    if (effects.w > 0.5) {
+        color = vec3(1.0) - exp(-color * exposure);
+    } else {
+        color = clamp(color * exposure, 0.0, 1.0);
+    }
 
-    // Adjust saturation
+    // Adjust saturation and contrast
     color = adjustSaturation(color, saturation);
+    color = clamp((color - 0.5) * contrast + 0.5, 0.0, 1.0);
 
     // Apply vignette
     color *= vignette(uv);
@@ -77,7 +125,7 @@ void main() {
     color *= scanline;
 
     // Gamma correction
-    color = pow(color, vec3(1.0/2.2));
+    color = pow(color, vec3(1.0 / gamma));
 
     FragColor = vec4(color, 1.0);
 }
@@ -0,0 +1,16 @@
+// Licensed under the Apache License, Version 2.0
+// Fullscreen Quad Vertex Shader for Bas Veeg Arc 3D
+
+#version 330 core
+
+in vec4 vertex;
+in vec2 uv0;
+
+uniform mat4 worldViewProj;
+
+out vec2 TexCoord;
+
+void main() {
+    gl_Position = worldViewProj * vertex;
+    TexCoord = uv0;
+}
@@ -0,0 +1,50 @@
+// Licensed under the Apache License, Version 2.0
+// Screen-Space Ambient Occlusion for Bas Veeg Arc 3D
+// Runs at half resolution on the linear depth buffer. Writes (occlusion,
+// depth) so the composite pass can upsample it bilaterally.
+
+#version 330 core
+
+in vec2 TexCoord;
+out vec4 FragColor;
+
+uniform sampler2D depthTexture;  // Linear view depth
+uniform vec4 projParams;         // tan(fovX / 2), tan(fovY / 2), radius, sampleCount
+uniform float time;
+
+vec3 viewPosition(vec2 uv) {
+    float depth = textureLod(depthTexture, uv, 0.0).r;
+    vec2 ndc = uv * 2.0 - 1.0;
+    return vec3(ndc * projParams.xy * depth, -depth);
+}
+
+void main() {
+    vec3 position = viewPosition(TexCoord);
+    float depth = -position.z;
+
+    // Normal from depth derivatives
+    vec3 normal = normalize(cross(dFdx(position), dFdy(position)));
+
+    // Spiral of samples in a disc whose screen size follows the radius
+    float radius = projParams.z;
+    int sampleCount = int(projParams.w);
+    vec2 screenRadius = radius / (projParams.xy * depth) * 0.5;
+    float angle = fract(sin(dot(gl_FragCoord.xy, vec2(12.9898, 78.233))) * 43758.5453) * 6.2831853;
+
+    float occlusion = 0.0;
+    for (int i = 0; i < sampleCount; i++) {
+        float t = (float(i) + 0.5) / float(sampleCount);
+        float a = angle + t * 6.2831853 * 3.0;
+        vec2 offset = vec2(cos(a), sin(a)) * t * screenRadius;
+
+        vec3 delta = viewPosition(TexCoord + offset) - position;
+        float distSq = dot(delta, delta);
+        float facing = max(dot(delta, normal) - 0.01 * depth, 0.0);
+
+        // Falls off to nothing at the radius
+        occlusion += facing / (distSq + 0.01) * max(1.0 - distSq / (radius * radius), 0.0);
+    }
+
+    float ao = clamp(1.0 - occlusion * 2.0 / float(max(sampleCount, 1)), 0.0, 1.0);
+    FragColor = vec4(ao, depth, 0.0, 1.0);
+}
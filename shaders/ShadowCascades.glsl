@@ -0,0 +1,42 @@
+// Cascaded sun shadows (see ShadowCascades), shared by the lit fragment
+// programs. The pass must be bound with ShadowCascades::bindToPass.
+
+uniform vec4 cascadeSplits;           // Far view depth of each cascade
+uniform vec4 shadowParams;            // cascadeCount, depthBias, 1 / textureSize
+uniform sampler2D shadowMap0;
+uniform sampler2D shadowMap1;
+uniform sampler2D shadowMap2;
+uniform sampler2D shadowMap3;
+uniform mat4 texViewProj0;
+uniform mat4 texViewProj1;
+uniform mat4 texViewProj2;
+uniform mat4 texViewProj3;
+
+// 2x2 PCF against one cascade; 1 = lit
+float sampleCascade(sampler2D shadowMap, mat4 texViewProj, vec3 worldPos) {
+    vec4 lightClip = texViewProj * vec4(worldPos, 1.0);
+    vec2 uv = lightClip.xy / lightClip.w;
+    float depth = lightClip.z * 0.5 + 0.5 - shadowParams.y;
+
+    float lit = 0.0;
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 2; x++) {
+            vec2 offset = (vec2(x, y) - 0.5) * shadowParams.z;
+            lit += depth <= texture(shadowMap, uv + offset).r ? 1.0 : 0.0;
+        }
+    }
+    return lit * 0.25;
+}
+
+// How much sun reaches a fragment; 1 when no cascades are bound
+float sunShadow(vec3 worldPos, float viewDepth) {
+    int cascadeCount = int(shadowParams.x);
+    if (cascadeCount == 0) return 1.0;
+
+    // Samplers cannot be indexed dynamically in GLSL 3.30
+    if (viewDepth < cascadeSplits.x) return sampleCascade(shadowMap0, texViewProj0, worldPos);
+    if (cascadeCount > 1 && viewDepth < cascadeSplits.y) return sampleCascade(shadowMap1, texViewProj1, worldPos);
+    if (cascadeCount > 2 && viewDepth < cascadeSplits.z) return sampleCascade(shadowMap2, texViewProj2, worldPos);
+    if (cascadeCount > 3 && viewDepth < cascadeSplits.w) return sampleCascade(shadowMap3, texViewProj3, worldPos);
+    return 1.0;
+}
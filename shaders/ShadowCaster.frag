@@ -0,0 +1,12 @@
+// Licensed under the Apache License, Version 2.0
+// Shadow Caster Fragment Shader for Bas Veeg Arc 3D
+
+#version 330 core
+
+in float Depth;
+
+out vec4 FragColor;
+
+void main() {
+    FragColor = vec4(Depth, 0.0, 0.0, 1.0);
+}
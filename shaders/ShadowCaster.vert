@@ -0,0 +1,17 @@
+// Licensed under the Apache License, Version 2.0
+// Shadow Caster Vertex Shader for Bas Veeg Arc 3D
+
+#version 330 core
+
+in vec4 vertex;
+
+uniform mat4 worldViewProj;
+
+out float Depth;
+
+void main() {
+    gl_Position = worldViewProj * vertex;
+
+    // Shadow cameras are orthographic, so clip z is already linear
+    Depth = gl_Position.z * 0.5 + 0.5;
+}
@@ -0,0 +1,12 @@
+// Licensed under the Apache License, Version 2.0
+// Linear View Depth Fragment Shader for Bas Veeg Arc 3D
+
+#version 330 core
+
+in float ViewDepth;
+
+out vec4 FragColor;
+
+void main() {
+    FragColor = vec4(ViewDepth, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,16 @@
+// Licensed under the Apache License, Version 2.0
+// Linear View Depth Vertex Shader for Bas Veeg Arc 3D
+
+#version 330 core
+
+in vec4 vertex;
+
+uniform mat4 worldViewProj;
+uniform mat4 worldView;
+
+out float ViewDepth;
+
+void main() {
+    gl_Position = worldViewProj * vertex;
+    ViewDepth = -(worldView * vertex).z;
+}
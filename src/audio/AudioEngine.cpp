@@ -87,6 +87,19 @@ AudioBuffer* AudioEngine::loadSound(const std::string& filename) {
     return bufferPtr;
 }
 
+AudioBuffer* AudioEngine::loadSamples(const std::string& name, const short* samples, size_t count,
+                                      int sampleRate) {
+    auto buffer = std::make_unique<AudioBuffer>(samples, count, sampleRate);
+    if (!buffer->isLoaded()) {
+        std::cerr << "Failed to upload audio samples: " << name << std::endl;
+        return nullptr;
+    }
+
+    AudioBuffer* bufferPtr = buffer.get();
+    buffers[name] = std::move(buffer);
+    return bufferPtr;
+}
+
 AudioBuffer* AudioEngine::loadMusic(const std::string& filename) {
     // Same as loadSound for now, could implement streaming later
     return loadSound(filename);
@@ -173,6 +186,12 @@ AudioBuffer::AudioBuffer(const std::string& filename) {
     }
 }
 
+AudioBuffer::AudioBuffer(const short* samples, size_t count, int sampleRate) {
+    alGenBuffers(1, &buffer);
+    alBufferData(buffer, AL_FORMAT_MONO16, samples, static_cast<ALsizei>(count * sizeof(short)), sampleRate);
+    loaded = alGetError() == AL_NO_ERROR;
+}
+
 AudioBuffer::~AudioBuffer() {
     if (buffer) {
         alDeleteBuffers(1, &buffer);
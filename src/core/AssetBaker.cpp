@@ -0,0 +1,291 @@
+#include "core/AssetBaker.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BVA {
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x4B415642;  // "BVAK"
+
+// Payload follows the header, so it starts 8-byte aligned in the mapping
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t format;
+    uint64_t key;
+    uint64_t payloadSize;
+};
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    // FNV-1a
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        close();
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (view) UnmapViewOfFile(view);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (view) munmap(const_cast<uint8_t*>(view), length);
+#endif
+        view = nullptr;
+        length = 0;
+    }
+
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return false;
+        length = static_cast<size_t>(fileSize.QuadPart);
+
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+
+        view = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        return view != nullptr;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<size_t>(info.st_size);
+
+        // The mapping stays valid after the descriptor is closed
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) return false;
+
+        view = static_cast<const uint8_t*>(mapped);
+        return true;
+#endif
+    }
+
+    const uint8_t* data() const { return view; }
+    size_t size() const { return length; }
+
+private:
+    const uint8_t* view = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+} // namespace
+
+struct AssetBaker::Job {
+    std::string name;
+    std::string params;
+    uint32_t version = 0;
+    uint64_t key = 0;
+    Generator generate;
+
+    // Result: either generated bytes or a view into the mapped cache file
+    std::vector<uint8_t> generated;
+    MappedFile mapped;
+    BakedAsset result;
+    bool fromCache = false;
+    bool finished = false;
+};
+
+AssetBaker::AssetBaker(std::string directory) : cacheDirectory(std::move(directory)) {}
+
+AssetBaker::~AssetBaker() {
+    wait();
+}
+
+void AssetBaker::addJob(const std::string& name, const std::string& params, uint32_t version,
+                        Generator generate) {
+    if (started) {
+        std::cerr << "AssetBaker: job added after start, ignored: " << name << std::endl;
+        return;
+    }
+    if (jobIndices.count(name)) {
+        std::cerr << "AssetBaker: duplicate job: " << name << std::endl;
+        return;
+    }
+
+    auto job = std::make_unique<Job>();
+    job->name = name;
+    job->params = params;
+    job->version = version;
+    job->generate = std::move(generate);
+
+    // Key covers everything that affects the output
+    uint64_t key = 14695981039346656037ull;
+    key = hashBytes(key, &CACHE_FORMAT, sizeof(CACHE_FORMAT));
+    key = hashBytes(key, name.c_str(), name.size() + 1);
+    key = hashBytes(key, params.c_str(), params.size() + 1);
+    key = hashBytes(key, &version, sizeof(version));
+    job->key = key;
+
+    jobIndices[name] = jobs.size();
+    jobs.push_back(std::move(job));
+}
+
+void AssetBaker::start(unsigned threadCount) {
+    if (started) return;
+    started = true;
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory, ec);
+    if (ec) {
+        std::cerr << "AssetBaker: cannot create cache directory " << cacheDirectory
+                  << ", baking without cache" << std::endl;
+    }
+
+    if (threadCount == 0) {
+        unsigned cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 1;
+    }
+    threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(std::max<size_t>(jobs.size(), 1)));
+
+    workers.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.emplace_back(&AssetBaker::workerLoop, this);
+    }
+}
+
+void AssetBaker::wait() {
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers.clear();
+}
+
+void AssetBaker::workerLoop() {
+    while (true) {
+        Job* job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (nextJob >= jobs.size()) return;
+            job = jobs[nextJob++].get();
+        }
+
+        runJob(*job);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job->finished = true;
+        }
+        jobFinished.notify_all();
+    }
+}
+
+std::string AssetBaker::cachePath(const Job& job) const {
+    std::string fileName = job.name;
+    std::replace_if(fileName.begin(), fileName.end(),
+                    [](char c) { return !std::isalnum(static_cast<unsigned char>(c)); }, '_');
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(job.key));
+    return cacheDirectory + "/" + fileName + "-" + hex + ".bin";
+}
+
+void AssetBaker::runJob(Job& job) {
+    std::string path = cachePath(job);
+
+    // Cache hit: map the file and point straight into it
+    if (job.mapped.open(path) && job.mapped.size() >= sizeof(CacheHeader)) {
+        CacheHeader header;
+        std::memcpy(&header, job.mapped.data(), sizeof(header));
+        if (header.magic == CACHE_MAGIC && header.format == CACHE_FORMAT && header.key == job.key &&
+            header.payloadSize == job.mapped.size() - sizeof(CacheHeader)) {
+            job.result = {job.mapped.data() + sizeof(CacheHeader), static_cast<size_t>(header.payloadSize)};
+            job.fromCache = true;
+            return;
+        }
+    }
+    job.mapped.close();  // Missing, stale or from another version
+
+    job.generated = job.generate();
+    job.result = {job.generated.data(), job.generated.size()};
+    if (job.generated.empty()) {
+        std::cerr << "AssetBaker: generator produced nothing: " << job.name << std::endl;
+        job.result = {};
+        return;
+    }
+
+    // Write to a temporary file and rename, so a crash never leaves a
+    // truncated file under the real name
+    CacheHeader header{CACHE_MAGIC, CACHE_FORMAT, job.key, job.generated.size()};
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(reinterpret_cast<const char*>(job.generated.data()), job.generated.size())) {
+            return;  // Not fatal, the asset is still in memory
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
+BakedAsset AssetBaker::get(const std::string& name) const {
+    auto it = jobIndices.find(name);
+    if (it == jobIndices.end()) return {};
+
+    const Job& job = *jobs[it->second];
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!started) return {};
+    jobFinished.wait(lock, [&job] { return job.finished; });
+    return job.result;
+}
+
+size_t AssetBaker::getCacheHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::count_if(jobs.begin(), jobs.end(),
+                         [](const std::unique_ptr<Job>& job) { return job->finished && job->fromCache; });
+}
+
+} // namespace BVA
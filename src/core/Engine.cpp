@@ -5,6 +5,13 @@
 #include "core/InputManager.hpp"
 #include "core/GameStateManager.hpp"
 #include "network/NetworkManager.hpp"
+#include "core/GameData.hpp"
+#include "core/ReplaySystem.hpp"
+#include "core/AssetBaker.hpp"
+#include "graphics/ProceduralGenerator.hpp"
+#include "graphics/LevelGeometry.hpp"
+#include "graphics/RenderThread.hpp"
+#include "ui/UIManager.hpp"
 #include <iostream>
 #include <thread>
 
@@ -18,6 +25,22 @@ Engine& Engine::getInstance() {
 bool Engine::initialize() {
     std::cout << "Initializing subsystems..." << std::endl;
 
+    // Procedural meshes, textures and sounds bake on worker threads while the
+    // subsystems come up; results cached by earlier launches are mapped
+    assets = std::make_unique<AssetBaker>("cache/assets");
+    ProceduralMeshGenerator::registerBakeJobs(*assets);
+    ProceduralTextureGenerator::registerBakeJobs(*assets);
+    ProceduralAudioGenerator::registerBakeJobs(*assets);
+    LevelGeometry::registerBakeJobs(*assets);
+    assets->start();
+
+    // Character/boss definitions; recompiled here if the text source was edited
+    if (!GameData::load("assets/data/gamedata.bin", "assets/data/gamedata.txt")) {
+        std::cerr << "Failed to load game data!" << std::endl;
+        return false;
+    }
+    std::cout << "  - Game data: OK" << std::endl;
+
     // Initialize graphics first
     graphics = std::make_unique<GraphicsEngine>();
     if (!graphics->initialize()) {
@@ -26,6 +49,16 @@ bool Engine::initialize() {
     }
     std::cout << "  - Graphics engine: OK" << std::endl;
 
+    // Overlays are created on the render thread, which draws them
+    ui = std::make_unique<UIManager>();
+    bool uiReady = false;
+    graphics->runOnRenderThread([&]() { uiReady = ui->initialize(graphics->getSceneManager()); });
+    if (!uiReady) {
+        std::cerr << "Failed to initialize UI manager!" << std::endl;
+        return false;
+    }
+    std::cout << "  - UI manager: OK" << std::endl;
+
     // Initialize physics
     physics = std::make_unique<PhysicsEngine>();
     if (!physics->initialize()) {
@@ -40,6 +73,8 @@ bool Engine::initialize() {
         std::cerr << "Failed to initialize audio engine!" << std::endl;
         return false;
     }
+    // Menu music only; the rest streams in with the first level
+    ProceduralAudioGenerator::loadBakedSound(*assets, *audio, "proc/menu");
     std::cout << "  - Audio engine: OK" << std::endl;
 
     // Initialize input
@@ -64,8 +99,16 @@ bool Engine::initialize() {
         std::cerr << "Failed to initialize game state manager!" << std::endl;
         return false;
     }
+    gameState->setUI(ui.get());
     std::cout << "  - Game state manager: OK" << std::endl;
 
+    replay = std::make_unique<ReplaySystem>();
+
+    // Level assets keep baking behind the main menu; the level streamer
+    // waits for the ones it needs
+    std::cout << "  - Baked assets: " << assets->getCacheHits() << "/" << assets->getJobCount()
+              << " from cache so far" << std::endl;
+
     running = true;
     return true;
 }
@@ -120,32 +163,63 @@ void Engine::update(float dt) {
     // Update network
     network->update(dt);
 
-    // Update game state
-    gameState->update(dt);
+    if (replay->isPlaying()) {
+        // Recorded inputs drive the simulation (possibly several ticks per frame)
+        replay->handlePlaybackControls(*input);
+        replay->updatePlayback(dt);
+    } else {
+        // Local players' input for this tick; remote players arrive over the network
+        std::array<PlayerInput, GameStateManager::MAX_PLAYERS> inputs;
+        for (int i = 0; i < GameStateManager::MAX_PLAYERS; i++) {
+            if (!gameState->isRemotePlayer(i)) {
+                gameState->setPlayerInput(i, input->samplePlayerInput(i));
+            }
+            inputs[i] = gameState->getPlayerInput(i);
+        }
+        replay->recordTick(inputs);
 
-    // Update physics
-    physics->update(dt);
+        simulateTick(dt);
+    }
 
     // Update audio
     audio->update(dt);
 
-    // Update graphics (animations, particles, etc.)
-    graphics->update(dt);
+    // Graphics subsystems (animations, particles, etc.) update on the render
+    // thread with the frame they draw
+}
+
+void Engine::simulateTick(float dt) {
+    gameState->update(dt);
+    physics->update(dt);
 }
 
 void Engine::render() {
-    graphics->render();
+    UIManager* overlays = ui.get();
+    float dt = deltaTime;
+    graphics->getFramePacket().enqueue([overlays, dt]() { overlays->update(dt); });
+
+    // Drawing happens on the render thread; this returns as soon as the
+    // previous frame is done, so the next frame's simulation overlaps it
+    graphics->submitFrame(deltaTime);
+
+    if (graphics->isWindowClosed()) {
+        quit();
+    }
 }
 
 void Engine::shutdown() {
     std::cout << "Shutting down subsystems..." << std::endl;
 
+    replay.reset();
+
     if (gameState) {
         gameState->shutdown();
         gameState.reset();
         std::cout << "  - Game state manager: Shutdown" << std::endl;
     }
 
+    GameData::unload();
+
     if (network) {
         network->shutdown();
         network.reset();
@@ -170,12 +244,20 @@ void Engine::shutdown() {
         std::cout << "  - Physics engine: Shutdown" << std::endl;
     }
 
+    if (ui) {
+        graphics->runOnRenderThread([this]() { ui->shutdown(); });
+        ui.reset();
+        std::cout << "  - UI manager: Shutdown" << std::endl;
+    }
+
     if (graphics) {
         graphics->shutdown();
         graphics.reset();
         std::cout << "  - Graphics engine: Shutdown" << std::endl;
     }
 
+    assets.reset();
+
     running = false;
 }
 
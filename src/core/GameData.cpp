@@ -0,0 +1,553 @@
+#include "core/GameData.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <unordered_map>
+#include <cstdlib>
+#include <cstring>
+
+namespace BVA {
+
+std::vector<uint64_t> GameData::storage;
+const GameDataHeader* GameData::header = nullptr;
+
+namespace {
+
+constexpr uint32_t CHARACTER_COUNT = static_cast<uint32_t>(CharacterID::Count);
+constexpr uint32_t BOSS_COUNT = static_cast<uint32_t>(BossType::Count);
+constexpr uint32_t EFFECT_KIND_COUNT = static_cast<uint32_t>(AbilityEffect::Count);
+
+// Section keys in the text source, in enum order
+const char* const CHARACTER_KEYS[] = {
+    "Bas", "Berkay", "Luca", "Gefferinho", "Hadi", "Nitin", "PalaBaba",
+    "Fufinho", "EfeAbi", "Jad", "Umut", "KeizerBomTaha", "GoonLordTobese"
+};
+const char* const BOSS_KEYS[] = {
+    "Bastiaan", "KeizerBomTaha", "Mees", "PrincipalVanDerBerg", "JanitorKing", "HeadChef"
+};
+const char* const EFFECT_KEYS[] = {
+    "DamageBoost", "SpeedBoost", "HealthBoost", "SplashDamage", "FireDamage", "Projectile", "PlaneSummon"
+};
+
+static_assert(sizeof(CHARACTER_KEYS) / sizeof(CHARACTER_KEYS[0]) == CHARACTER_COUNT, "CHARACTER_KEYS out of sync");
+static_assert(sizeof(BOSS_KEYS) / sizeof(BOSS_KEYS[0]) == BOSS_COUNT, "BOSS_KEYS out of sync");
+static_assert(sizeof(EFFECT_KEYS) / sizeof(EFFECT_KEYS[0]) == EFFECT_KIND_COUNT, "EFFECT_KEYS out of sync");
+
+// Returned before the table is loaded, so lookups never fail
+const CharacterRecord DEFAULT_CHARACTER = {};
+const BossRecord DEFAULT_BOSS = {};
+
+template <size_t N>
+int findKey(const char* const (&keys)[N], const std::string& key) {
+    for (size_t i = 0; i < N; i++) {
+        if (key == keys[i]) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+template <typename T>
+const T* recordsAt(const void* base, uint32_t offset) {
+    return reinterpret_cast<const T*>(static_cast<const uint8_t*>(base) + offset);
+}
+
+std::string trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(start, end - start + 1);
+}
+
+bool parseFloat(const std::string& value, float& out) {
+    if (value.empty()) return false;
+    char* end = nullptr;
+    out = std::strtof(value.c_str(), &end);
+    return *end == '\0';
+}
+
+bool parseBool(const std::string& value, bool& out) {
+    if (value == "true") { out = true; return true; }
+    if (value == "false") { out = false; return true; }
+    return false;
+}
+
+// Whitespace separated floats; exactly count values required
+bool parseFloats(const std::string& value, float* out, int count) {
+    std::istringstream stream(value);
+    for (int i = 0; i < count; i++) {
+        if (!(stream >> out[i])) return false;
+    }
+    std::string rest;
+    return !(stream >> rest);
+}
+
+// Deduplicating NUL-terminated string pool; offset 0 is ""
+class StringPool {
+public:
+    StringPool() : data(1, '\0') {}
+
+    uint32_t add(const std::string& s) {
+        if (s.empty()) return 0;
+        auto it = offsets.find(s);
+        if (it != offsets.end()) return it->second;
+
+        uint32_t offset = static_cast<uint32_t>(data.size());
+        data.insert(data.end(), s.begin(), s.end());
+        data.push_back('\0');
+        offsets[s] = offset;
+        return offset;
+    }
+
+    const std::vector<char>& getData() const { return data; }
+
+private:
+    std::vector<char> data;
+    std::unordered_map<std::string, uint32_t> offsets;
+};
+
+bool parseStatsField(const std::string& key, const std::string& value, CharacterStats& stats) {
+    if (key == "maxHealth") return parseFloat(value, stats.maxHealth);
+    if (key == "moveSpeed") return parseFloat(value, stats.moveSpeed);
+    if (key == "attackDamage") return parseFloat(value, stats.attackDamage);
+    if (key == "attackSpeed") return parseFloat(value, stats.attackSpeed);
+    if (key == "defense") return parseFloat(value, stats.defense);
+    return false;
+}
+
+bool parseProjectileField(const std::string& key, const std::string& value, ProjectileRecord& projectile) {
+    const std::string prefix = "projectile.";
+    if (key.compare(0, prefix.size(), prefix) != 0) return false;
+    std::string field = key.substr(prefix.size());
+
+    if (field == "speed") return parseFloat(value, projectile.speed);
+    if (field == "radius") return parseFloat(value, projectile.radius);
+    if (field == "lifetime") return parseFloat(value, projectile.lifetime);
+    if (field == "gravityScale") return parseFloat(value, projectile.gravityScale);
+    if (field == "fireDPS") return parseFloat(value, projectile.fireDPS);
+    if (field == "fireDuration") return parseFloat(value, projectile.fireDuration);
+    if (field == "splashRadius") return parseFloat(value, projectile.splashRadius);
+    if (field == "scale") return parseFloat(value, projectile.scale);
+    if (field == "color") return parseFloats(value, projectile.color, 3);
+    if (field == "spread") return parseFloat(value, projectile.spreadDegrees);
+    if (field == "loft") return parseFloat(value, projectile.loft);
+    if (field == "count") {
+        float count = 0.0f;
+        if (!parseFloat(value, count) || count < 1.0f) return false;
+        projectile.count = static_cast<uint32_t>(count);
+        return true;
+    }
+    return false;
+}
+
+bool parseCharacterField(const std::string& key, const std::string& value, CharacterRecord& character,
+                         std::vector<EffectRecord>& effects, StringPool& strings) {
+    if (key == "name") { character.name = strings.add(value); return true; }
+    if (key == "ability.name") { character.abilityName = strings.add(value); return true; }
+    if (key == "ability.voiceLine") { character.voiceLine = strings.add(value); return true; }
+    if (key == "ability.description") { character.description = strings.add(value); return true; }
+    if (key == "ability.message") { character.activationMessage = strings.add(value); return true; }
+    if (key == "ability.duration") return parseFloat(value, character.abilityDuration);
+    if (key == "ability.cooldown") return parseFloat(value, character.abilityCooldown);
+
+    // effect = <Kind> <value> [param]
+    if (key == "effect") {
+        std::istringstream stream(value);
+        std::string kind;
+        EffectRecord effect = {AbilityEffect::DamageBoost, 0.0f, 0.0f};
+        if (!(stream >> kind >> effect.value)) return false;
+        stream >> effect.param;
+
+        int kindIndex = findKey(EFFECT_KEYS, kind);
+        if (kindIndex < 0) return false;
+        effect.effect = static_cast<AbilityEffect>(kindIndex);
+        effects.push_back(effect);
+        return true;
+    }
+
+    return parseStatsField(key, value, character.stats) ||
+           parseProjectileField(key, value, character.projectile);
+}
+
+bool parseBossField(const std::string& key, const std::string& value, BossRecord& boss, StringPool& strings) {
+    if (key == "name") { boss.name = strings.add(value); return true; }
+    if (key == "intro") { boss.introText = strings.add(value); return true; }
+    if (key == "phase2") return parseFloat(value, boss.phase2HealthPercent);
+    if (key == "phase3") return parseFloat(value, boss.phase3HealthPercent);
+    return parseStatsField(key, value, boss.stats);
+}
+
+bool parseAttackField(const std::string& key, const std::string& value, BossAttackRecord& attack,
+                      StringPool& strings) {
+    if (key == "name") { attack.name = strings.add(value); return true; }
+    if (key == "message") { attack.message = strings.add(value); return true; }
+    if (key == "damage") return parseFloat(value, attack.damage);
+    if (key == "range") return parseFloat(value, attack.range);
+    if (key == "cooldown") return parseFloat(value, attack.cooldown);
+    if (key == "windup") return parseFloat(value, attack.windupTime);
+
+    if (key == "aoe" || key == "projectile") {
+        bool enabled = false;
+        if (!parseBool(value, enabled)) return false;
+        uint32_t flag = (key == "aoe") ? BossAttackRecord::FLAG_AOE : BossAttackRecord::FLAG_PROJECTILE;
+        attack.flags = enabled ? (attack.flags | flag) : (attack.flags & ~flag);
+        return true;
+    }
+
+    // slow = <speed multiplier> <duration>
+    if (key == "slow") {
+        float slow[2];
+        if (!parseFloats(value, slow, 2)) return false;
+        attack.slowMultiplier = slow[0];
+        attack.slowDuration = slow[1];
+        return true;
+    }
+
+    return parseProjectileField(key, value, attack.projectile);
+}
+
+} // namespace
+
+bool GameData::compile(const std::string& sourcePath, std::vector<uint8_t>& output) {
+    std::ifstream file(sourcePath);
+    if (!file) {
+        std::cerr << "Failed to open game data source: " << sourcePath << std::endl;
+        return false;
+    }
+
+    std::vector<CharacterRecord> characters(CHARACTER_COUNT, DEFAULT_CHARACTER);
+    std::vector<std::vector<EffectRecord>> characterEffects(CHARACTER_COUNT);
+    std::vector<bool> haveCharacter(CHARACTER_COUNT, false);
+
+    BossRecord defaultBoss = DEFAULT_BOSS;
+    defaultBoss.phase2HealthPercent = 0.66f;
+    defaultBoss.phase3HealthPercent = 0.33f;
+    std::vector<BossRecord> bosses(BOSS_COUNT, defaultBoss);
+    std::vector<std::vector<BossAttackRecord>> bossAttacks(BOSS_COUNT);
+    std::vector<bool> haveBoss(BOSS_COUNT, false);
+
+    StringPool strings;
+
+    enum class Section { None, Character, Boss, Attack };
+    Section section = Section::None;
+    int characterIndex = -1;
+    int bossIndex = -1;
+
+    bool ok = true;
+    int lineNumber = 0;
+    auto error = [&](const std::string& message) {
+        std::cerr << sourcePath << ":" << lineNumber << ": " << message << std::endl;
+        ok = false;
+    };
+
+    std::string line;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        // [character <Key>], [boss <Key>], or [attack] (belongs to the last boss)
+        if (line[0] == '[') {
+            if (line.back() != ']') {
+                error("unterminated section header");
+                section = Section::None;
+                continue;
+            }
+
+            std::istringstream stream(line.substr(1, line.size() - 2));
+            std::string kind, key;
+            stream >> kind >> key;
+
+            if (kind == "character") {
+                characterIndex = findKey(CHARACTER_KEYS, key);
+                if (characterIndex < 0) {
+                    error("unknown character '" + key + "'");
+                    section = Section::None;
+                } else if (haveCharacter[characterIndex]) {
+                    error("duplicate character '" + key + "'");
+                    section = Section::None;
+                } else {
+                    haveCharacter[characterIndex] = true;
+                    section = Section::Character;
+                }
+            } else if (kind == "boss") {
+                bossIndex = findKey(BOSS_KEYS, key);
+                if (bossIndex < 0) {
+                    error("unknown boss '" + key + "'");
+                    section = Section::None;
+                } else if (haveBoss[bossIndex]) {
+                    error("duplicate boss '" + key + "'");
+                    section = Section::None;
+                } else {
+                    haveBoss[bossIndex] = true;
+                    section = Section::Boss;
+                }
+            } else if (kind == "attack") {
+                if (section != Section::Boss && section != Section::Attack) {
+                    error("[attack] must follow a [boss] section");
+                    section = Section::None;
+                } else {
+                    BossAttackRecord attack = {};
+                    attack.slowMultiplier = 1.0f;
+                    bossAttacks[bossIndex].push_back(attack);
+                    section = Section::Attack;
+                }
+            } else {
+                error("unknown section '" + kind + "'");
+                section = Section::None;
+            }
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error("expected 'key = value'");
+            continue;
+        }
+
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+
+        bool handled = false;
+        switch (section) {
+            case Section::Character:
+                handled = parseCharacterField(key, value, characters[characterIndex],
+                                              characterEffects[characterIndex], strings);
+                break;
+            case Section::Boss:
+                handled = parseBossField(key, value, bosses[bossIndex], strings);
+                break;
+            case Section::Attack:
+                handled = parseAttackField(key, value, bossAttacks[bossIndex].back(), strings);
+                break;
+            case Section::None:
+                error("field outside of a section");
+                continue;
+        }
+
+        if (!handled) {
+            error("invalid field '" + key + " = " + value + "'");
+        }
+    }
+
+    for (uint32_t i = 0; i < CHARACTER_COUNT; i++) {
+        if (!haveCharacter[i]) {
+            std::cerr << sourcePath << ": missing [character " << CHARACTER_KEYS[i] << "]" << std::endl;
+            ok = false;
+        }
+    }
+    for (uint32_t i = 0; i < BOSS_COUNT; i++) {
+        if (!haveBoss[i]) {
+            std::cerr << sourcePath << ": missing [boss " << BOSS_KEYS[i] << "]" << std::endl;
+            ok = false;
+        }
+    }
+
+    if (!ok) return false;
+
+    // Flatten per-entry lists into shared arrays
+    std::vector<EffectRecord> effects;
+    for (uint32_t i = 0; i < CHARACTER_COUNT; i++) {
+        characters[i].firstEffect = static_cast<uint32_t>(effects.size());
+        characters[i].effectCount = static_cast<uint32_t>(characterEffects[i].size());
+        effects.insert(effects.end(), characterEffects[i].begin(), characterEffects[i].end());
+    }
+
+    std::vector<BossAttackRecord> attacks;
+    for (uint32_t i = 0; i < BOSS_COUNT; i++) {
+        bosses[i].firstAttack = static_cast<uint32_t>(attacks.size());
+        bosses[i].attackCount = static_cast<uint32_t>(bossAttacks[i].size());
+        attacks.insert(attacks.end(), bossAttacks[i].begin(), bossAttacks[i].end());
+    }
+
+    const std::vector<char>& stringData = strings.getData();
+
+    // Header, then each array back to back (all record sizes are 4-byte multiples)
+    GameDataHeader fileHeader = {};
+    fileHeader.magic = GAMEDATA_MAGIC;
+    fileHeader.version = GAMEDATA_VERSION;
+
+    uint32_t offset = sizeof(GameDataHeader);
+    auto place = [&offset](uint32_t count, size_t recordSize) {
+        uint32_t at = offset;
+        offset += static_cast<uint32_t>(count * recordSize);
+        return at;
+    };
+
+    fileHeader.characterCount = CHARACTER_COUNT;
+    fileHeader.characterOffset = place(CHARACTER_COUNT, sizeof(CharacterRecord));
+    fileHeader.bossCount = BOSS_COUNT;
+    fileHeader.bossOffset = place(BOSS_COUNT, sizeof(BossRecord));
+    fileHeader.attackCount = static_cast<uint32_t>(attacks.size());
+    fileHeader.attackOffset = place(fileHeader.attackCount, sizeof(BossAttackRecord));
+    fileHeader.effectCount = static_cast<uint32_t>(effects.size());
+    fileHeader.effectOffset = place(fileHeader.effectCount, sizeof(EffectRecord));
+    fileHeader.stringsSize = static_cast<uint32_t>(stringData.size());
+    fileHeader.stringsOffset = place(fileHeader.stringsSize, 1);
+
+    output.assign(offset, 0);
+    std::memcpy(output.data(), &fileHeader, sizeof(fileHeader));
+    std::memcpy(output.data() + fileHeader.characterOffset, characters.data(), characters.size() * sizeof(CharacterRecord));
+    std::memcpy(output.data() + fileHeader.bossOffset, bosses.data(), bosses.size() * sizeof(BossRecord));
+    if (!attacks.empty()) {
+        std::memcpy(output.data() + fileHeader.attackOffset, attacks.data(), attacks.size() * sizeof(BossAttackRecord));
+    }
+    if (!effects.empty()) {
+        std::memcpy(output.data() + fileHeader.effectOffset, effects.data(), effects.size() * sizeof(EffectRecord));
+    }
+    std::memcpy(output.data() + fileHeader.stringsOffset, stringData.data(), stringData.size());
+
+    return true;
+}
+
+bool GameData::compileFile(const std::string& sourcePath, const std::string& binaryPath) {
+    std::vector<uint8_t> output;
+    if (!compile(sourcePath, output)) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(binaryPath).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    std::ofstream file(binaryPath, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(output.data()), output.size())) {
+        std::cerr << "Failed to write game data: " << binaryPath << std::endl;
+        return false;
+    }
+
+    std::cout << "Compiled game data: " << sourcePath << " -> " << binaryPath
+              << " (" << output.size() << " bytes)" << std::endl;
+    return true;
+}
+
+bool GameData::load(const std::string& binaryPath, const std::string& sourcePath) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    // Recompile edited definitions; a stale binary is still usable if that fails
+    if (!sourcePath.empty() && fs::exists(sourcePath, ec)) {
+        bool stale = !fs::exists(binaryPath, ec) ||
+                     fs::last_write_time(sourcePath, ec) > fs::last_write_time(binaryPath, ec);
+        if (stale && !compileFile(sourcePath, binaryPath)) {
+            std::cerr << "Game data source has errors, using existing binary" << std::endl;
+        }
+    }
+
+    std::ifstream file(binaryPath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Failed to open game data: " << binaryPath << std::endl;
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+
+    std::vector<uint64_t> buffer((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    if (!file.read(reinterpret_cast<char*>(buffer.data()), size)) {
+        std::cerr << "Failed to read game data: " << binaryPath << std::endl;
+        return false;
+    }
+
+    if (!validate(reinterpret_cast<const uint8_t*>(buffer.data()), size)) {
+        std::cerr << "Invalid game data: " << binaryPath << std::endl;
+        return false;
+    }
+
+    storage = std::move(buffer);
+    header = reinterpret_cast<const GameDataHeader*>(storage.data());
+
+    std::cout << "Game data loaded: " << header->characterCount << " characters, "
+              << header->bossCount << " bosses, " << header->attackCount << " boss attacks" << std::endl;
+    return true;
+}
+
+void GameData::unload() {
+    header = nullptr;
+    storage.clear();
+    storage.shrink_to_fit();
+}
+
+bool GameData::validate(const uint8_t* data, size_t size) {
+    if (size < sizeof(GameDataHeader)) return false;
+
+    const GameDataHeader* h = reinterpret_cast<const GameDataHeader*>(data);
+    if (h->magic != GAMEDATA_MAGIC || h->version != GAMEDATA_VERSION) return false;
+    if (h->characterCount != CHARACTER_COUNT || h->bossCount != BOSS_COUNT) return false;
+
+    auto inBounds = [size](uint32_t offset, uint32_t count, size_t recordSize) {
+        return offset % 4 == 0 && offset <= size && count <= (size - offset) / recordSize;
+    };
+    if (!inBounds(h->characterOffset, h->characterCount, sizeof(CharacterRecord)) ||
+        !inBounds(h->bossOffset, h->bossCount, sizeof(BossRecord)) ||
+        !inBounds(h->attackOffset, h->attackCount, sizeof(BossAttackRecord)) ||
+        !inBounds(h->effectOffset, h->effectCount, sizeof(EffectRecord)) ||
+        h->stringsOffset > size || h->stringsSize == 0 || h->stringsSize > size - h->stringsOffset ||
+        data[h->stringsOffset + h->stringsSize - 1] != '\0') {
+        return false;
+    }
+
+    // Check every cross reference once here so lookups can skip it
+    auto validString = [h](uint32_t offset) { return offset < h->stringsSize; };
+
+    const CharacterRecord* characters = recordsAt<CharacterRecord>(data, h->characterOffset);
+    for (uint32_t i = 0; i < h->characterCount; i++) {
+        const CharacterRecord& c = characters[i];
+        if (!validString(c.name) || !validString(c.abilityName) || !validString(c.voiceLine) ||
+            !validString(c.description) || !validString(c.activationMessage) ||
+            c.firstEffect > h->effectCount || c.effectCount > h->effectCount - c.firstEffect) {
+            return false;
+        }
+    }
+
+    const EffectRecord* effects = recordsAt<EffectRecord>(data, h->effectOffset);
+    for (uint32_t i = 0; i < h->effectCount; i++) {
+        if (static_cast<uint32_t>(effects[i].effect) >= EFFECT_KIND_COUNT) return false;
+    }
+
+    const BossRecord* bosses = recordsAt<BossRecord>(data, h->bossOffset);
+    for (uint32_t i = 0; i < h->bossCount; i++) {
+        const BossRecord& b = bosses[i];
+        if (!validString(b.name) || !validString(b.introText) ||
+            b.firstAttack > h->attackCount || b.attackCount > h->attackCount - b.firstAttack) {
+            return false;
+        }
+    }
+
+    const BossAttackRecord* attacks = recordsAt<BossAttackRecord>(data, h->attackOffset);
+    for (uint32_t i = 0; i < h->attackCount; i++) {
+        if (!validString(attacks[i].name) || !validString(attacks[i].message)) return false;
+    }
+
+    return true;
+}
+
+const CharacterRecord& GameData::getCharacter(CharacterID id) {
+    uint32_t index = static_cast<uint32_t>(id);
+    if (!header || index >= header->characterCount) return DEFAULT_CHARACTER;
+    return recordsAt<CharacterRecord>(header, header->characterOffset)[index];
+}
+
+const BossRecord& GameData::getBoss(BossType type) {
+    uint32_t index = static_cast<uint32_t>(type);
+    if (!header || index >= header->bossCount) return DEFAULT_BOSS;
+    return recordsAt<BossRecord>(header, header->bossOffset)[index];
+}
+
+const EffectRecord* GameData::getEffects(const CharacterRecord& character) {
+    if (!header) return nullptr;
+    return recordsAt<EffectRecord>(header, header->effectOffset) + character.firstEffect;
+}
+
+const BossAttackRecord* GameData::getAttacks(const BossRecord& boss) {
+    if (!header) return nullptr;
+    return recordsAt<BossAttackRecord>(header, header->attackOffset) + boss.firstAttack;
+}
+
+const char* GameData::getString(uint32_t offset) {
+    if (!header || offset >= header->stringsSize) return "";
+    return recordsAt<char>(header, header->stringsOffset + offset);
+}
+
+} // namespace BVA
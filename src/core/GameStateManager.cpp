@@ -1,6 +1,18 @@
 #include "core/GameStateManager.hpp"
 #include "core/Engine.hpp"
+#include "core/LevelStreamer.hpp"
+#include "core/ReplaySystem.hpp"
+#include "core/StateBuffer.hpp"
+#include "graphics/GraphicsEngine.hpp"
+#include "graphics/LevelGeometry.hpp"
+#include "graphics/RenderThread.hpp"
+#include "graphics/ShaderCache.hpp"
+#include "network/NetworkManager.hpp"
+#include "ui/UIManager.hpp"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <random>
 
 namespace BVA {
 
@@ -12,18 +24,88 @@ GameStateManager::~GameStateManager() {
 
 bool GameStateManager::initialize() {
     setupStoryLevels();
+
+    Engine& engine = Engine::getInstance();
+    GraphicsEngine* graphics = engine.getGraphics();
+    Ogre::SceneManager* sceneManager = graphics ? graphics->getSceneManager() : nullptr;
+
+    enemySpawner = std::make_unique<EnemySpawner>();
+    if (!enemySpawner->initialize(sceneManager, engine.getPhysics())) {
+        std::cerr << "Failed to initialize enemy spawner!" << std::endl;
+        return false;
+    }
+
+    projectiles = std::make_unique<ProjectileSystem>();
+    if (!projectiles->initialize(sceneManager)) {
+        std::cerr << "Failed to initialize projectile system!" << std::endl;
+        return false;
+    }
+
+    aiScheduler = std::make_unique<AIScheduler>();
+
+    levelStreamer = std::make_unique<LevelStreamer>(enemySpawner.get());
+    levelStreamer->setProgressCallback([this](float progress) {
+        queueUI([progress](UIManager& loading) { loading.updateLoadingProgress(progress); });
+    });
+
+    // Remote players send their tick input as [playerIndex, moveX, moveZ, buttons]
+    if (NetworkManager* network = engine.getNetwork()) {
+        network->registerPacketHandler(PacketType::PlayerMove, [this](const NetworkPacket& packet, ENetPeer*) {
+            if (packet.data.size() < 4) return;
+
+            PlayerInput input;
+            input.moveX = static_cast<int8_t>(packet.data[1]);
+            input.moveZ = static_cast<int8_t>(packet.data[2]);
+            input.buttons = packet.data[3];
+
+            int playerIndex = packet.data[0];
+            setPlayerInput(playerIndex, input);
+            if (playerIndex < MAX_PLAYERS) {
+                remoteInputs[playerIndex] = true;
+            }
+        });
+    }
+
     std::cout << "Game state manager initialized" << std::endl;
     std::cout << "  Story levels: " << storyLevels.size() << std::endl;
+
+    // Startup only loads the menu; the first level streams in behind it
+    streamLevel(0);
     return true;
 }
 
 void GameStateManager::shutdown() {
+    // Before the spawner: the streamer may still be filling its pools
+    levelStreamer.reset();
+
+    if (aiScheduler) {
+        aiScheduler->clear();
+        aiScheduler.reset();
+    }
+
     players.clear();
     enemies.clear();
     currentBoss.reset();
+
+    if (enemySpawner) {
+        enemySpawner->shutdown();
+        enemySpawner.reset();
+    }
+
+    if (projectiles) {
+        projectiles->shutdown();
+        projectiles.reset();
+    }
 }
 
 void GameStateManager::update(float dt) {
+    if (levelStreamer) {
+        // Pools grow only outside a match, so recordings replay the same spawns
+        ReplaySystem* replay = Engine::getInstance().getReplay();
+        bool recorded = replay && (replay->isRecording() || replay->isPlaying());
+        levelStreamer->update(!matchActive && !recorded);
+    }
+
     if (currentState == GameState::InGame || currentState == GameState::BossFight) {
         playTime += dt;
 
@@ -33,6 +115,12 @@ void GameStateManager::update(float dt) {
         // Update combo timer
         updateCombo(dt);
 
+        // Player input for this tick
+        applyPlayerInputs();
+
+        // Time-sliced AI decisions; characters act on them below
+        updateAI(dt);
+
         // Update players
         for (auto& player : players) {
             if (player) {
@@ -41,10 +129,8 @@ void GameStateManager::update(float dt) {
         }
 
         // Update enemies
-        for (auto& enemy : enemies) {
-            if (enemy) {
-                enemy->update(dt);
-            }
+        for (EnemyCharacter* enemy : enemies) {
+            enemy->update(dt);
         }
 
         // Update boss
@@ -52,9 +138,18 @@ void GameStateManager::update(float dt) {
             currentBoss->update(dt);
         }
 
+        // Move projectiles and resolve hits
+        updateProjectiles(dt);
+
+        // Return defeated enemies to their pools
+        reclaimDeadEnemies();
+
         // Check win/lose conditions
         checkVictoryCondition();
         checkDefeatCondition();
+
+        // Camera keeps the living players in frame
+        updateCamera();
     }
 
     if (matchActive) {
@@ -75,6 +170,7 @@ void GameStateManager::setState(GameState state) {
         matchTime = 0.0f;
     } else if (state == GameState::Victory || state == GameState::Defeat) {
         matchActive = false;
+        finishRecording();
     }
 }
 
@@ -84,9 +180,7 @@ void GameStateManager::setGameMode(GameMode mode) {
 }
 
 void GameStateManager::startStoryMode() {
-    setGameMode(GameMode::StoryMode);
-    currentLevel = 0;
-    loadLevel(0);
+    startMatch(GameMode::StoryMode, 0);
 }
 
 void GameStateManager::loadLevel(int levelIndex) {
@@ -98,8 +192,12 @@ void GameStateManager::loadLevel(int levelIndex) {
     cleanupLevel();
     currentLevel = levelIndex;
 
+    // Fill enemy pools for this level (including boss summons) before the
+    // fight starts, so mid-fight spawns never create meshes or bodies
     const LevelData& level = storyLevels[levelIndex];
+    std::vector<std::string> archetypes = getLevelArchetypes(level);
     std::cout << "Loading level: " << level.name << std::endl;
+    prepareScene(level.sceneName, archetypes, level.enemyPoolSize);
 
     // Play intro cutscene if available
     if (!level.cutsceneBefore.empty()) {
@@ -108,7 +206,13 @@ void GameStateManager::loadLevel(int levelIndex) {
         setState(GameState::InGame);
     }
 
-    // TODO: Load actual level geometry and spawn enemies
+    enemies.reserve(archetypes.size() * level.enemyPoolSize);
+
+    // Opening wave: one of each listed enemy around the arena centre
+    for (size_t i = 0; i < level.enemies.size(); i++) {
+        float angle = Ogre::Math::TWO_PI * i / level.enemies.size();
+        spawnEnemy(level.enemies[i], Ogre::Vector3(std::cos(angle) * 12.0f, 2.0f, std::sin(angle) * 12.0f));
+    }
 }
 
 void GameStateManager::completeLevel() {
@@ -116,9 +220,14 @@ void GameStateManager::completeLevel() {
 
     const LevelData& level = storyLevels[currentLevel];
 
-    // Play outro cutscene if available
+    // Usually streaming since the boss appeared
+    streamLevel(currentLevel + 1);
+
+    // Play outro cutscene if available; the next level follows it
     if (!level.cutsceneAfter.empty()) {
         playCutscene(level.cutsceneAfter);
+        advanceAfterCutscene = true;
+        return;
     }
 
     // Progress to next level
@@ -141,22 +250,44 @@ bool GameStateManager::isStoryComplete() const {
 }
 
 void GameStateManager::startVersus(bool online) {
-    setGameMode(online ? GameMode::OnlineVersus : GameMode::VersusLocal);
-    setState(GameState::InGame);
+    startMatch(online ? GameMode::OnlineVersus : GameMode::VersusLocal, 0);
     std::cout << "Starting versus mode (online: " << online << ")" << std::endl;
 }
 
 void GameStateManager::startCoop(bool online) {
-    setGameMode(online ? GameMode::OnlineCoop : GameMode::CoopLocal);
-    setState(GameState::InGame);
+    startMatch(online ? GameMode::OnlineCoop : GameMode::CoopLocal, 0);
     std::cout << "Starting co-op mode (online: " << online << ")" << std::endl;
 }
 
 void GameStateManager::endMatch() {
     matchActive = false;
+    finishRecording();
     setState(GameState::MainMenu);
 }
 
+void GameStateManager::startMatch(GameMode mode, int levelIndex) {
+    MatchSetup setup = getMatchSetup();
+    setup.mode = mode;
+    setup.levelIndex = levelIndex;
+
+    // Every match is recorded (a few KB) so it can be watched back; the
+    // recording picks the seed and begins the match
+    ReplaySystem* replay = Engine::getInstance().getReplay();
+    if (replay && !replay->isPlaying()) {
+        replay->startRecording(setup);
+    } else {
+        setup.seed = std::random_device{}();
+        beginMatch(setup);
+    }
+}
+
+void GameStateManager::finishRecording() {
+    ReplaySystem* replay = Engine::getInstance().getReplay();
+    if (replay && replay->isRecording()) {
+        replay->stopRecording(ReplaySystem::LAST_REPLAY_PATH);
+    }
+}
+
 void GameStateManager::addPlayer(CharacterID characterId, int playerIndex) {
     if (playerIndex < 0) return;
 
@@ -184,6 +315,12 @@ void GameStateManager::addPlayer(CharacterID characterId, int playerIndex) {
 void GameStateManager::removePlayer(int playerIndex) {
     if (playerIndex >= 0 && playerIndex < players.size()) {
         if (players[playerIndex]) {
+            if (projectiles) {
+                projectiles->forgetOwner(players[playerIndex].get());
+            }
+            if (aiScheduler) {
+                aiScheduler->forgetTarget(players[playerIndex].get());
+            }
             players[playerIndex]->cleanup();
             players[playerIndex].reset();
         }
@@ -198,34 +335,281 @@ Character* GameStateManager::getPlayer(int playerIndex) {
 }
 
 void GameStateManager::spawnEnemy(const std::string& enemyType, const Ogre::Vector3& position) {
-    // TODO: Create enemy based on type
-    std::cout << "Spawning enemy: " << enemyType << " at position ("
-              << position.x << ", " << position.y << ", " << position.z << ")" << std::endl;
+    EnemyCharacter* enemy = enemySpawner->spawn(enemyType, position);
+    if (!enemy) {
+        std::cerr << "Could not spawn enemy: " << enemyType << " (unknown type or pool exhausted)" << std::endl;
+        return;
+    }
+    enemies.push_back(enemy);
+    aiScheduler->registerAgent(enemy);
+}
+
+int GameStateManager::spawnWave(const std::string& enemyType, int count,
+                                const Ogre::Vector3& center, float radius) {
+    // Ring rotated per wave from the match seed, so replays spawn the same
+    size_t first = enemies.size();
+    float startAngle = randomRange(0.0f, Ogre::Math::TWO_PI);
+    int spawned = enemySpawner->spawnWave(enemyType, count, center, radius, enemies, startAngle);
+    for (size_t i = first; i < enemies.size(); i++) {
+        aiScheduler->registerAgent(enemies[i]);
+    }
+    return spawned;
 }
 
 void GameStateManager::removeEnemy(Character* enemy) {
-    auto it = std::find_if(enemies.begin(), enemies.end(),
-                            [enemy](const std::unique_ptr<Character>& e) {
-                                return e.get() == enemy;
-                            });
+    auto it = std::find(enemies.begin(), enemies.end(), enemy);
     if (it != enemies.end()) {
-        (*it)->cleanup();
-        enemies.erase(it);
+        if (projectiles) {
+            projectiles->forgetOwner(enemy);
+        }
+        aiScheduler->unregisterAgent(*it);
+        enemySpawner->despawn(*it);
+        *it = enemies.back();
+        enemies.pop_back();
+    }
+}
+
+void GameStateManager::reclaimDeadEnemies() {
+    size_t i = 0;
+    while (i < enemies.size()) {
+        if (!enemies[i]->isAlive()) {
+            removeEnemy(enemies[i]);
+        } else {
+            i++;
+        }
     }
 }
 
 void GameStateManager::spawnBoss(BossType bossType) {
+    if (!restoreBoss(bossType)) return;
+
+    currentBoss->startBattle();
+    setState(GameState::BossFight);
+    std::cout << "Boss spawned: " << currentBoss->getName() << std::endl;
+    std::cout << currentBoss->getIntroText() << std::endl;
+
+    // Last stretch of the level: the next one streams in from here
+    if (currentGameMode == GameMode::StoryMode) {
+        streamLevel(currentLevel + 1);
+    }
+}
+
+bool GameStateManager::restoreBoss(BossType bossType) {
+    if (currentBoss) {
+        aiScheduler->unregisterAgent(currentBoss.get());
+    }
+
     currentBoss = createBoss(bossType);
+    if (!currentBoss) return false;
+
+    auto* engine = &Engine::getInstance();
+    currentBoss->initialize(engine->getGraphics()->getSceneManager(), engine->getPhysics());
+    currentBoss->setPosition(Ogre::Vector3(0.0f, 2.0f, 10.0f));
+    aiScheduler->registerAgent(currentBoss.get());
+    return true;
+}
+
+MatchSetup GameStateManager::getMatchSetup() const {
+    MatchSetup setup;
+    setup.seed = matchSeed;
+    setup.mode = currentGameMode;
+    setup.levelIndex = currentLevel;
+    setup.aiBudget = aiScheduler->getBudget();
+    setup.aiMaxThinks = static_cast<uint16_t>(aiScheduler->getMaxThinksPerFrame());
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        if (i < static_cast<int>(players.size()) && players[i]) {
+            setup.characters[i] = static_cast<int8_t>(players[i]->getID());
+        }
+    }
+    return setup;
+}
+
+void GameStateManager::beginMatch(const MatchSetup& setup) {
+    cleanupLevel();
+    for (int i = 0; i < static_cast<int>(players.size()); i++) {
+        removePlayer(i);
+    }
+    players.clear();
+
+    matchSeed = setup.seed;
+    rngState = setup.seed ? setup.seed : 1;
+    playTime = 0.0f;
+    playerInputs = {};
+    prevPlayerInputs = {};
+
+    aiScheduler->setBudget(setup.aiBudget);
+    aiScheduler->setMaxThinksPerFrame(setup.aiMaxThinks);
+
+    setGameMode(setup.mode);
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        if (setup.characters[i] >= 0 && setup.characters[i] < static_cast<int>(CharacterID::Count)) {
+            addPlayer(static_cast<CharacterID>(setup.characters[i]), i);
+        }
+    }
+
+    if (setup.mode == GameMode::StoryMode) {
+        loadLevel(setup.levelIndex);
+    } else {
+        prepareScene("");
+        setState(GameState::InGame);
+    }
+}
+
+void GameStateManager::setPlayerInput(int playerIndex, const PlayerInput& input) {
+    if (playerIndex < 0 || playerIndex >= MAX_PLAYERS) return;
+    playerInputs[playerIndex] = input;
+}
+
+const PlayerInput& GameStateManager::getPlayerInput(int playerIndex) const {
+    static const PlayerInput none;
+    if (playerIndex < 0 || playerIndex >= MAX_PLAYERS) return none;
+    return playerInputs[playerIndex];
+}
+
+bool GameStateManager::isRemotePlayer(int playerIndex) const {
+    return playerIndex >= 0 && playerIndex < MAX_PLAYERS && remoteInputs[playerIndex];
+}
+
+uint32_t GameStateManager::nextRandom() {
+    // xorshift64*: tiny state, identical on every platform
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return static_cast<uint32_t>((rngState * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+float GameStateManager::randomRange(float min, float max) {
+    return min + (max - min) * (nextRandom() / 4294967296.0f);
+}
+
+int32_t GameStateManager::encodeCharacter(const Character* character) const {
+    if (!character) return -1;
+
+    for (size_t i = 0; i < players.size(); i++) {
+        if (players[i].get() == character) return static_cast<int32_t>(i);
+    }
+    if (currentBoss.get() == character) return BOSS_ID;
+
+    if (auto* enemy = dynamic_cast<const EnemyCharacter*>(character)) {
+        int id = enemySpawner->getInstanceId(enemy);
+        if (id >= 0) return ENEMY_ID_BASE + id;
+    }
+    return -1;
+}
+
+Character* GameStateManager::decodeCharacter(int32_t id) {
+    if (id < 0) return nullptr;
+    if (id < MAX_PLAYERS) return getPlayer(id);
+    if (id == BOSS_ID) return currentBoss.get();
+    if (id >= ENEMY_ID_BASE) return enemySpawner->getInstance(id - ENEMY_ID_BASE);
+    return nullptr;
+}
+
+void GameStateManager::saveState(StateBuffer& buffer) const {
+    buffer.write(currentState);
+    buffer.write(currentGameMode);
+    buffer.write(static_cast<int32_t>(currentLevel));
+    buffer.write(matchActive);
+    buffer.write(matchTime);
+    buffer.write(static_cast<int32_t>(totalScore));
+    buffer.write(playTime);
+    buffer.write(static_cast<int32_t>(comboCounter));
+    buffer.write(comboTimer);
+    buffer.write(rngState);
+    buffer.write(playerInputs);
+    buffer.write(prevPlayerInputs);
+
+    // Player slots are fixed by the match setup, only their state changes
+    buffer.write(static_cast<uint32_t>(players.size()));
+    for (const auto& player : players) {
+        buffer.write(player != nullptr);
+        if (player) {
+            player->saveState(buffer);
+        }
+    }
+
+    buffer.write(currentBoss != nullptr);
     if (currentBoss) {
-        auto* engine = &Engine::getInstance();
-        currentBoss->initialize(engine->getGraphics()->getSceneManager(),
-                                engine->getPhysics());
-        currentBoss->setPosition(Ogre::Vector3(0.0f, 2.0f, 10.0f));
-        currentBoss->startBattle();
+        buffer.write(currentBoss->getBossType());
+        currentBoss->saveState(buffer);
+    }
+
+    enemySpawner->saveState(buffer);
+    buffer.write(static_cast<uint32_t>(enemies.size()));
+    for (const EnemyCharacter* enemy : enemies) {
+        buffer.writeCharacter(enemy);
+    }
+
+    projectiles->saveState(buffer);
+    aiScheduler->saveState(buffer);
+}
+
+void GameStateManager::loadState(StateBuffer& buffer) {
+    GameState state = buffer.read<GameState>();
+    GameMode mode = buffer.read<GameMode>();
+    int level = buffer.read<int32_t>();
+
+    // Level change since the snapshot: rebuild its pools first
+    if (mode == GameMode::StoryMode && level != currentLevel) {
+        loadLevel(level);
+    }
+    currentGameMode = mode;
+    currentLevel = level;
+
+    buffer.read(matchActive);
+    buffer.read(matchTime);
+    totalScore = buffer.read<int32_t>();
+    buffer.read(playTime);
+    comboCounter = buffer.read<int32_t>();
+    buffer.read(comboTimer);
+    buffer.read(rngState);
+    buffer.read(playerInputs);
+    buffer.read(prevPlayerInputs);
+
+    // Projectiles may reference characters that are about to change
+    projectiles->clear();
+
+    uint32_t playerCount = buffer.read<uint32_t>();
+    for (uint32_t i = 0; i < playerCount; i++) {
+        bool present = buffer.read<bool>();
+        Character* player = getPlayer(i);
+        if (present && player) {
+            player->loadState(buffer);
+        } else if (present) {
+            std::cerr << "Snapshot has player " << i << " but the match does not" << std::endl;
+            return;
+        }
+    }
+
+    if (buffer.read<bool>()) {
+        BossType bossType = buffer.read<BossType>();
+        if ((!currentBoss || currentBoss->getBossType() != bossType) && !restoreBoss(bossType)) {
+            std::cerr << "Snapshot has a boss this build cannot create" << std::endl;
+            return;
+        }
+        currentBoss->loadState(buffer);
+    } else if (currentBoss) {
+        aiScheduler->unregisterAgent(currentBoss.get());
+        currentBoss.reset();
+    }
+
+    enemies.clear();
+    enemySpawner->loadState(buffer);
+    uint32_t enemyCount = buffer.read<uint32_t>();
+    for (uint32_t i = 0; i < enemyCount && !buffer.hasOverflowed(); i++) {
+        if (auto* enemy = dynamic_cast<EnemyCharacter*>(buffer.readCharacter())) {
+            enemies.push_back(enemy);
+        }
+    }
 
-        setState(GameState::BossFight);
-        std::cout << "Boss spawned: " << currentBoss->getName() << std::endl;
-        std::cout << currentBoss->getIntroText() << std::endl;
+    projectiles->loadState(buffer);
+    aiScheduler->loadState(buffer);
+
+    // Set directly; setState() would reset the match timer
+    currentState = state;
+
+    if (buffer.hasOverflowed()) {
+        std::cerr << "Snapshot ended early, state may be incomplete" << std::endl;
     }
 }
 
@@ -236,9 +620,14 @@ void GameStateManager::playCutscene(const std::string& cutsceneName) {
 }
 
 void GameStateManager::skipCutscene() {
-    if (currentState == GameState::Cutscene) {
-        setState(GameState::InGame);
+    if (currentState != GameState::Cutscene) return;
+
+    if (advanceAfterCutscene) {
+        advanceAfterCutscene = false;
+        nextLevel();
+        return;
     }
+    setState(GameState::InGame);
 }
 
 void GameStateManager::pauseGame() {
@@ -258,8 +647,12 @@ void GameStateManager::restartLevel() {
 }
 
 void GameStateManager::quitToMenu() {
+    finishRecording();
     cleanupLevel();
     setState(GameState::MainMenu);
+
+    // Back in the menu, starting story mode again should be instant too
+    streamLevel(0);
 }
 
 void GameStateManager::addScore(int points) {
@@ -279,21 +672,88 @@ void GameStateManager::resetCombo() {
 void GameStateManager::setupStoryLevels() {
     // Define all story mode levels
     storyLevels = {
-        {"The Classroom", "classroom_scene", {"Wolters", "PrefectA"}, BossType::Bastiaan, "intro", ""},
-        {"The Cafeteria", "cafeteria_scene", {"Chef", "PrefectB"}, BossType::Mees, "", ""},
-        {"The Gym", "gym_scene", {"Coach"}, BossType::HeadChef, "", ""},
-        {"The Library", "library_scene", {"Librarian"}, BossType::PrincipalVanDerBerg, "", ""},
-        {"The Janitor's Domain", "janitor_scene", {}, BossType::JanitorKing, "", ""},
-        {"Final Confrontation", "final_scene", {}, BossType::KeizerBomTaha, "", "ending"}
+        {"The Classroom", "classroom_scene", {"Wolters", "PrefectA"}, BossType::Bastiaan, "intro", "", 8},
+        {"The Cafeteria", "cafeteria_scene", {"Chef", "PrefectB"}, BossType::Mees, "", "", 8},
+        {"The Gym", "gym_scene", {"Coach"}, BossType::HeadChef, "", "", 8},
+        {"The Library", "library_scene", {"Librarian"}, BossType::PrincipalVanDerBerg, "", "", 64},
+        {"The Janitor's Domain", "janitor_scene", {}, BossType::JanitorKing, "", "", 0},
+        {"Final Confrontation", "final_scene", {}, BossType::KeizerBomTaha, "", "ending", 0}
     };
 }
 
+void GameStateManager::prepareScene(const std::string& sceneName, const std::vector<std::string>& archetypes,
+                                    int poolSize) {
+    if (!levelStreamer->isStreaming(sceneName)) {
+        levelStreamer->begin(sceneName, archetypes, poolSize);
+    }
+
+    // Whatever has not streamed in yet loads now: nothing compiles or gets
+    // created mid-match
+    if (!levelStreamer->isReady()) {
+        setState(GameState::Loading);
+        std::string title = sceneName.empty() ? "Arena" : sceneName;
+        queueUI([title](UIManager& loading) { loading.showLoadingScreen(title); });
+        // Keeps submitting frames, so the loading screen stays live
+        levelStreamer->finish();
+        queueUI([](UIManager& loading) { loading.hideLoadingScreen(); });
+    }
+
+    // Pools only grow, so this is a no-op unless the streamed level had
+    // different enemies
+    enemySpawner->prepareLevel(archetypes, poolSize);
+    levelStreamer->activate();
+}
+
+void GameStateManager::queueUI(std::function<void(UIManager&)> call) {
+    if (!ui) return;
+
+    UIManager* target = ui;
+    if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+        graphics->getFramePacket().enqueue([target, call = std::move(call)]() { call(*target); });
+    } else {
+        call(*target);
+    }
+}
+
+void GameStateManager::streamLevel(int levelIndex) {
+    if (levelIndex < 0 || levelIndex >= static_cast<int>(storyLevels.size())) return;
+
+    const LevelData& level = storyLevels[levelIndex];
+    if (!levelStreamer->isStreaming(level.sceneName)) {
+        levelStreamer->begin(level.sceneName, getLevelArchetypes(level), level.enemyPoolSize);
+    }
+}
+
+std::vector<std::string> GameStateManager::getLevelArchetypes(const LevelData& level) {
+    std::vector<std::string> archetypes = level.enemies;
+    if (const char* summon = getBossSummonArchetype(level.bossType)) {
+        archetypes.push_back(summon);
+    }
+    return archetypes;
+}
+
 void GameStateManager::cleanupLevel() {
+    if (projectiles) {
+        projectiles->clear();
+    }
+    if (aiScheduler) {
+        aiScheduler->clear();
+    }
+    if (enemySpawner) {
+        enemySpawner->despawnAll();
+    }
     enemies.clear();
     currentBoss.reset();
+    advanceAfterCutscene = false;
     totalScore = 0;
     comboCounter = 0;
     comboTimer = 0.0f;
+
+    // Back to framing the arena centre
+    cameraTargets.clear();
+    if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+        graphics->getFramePacket().setCameraTargets(cameraTargets);
+    }
 }
 
 void GameStateManager::updateCombatLogic(float dt) {
@@ -304,6 +764,79 @@ void GameStateManager::updateCombatLogic(float dt) {
     // - Award score/combo
 }
 
+void GameStateManager::updateCamera() {
+    GraphicsEngine* graphics = Engine::getInstance().getGraphics();
+    if (!graphics) return;
+
+    cameraTargets.clear();
+    for (const auto& player : players) {
+        if (player && player->isAlive()) {
+            cameraTargets.push_back(player->getPosition());
+        }
+    }
+    graphics->getFramePacket().setCameraTargets(cameraTargets);
+}
+
+void GameStateManager::updateProjectiles(float dt) {
+    if (!projectiles) return;
+
+    // Reused every tick to avoid per-frame allocation
+    projectileTargets.clear();
+    for (auto& player : players) {
+        if (player && player->isAlive()) {
+            projectileTargets.push_back(player.get());
+        }
+    }
+    for (EnemyCharacter* enemy : enemies) {
+        if (enemy->isAlive()) {
+            projectileTargets.push_back(enemy);
+        }
+    }
+    if (currentBoss && currentBoss->isAlive()) {
+        projectileTargets.push_back(currentBoss.get());
+    }
+
+    projectiles->update(dt, projectileTargets);
+}
+
+void GameStateManager::updateAI(float dt) {
+    if (!aiScheduler) return;
+
+    // Agents only target players
+    aiTargets.clear();
+    for (auto& player : players) {
+        if (player && player->isAlive()) {
+            aiTargets.push_back(player.get());
+        }
+    }
+
+    aiScheduler->update(dt, aiTargets);
+}
+
+void GameStateManager::applyPlayerInputs() {
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        const PlayerInput& input = playerInputs[i];
+        const PlayerInput& previous = prevPlayerInputs[i];
+        prevPlayerInputs[i] = input;
+
+        Character* player = getPlayer(i);
+        if (!player || !player->isAlive()) continue;
+
+        player->move(input.getMoveDirection());
+
+        // Jump and ability trigger on press, attack repeats while held
+        if (input.isDown(PlayerInput::JUMP) && !previous.isDown(PlayerInput::JUMP)) {
+            player->jump();
+        }
+        if (input.isDown(PlayerInput::ATTACK)) {
+            player->attack();
+        }
+        if (input.isDown(PlayerInput::ABILITY) && !previous.isDown(PlayerInput::ABILITY)) {
+            player->useAbility();
+        }
+    }
+}
+
 void GameStateManager::updateCombo(float dt) {
     if (comboTimer > 0.0f) {
         comboTimer -= dt;
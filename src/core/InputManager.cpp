@@ -1,8 +1,30 @@
 #include "core/InputManager.hpp"
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 
 namespace BVA {
 
+namespace {
+
+int8_t quantizeAxis(float value) {
+    float clamped = std::max(-1.0f, std::min(1.0f, value));
+    return static_cast<int8_t>(std::lround(clamped * PlayerInput::MOVE_STEPS));
+}
+
+} // namespace
+
+Ogre::Vector3 PlayerInput::getMoveDirection() const {
+    Ogre::Vector3 direction(moveX, 0.0f, moveZ);
+    direction /= static_cast<float>(MOVE_STEPS);
+
+    // Diagonals shouldn't be faster than straight movement
+    if (direction.squaredLength() > 1.0f) {
+        direction.normalise();
+    }
+    return direction;
+}
+
 InputManager::InputManager() {
     // Initialize gamepad support for up to 4 players
     gamepads.resize(4);
@@ -214,6 +236,36 @@ bool InputManager::isActionReleased(const std::string& actionName) const {
     return false;
 }
 
+PlayerInput InputManager::samplePlayerInput(int playerIndex) const {
+    PlayerInput input;
+    Ogre::Vector2 stick = getLeftStick(playerIndex);
+
+    if (playerIndex == 0) {
+        // Keyboard (through the default actions) takes priority over the stick
+        float x = 0.0f, z = 0.0f;
+        if (isActionDown("Move Left")) x -= 1.0f;
+        if (isActionDown("Move Right")) x += 1.0f;
+        if (isActionDown("Move Forward")) z -= 1.0f;
+        if (isActionDown("Move Backward")) z += 1.0f;
+        if (x != 0.0f || z != 0.0f) {
+            stick = Ogre::Vector2(x, -z);
+        }
+
+        if (isActionDown("Jump")) input.buttons |= PlayerInput::JUMP;
+        if (isActionDown("Attack")) input.buttons |= PlayerInput::ATTACK;
+        if (isActionDown("Ability")) input.buttons |= PlayerInput::ABILITY;
+    } else {
+        if (isButtonDown(GamepadButton::A, playerIndex)) input.buttons |= PlayerInput::JUMP;
+        if (isButtonDown(GamepadButton::X, playerIndex)) input.buttons |= PlayerInput::ATTACK;
+        if (isButtonDown(GamepadButton::B, playerIndex)) input.buttons |= PlayerInput::ABILITY;
+    }
+
+    // Stick up is forward (-Z)
+    input.moveX = quantizeAxis(stick.x);
+    input.moveZ = quantizeAxis(-stick.y);
+    return input;
+}
+
 bool InputManager::isGamepadConnected(int playerIndex) const {
     if (playerIndex < 0 || playerIndex >= gamepads.size()) return false;
     return gamepads[playerIndex].connected;
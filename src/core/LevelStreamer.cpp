@@ -0,0 +1,294 @@
+#include "core/LevelStreamer.hpp"
+#include "core/Engine.hpp"
+#include "core/AssetBaker.hpp"
+#include "audio/AudioEngine.hpp"
+#include "gameplay/EnemySpawner.hpp"
+#include "graphics/GraphicsEngine.hpp"
+#include "graphics/LevelGeometry.hpp"
+#include "graphics/ProceduralGenerator.hpp"
+#include "graphics/RenderThread.hpp"
+#include "graphics/ShaderCache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace BVA {
+
+LevelStreamer::LevelStreamer(EnemySpawner* enemySpawner) : spawner(enemySpawner) {}
+
+LevelStreamer::~LevelStreamer() {
+    cancel();
+}
+
+void LevelStreamer::begin(const std::string& scene, const std::vector<std::string>& enemyArchetypes,
+                          int enemyPoolSize) {
+    cancel();
+
+    Engine& engine = Engine::getInstance();
+    sceneName = scene;
+    poolSize = enemyPoolSize;
+
+    archetypes.clear();
+    int enemiesToCreate = 0;
+    for (const std::string& archetype : enemyArchetypes) {
+        if (std::find(archetypes.begin(), archetypes.end(), archetype) != archetypes.end()) continue;
+        archetypes.push_back(archetype);
+        if (spawner) {
+            enemiesToCreate += std::max(0, poolSize - spawner->getPoolSize(archetype));
+        }
+    }
+
+    // Sounds are uploaded once and kept; only the missing ones are streamed
+    sounds.clear();
+    if (AudioEngine* audio = engine.getAudio()) {
+        for (const std::string& name : ProceduralAudioGenerator::getBakedSoundNames()) {
+            if (!audio->hasSound(name)) {
+                sounds.push_back(name);
+            }
+        }
+    }
+
+    // Fetching, geometry and shaders count one unit each
+    totalUnits = 3 + static_cast<int>(sounds.size()) + enemiesToCreate;
+    doneUnits = 0;
+
+    // Waiting on the baker is the only part that may take seconds (first
+    // launch); nothing in it touches Ogre, OpenAL or the physics world
+    stage = Stage::Fetching;
+    fetched = false;
+    const AssetBaker* assets = engine.getAssets();
+    worker = std::thread([this, scene, names = sounds, assets]() {
+        LevelGeometry::prefetch(scene);
+        if (assets) {
+            for (const std::string& name : names) {
+                assets->get(name);
+            }
+        }
+        fetched = true;
+    });
+
+    std::cout << "Streaming level: " << (scene.empty() ? "arena" : scene) << std::endl;
+}
+
+void LevelStreamer::cancel() {
+    if (stage == Stage::Idle) return;
+
+    joinWorker();
+
+    // Waits for a step still queued with the frame packet and drops the
+    // geometry nobody is going to show
+    if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+        graphics->runOnRenderThread([graphics]() {
+            if (LevelGeometry* level = graphics->getLevelGeometry()) {
+                level->discardPrepared();
+            }
+        });
+    }
+    renderQueued = false;
+    slicesStarted = false;
+
+    // Enemies already created stay in their pools
+    stage = Stage::Idle;
+    sceneName.clear();
+    archetypes.clear();
+    sounds.clear();
+    totalUnits = 0;
+    doneUnits = 0;
+}
+
+void LevelStreamer::update(bool growPools) {
+    poolsAllowed = growPools;
+    if (stage != Stage::Idle && stage != Stage::Ready) {
+        step(false);
+    }
+}
+
+void LevelStreamer::finish() {
+    GraphicsEngine* graphics = Engine::getInstance().getGraphics();
+    auto previous = std::chrono::steady_clock::now();
+
+    // Called at a fixed point of the simulation (level load), so the pools
+    // grow here even mid-match
+    poolsAllowed = true;
+
+    while (stage != Stage::Idle && stage != Stage::Ready) {
+        if (!graphics) {
+            step(true);
+            continue;
+        }
+
+        // Same steps as in the background, with a frame after each. Pool
+        // growth only queues render work, so it runs in one go.
+        step(stage == Stage::EnemyPools);
+        auto now = std::chrono::steady_clock::now();
+        std::chrono::duration<float> elapsed = now - previous;
+        previous = now;
+        graphics->submitFrame(elapsed.count());
+    }
+}
+
+void LevelStreamer::activate() {
+    if (stage == Stage::Idle) return;
+    finish();
+
+    if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+        graphics->runOnRenderThread([graphics, scene = sceneName]() {
+            graphics->activateLevelResources(scene);
+            graphics->getLevelGeometry()->activate();
+        });
+    }
+
+    stage = Stage::Idle;
+    sceneName.clear();
+    archetypes.clear();
+}
+
+bool LevelStreamer::isStreaming(const std::string& scene) const {
+    return stage != Stage::Idle && sceneName == scene;
+}
+
+float LevelStreamer::getProgress() const {
+    if (stage == Stage::Ready) return 1.0f;
+    return totalUnits > 0 ? static_cast<float>(doneUnits) / totalUnits : 0.0f;
+}
+
+void LevelStreamer::step(bool blocking) {
+    Engine& engine = Engine::getInstance();
+    GraphicsEngine* graphics = engine.getGraphics();
+
+    switch (stage) {
+        case Stage::Fetching:
+            if (!fetched && !blocking) return;
+            joinWorker();
+            completeUnits(1);
+            stage = Stage::Geometry;
+            break;
+
+        case Stage::Geometry:
+            if (!graphics || runRenderSlices(
+                    [graphics, scene = sceneName]() {
+                        graphics->prepareLevelResources(scene);
+                        graphics->getLevelGeometry()->beginPrepare(scene);
+                    },
+                    [graphics]() { return graphics->getLevelGeometry()->continuePrepare(PROPS_PER_SLICE); },
+                    blocking)) {
+                completeUnits(1);
+                stage = Stage::Shaders;
+            }
+            break;
+
+        case Stage::Shaders:
+            // After the geometry, so the level's materials exist
+            if (!graphics || runRenderSlices(
+                    [graphics]() {
+                        if (ShaderCache* shaders = graphics->getShaderCache()) {
+                            shaders->beginWarmup();
+                        }
+                    },
+                    [graphics]() {
+                        ShaderCache* shaders = graphics->getShaderCache();
+                        return !shaders || shaders->continueWarmup(MATERIALS_PER_SLICE);
+                    },
+                    blocking)) {
+                completeUnits(1);
+                stage = Stage::Sounds;
+            }
+            break;
+
+        case Stage::Sounds: {
+            const AssetBaker* assets = engine.getAssets();
+            AudioEngine* audio = engine.getAudio();
+            if (sounds.empty() || !assets || !audio) {
+                completeUnits(static_cast<int>(sounds.size()));
+                sounds.clear();
+                stage = Stage::EnemyPools;
+                break;
+            }
+
+            // One buffer upload per update
+            ProceduralAudioGenerator::loadBakedSound(*assets, *audio, sounds.back());
+            sounds.pop_back();
+            completeUnits(1);
+            break;
+        }
+
+        case Stage::EnemyPools:
+            if (!poolsAllowed && !blocking) return;
+
+            // A few instances per update, one archetype at a time
+            for (const std::string& archetype : archetypes) {
+                int size = spawner ? spawner->getPoolSize(archetype) : poolSize;
+                if (size >= poolSize) continue;
+
+                int target = blocking ? poolSize : std::min(poolSize, size + ENEMIES_PER_UPDATE);
+                spawner->prepareLevel({archetype}, target);
+                completeUnits(spawner->getPoolSize(archetype) - size);
+                if (!blocking) return;
+            }
+            // Pools grown elsewhere meanwhile leave units that never complete
+            completeUnits(totalUnits - doneUnits);
+            stage = Stage::Ready;
+            std::cout << "Level streamed: " << (sceneName.empty() ? "arena" : sceneName) << std::endl;
+            break;
+
+        case Stage::Idle:
+        case Stage::Ready:
+            break;
+    }
+}
+
+bool LevelStreamer::runRenderSlices(std::function<void()> start, std::function<bool()> slice, bool blocking) {
+    GraphicsEngine* graphics = Engine::getInstance().getGraphics();
+
+    if (renderQueued) {
+        if (!renderDone) {
+            if (!blocking) return false;
+            graphics->runOnRenderThread([]() {});  // Everything queued before it has run
+        }
+        renderQueued = false;
+        if (renderFinished) {
+            slicesStarted = false;
+            return true;
+        }
+    }
+
+    bool first = !slicesStarted;
+    slicesStarted = true;
+
+    if (blocking) {
+        graphics->runOnRenderThread([&]() {
+            if (first) start();
+            while (!slice()) {
+            }
+        });
+        slicesStarted = false;
+        return true;
+    }
+
+    // Runs with the next frame the simulation submits
+    renderDone = false;
+    renderQueued = true;
+    graphics->getFramePacket().enqueue([this, first, start = std::move(start), slice = std::move(slice)]() {
+        if (first) start();
+        renderFinished = slice();
+        renderDone = true;
+    });
+    return false;
+}
+
+void LevelStreamer::completeUnits(int units) {
+    if (units <= 0) return;
+
+    doneUnits = std::min(totalUnits, doneUnits + units);
+    if (onProgress) {
+        onProgress(getProgress());
+    }
+}
+
+void LevelStreamer::joinWorker() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+} // namespace BVA
@@ -0,0 +1,487 @@
+#include "core/ReplaySystem.hpp"
+#include "core/Engine.hpp"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+namespace BVA {
+
+namespace {
+
+constexpr char REPLAY_MAGIC[4] = {'B', 'V', 'A', 'R'};
+constexpr uint16_t REPLAY_VERSION = 2;
+constexpr char KEYFRAME_MAGIC[4] = {'B', 'V', 'A', 'K'};
+constexpr uint16_t KEYFRAME_VERSION = 1;
+
+void writeBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+void writeVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+struct Reader {
+    const std::vector<uint8_t>& data;
+    size_t offset = 0;
+    bool failed = false;
+
+    bool readBytes(void* out, size_t size) {
+        if (offset + size > data.size()) {
+            failed = true;
+            return false;
+        }
+        std::memcpy(out, data.data() + offset, size);
+        offset += size;
+        return true;
+    }
+
+    uint32_t readVarint() {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t byte = 0;
+            if (!readBytes(&byte, 1)) return 0;
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        failed = true;
+        return 0;
+    }
+
+    bool atEnd() const { return offset >= data.size(); }
+};
+
+} // namespace
+
+ReplaySystem::ReplaySystem() {}
+
+ReplaySystem::~ReplaySystem() {}
+
+void ReplaySystem::startRecording() {
+    if (GameStateManager* gameState = Engine::getInstance().getGameState()) {
+        startRecording(gameState->getMatchSetup());
+    }
+}
+
+void ReplaySystem::startRecording(const MatchSetup& matchSetup) {
+    GameStateManager* gameState = Engine::getInstance().getGameState();
+    if (!gameState || mode == Mode::Playback) return;
+
+    setup = matchSetup;
+    setup.seed = std::random_device{}();
+
+    changes.clear();
+    currentInputs = {};
+    tickCount = 0;
+    keyframes.clear();
+    recordedPath.clear();
+
+    gameState->beginMatch(setup);
+
+    mode = Mode::Recording;
+    std::cout << "Replay recording started (seed " << setup.seed << ")" << std::endl;
+}
+
+void ReplaySystem::recordTick(const std::array<PlayerInput, GameStateManager::MAX_PLAYERS>& inputs) {
+    if (mode != Mode::Recording) return;
+
+    // Same point in the tick as playback takes them: before this tick's
+    // input changes are applied and it is simulated
+    if (tickCount % KEYFRAME_INTERVAL == 0) {
+        captureKeyframe(tickCount, changes.size());
+    }
+
+    for (int i = 0; i < GameStateManager::MAX_PLAYERS; i++) {
+        if (inputs[i] != currentInputs[i]) {
+            changes.push_back({tickCount, static_cast<uint8_t>(i), inputs[i]});
+            currentInputs[i] = inputs[i];
+        }
+    }
+    tickCount++;
+}
+
+bool ReplaySystem::stopRecording(const std::string& path) {
+    if (mode != Mode::Recording) return false;
+    mode = Mode::Idle;
+
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    if (!save(path)) {
+        keyframes.clear();
+        return false;
+    }
+    recordedPath = path;
+    if (!saveKeyframes(keyframePath(path))) {
+        std::cerr << "Replay keyframes not saved; seeking will rebuild them" << std::endl;
+    }
+    std::cout << "Replay saved: " << path << " (" << tickCount << " ticks, "
+              << changes.size() << " input changes)" << std::endl;
+    return true;
+}
+
+bool ReplaySystem::startPlayback(const std::string& path) {
+    GameStateManager* gameState = Engine::getInstance().getGameState();
+    if (!gameState || mode == Mode::Recording) return false;
+    if (!load(path)) return false;
+
+    gameState->beginMatch(setup);
+
+    currentInputs = {};
+    currentTick = 0;
+    changeCursor = 0;
+    playbackAccumulator = 0.0f;
+    playbackPaused = false;
+
+    // The match just recorded already has keyframes across its whole length;
+    // other replays bring theirs from disk
+    if (path != recordedPath || keyframes.empty()) {
+        keyframes.clear();
+        recordedPath.clear();
+        captureKeyframe(currentTick, changeCursor);
+        if (!loadKeyframes(keyframePath(path))) {
+            std::cout << "Replay keyframes unavailable; built as playback runs" << std::endl;
+        }
+    }
+
+    mode = Mode::Playback;
+    std::cout << "Replay playback: " << path << " (" << tickCount << " ticks)" << std::endl;
+    return true;
+}
+
+void ReplaySystem::updatePlayback(float dt) {
+    if (mode != Mode::Playback || playbackPaused) return;
+
+    playbackAccumulator += dt * playbackSpeed;
+    const float tickTime = 1.0f / TICK_RATE;
+
+    int ticks = 0;
+    while (playbackAccumulator >= tickTime && currentTick < tickCount && ticks < MAX_TICKS_PER_UPDATE) {
+        stepPlayback();
+        playbackAccumulator -= tickTime;
+        ticks++;
+    }
+
+    // Don't bank time we couldn't simulate
+    if (ticks == MAX_TICKS_PER_UPDATE || currentTick >= tickCount) {
+        playbackAccumulator = 0.0f;
+    }
+}
+
+void ReplaySystem::handlePlaybackControls(const InputManager& input) {
+    if (mode != Mode::Playback) return;
+
+    if (input.isKeyPressed(KeyCode::Escape)) {
+        stopPlayback();
+        return;
+    }
+    if (input.isKeyPressed(KeyCode::Space)) {
+        playbackPaused = !playbackPaused;
+    }
+    if (input.isKeyPressed(KeyCode::Right)) {
+        seek(currentTick + SEEK_STEP);
+    }
+    if (input.isKeyPressed(KeyCode::Left)) {
+        seek(currentTick > SEEK_STEP ? currentTick - SEEK_STEP : 0);
+    }
+    if (input.isKeyPressed(KeyCode::Up)) {
+        playbackSpeed = std::min(playbackSpeed * 2.0f, 8.0f);
+    }
+    if (input.isKeyPressed(KeyCode::Down)) {
+        playbackSpeed = std::max(playbackSpeed * 0.5f, 0.25f);
+    }
+}
+
+void ReplaySystem::seek(uint32_t tick) {
+    if (mode != Mode::Playback) return;
+    tick = std::min(tick, tickCount);
+
+    // Latest keyframe at or before the target; only restore when it beats
+    // simulating forward from where we are
+    const Keyframe* best = nullptr;
+    for (const Keyframe& keyframe : keyframes) {
+        if (keyframe.tick <= tick && (!best || keyframe.tick > best->tick)) {
+            best = &keyframe;
+        }
+    }
+    if (best && (tick < currentTick || best->tick > currentTick)) {
+        restoreKeyframe(*best);
+    }
+
+    while (currentTick < tick) {
+        stepPlayback();
+    }
+    playbackAccumulator = 0.0f;
+}
+
+void ReplaySystem::stopPlayback() {
+    if (mode != Mode::Playback) return;
+    mode = Mode::Idle;
+
+    if (GameStateManager* gameState = Engine::getInstance().getGameState()) {
+        gameState->quitToMenu();
+    }
+}
+
+void ReplaySystem::stepPlayback() {
+    Engine& engine = Engine::getInstance();
+    GameStateManager* gameState = engine.getGameState();
+
+    while (changeCursor < changes.size() && changes[changeCursor].tick == currentTick) {
+        const InputChange& change = changes[changeCursor++];
+        currentInputs[change.playerIndex] = change.input;
+    }
+    for (int i = 0; i < GameStateManager::MAX_PLAYERS; i++) {
+        gameState->setPlayerInput(i, currentInputs[i]);
+    }
+
+    engine.simulateTick(1.0f / TICK_RATE);
+    currentTick++;
+
+    if (currentTick % KEYFRAME_INTERVAL == 0) {
+        captureKeyframe(currentTick, changeCursor);
+    }
+}
+
+void ReplaySystem::captureKeyframe(uint32_t tick, size_t cursor) {
+    for (const Keyframe& keyframe : keyframes) {
+        if (keyframe.tick == tick) return;
+    }
+
+    GameStateManager* gameState = Engine::getInstance().getGameState();
+    Keyframe keyframe{tick, cursor, currentInputs, StateBuffer(gameState)};
+    gameState->saveState(keyframe.state);
+
+    // Kept sorted; seeking backwards can revisit ticks out of order
+    auto it = std::upper_bound(keyframes.begin(), keyframes.end(), tick,
+                               [](uint32_t t, const Keyframe& k) { return t < k.tick; });
+    keyframes.insert(it, std::move(keyframe));
+}
+
+void ReplaySystem::restoreKeyframe(const Keyframe& keyframe) {
+    GameStateManager* gameState = Engine::getInstance().getGameState();
+
+    StateBuffer state = keyframe.state;
+    state.rewind();
+    gameState->loadState(state);
+
+    currentTick = keyframe.tick;
+    changeCursor = keyframe.changeCursor;
+    currentInputs = keyframe.inputs;
+}
+
+// File layout: header, then per tick with changes a varint tick delta,
+// a player mask and the changed inputs. A few KB for a full match.
+bool ReplaySystem::save(const std::string& path) const {
+    std::vector<uint8_t> out;
+    writeBytes(out, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    writeBytes(out, &REPLAY_VERSION, sizeof(REPLAY_VERSION));
+    uint16_t tickRate = TICK_RATE;
+    writeBytes(out, &tickRate, sizeof(tickRate));
+    writeBytes(out, &setup.seed, sizeof(setup.seed));
+    uint8_t gameMode = static_cast<uint8_t>(setup.mode);
+    writeBytes(out, &gameMode, sizeof(gameMode));
+    writeBytes(out, &setup.levelIndex, sizeof(setup.levelIndex));
+    writeBytes(out, setup.characters, sizeof(setup.characters));
+    writeBytes(out, &setup.aiBudget, sizeof(setup.aiBudget));
+    writeBytes(out, &setup.aiMaxThinks, sizeof(setup.aiMaxThinks));
+    writeBytes(out, &tickCount, sizeof(tickCount));
+
+    uint32_t lastTick = 0;
+    size_t i = 0;
+    while (i < changes.size()) {
+        uint32_t tick = changes[i].tick;
+        writeVarint(out, tick - lastTick);
+        lastTick = tick;
+
+        size_t end = i;
+        uint8_t mask = 0;
+        while (end < changes.size() && changes[end].tick == tick) {
+            mask |= 1 << changes[end].playerIndex;
+            end++;
+        }
+        out.push_back(mask);
+
+        // Changes within a tick are recorded in player order
+        for (; i < end; i++) {
+            const PlayerInput& input = changes[i].input;
+            out.push_back(static_cast<uint8_t>(input.moveX));
+            out.push_back(static_cast<uint8_t>(input.moveZ));
+            out.push_back(input.buttons);
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(out.data()), out.size())) {
+        std::cerr << "Failed to write replay: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ReplaySystem::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open replay: " << path << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader reader{data};
+    char magic[4] = {};
+    uint16_t version = 0, tickRate = 0;
+    uint8_t gameMode = 0;
+    MatchSetup loaded;
+    uint32_t loadedTickCount = 0;
+
+    reader.readBytes(magic, sizeof(magic));
+    reader.readBytes(&version, sizeof(version));
+    reader.readBytes(&tickRate, sizeof(tickRate));
+    reader.readBytes(&loaded.seed, sizeof(loaded.seed));
+    reader.readBytes(&gameMode, sizeof(gameMode));
+    reader.readBytes(&loaded.levelIndex, sizeof(loaded.levelIndex));
+    reader.readBytes(loaded.characters, sizeof(loaded.characters));
+    reader.readBytes(&loaded.aiBudget, sizeof(loaded.aiBudget));
+    reader.readBytes(&loaded.aiMaxThinks, sizeof(loaded.aiMaxThinks));
+    reader.readBytes(&loadedTickCount, sizeof(loadedTickCount));
+
+    if (reader.failed || std::memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0 ||
+        version != REPLAY_VERSION || tickRate != TICK_RATE) {
+        std::cerr << "Invalid or incompatible replay: " << path << std::endl;
+        return false;
+    }
+    loaded.mode = static_cast<GameMode>(gameMode);
+
+    std::vector<InputChange> loadedChanges;
+    uint32_t tick = 0;
+    while (!reader.atEnd() && !reader.failed) {
+        tick += reader.readVarint();
+        uint8_t mask = 0;
+        reader.readBytes(&mask, 1);
+
+        for (int player = 0; player < GameStateManager::MAX_PLAYERS; player++) {
+            if (!(mask & (1 << player))) continue;
+
+            uint8_t bytes[3] = {};
+            reader.readBytes(bytes, sizeof(bytes));
+            PlayerInput input;
+            input.moveX = static_cast<int8_t>(bytes[0]);
+            input.moveZ = static_cast<int8_t>(bytes[1]);
+            input.buttons = bytes[2];
+            loadedChanges.push_back({tick, static_cast<uint8_t>(player), input});
+        }
+    }
+
+    if (reader.failed) {
+        std::cerr << "Truncated replay: " << path << std::endl;
+        return false;
+    }
+
+    setup = loaded;
+    changes = std::move(loadedChanges);
+    tickCount = loadedTickCount;
+    return true;
+}
+
+// Keyframe file: header tying it to the replay, then per keyframe its
+// tick, input cursor, held inputs and raw snapshot
+bool ReplaySystem::saveKeyframes(const std::string& path) const {
+    std::vector<uint8_t> out;
+    writeBytes(out, KEYFRAME_MAGIC, sizeof(KEYFRAME_MAGIC));
+    writeBytes(out, &KEYFRAME_VERSION, sizeof(KEYFRAME_VERSION));
+    writeBytes(out, &setup.seed, sizeof(setup.seed));
+    writeBytes(out, &tickCount, sizeof(tickCount));
+    uint32_t count = static_cast<uint32_t>(keyframes.size());
+    writeBytes(out, &count, sizeof(count));
+
+    for (const Keyframe& keyframe : keyframes) {
+        uint32_t cursor = static_cast<uint32_t>(keyframe.changeCursor);
+        writeBytes(out, &keyframe.tick, sizeof(keyframe.tick));
+        writeBytes(out, &cursor, sizeof(cursor));
+        for (const PlayerInput& input : keyframe.inputs) {
+            out.push_back(static_cast<uint8_t>(input.moveX));
+            out.push_back(static_cast<uint8_t>(input.moveZ));
+            out.push_back(input.buttons);
+        }
+        const std::vector<uint8_t>& state = keyframe.state.getData();
+        uint32_t size = static_cast<uint32_t>(state.size());
+        writeBytes(out, &size, sizeof(size));
+        writeBytes(out, state.data(), state.size());
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    return static_cast<bool>(file.write(reinterpret_cast<const char*>(out.data()), out.size()));
+}
+
+bool ReplaySystem::loadKeyframes(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file || keyframes.empty()) return false;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader reader{data};
+    char magic[4] = {};
+    uint16_t version = 0;
+    uint32_t seed = 0, ticks = 0, count = 0;
+    reader.readBytes(magic, sizeof(magic));
+    reader.readBytes(&version, sizeof(version));
+    reader.readBytes(&seed, sizeof(seed));
+    reader.readBytes(&ticks, sizeof(ticks));
+    reader.readBytes(&count, sizeof(count));
+    if (reader.failed || std::memcmp(magic, KEYFRAME_MAGIC, sizeof(magic)) != 0 ||
+        version != KEYFRAME_VERSION || seed != setup.seed || ticks != tickCount) {
+        return false;
+    }
+
+    GameStateManager* gameState = Engine::getInstance().getGameState();
+    std::vector<Keyframe> loaded;
+    for (uint32_t i = 0; i < count && !reader.failed; i++) {
+        Keyframe keyframe{0, 0, {}, StateBuffer(gameState)};
+        uint32_t cursor = 0;
+        reader.readBytes(&keyframe.tick, sizeof(keyframe.tick));
+        reader.readBytes(&cursor, sizeof(cursor));
+        keyframe.changeCursor = cursor;
+        for (PlayerInput& input : keyframe.inputs) {
+            uint8_t bytes[3] = {};
+            reader.readBytes(bytes, sizeof(bytes));
+            input.moveX = static_cast<int8_t>(bytes[0]);
+            input.moveZ = static_cast<int8_t>(bytes[1]);
+            input.buttons = bytes[2];
+        }
+
+        uint32_t size = 0;
+        reader.readBytes(&size, sizeof(size));
+        std::vector<uint8_t> state(size);
+        reader.readBytes(state.data(), state.size());
+        keyframe.state.assign(std::move(state));
+
+        if (keyframe.tick > tickCount || keyframe.changeCursor > changes.size()) {
+            reader.failed = true;
+        }
+        loaded.push_back(std::move(keyframe));
+    }
+
+    // Snapshots are raw; a file from another build (or a diverging
+    // simulation) shows up as a different opening snapshot
+    if (reader.failed || loaded.empty() || loaded.front().tick != 0 ||
+        loaded.front().state.getData() != keyframes.front().state.getData()) {
+        return false;
+    }
+
+    keyframes = std::move(loaded);
+    std::cout << "Replay keyframes: " << keyframes.size() << " loaded" << std::endl;
+    return true;
+}
+
+} // namespace BVA
@@ -0,0 +1,17 @@
+#include "core/StateBuffer.hpp"
+#include "core/GameStateManager.hpp"
+
+namespace BVA {
+
+void StateBuffer::writeCharacter(const Character* character) {
+    int32_t id = (characters && character) ? characters->encodeCharacter(character) : -1;
+    write(id);
+}
+
+Character* StateBuffer::readCharacter() {
+    int32_t id = read<int32_t>();
+    if (id < 0 || !characters) return nullptr;
+    return characters->decodeCharacter(id);
+}
+
+} // namespace BVA
@@ -0,0 +1,177 @@
+#include "gameplay/AIScheduler.hpp"
+#include "gameplay/Character.hpp"
+#include "core/StateBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace BVA {
+
+// ===== AIWorldSnapshot =====
+
+void AIWorldSnapshot::build(const std::vector<Character*>& targets) {
+    characters.clear();
+    posX.clear();
+    posY.clear();
+    posZ.clear();
+
+    for (Character* target : targets) {
+        if (!target || !target->isAlive()) continue;
+
+        Ogre::Vector3 p = target->getPosition();
+        characters.push_back(target);
+        posX.push_back(p.x);
+        posY.push_back(p.y);
+        posZ.push_back(p.z);
+    }
+}
+
+Character* AIWorldSnapshot::findNearest(const Ogre::Vector3& position, float maxDistance,
+                                        float* outDistance) const {
+    Character* nearest = nullptr;
+    float bestDistSq = maxDistance * maxDistance;
+
+    for (size_t i = 0; i < characters.size(); i++) {
+        float dx = posX[i] - position.x;
+        float dy = posY[i] - position.y;
+        float dz = posZ[i] - position.z;
+        float distSq = dx * dx + dy * dy + dz * dz;
+        if (distSq < bestDistSq) {
+            bestDistSq = distSq;
+            nearest = characters[i];
+        }
+    }
+
+    if (outDistance) {
+        *outDistance = nearest ? std::sqrt(bestDistSq) : maxDistance;
+    }
+    return nearest;
+}
+
+int AIWorldSnapshot::countWithin(const Ogre::Vector3& position, float radius) const {
+    float radiusSq = radius * radius;
+    int count = 0;
+
+    for (size_t i = 0; i < characters.size(); i++) {
+        float dx = posX[i] - position.x;
+        float dy = posY[i] - position.y;
+        float dz = posZ[i] - position.z;
+        if (dx * dx + dy * dy + dz * dz <= radiusSq) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool AIWorldSnapshot::contains(const Character* target) const {
+    return std::find(characters.begin(), characters.end(), target) != characters.end();
+}
+
+Ogre::Vector3 AIWorldSnapshot::getPosition(const Character* target) const {
+    auto it = std::find(characters.begin(), characters.end(), target);
+    if (it == characters.end()) {
+        return Ogre::Vector3::ZERO;
+    }
+    size_t i = it - characters.begin();
+    return Ogre::Vector3(posX[i], posY[i], posZ[i]);
+}
+
+// ===== AIScheduler =====
+
+AIScheduler::AIScheduler() {}
+
+void AIScheduler::update(float dt, const std::vector<Character*>& targets) {
+    world.build(targets);
+
+    for (auto& slot : agents) {
+        slot.sinceLastThink += dt;
+    }
+
+    lastThinkCount = 0;
+    lastThinkMicroseconds = 0.0f;
+    if (agents.empty()) return;
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto start = Clock::now();
+
+    // Resume where last frame stopped so every agent gets its turn
+    size_t thinks = 0;
+    size_t maxThinks = std::min(agents.size(), maxThinksPerFrame);
+    float spent = 0.0f;
+    while (thinks < maxThinks) {
+        if (cursor >= agents.size()) {
+            cursor = 0;
+        }
+
+        AgentSlot& slot = agents[cursor];
+        slot.agent->think(world, slot.sinceLastThink);
+        slot.sinceLastThink = 0.0f;
+        spent += slot.agent->estimateThinkCost(world);
+        cursor++;
+        thinks++;
+
+        if (spent >= budgetMicroseconds) {
+            break;
+        }
+    }
+
+    lastThinkCount = thinks;
+    std::chrono::duration<float, std::micro> elapsed = Clock::now() - start;
+    lastThinkMicroseconds = elapsed.count();
+}
+
+void AIScheduler::registerAgent(AIAgent* agent) {
+    for (const auto& slot : agents) {
+        if (slot.agent == agent) return;
+    }
+    // New agents think on their first frame
+    agents.insert(agents.begin() + std::min(cursor, agents.size()), {agent, 0.0f});
+}
+
+void AIScheduler::unregisterAgent(AIAgent* agent) {
+    for (size_t i = 0; i < agents.size(); i++) {
+        if (agents[i].agent == agent) {
+            agents.erase(agents.begin() + i);
+            if (cursor > i) {
+                cursor--;
+            }
+            return;
+        }
+    }
+}
+
+void AIScheduler::forgetTarget(Character* target) {
+    for (auto& slot : agents) {
+        slot.agent->forgetTarget(target);
+    }
+}
+
+void AIScheduler::saveState(StateBuffer& buffer) const {
+    buffer.write(static_cast<uint32_t>(agents.size()));
+    for (const auto& slot : agents) {
+        buffer.writeCharacter(dynamic_cast<const Character*>(slot.agent));
+        buffer.write(slot.sinceLastThink);
+    }
+    buffer.write(static_cast<uint32_t>(cursor));
+}
+
+void AIScheduler::loadState(StateBuffer& buffer) {
+    agents.clear();
+    uint32_t count = buffer.read<uint32_t>();
+    for (uint32_t i = 0; i < count && !buffer.hasOverflowed(); i++) {
+        AIAgent* agent = dynamic_cast<AIAgent*>(buffer.readCharacter());
+        float sinceLastThink = buffer.read<float>();
+        if (agent) {
+            agents.push_back({agent, sinceLastThink});
+        }
+    }
+    cursor = std::min<size_t>(buffer.read<uint32_t>(), agents.size());
+    lastThinkCount = 0;
+}
+
+void AIScheduler::clear() {
+    agents.clear();
+    cursor = 0;
+    lastThinkCount = 0;
+}
+
+} // namespace BVA
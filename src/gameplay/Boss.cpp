@@ -1,11 +1,43 @@
 #include "gameplay/Boss.hpp"
 #include "core/Engine.hpp"
+#include "core/GameStateManager.hpp"
+#include "core/StateBuffer.hpp"
+#include "graphics/GraphicsEngine.hpp"
+#include "graphics/RenderThread.hpp"
 #include <iostream>
+#include <algorithm>
 
 namespace BVA {
 
-Boss::Boss(BossType type) : Character(CharacterID::Bas), bossType(type) {
-    // Boss-specific initialization
+namespace {
+
+// Horizontal aim direction from boss to target
+Ogre::Vector3 aimAt(Boss* boss, Character* target) {
+    Ogre::Vector3 dir = target->getPosition() - boss->getPosition();
+    dir.y = 0.0f;
+    return dir.isZeroLength() ? boss->getFacing() : dir.normalisedCopy();
+}
+
+void shakeCamera(float trauma, float duration) {
+    if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+        graphics->getFramePacket().addCameraShake(trauma, duration);
+    }
+}
+
+} // namespace
+
+Boss::Boss(BossType type)
+    : Character(CharacterID::Bas), bossType(type), bossDefinition(&GameData::getBoss(type)) {
+    name = GameData::getString(bossDefinition->name);
+    stats = bossDefinition->stats;
+    currentHealth = stats.maxHealth;
+    phase2HealthPercent = bossDefinition->phase2HealthPercent;
+    phase3HealthPercent = bossDefinition->phase3HealthPercent;
+
+    attacks = GameData::getAttacks(*bossDefinition);
+    attackCount = bossDefinition->attackCount;
+
+    hostile = true;
 }
 
 void Boss::update(float dt) {
@@ -29,9 +61,10 @@ void Boss::update(float dt) {
     // Update attack windup
     if (attackWindup > 0.0f) {
         attackWindup -= dt;
-        if (attackWindup <= 0.0f && currentAttack) {
-            executeAttack(*currentAttack);
-            currentAttack = nullptr;
+        if (attackWindup <= 0.0f && currentAttackIndex >= 0) {
+            executeAttack(attacks[currentAttackIndex]);
+            lastAttackIndex = currentAttackIndex;
+            currentAttackIndex = -1;
         }
     }
 
@@ -53,39 +86,197 @@ void Boss::takeDamage(float damage, Character* attacker) {
         transitionToPhase(BossPhase::Phase3);
     }
 
-    targetPlayer = attacker;
+    // Aggro onto whoever hit us (damage over time has no attacker)
+    if (attacker && !attacker->isHostile()) {
+        targetPlayer = attacker;
+    }
 }
 
 void Boss::startBattle() {
     inIntro = true;
     introTimer = 0.0f;
     playIntro();
+    shakeCamera(0.6f, 1.2f);
 }
 
 void Boss::updateAI(float dt) {
-    // Base AI: attack when cooldown is ready
-    if (attackCooldown <= 0.0f && !currentAttack && !availableAttacks.empty()) {
+    // Acts on the last decision from think(); the scoring itself runs in
+    // AIScheduler time slices, not every tick
+
+    // Rooted while winding up an attack
+    if (currentAttackIndex >= 0) {
+        move(Ogre::Vector3::ZERO);
+        return;
+    }
+
+    if (attackCooldown <= 0.0f && plannedAttackIndex >= 0) {
+        move(Ogre::Vector3::ZERO);
         selectNextAttack();
+        return;
+    }
+
+    if (approachTarget && targetPlayer && targetPlayer->isAlive()) {
+        Ogre::Vector3 toTarget = targetPlayer->getPosition() - getPosition();
+        toTarget.y = 0.0f;
+        move(toTarget.normalisedCopy());
+    } else {
+        move(Ogre::Vector3::ZERO);
     }
 }
 
 void Boss::selectNextAttack() {
-    if (availableAttacks.empty()) return;
+    if (plannedAttackIndex < 0 || plannedAttackIndex >= static_cast<int>(attackCount)) {
+        return;
+    }
+
+    currentAttackIndex = plannedAttackIndex;
+    plannedAttackIndex = -1;
 
-    // Simple random selection
-    int attackIndex = rand() % availableAttacks.size();
-    currentAttack = &availableAttacks[attackIndex];
-    attackWindup = currentAttack->windupTime;
-    attackCooldown = currentAttack->cooldown;
+    const BossAttackRecord& attack = attacks[currentAttackIndex];
+    attackWindup = attack.windupTime;
+    attackCooldown = attack.cooldown;
 
-    std::cout << name << " prepares " << currentAttack->name << "!" << std::endl;
+    // Stretched so the windup pose peaks as the attack lands
+    if (attack.windupTime > 0.0f) {
+        playAnimation(AnimationClipId::Windup, false, attack.windupTime);
+    }
+
+    std::cout << name << " prepares " << GameData::getString(attack.name) << "!" << std::endl;
 }
 
-void Boss::executeAttack(const BossAttack& attack) {
-    std::cout << name << " uses " << attack.name << "!" << std::endl;
+void Boss::think(const AIWorldSnapshot& world, float elapsed) {
+    if (inIntro || !isAlive()) return;
 
-    if (attack.executeFunc) {
-        attack.executeFunc(this, targetPlayer);
+    Ogre::Vector3 position = getPosition();
+
+    // Keep the current target while it's alive, otherwise take the nearest
+    if (!targetPlayer || !world.contains(targetPlayer)) {
+        targetPlayer = world.findNearest(position, AGGRO_RANGE);
+    }
+
+    plannedAttackIndex = -1;
+    approachTarget = false;
+    if (!targetPlayer) return;
+
+    targetDistance = position.distance(world.getPosition(targetPlayer));
+
+    // A little jitter keeps the pattern from being learnable; drawn from
+    // the match RNG so replays choose the same attacks
+    GameStateManager* gameState = Engine::getInstance().getGameState();
+    float bestScore = 0.0f;
+    for (uint32_t i = 0; i < attackCount; i++) {
+        float score = scoreAttack(i, world, position);
+        if (gameState) {
+            score *= gameState->randomRange(0.85f, 1.15f);
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            plannedAttackIndex = static_cast<int>(i);
+        }
+    }
+
+    // Nothing reaches the target: close the distance
+    approachTarget = plannedAttackIndex < 0;
+}
+
+float Boss::estimateThinkCost(const AIWorldSnapshot& world) const {
+    // A target scan plus scoring every attack against the targets in range
+    return 2.0f + 0.05f * world.size() + attackCount * (0.5f + 0.1f * world.size());
+}
+
+void Boss::forgetTarget(Character* target) {
+    if (targetPlayer == target) {
+        targetPlayer = nullptr;
+        plannedAttackIndex = -1;
+    }
+}
+
+void Boss::saveState(StateBuffer& buffer) const {
+    Character::saveState(buffer);
+
+    buffer.write(currentPhase);
+    buffer.write(hasEnteredPhase2);
+    buffer.write(hasEnteredPhase3);
+    buffer.write(inIntro);
+    buffer.write(introTimer);
+    buffer.write(attackCooldown);
+    buffer.write(attackWindup);
+    buffer.write(currentAttackIndex);
+    buffer.write(plannedAttackIndex);
+    buffer.write(lastAttackIndex);
+    buffer.write(approachTarget);
+    buffer.write(targetDistance);
+    buffer.writeCharacter(targetPlayer);
+}
+
+void Boss::loadState(StateBuffer& buffer) {
+    Character::loadState(buffer);
+
+    buffer.read(currentPhase);
+    buffer.read(hasEnteredPhase2);
+    buffer.read(hasEnteredPhase3);
+    buffer.read(inIntro);
+    buffer.read(introTimer);
+    buffer.read(attackCooldown);
+    buffer.read(attackWindup);
+    buffer.read(currentAttackIndex);
+    buffer.read(plannedAttackIndex);
+    buffer.read(lastAttackIndex);
+    buffer.read(approachTarget);
+    buffer.read(targetDistance);
+    targetPlayer = buffer.readCharacter();
+}
+
+float Boss::scoreAttack(size_t index, const AIWorldSnapshot& world,
+                        const Ogre::Vector3& position) const {
+    const BossAttackRecord& attack = attacks[index];
+    if (targetDistance > attack.range) return 0.0f;
+
+    // Base utility: damage per second of cooldown
+    float score = attack.damage / std::max(attack.cooldown, 0.1f);
+
+    // AOE attacks are worth more the more players they catch
+    if (attack.isAOE()) {
+        int caught = world.countWithin(position, attack.range);
+        score *= 1.0f + 0.5f * std::max(0, caught - 1);
+    }
+
+    // Projectiles prefer range, melee prefers being close
+    float rangeFraction = targetDistance / std::max(attack.range, 0.1f);
+    score *= attack.isProjectile() ? (0.75f + 0.5f * rangeFraction)
+                                 : (1.25f - 0.5f * rangeFraction);
+
+    // Early phases favour quick attacks; later phases commit to heavy windups
+    float windupPenalty = (currentPhase == BossPhase::Phase1) ? 0.5f : 0.2f;
+    score /= 1.0f + attack.windupTime * windupPenalty;
+
+    // Avoid repeating the same attack
+    if (static_cast<int>(index) == lastAttackIndex && attackCount > 1) {
+        score *= 0.6f;
+    }
+
+    return score;
+}
+
+void Boss::executeAttack(const BossAttackRecord& attack) {
+    std::cout << name << " uses " << GameData::getString(attack.name) << "!" << std::endl;
+    playAnimation(AnimationClipId::Attack);
+
+    const char* message = GameData::getString(attack.message);
+    if (*message) {
+        std::cout << message << std::endl;
+    }
+
+    if (!targetPlayer) return;
+
+    if (attack.isProjectile()) {
+        launchProjectiles(aimAt(this, targetPlayer), attack.projectile, attack.damage);
+    } else {
+        targetPlayer->takeDamage(attack.damage, this);
+        shakeCamera(0.35f, 0.4f);
+        if (attack.slowDuration > 0.0f) {
+            targetPlayer->applySpeedBoost(attack.slowMultiplier, attack.slowDuration);
+        }
     }
 }
 
@@ -96,66 +287,20 @@ void Boss::onPhaseChange(BossPhase newPhase) {
 void Boss::playIntro() {
     std::cout << "\n=== BOSS BATTLE ===" << std::endl;
     std::cout << name << std::endl;
-    std::cout << introText << std::endl;
+    std::cout << getIntroText() << std::endl;
     std::cout << "===================" << std::endl;
 }
 
-void Boss::addAttack(const BossAttack& attack) {
-    availableAttacks.push_back(attack);
-}
-
 void Boss::transitionToPhase(BossPhase phase) {
     currentPhase = phase;
     onPhaseChange(phase);
+    shakeCamera(0.5f, 0.8f);
 }
 
 // ===== Boss Implementations =====
 
 // Bastiaan - The Artist
-BastiaanBoss::BastiaanBoss() : Boss(BossType::Bastiaan) {
-    name = "Bastiaan";
-    introText = "You dare interrupt my artistic vision? Prepare to become part of my masterpiece!";
-
-    stats.maxHealth = 800.0f;
-    stats.moveSpeed = 4.0f;
-    stats.attackDamage = 15.0f;
-    stats.defense = 5.0f;
-    currentHealth = stats.maxHealth;
-
-    // Paint Splash Attack
-    addAttack({
-        "Paint Splash",
-        20.0f,
-        8.0f,
-        3.0f,
-        0.5f,
-        true,
-        false,
-        [](Boss* boss, Character* target) {
-            if (target) {
-                target->takeDamage(20.0f, boss);
-                std::cout << "Bastiaan splashes paint everywhere!" << std::endl;
-            }
-        }
-    });
-
-    // Canvas Throw
-    addAttack({
-        "Canvas Throw",
-        30.0f,
-        15.0f,
-        4.0f,
-        1.0f,
-        false,
-        true,
-        [](Boss* boss, Character* target) {
-            if (target) {
-                target->takeDamage(30.0f, boss);
-                std::cout << "Bastiaan hurls a heavy canvas!" << std::endl;
-            }
-        }
-    });
-}
+BastiaanBoss::BastiaanBoss() : Boss(BossType::Bastiaan) {}
 
 void BastiaanBoss::updateAI(float dt) {
     Boss::updateAI(dt);
@@ -171,50 +316,7 @@ void BastiaanBoss::onPhaseChange(BossPhase newPhase) {
 }
 
 // Keizer Bom Taha Boss Version
-KeizerBomTahaBoss::KeizerBomTahaBoss() : Boss(BossType::KeizerBomTaha) {
-    name = "Keizer Bom Taha";
-    introText = "I am the supreme military commander! You will fall before my aerial bombardment!";
-
-    stats.maxHealth = 900.0f;
-    stats.moveSpeed = 4.5f;
-    stats.attackDamage = 18.0f;
-    stats.defense = 8.0f;
-    currentHealth = stats.maxHealth;
-
-    // Bomb Drop
-    addAttack({
-        "Aerial Bombardment",
-        40.0f,
-        12.0f,
-        5.0f,
-        2.0f,
-        true,
-        false,
-        [](Boss* boss, Character* target) {
-            std::cout << "Bombs rain from above!" << std::endl;
-            if (target) {
-                target->takeDamage(40.0f, boss);
-            }
-        }
-    });
-
-    // Ground Pound
-    addAttack({
-        "Ground Pound",
-        25.0f,
-        8.0f,
-        3.5f,
-        0.8f,
-        true,
-        false,
-        [](Boss* boss, Character* target) {
-            std::cout << "Keizer Bom Taha slams the ground!" << std::endl;
-            if (target) {
-                target->takeDamage(25.0f, boss);
-            }
-        }
-    });
-}
+KeizerBomTahaBoss::KeizerBomTahaBoss() : Boss(BossType::KeizerBomTaha) {}
 
 void KeizerBomTahaBoss::updateAI(float dt) {
     Boss::updateAI(dt);
@@ -231,90 +333,15 @@ void KeizerBomTahaBoss::onPhaseChange(BossPhase newPhase) {
 }
 
 // Mees - Pita Sirracha Thrower
-MeesBoss::MeesBoss() : Boss(BossType::Mees) {
-    name = "Mees";
-    introText = "You want some pita? Here, have ALL the pitas!";
-
-    stats.maxHealth = 750.0f;
-    stats.moveSpeed = 5.0f;
-    stats.attackDamage = 12.0f;
-    stats.defense = 3.0f;
-    currentHealth = stats.maxHealth;
-
-    // Pita Throw
-    addAttack({
-        "Pita Sirracha Barrage",
-        15.0f,
-        20.0f,
-        2.0f,
-        0.3f,
-        false,
-        true,
-        [](Boss* boss, Character* target) {
-            std::cout << "Mees throws burning hot pitas!" << std::endl;
-            if (target) {
-                target->takeDamage(15.0f, boss);
-                target->applyFireDamage(3.0f, 4.0f);
-            }
-        }
-    });
-}
+MeesBoss::MeesBoss() : Boss(BossType::Mees) {}
 
 void MeesBoss::updateAI(float dt) {
     Boss::updateAI(dt);
     // Mees is aggressive and fast
 }
 
-void MeesBoss::throwPitaSirracha() {
-    std::cout << "Pita incoming!" << std::endl;
-}
-
 // Principal Van Der Berg - 3-Phase Authority Figure
-PrincipalVanDerBergBoss::PrincipalVanDerBergBoss() : Boss(BossType::PrincipalVanDerBerg) {
-    name = "Principal Van Der Berg";
-    introText = "Students! You will respect my AUTHORITY!";
-
-    stats.maxHealth = 1200.0f;
-    stats.moveSpeed = 3.5f;
-    stats.attackDamage = 20.0f;
-    stats.defense = 10.0f;
-    currentHealth = stats.maxHealth;
-
-    // Authority Shout
-    addAttack({
-        "Authority Shout",
-        25.0f,
-        15.0f,
-        4.0f,
-        1.0f,
-        true,
-        false,
-        [](Boss* boss, Character* target) {
-            std::cout << "SILENCE! You will obey!" << std::endl;
-            if (target) {
-                target->takeDamage(25.0f, boss);
-                target->applySpeedBoost(0.5f, 3.0f); // Slow debuff
-            }
-        }
-    });
-
-    // Ruler Smack
-    addAttack({
-        "Ruler Smack",
-        35.0f,
-        5.0f,
-        3.0f,
-        0.5f,
-        false,
-        false,
-        [](Boss* boss, Character* target) {
-            std::cout << "Principal Van Der Berg swings his massive ruler!" << std::endl;
-            if (target) {
-                target->takeDamage(35.0f, boss);
-            }
-        }
-    });
-}
+PrincipalVanDerBergBoss::PrincipalVanDerBergBoss() : Boss(BossType::PrincipalVanDerBerg) {}
 
 void PrincipalVanDerBergBoss::updateAI(float dt) {
     Boss::updateAI(dt);
@@ -339,59 +366,33 @@ void PrincipalVanDerBergBoss::onPhaseChange(BossPhase newPhase) {
     }
 }
 
-void PrincipalVanDerBergBoss::summonPrefects() {
-    std::cout << "Principal Van Der Berg summons prefects!" << std::endl;
-    prefectsSummoned++;
-    // TODO: Spawn actual prefect enemies
+void PrincipalVanDerBergBoss::saveState(StateBuffer& buffer) const {
+    Boss::saveState(buffer);
+    buffer.write(prefectsSummoned);
+    buffer.write(authorityMeter);
 }
 
-// Janitor King - Master of Mop Combat
-JanitorKingBoss::JanitorKingBoss() : Boss(BossType::JanitorKing) {
-    name = "The Janitor King";
-    introText = "You kids made a mess... and now I'll clean YOU up!";
-
-    stats.maxHealth = 1500.0f;
-    stats.moveSpeed = 4.0f;
-    stats.attackDamage = 22.0f;
-    stats.defense = 12.0f;
-    currentHealth = stats.maxHealth;
+void PrincipalVanDerBergBoss::loadState(StateBuffer& buffer) {
+    Boss::loadState(buffer);
+    buffer.read(prefectsSummoned);
+    buffer.read(authorityMeter);
+}
 
-    // Mop Swing
-    addAttack({
-        "Mop Whirlwind",
-        30.0f,
-        10.0f,
-        3.5f,
-        0.8f,
-        true,
-        false,
-        [](Boss* boss, Character* target) {
-            std::cout << "The Janitor King spins his legendary mop!" << std::endl;
-            if (target) {
-                target->takeDamage(30.0f, boss);
-            }
-        }
-    });
-
-    // Wet Floor
-    addAttack({
-        "Slippery Floor",
-        10.0f,
-        20.0f,
-        6.0f,
-        1.5f,
-        true,
-        false,
-        [](Boss* boss, Character* target) {
-            std::cout << "Watch out! The floor is wet!" << std::endl;
-            if (target) {
-                target->takeDamage(10.0f, boss);
-                target->applySpeedBoost(0.3f, 5.0f); // Major slow
-            }
-        }
-    });
+void PrincipalVanDerBergBoss::summonPrefects() {
+    GameStateManager* gameState = Engine::getInstance().getGameState();
+    if (!gameState) return;
+
+    // Waves grow with each phase; instances come from the level's prefect pool
+    int waveSize = 8 * (static_cast<int>(currentPhase) + 1);
+    int spawned = gameState->spawnWave(getBossSummonArchetype(bossType), waveSize, getPosition(), 6.0f);
+    prefectsSummoned += spawned;
+
+    std::cout << "Principal Van Der Berg summons " << spawned << " prefects!" << std::endl;
 }
 
+// Janitor King - Master of Mop Combat
+JanitorKingBoss::JanitorKingBoss() : Boss(BossType::JanitorKing) {}
+
 void JanitorKingBoss::updateAI(float dt) {
     Boss::updateAI(dt);
 }
@@ -408,6 +409,22 @@ void JanitorKingBoss::onPhaseChange(BossPhase newPhase) {
     }
 }
 
+void JanitorKingBoss::saveState(StateBuffer& buffer) const {
+    Boss::saveState(buffer);
+    buffer.write(static_cast<uint32_t>(slipperyZones.size()));
+    for (const auto& zone : slipperyZones) {
+        buffer.write(zone.ptr(), 3);
+    }
+}
+
+void JanitorKingBoss::loadState(StateBuffer& buffer) {
+    Boss::loadState(buffer);
+    slipperyZones.resize(buffer.read<uint32_t>());
+    for (auto& zone : slipperyZones) {
+        buffer.read(zone.ptr(), 3);
+    }
+}
+
 void JanitorKingBoss::createSlipperyFloor() {
     std::cout << "The entire floor becomes dangerously slippery!" << std::endl;
     // TODO: Create actual slippery zones
@@ -415,51 +432,7 @@ void JanitorKingBoss::createSlipperyFloor() {
 }
 
 // Head Chef Ramsey - Culinary Combat Expert
-HeadChefBoss::HeadChefBoss() : Boss(BossType::HeadChef) {
-    name = "Head Chef Ramsey";
-    introText = "This cafeteria is MY KITCHEN! And you're BURNT!";
-
-    stats.maxHealth = 1000.0f;
-    stats.moveSpeed = 5.0f;
-    stats.attackDamage = 18.0f;
-    stats.defense = 6.0f;
-    currentHealth = stats.maxHealth;
-
-    // Pan Throw
-    addAttack({
-        "Burning Pan",
-        28.0f,
-        12.0f,
-        2.5f,
-        0.4f,
-        false,
-        true,
-        [](Boss* boss, Character* target) {
-            std::cout << "Chef Ramsey throws a red-hot frying pan!" << std::endl;
-            if (target) {
-                target->takeDamage(28.0f, boss);
-                target->applyFireDamage(5.0f, 3.0f);
-            }
-        }
-    });
-
-    // Food Barrage
-    addAttack({
-        "IT'S RAW!",
-        20.0f,
-        15.0f,
-        3.0f,
-        0.6f,
-        true,
-        false,
-        [](Boss* boss, Character* target) {
-            std::cout << "WHERE'S THE LAMB SAUCE?!" << std::endl;
-            if (target) {
-                target->takeDamage(20.0f, boss);
-            }
-        }
-    });
-}
+HeadChefBoss::HeadChefBoss() : Boss(BossType::HeadChef) {}
 
 void HeadChefBoss::updateAI(float dt) {
     Boss::updateAI(dt);
@@ -481,8 +454,31 @@ void HeadChefBoss::onPhaseChange(BossPhase newPhase) {
     }
 }
 
+void HeadChefBoss::saveState(StateBuffer& buffer) const {
+    Boss::saveState(buffer);
+    buffer.write(inRageMode);
+}
+
+void HeadChefBoss::loadState(StateBuffer& buffer) {
+    Boss::loadState(buffer);
+    buffer.read(inRageMode);
+}
+
 void HeadChefBoss::throwFood() {
     std::cout << "Chef throws various kitchen items!" << std::endl;
+
+    ProjectileDesc food;
+    food.speed = 12.0f;
+    food.damage = 8.0f;
+    food.lifetime = 4.0f;
+    food.color = Ogre::ColourValue(0.6f, 0.9f, 0.3f);
+
+    // Full ring of food, denser in rage mode
+    int count = inRageMode ? 48 : 24;
+    for (int i = 0; i < count; i++) {
+        Ogre::Radian angle(Ogre::Math::TWO_PI * i / count);
+        launchProjectile(Ogre::Vector3(Ogre::Math::Cos(angle), 0.0f, Ogre::Math::Sin(angle)), food);
+    }
 }
 
 // Boss Factory
@@ -505,4 +501,13 @@ std::unique_ptr<Boss> createBoss(BossType type) {
     }
 }
 
+const char* getBossSummonArchetype(BossType type) {
+    switch (type) {
+        case BossType::PrincipalVanDerBerg:
+            return "PrefectA";
+        default:
+            return nullptr;
+    }
+}
+
 } // namespace BVA
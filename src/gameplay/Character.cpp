@@ -13,13 +13,53 @@
 #include "gameplay/Character.hpp"
 #include "gameplay/Characters.hpp"
 #include "core/Engine.hpp"
-#include "graphics/ProceduralGenerator.hpp"
+#include "core/GameStateManager.hpp"
+#include "graphics/GraphicsEngine.hpp"
+#include "graphics/CharacterInstancer.hpp"
+#include "graphics/AnimationSystem.hpp"
+#include "graphics/ParticleManager.hpp"
+#include "graphics/RenderThread.hpp"
+#include "core/StateBuffer.hpp"
 #include <iostream>
 
 namespace BVA {
 
-Character::Character(CharacterID id) : id(id), currentHealth(100.0f) {
-    // Base initialization
+namespace {
+
+// Destroying scene objects has to finish on the render thread before the
+// simulation carries on
+void runOnRenderThread(std::function<void()> task) {
+    if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+        graphics->runOnRenderThread(std::move(task));
+    } else {
+        task();
+    }
+}
+
+// Everything else rides along in the frame packet
+void queueRenderCommand(std::function<void()> command) {
+    if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+        graphics->getFramePacket().enqueue(std::move(command));
+    } else {
+        command();
+    }
+}
+
+void queueNodePosition(Ogre::SceneNode* node, const Ogre::Vector3& position) {
+    if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+        graphics->getFramePacket().setPosition(node, position);
+    } else {
+        node->setPosition(position);
+    }
+}
+
+} // namespace
+
+Character::Character(CharacterID id)
+    : id(id), definition(&GameData::getCharacter(id)) {
+    name = GameData::getString(definition->name);
+    stats = definition->stats;
+    currentHealth = stats.maxHealth;
 }
 
 Character::~Character() {
@@ -27,11 +67,47 @@ Character::~Character() {
 }
 
 void Character::initialize(Ogre::SceneManager* sceneManager, PhysicsEngine* physics) {
-    // Create scene node
-    sceneNode = sceneManager->getRootSceneNode()->createChildSceneNode();
+    // Created with the next frame rather than waited for, so filling enemy
+    // pools never stalls the simulation; commands queued after this one see
+    // the objects, positions switch over once renderReady is set
+    renderQueued = true;
+    queueRenderCommand([this, sceneManager] {
+        // Create scene node
+        sceneNode = sceneManager->getRootSceneNode()->createChildSceneNode();
+
+        // Drawn through the shared instanced humanoid mesh (no external files
+        // needed); the mesh is pre-shaded for a 1.2x body colour tint
+        GraphicsEngine* graphics = Engine::getInstance().getGraphics();
+        if (AnimationSystem* animations = graphics ? graphics->getAnimations() : nullptr) {
+            animationInstance = animations->addInstance();
+        }
+        if (CharacterInstancer* instancer = graphics ? graphics->getCharacterInstancer() : nullptr) {
+            renderInstance = instancer->addInstance(getRenderGroup(), sceneNode, getBodyColor() * 1.2f,
+                                                    animationInstance);
+        }
+        renderReady = true;
+    });
 
+    currentAnimation = AnimationClipId::Count;
+    animationLock = 0.0f;
+    playAnimation(AnimationClipId::Idle, true);
+
+    // Create physics body
+    btCollisionShape* shape = physics->createCapsuleShape(0.5f, 1.0f);
+    btTransform transform;
+    transform.setIdentity();
+    transform.setOrigin(btVector3(0, 1, 0));
+    physicsBody = physics->createRigidBody(70.0f, transform, shape);
+    physicsBody->setUserData(this);
+
+    // Disable rotation on physics body
+    physicsBody->getRigidBody()->setAngularFactor(btVector3(0, 0, 0));
+
+    currentHealth = stats.maxHealth;
+}
+
+Ogre::ColourValue Character::getBodyColor() const {
     // Generate unique color for this character based on ID
-    Ogre::ColourValue characterColor;
     int colorIndex = static_cast<int>(id) % 13;
     float hue = (colorIndex / 13.0f) * 360.0f;
 
@@ -49,41 +125,47 @@ void Character::initialize(Ogre::SceneManager* sceneManager, PhysicsEngine* phys
     else if (h < 5.0f) { r = x; g = 0; b = c; }
     else { r = c; g = 0; b = x; }
 
-    characterColor = Ogre::ColourValue(r * v, g * v, b * v);
-
-    // Create procedural character mesh (no external files needed - Apache License approved!)
-    std::string meshName = "Character_" + name + "_" + std::to_string((size_t)this);
-    Ogre::ManualObject* characterMesh = ProceduralMeshGenerator::createCharacterMesh(meshName, characterColor);
-    sceneNode->attachObject(characterMesh);
-
-    // Create physics body
-    btCollisionShape* shape = physics->createCapsuleShape(0.5f, 1.0f);
-    btTransform transform;
-    transform.setIdentity();
-    transform.setOrigin(btVector3(0, 1, 0));
-    physicsBody = physics->createRigidBody(70.0f, transform, shape);
-    physicsBody->setUserData(this);
-
-    // Disable rotation on physics body
-    physicsBody->getRigidBody()->setAngularFactor(btVector3(0, 0, 0));
-
-    currentHealth = stats.maxHealth;
+    return Ogre::ColourValue(r * v, g * v, b * v);
 }
 
 void Character::cleanup() {
-    if (abilityParticles) {
-        abilityParticles->removeAllEmitters();
-        abilityParticles = nullptr;
-    }
-
-    if (entity && sceneNode) {
-        sceneNode->detachObject(entity);
+    // Also flushes a creation command still waiting in the frame packet
+    if (renderQueued) {
+        runOnRenderThread([this] {
+            if (abilityParticles) {
+                abilityParticles->removeAllEmitters();
+            }
+
+            if (entity && sceneNode) {
+                sceneNode->detachObject(entity);
+            }
+
+            if (renderInstance >= 0) {
+                GraphicsEngine* graphics = Engine::getInstance().getGraphics();
+                if (CharacterInstancer* instancer = graphics ? graphics->getCharacterInstancer() : nullptr) {
+                    instancer->removeInstance(renderInstance);
+                }
+            }
+
+            if (animationInstance >= 0) {
+                GraphicsEngine* graphics = Engine::getInstance().getGraphics();
+                if (AnimationSystem* animations = graphics ? graphics->getAnimations() : nullptr) {
+                    animations->removeInstance(animationInstance);
+                }
+            }
+
+            abilityParticles = nullptr;
+            renderInstance = -1;
+            animationInstance = -1;
+            entity = nullptr;
+            sceneNode = nullptr;
+        });
     }
+    renderQueued = false;
+    renderReady = false;
 
     // Physics body cleanup handled by PhysicsEngine
     physicsBody = nullptr;
-    entity = nullptr;
-    sceneNode = nullptr;
 }
 
 void Character::update(float dt) {
@@ -126,9 +208,18 @@ void Character::update(float dt) {
     }
 
     // Sync graphics with physics
-    if (physicsBody && sceneNode) {
+    if (physicsBody) {
         btVector3 pos = physicsBody->getPosition();
-        sceneNode->setPosition(Ogre::Vector3(pos.x(), pos.y(), pos.z()));
+        queuePosition(Ogre::Vector3(pos.x(), pos.y(), pos.z()));
+    }
+
+    // Locomotion once any one-shot clip has played out
+    if (animationLock > 0.0f) {
+        animationLock -= dt;
+    } else if (isAlive() && physicsBody) {
+        btVector3 velocity = physicsBody->getVelocity();
+        float speedSq = velocity.x() * velocity.x() + velocity.z() * velocity.z();
+        playAnimation(speedSq > 0.25f ? AnimationClipId::Run : AnimationClipId::Idle, true);
     }
 }
 
@@ -139,6 +230,11 @@ void Character::render() {
 void Character::move(const Ogre::Vector3& direction) {
     if (!physicsBody) return;
 
+    Ogre::Vector3 flat(direction.x, 0.0f, direction.z);
+    if (flat.squaredLength() > 0.0001f) {
+        facing = flat.normalisedCopy();
+    }
+
     float speed = stats.moveSpeed * speedMultiplier;
     btVector3 velocity(direction.x * speed, physicsBody->getVelocity().y(), direction.z * speed);
     physicsBody->setVelocity(velocity);
@@ -152,12 +248,43 @@ void Character::jump() {
     isJumping = true;
 }
 
+void Character::setVisible(bool visible) {
+    if (!renderQueued) return;
+
+    // Render objects are read on the render thread, after their creation
+    queueRenderCommand([this, visible] {
+        if (sceneNode) {
+            sceneNode->setVisible(visible);
+        }
+
+        GraphicsEngine* graphics = Engine::getInstance().getGraphics();
+        CharacterInstancer* instancer = graphics ? graphics->getCharacterInstancer() : nullptr;
+        if (instancer && renderInstance >= 0) {
+            instancer->setInstanceVisible(renderInstance, visible);
+        }
+    });
+}
+
 void Character::setPosition(const Ogre::Vector3& pos) {
     if (physicsBody) {
         physicsBody->setPosition(btVector3(pos.x, pos.y, pos.z));
     }
-    if (sceneNode) {
-        sceneNode->setPosition(pos);
+    queuePosition(pos);
+}
+
+void Character::queuePosition(const Ogre::Vector3& pos) {
+    if (renderReady) {
+        if (sceneNode) {
+            queueNodePosition(sceneNode, pos);
+        }
+    } else if (renderQueued) {
+        // Positions apply before commands, so until the node exists it is
+        // moved by a command queued behind its creation
+        queueRenderCommand([this, pos] {
+            if (sceneNode) {
+                sceneNode->setPosition(pos);
+            }
+        });
     }
 }
 
@@ -188,26 +315,34 @@ void Character::useAbility() {
     if (!canUseAbility() || isUsingAbility) return;
 
     isUsingAbility = true;
-    abilityCooldownTimer = ability.cooldown;
-    abilityActiveTimer = ability.duration;
+    abilityCooldownTimer = definition->abilityCooldown;
+    abilityActiveTimer = definition->abilityDuration;
 
     // Play voice line
-    playVoiceLine(ability.voiceLine);
+    playVoiceLine(GameData::getString(definition->voiceLine));
 
     // Trigger ability effect
+    playAnimation(AnimationClipId::Ability);
     onAbilityActivated();
 
-    std::cout << name << " uses " << ability.name << "!" << std::endl;
+    std::cout << name << " uses " << GameData::getString(definition->abilityName) << "!" << std::endl;
 }
 
 void Character::takeDamage(float damage, Character* attacker) {
+    bool wasAlive = isAlive();
     float actualDamage = std::max(0.0f, damage - stats.defense);
     currentHealth -= actualDamage;
 
     if (currentHealth <= 0.0f) {
         currentHealth = 0.0f;
         // Handle death
+        if (wasAlive) {
+            playAnimation(AnimationClipId::Death);
+        }
         std::cout << name << " has been defeated!" << std::endl;
+    } else if (actualDamage > 0.0f && animationLock <= 0.0f) {
+        // Flinch, unless that would cut an attack or ability short
+        playAnimation(AnimationClipId::Hit);
     }
 }
 
@@ -235,45 +370,180 @@ void Character::applyFireDamage(float dps, float duration) {
     fireDamageTimer = duration;
 }
 
+bool Character::launchProjectile(const Ogre::Vector3& direction, const ProjectileDesc& desc) {
+    GameStateManager* gameState = Engine::getInstance().getGameState();
+    if (!gameState || !gameState->getProjectiles()) return false;
+
+    // Spawn just outside our own capsule, roughly at chest height
+    Ogre::Vector3 dir = direction.normalisedCopy();
+    Ogre::Vector3 origin = getPosition() + Ogre::Vector3(0.0f, 0.5f, 0.0f) +
+                           dir * (ProjectileSystem::CAPSULE_RADIUS + desc.radius + 0.1f);
+
+    return gameState->getProjectiles()->spawn(this, getProjectileTeam(this), origin, dir, desc);
+}
+
+int Character::launchProjectiles(const Ogre::Vector3& direction, const ProjectileRecord& record, float damage) {
+    ProjectileDesc desc = makeProjectileDesc(record, damage);
+
+    Ogre::Vector3 aim = direction + Ogre::Vector3(0.0f, record.loft, 0.0f);
+    float firstAngle = -0.5f * record.spreadDegrees * (record.count - 1);
+
+    int launched = 0;
+    for (uint32_t i = 0; i < record.count; i++) {
+        Ogre::Quaternion spread(Ogre::Degree(firstAngle + record.spreadDegrees * i), Ogre::Vector3::UNIT_Y);
+        if (launchProjectile(spread * aim, desc)) {
+            launched++;
+        }
+    }
+    return launched;
+}
+
 float Character::getAbilityCooldownPercent() const {
-    if (ability.cooldown <= 0.0f) return 1.0f;
-    return 1.0f - (abilityCooldownTimer / ability.cooldown);
+    if (definition->abilityCooldown <= 0.0f) return 1.0f;
+    return 1.0f - (abilityCooldownTimer / definition->abilityCooldown);
 }
 
 void Character::onAbilityActivated() {
-    // Override in subclasses
+    const EffectRecord* effects = GameData::getEffects(*definition);
+
+    for (uint32_t i = 0; i < definition->effectCount; i++) {
+        const EffectRecord& effect = effects[i];
+        float duration = effect.param > 0.0f ? effect.param : definition->abilityDuration;
+
+        switch (effect.effect) {
+            case AbilityEffect::DamageBoost:
+                applyDamageBoost(effect.value, duration);
+                break;
+            case AbilityEffect::SpeedBoost:
+                applySpeedBoost(effect.value, duration);
+                break;
+            case AbilityEffect::HealthBoost:
+                heal(effect.value);
+                break;
+            case AbilityEffect::SplashDamage:
+                applySplashDamage(effect.value, effect.param);
+                break;
+            case AbilityEffect::FireDamage:
+                applyFireDamage(effect.value, duration);
+                break;
+            case AbilityEffect::Projectile:
+                launchProjectiles(getFacing(), definition->projectile, effect.value);
+                break;
+            default:
+                // PlaneSummon etc. are driven by the character subclass
+                break;
+        }
+    }
+
+    // The character's ability effect (Bas's shockwave goes through the
+    // particle simulator); particles belong to the render thread
+    const char* characterName = name;
+    Ogre::Vector3 position = getPosition();
+    queueRenderCommand([characterName, position] {
+        GraphicsEngine* graphics = Engine::getInstance().getGraphics();
+        if (ParticleManager* particles = graphics ? graphics->getParticles() : nullptr) {
+            particles->playAbilityEffect(characterName, position);
+        }
+    });
+
+    const char* message = GameData::getString(definition->activationMessage);
+    if (*message) {
+        std::cout << message << std::endl;
+    }
 }
 
 void Character::updateAbility(float dt) {
     // Override in subclasses
 }
 
-void Character::playVoiceLine(const std::string& line) {
+void Character::saveState(StateBuffer& buffer) const {
+    Ogre::Vector3 position = getPosition();
+    btVector3 velocity = physicsBody ? physicsBody->getVelocity() : btVector3(0, 0, 0);
+
+    buffer.write(position.ptr(), 3);
+    buffer.write(velocity.x());
+    buffer.write(velocity.y());
+    buffer.write(velocity.z());
+    buffer.write(facing.ptr(), 3);
+    buffer.write(stats);
+    buffer.write(currentHealth);
+    buffer.write(isJumping);
+    buffer.write(isUsingAbility);
+    buffer.write(attackCooldownTimer);
+    buffer.write(abilityCooldownTimer);
+    buffer.write(abilityActiveTimer);
+    buffer.write(damageMultiplier);
+    buffer.write(speedMultiplier);
+    buffer.write(damageBoostTimer);
+    buffer.write(speedBoostTimer);
+    buffer.write(fireDamageTimer);
+    buffer.write(fireDPS);
+}
+
+void Character::loadState(StateBuffer& buffer) {
+    Ogre::Vector3 position;
+    buffer.read(position.ptr(), 3);
+    float vx = buffer.read<float>();
+    float vy = buffer.read<float>();
+    float vz = buffer.read<float>();
+    buffer.read(facing.ptr(), 3);
+    buffer.read(stats);
+    buffer.read(currentHealth);
+    buffer.read(isJumping);
+    buffer.read(isUsingAbility);
+    buffer.read(attackCooldownTimer);
+    buffer.read(abilityCooldownTimer);
+    buffer.read(abilityActiveTimer);
+    buffer.read(damageMultiplier);
+    buffer.read(speedMultiplier);
+    buffer.read(damageBoostTimer);
+    buffer.read(speedBoostTimer);
+    buffer.read(fireDamageTimer);
+    buffer.read(fireDPS);
+
+    setPosition(position);
+    if (physicsBody) {
+        physicsBody->setVelocity(btVector3(vx, vy, vz));
+    }
+}
+
+void Character::playVoiceLine(const char* line) {
     // Play audio (will be implemented when audio system is integrated)
     std::cout << "[" << name << "]: \"" << line << "\"" << std::endl;
 }
 
-void Character::playAnimation(const std::string& animName, bool loop) {
-    // TODO: Implement animation playback
+void Character::playAnimation(const std::string& animName, bool loop, float duration) {
+    playAnimation(findAnimationClip(animName), loop, duration);
+}
+
+void Character::playAnimation(AnimationClipId clip, bool loop, float duration) {
+    if (clip == AnimationClipId::Count) return;
+    // Locomotion asks every frame; only changes are sent
+    if (loop && clip == currentAnimation) return;
+
+    const AnimationClipInfo& info = getAnimationClipInfo(clip);
+    float speed = duration > 0.0f ? info.length / duration : 1.0f;
+    currentAnimation = clip;
+    animationLock = loop ? 0.0f : info.length / speed;
+
+    if (!renderQueued) return;
+    queueRenderCommand([this, clip, loop, speed] {
+        GraphicsEngine* graphics = Engine::getInstance().getGraphics();
+        AnimationSystem* animations = graphics ? graphics->getAnimations() : nullptr;
+        if (animations && animationInstance >= 0) {
+            animations->play(animationInstance, clip, loop, speed);
+        }
+    });
 }
 
 // Character factory
 std::unique_ptr<Character> createCharacter(CharacterID id) {
+    // Stats and abilities come from GameData; only characters with
+    // behaviour the table can't express need a subclass
     switch (id) {
-        case CharacterID::Bas: return std::make_unique<BasCharacter>();
-        case CharacterID::Berkay: return std::make_unique<BerkayCharacter>();
-        case CharacterID::Luca: return std::make_unique<LucaCharacter>();
-        case CharacterID::Gefferinho: return std::make_unique<GefferinhoCharacter>();
-        case CharacterID::Hadi: return std::make_unique<HadiCharacter>();
-        case CharacterID::Nitin: return std::make_unique<NitinCharacter>();
-        case CharacterID::PalaBaba: return std::make_unique<PalaBabaCharacter>();
-        case CharacterID::Fufinho: return std::make_unique<FufinhoCharacter>();
-        case CharacterID::EfeAbi: return std::make_unique<EfeAbiCharacter>();
-        case CharacterID::Jad: return std::make_unique<JadCharacter>();
-        case CharacterID::Umut: return std::make_unique<UmutCharacter>();
         case CharacterID::KeizerBomTaha: return std::make_unique<KeizerBomTahaCharacter>();
-        case CharacterID::GoonLordTobese: return std::make_unique<GoonLordTobeseCharacter>();
-        default: return nullptr;
+        case CharacterID::Count: return nullptr;
+        default: return std::make_unique<Character>(id);
     }
 }
 
@@ -0,0 +1,170 @@
+#include "gameplay/Enemy.hpp"
+#include "core/Engine.hpp"
+#include "core/StateBuffer.hpp"
+#include "graphics/GraphicsEngine.hpp"
+#include "graphics/RenderThread.hpp"
+#include <iostream>
+
+namespace BVA {
+
+namespace {
+
+// Parking spot for inactive pooled enemies, far below the arena
+const Ogre::Vector3 POOL_PARK_POSITION(0.0f, -1000.0f, 0.0f);
+
+// {maxHealth, moveSpeed, attackDamage, attackSpeed, defense}
+const EnemyArchetype ENEMY_ARCHETYPES[] = {
+    {"Wolters",   {80.0f, 3.5f, 8.0f, 0.8f, 2.0f}, Ogre::ColourValue(0.45f, 0.35f, 0.25f), 1.05f, 18.0f, 1.8f},
+    {"PrefectA",  {40.0f, 4.5f, 5.0f, 1.2f, 0.0f}, Ogre::ColourValue(0.2f, 0.3f, 0.7f),   0.9f,  20.0f, 1.5f},
+    {"PrefectB",  {50.0f, 4.0f, 6.0f, 1.0f, 1.0f}, Ogre::ColourValue(0.3f, 0.2f, 0.6f),   0.95f, 20.0f, 1.5f},
+    {"Chef",      {70.0f, 3.5f, 9.0f, 0.9f, 1.0f}, Ogre::ColourValue(0.9f, 0.9f, 0.9f),   1.0f,  16.0f, 1.8f},
+    {"Coach",     {90.0f, 5.0f, 10.0f, 1.0f, 2.0f}, Ogre::ColourValue(0.8f, 0.4f, 0.1f),  1.1f,  22.0f, 1.8f},
+    {"Librarian", {60.0f, 3.0f, 7.0f, 0.7f, 1.0f}, Ogre::ColourValue(0.4f, 0.5f, 0.3f),   1.0f,  14.0f, 1.6f},
+};
+
+} // namespace
+
+const EnemyArchetype* findEnemyArchetype(const std::string& name) {
+    for (const auto& archetype : ENEMY_ARCHETYPES) {
+        if (name == archetype.name) {
+            return &archetype;
+        }
+    }
+    return nullptr;
+}
+
+const EnemyArchetype* getEnemyArchetype(int index) {
+    constexpr int count = sizeof(ENEMY_ARCHETYPES) / sizeof(ENEMY_ARCHETYPES[0]);
+    return (index >= 0 && index < count) ? &ENEMY_ARCHETYPES[index] : nullptr;
+}
+
+int getEnemyArchetypeIndex(const EnemyArchetype& archetype) {
+    constexpr int count = sizeof(ENEMY_ARCHETYPES) / sizeof(ENEMY_ARCHETYPES[0]);
+    int index = static_cast<int>(&archetype - ENEMY_ARCHETYPES);
+    return (index >= 0 && index < count) ? index : -1;
+}
+
+EnemyCharacter::EnemyCharacter(const EnemyArchetype& type)
+    : Character(CharacterID::Bas), archetype(type) {
+    name = archetype.name;
+    stats = archetype.stats;
+    currentHealth = stats.maxHealth;
+    hostile = true;
+}
+
+void EnemyCharacter::initialize(Ogre::SceneManager* sceneManager, PhysicsEngine* physics) {
+    Character::initialize(sceneManager, physics);
+
+    // Queued behind the node's creation
+    Ogre::Vector3 scale(archetype.scale);
+    auto applyScale = [this, scale] {
+        if (sceneNode) {
+            sceneNode->setScale(scale);
+        }
+    };
+    if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+        graphics->getFramePacket().enqueue(applyScale);
+    } else {
+        applyScale();
+    }
+
+    // Pool slots start parked and disabled
+    deactivate();
+}
+
+void EnemyCharacter::activate(const Ogre::Vector3& position) {
+    active = true;
+
+    // Reset per-life state; stats may have been modified by buffs
+    stats = archetype.stats;
+    currentHealth = stats.maxHealth;
+    attackCooldownTimer = 0.0f;
+    abilityCooldownTimer = 0.0f;
+    damageMultiplier = 1.0f;
+    speedMultiplier = 1.0f;
+    damageBoostTimer = 0.0f;
+    speedBoostTimer = 0.0f;
+    fireDamageTimer = 0.0f;
+    target = nullptr;
+
+    if (physicsBody) {
+        physicsBody->setEnabled(true);
+        physicsBody->setVelocity(btVector3(0, 0, 0));
+    }
+    setPosition(position);
+    setVisible(true);
+}
+
+void EnemyCharacter::deactivate() {
+    active = false;
+    target = nullptr;
+
+    if (physicsBody) {
+        physicsBody->setEnabled(false);
+    }
+    setPosition(POOL_PARK_POSITION);
+    setVisible(false);
+}
+
+void EnemyCharacter::update(float dt) {
+    if (!active) return;
+
+    Character::update(dt);
+
+    if (isAlive()) {
+        updateAI(dt);
+    }
+}
+
+void EnemyCharacter::think(const AIWorldSnapshot& world, float elapsed) {
+    if (!active || !isAlive()) return;
+
+    // Chase the nearest living player
+    target = world.findNearest(getPosition(), archetype.aggroRange);
+}
+
+float EnemyCharacter::estimateThinkCost(const AIWorldSnapshot& world) const {
+    // One nearest-target scan
+    return 0.5f + 0.05f * world.size();
+}
+
+void EnemyCharacter::forgetTarget(Character* character) {
+    if (target == character) {
+        target = nullptr;
+    }
+}
+
+void EnemyCharacter::saveState(StateBuffer& buffer) const {
+    Character::saveState(buffer);
+    buffer.writeCharacter(target);
+}
+
+void EnemyCharacter::loadState(StateBuffer& buffer) {
+    Character::loadState(buffer);
+    target = buffer.readCharacter();
+}
+
+void EnemyCharacter::updateAI(float dt) {
+    // Acts on the target from the last think(); between thinks we only
+    // steer and swing, which is cheap
+    if (!target || !target->isAlive()) {
+        target = nullptr;
+        move(Ogre::Vector3::ZERO);
+        return;
+    }
+
+    Ogre::Vector3 toTarget = target->getPosition() - getPosition();
+    toTarget.y = 0.0f;
+
+    if (toTarget.squaredLength() > archetype.attackRange * archetype.attackRange) {
+        move(toTarget.normalisedCopy());
+    } else {
+        move(Ogre::Vector3::ZERO);
+        if (attackCooldownTimer <= 0.0f) {
+            attackCooldownTimer = 1.0f / stats.attackSpeed;
+            target->takeDamage(stats.attackDamage * damageMultiplier, this);
+        }
+    }
+}
+
+} // namespace BVA
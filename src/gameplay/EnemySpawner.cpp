@@ -0,0 +1,213 @@
+#include "gameplay/EnemySpawner.hpp"
+#include "core/StateBuffer.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+namespace BVA {
+
+EnemySpawner::EnemySpawner() {}
+
+EnemySpawner::~EnemySpawner() {
+    shutdown();
+}
+
+bool EnemySpawner::initialize(Ogre::SceneManager* sm, PhysicsEngine* physicsEngine) {
+    sceneManager = sm;
+    physics = physicsEngine;
+    std::cout << "Enemy spawner initialized" << std::endl;
+    return true;
+}
+
+void EnemySpawner::shutdown() {
+    pools.clear();
+}
+
+void EnemySpawner::prepareLevel(const std::vector<std::string>& archetypes, int poolSize) {
+    for (const auto& archetypeName : archetypes) {
+        const EnemyArchetype* archetype = findEnemyArchetype(archetypeName);
+        if (!archetype) {
+            std::cerr << "Unknown enemy archetype: " << archetypeName << std::endl;
+            continue;
+        }
+
+        Pool& pool = pools[archetypeName];
+        pool.archetype = archetype;
+
+        int created = 0;
+        while (static_cast<int>(pool.instances.size()) < poolSize) {
+            auto enemy = std::make_unique<EnemyCharacter>(*archetype);
+            enemy->setPoolIndex(static_cast<int>(pool.instances.size()));
+            if (sceneManager && physics) {
+                enemy->initialize(sceneManager, physics);
+            }
+            pool.freeList.push_back(enemy.get());
+            pool.instances.push_back(std::move(enemy));
+            created++;
+        }
+
+        // Capacity for every instance so despawn never reallocates
+        pool.freeList.reserve(pool.instances.size());
+
+        if (created > 0) {
+            std::cout << "  Enemy pool " << archetypeName << ": " << pool.instances.size()
+                      << " instances (+" << created << ")" << std::endl;
+        }
+    }
+}
+
+EnemySpawner::Pool* EnemySpawner::findPool(const std::string& archetypeName) {
+    auto it = pools.find(archetypeName);
+    return it != pools.end() ? &it->second : nullptr;
+}
+
+const EnemySpawner::Pool* EnemySpawner::findPool(const std::string& archetypeName) const {
+    auto it = pools.find(archetypeName);
+    return it != pools.end() ? &it->second : nullptr;
+}
+
+EnemyCharacter* EnemySpawner::spawn(const std::string& archetypeName, const Ogre::Vector3& position) {
+    Pool* pool = findPool(archetypeName);
+    if (!pool || pool->freeList.empty()) {
+        return nullptr;
+    }
+
+    EnemyCharacter* enemy = pool->freeList.back();
+    pool->freeList.pop_back();
+    enemy->activate(position);
+    return enemy;
+}
+
+int EnemySpawner::spawnWave(const std::string& archetypeName, int count, const Ogre::Vector3& center,
+                            float radius, std::vector<EnemyCharacter*>& spawned, float startAngle) {
+    Pool* pool = findPool(archetypeName);
+    if (!pool) return 0;
+
+    int spawnCount = std::min(count, static_cast<int>(pool->freeList.size()));
+    for (int i = 0; i < spawnCount; i++) {
+        float angle = startAngle + Ogre::Math::TWO_PI * i / spawnCount;
+        Ogre::Vector3 position = center + Ogre::Vector3(std::cos(angle), 0.0f, std::sin(angle)) * radius;
+
+        EnemyCharacter* enemy = pool->freeList.back();
+        pool->freeList.pop_back();
+        enemy->activate(position);
+        spawned.push_back(enemy);
+    }
+
+    return spawnCount;
+}
+
+void EnemySpawner::despawn(EnemyCharacter* enemy) {
+    if (!enemy || !enemy->isActive()) return;
+
+    enemy->deactivate();
+    if (Pool* pool = findPool(enemy->getArchetype().name)) {
+        pool->freeList.push_back(enemy);
+    }
+}
+
+void EnemySpawner::despawnAll() {
+    for (auto& [name, pool] : pools) {
+        for (auto& enemy : pool.instances) {
+            if (enemy->isActive()) {
+                enemy->deactivate();
+                pool.freeList.push_back(enemy.get());
+            }
+        }
+    }
+}
+
+int EnemySpawner::getFreeCount(const std::string& archetypeName) const {
+    auto it = pools.find(archetypeName);
+    return it != pools.end() ? static_cast<int>(it->second.freeList.size()) : 0;
+}
+
+int EnemySpawner::getPoolSize(const std::string& archetypeName) const {
+    auto it = pools.find(archetypeName);
+    return it != pools.end() ? static_cast<int>(it->second.instances.size()) : 0;
+}
+
+int EnemySpawner::getInstanceId(const EnemyCharacter* enemy) const {
+    int archetypeIndex = getEnemyArchetypeIndex(enemy->getArchetype());
+    if (archetypeIndex < 0) return -1;
+    return (archetypeIndex << 16) | enemy->getPoolIndex();
+}
+
+EnemyCharacter* EnemySpawner::getInstance(int id) {
+    const EnemyArchetype* archetype = getEnemyArchetype(id >> 16);
+    Pool* pool = archetype ? findPool(archetype->name) : nullptr;
+    if (!pool) return nullptr;
+
+    size_t index = static_cast<size_t>(id & 0xFFFF);
+    return index < pool->instances.size() ? pool->instances[index].get() : nullptr;
+}
+
+void EnemySpawner::saveState(StateBuffer& buffer) const {
+    // Archetype table order, so the layout doesn't depend on hash map order
+    for (int archetypeIndex = 0; getEnemyArchetype(archetypeIndex); archetypeIndex++) {
+        const Pool* pool = findPool(getEnemyArchetype(archetypeIndex)->name);
+        if (!pool) continue;
+
+        buffer.write(archetypeIndex);
+        buffer.write(static_cast<uint32_t>(pool->instances.size()));
+
+        buffer.write(static_cast<uint32_t>(pool->freeList.size()));
+        for (const EnemyCharacter* enemy : pool->freeList) {
+            buffer.write(enemy->getPoolIndex());
+        }
+
+        for (const auto& enemy : pool->instances) {
+            if (enemy->isActive()) {
+                buffer.write(enemy->getPoolIndex());
+                enemy->saveState(buffer);
+            }
+        }
+        buffer.write(-1);
+    }
+    buffer.write(-1);
+}
+
+void EnemySpawner::loadState(StateBuffer& buffer) {
+    despawnAll();
+
+    for (int archetypeIndex = buffer.read<int>(); archetypeIndex >= 0 && !buffer.hasOverflowed();
+         archetypeIndex = buffer.read<int>()) {
+        const EnemyArchetype* archetype = getEnemyArchetype(archetypeIndex);
+        uint32_t savedCount = buffer.read<uint32_t>();
+        if (!archetype) {
+            std::cerr << "Enemy snapshot references unknown archetype " << archetypeIndex << std::endl;
+            return;
+        }
+
+        // Pools only grow, but a snapshot may be restored into a fresh spawner
+        prepareLevel({archetype->name}, static_cast<int>(savedCount));
+        Pool* pool = findPool(archetype->name);
+
+        // Instances created after the snapshot go underneath the saved free
+        // list so spawns pop the same slots in the same order as before
+        pool->freeList.clear();
+        for (size_t i = savedCount; i < pool->instances.size(); i++) {
+            pool->freeList.push_back(pool->instances[i].get());
+        }
+
+        uint32_t freeCount = buffer.read<uint32_t>();
+        for (uint32_t i = 0; i < freeCount; i++) {
+            int index = buffer.read<int>();
+            if (index >= 0 && index < static_cast<int>(pool->instances.size())) {
+                pool->freeList.push_back(pool->instances[index].get());
+            }
+        }
+
+        for (int index = buffer.read<int>(); index >= 0 && !buffer.hasOverflowed(); index = buffer.read<int>()) {
+            if (index >= static_cast<int>(pool->instances.size())) {
+                std::cerr << "Enemy snapshot references missing pool slot " << index << std::endl;
+                return;
+            }
+            EnemyCharacter* enemy = pool->instances[index].get();
+            enemy->activate(Ogre::Vector3::ZERO);
+            enemy->loadState(buffer);
+        }
+    }
+}
+
+} // namespace BVA
@@ -0,0 +1,398 @@
+#include "gameplay/ProjectileSystem.hpp"
+#include "gameplay/Character.hpp"
+#include "graphics/GraphicsEngine.hpp"
+#include "graphics/InstanceBatch.hpp"
+#include "graphics/ProceduralGenerator.hpp"
+#include "graphics/RenderThread.hpp"
+#include "core/Engine.hpp"
+#include "core/StateBuffer.hpp"
+#include <iostream>
+#include <algorithm>
+
+namespace BVA {
+
+namespace {
+
+constexpr float GRAVITY = -20.0f;  // Matches PhysicsEngine world gravity
+
+// Squared distance between segments [p1,q1] and [p2,q2] (Ericson, RTCD 5.1.9)
+float segmentSegmentDistanceSq(const Ogre::Vector3& p1, const Ogre::Vector3& q1,
+                               const Ogre::Vector3& p2, const Ogre::Vector3& q2) {
+    const float epsilon = 1e-6f;
+    Ogre::Vector3 d1 = q1 - p1;
+    Ogre::Vector3 d2 = q2 - p2;
+    Ogre::Vector3 r = p1 - p2;
+    float a = d1.dotProduct(d1);
+    float e = d2.dotProduct(d2);
+    float f = d2.dotProduct(r);
+    float s = 0.0f;
+    float t = 0.0f;
+
+    if (a <= epsilon && e <= epsilon) {
+        return r.dotProduct(r);
+    }
+    if (a <= epsilon) {
+        t = Ogre::Math::Clamp(f / e, 0.0f, 1.0f);
+    } else {
+        float c = d1.dotProduct(r);
+        if (e <= epsilon) {
+            s = Ogre::Math::Clamp(-c / a, 0.0f, 1.0f);
+        } else {
+            float b = d1.dotProduct(d2);
+            float denom = a * e - b * b;
+            if (denom != 0.0f) {
+                s = Ogre::Math::Clamp((b * f - c * e) / denom, 0.0f, 1.0f);
+            }
+            t = (b * s + f) / e;
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = Ogre::Math::Clamp(-c / a, 0.0f, 1.0f);
+            } else if (t > 1.0f) {
+                t = 1.0f;
+                s = Ogre::Math::Clamp((b - c) / a, 0.0f, 1.0f);
+            }
+        }
+    }
+
+    Ogre::Vector3 c1 = p1 + d1 * s;
+    Ogre::Vector3 c2 = p2 + d2 * t;
+    return c1.squaredDistance(c2);
+}
+
+} // namespace
+
+ProjectileDesc makeProjectileDesc(const ProjectileRecord& record, float damage) {
+    ProjectileDesc desc;
+    desc.speed = record.speed;
+    desc.damage = damage;
+    desc.radius = record.radius;
+    desc.lifetime = record.lifetime;
+    desc.gravityScale = record.gravityScale;
+    desc.fireDPS = record.fireDPS;
+    desc.fireDuration = record.fireDuration;
+    desc.splashRadius = record.splashRadius;
+    desc.scale = record.scale;
+    desc.color = Ogre::ColourValue(record.color[0], record.color[1], record.color[2]);
+    return desc;
+}
+
+ProjectileTeam getProjectileTeam(const Character* character) {
+    return character->isHostile() ? ProjectileTeam::Enemies : ProjectileTeam::Players;
+}
+
+ProjectileSystem::ProjectileSystem() {
+    // Allocate the whole pool up front; spawning never allocates
+    for (auto* array : {&posX, &posY, &posZ, &prevX, &prevY, &prevZ, &velX, &velY, &velZ,
+                        &damage, &radius, &lifetime, &gravity, &fireDPS, &fireDuration,
+                        &splashRadius, &scale}) {
+        array->resize(MAX_PROJECTILES, 0.0f);
+    }
+    color.resize(MAX_PROJECTILES, Ogre::ColourValue::White);
+    owner.resize(MAX_PROJECTILES, nullptr);
+    team.resize(MAX_PROJECTILES, ProjectileTeam::Players);
+    dead.resize(MAX_PROJECTILES, 0);
+}
+
+ProjectileSystem::~ProjectileSystem() {
+    shutdown();
+}
+
+bool ProjectileSystem::initialize(Ogre::SceneManager* sm) {
+    sceneManager = sm;
+
+    if (sceneManager) {
+        graphics = Engine::getInstance().getGraphics();
+        auto createBatch = [this] {
+            try {
+                batch = std::make_unique<InstanceBatch>("ProjectileBatch",
+                                                        ProceduralMeshGenerator::getProjectileMesh(),
+                                                        "ProjectileInstancedMaterial",
+                                                        MAX_PROJECTILES);
+                batchNode = sceneManager->getRootSceneNode()->createChildSceneNode();
+                batchNode->attachObject(batch.get());
+            } catch (const Ogre::Exception& e) {
+                std::cerr << "Projectile rendering disabled: " << e.what() << std::endl;
+                batch.reset();
+            }
+        };
+        if (graphics) {
+            graphics->runOnRenderThread(createBatch);
+        } else {
+            createBatch();
+        }
+    }
+
+    std::cout << "Projectile system initialized (capacity: " << MAX_PROJECTILES << ")" << std::endl;
+    return true;
+}
+
+void ProjectileSystem::shutdown() {
+    clear();
+
+    auto destroyBatch = [this] {
+        if (batchNode) {
+            batchNode->detachAllObjects();
+            sceneManager->destroySceneNode(batchNode);
+            batchNode = nullptr;
+        }
+        batch.reset();
+    };
+    if (graphics) {
+        graphics->runOnRenderThread(destroyBatch);
+    } else {
+        destroyBatch();
+    }
+    sceneManager = nullptr;
+    graphics = nullptr;
+}
+
+void ProjectileSystem::clear() {
+    activeCount = 0;
+    updateRendering();
+}
+
+bool ProjectileSystem::spawn(Character* source, ProjectileTeam projectileTeam,
+                             const Ogre::Vector3& position, const Ogre::Vector3& direction,
+                             const ProjectileDesc& desc) {
+    if (activeCount >= MAX_PROJECTILES) {
+        return false;
+    }
+
+    Ogre::Vector3 velocity = direction.normalisedCopy() * desc.speed;
+    size_t i = activeCount++;
+
+    posX[i] = prevX[i] = position.x;
+    posY[i] = prevY[i] = position.y;
+    posZ[i] = prevZ[i] = position.z;
+    velX[i] = velocity.x;
+    velY[i] = velocity.y;
+    velZ[i] = velocity.z;
+    damage[i] = desc.damage;
+    radius[i] = desc.radius;
+    lifetime[i] = desc.lifetime;
+    gravity[i] = desc.gravityScale * GRAVITY;
+    fireDPS[i] = desc.fireDPS;
+    fireDuration[i] = desc.fireDuration;
+    splashRadius[i] = desc.splashRadius;
+    scale[i] = desc.scale;
+    color[i] = desc.color;
+    owner[i] = source;
+    team[i] = projectileTeam;
+    dead[i] = 0;
+
+    return true;
+}
+
+void ProjectileSystem::forgetOwner(Character* character) {
+    for (size_t i = 0; i < activeCount; i++) {
+        if (owner[i] == character) {
+            owner[i] = nullptr;
+        }
+    }
+}
+
+void ProjectileSystem::saveState(StateBuffer& buffer) const {
+    buffer.write(static_cast<uint32_t>(activeCount));
+    for (size_t i = 0; i < activeCount; i++) {
+        for (const auto* array : {&posX, &posY, &posZ, &prevX, &prevY, &prevZ, &velX, &velY, &velZ,
+                                  &damage, &radius, &lifetime, &gravity, &fireDPS, &fireDuration,
+                                  &splashRadius, &scale}) {
+            buffer.write((*array)[i]);
+        }
+        buffer.write(color[i].ptr(), 4);
+        buffer.writeCharacter(owner[i]);
+        buffer.write(team[i]);
+    }
+}
+
+void ProjectileSystem::loadState(StateBuffer& buffer) {
+    activeCount = std::min<size_t>(buffer.read<uint32_t>(), MAX_PROJECTILES);
+    for (size_t i = 0; i < activeCount; i++) {
+        for (auto* array : {&posX, &posY, &posZ, &prevX, &prevY, &prevZ, &velX, &velY, &velZ,
+                            &damage, &radius, &lifetime, &gravity, &fireDPS, &fireDuration,
+                            &splashRadius, &scale}) {
+            (*array)[i] = buffer.read<float>();
+        }
+        buffer.read(color[i].ptr(), 4);
+        owner[i] = buffer.readCharacter();
+        team[i] = buffer.read<ProjectileTeam>();
+        dead[i] = 0;
+    }
+}
+
+void ProjectileSystem::update(float dt, const std::vector<Character*>& targets) {
+    if (activeCount > 0) {
+        integrate(dt);
+        collide(targets);
+
+        // Compact: swap dead entries with the last live one
+        size_t i = 0;
+        while (i < activeCount) {
+            if (dead[i]) {
+                kill(i);
+            } else {
+                i++;
+            }
+        }
+    }
+
+    updateRendering();
+}
+
+void ProjectileSystem::integrate(float dt) {
+    const size_t n = activeCount;
+
+    // Plain loops over packed arrays; the compiler vectorizes these
+    for (size_t i = 0; i < n; i++) {
+        prevX[i] = posX[i];
+        prevY[i] = posY[i];
+        prevZ[i] = posZ[i];
+    }
+    for (size_t i = 0; i < n; i++) {
+        velY[i] += gravity[i] * dt;
+    }
+    for (size_t i = 0; i < n; i++) {
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+        posZ[i] += velZ[i] * dt;
+        lifetime[i] -= dt;
+    }
+    for (size_t i = 0; i < n; i++) {
+        dead[i] = (lifetime[i] <= 0.0f) ? 1 : 0;
+    }
+}
+
+void ProjectileSystem::collide(const std::vector<Character*>& targets) {
+    // Gather live capsule centres once instead of per projectile
+    targetX.clear();
+    targetY.clear();
+    targetZ.clear();
+    targetTeam.clear();
+    for (Character* target : targets) {
+        Ogre::Vector3 p = target->getPosition();
+        targetX.push_back(p.x);
+        targetY.push_back(p.y);
+        targetZ.push_back(p.z);
+        targetTeam.push_back(getProjectileTeam(target));
+    }
+
+    const size_t numTargets = targets.size();
+
+    for (size_t i = 0; i < activeCount; i++) {
+        if (dead[i]) continue;
+
+        Ogre::Vector3 from(prevX[i], prevY[i], prevZ[i]);
+        Ogre::Vector3 to(posX[i], posY[i], posZ[i]);
+        float hitRadius = radius[i] + CAPSULE_RADIUS;
+
+        // Swept segment bounds for a cheap rejection test
+        float minX = std::min(from.x, to.x) - hitRadius;
+        float maxX = std::max(from.x, to.x) + hitRadius;
+        float minY = std::min(from.y, to.y) - hitRadius - CAPSULE_HALF_HEIGHT;
+        float maxY = std::max(from.y, to.y) + hitRadius + CAPSULE_HALF_HEIGHT;
+        float minZ = std::min(from.z, to.z) - hitRadius;
+        float maxZ = std::max(from.z, to.z) + hitRadius;
+
+        for (size_t t = 0; t < numTargets; t++) {
+            if (targetTeam[t] == team[i]) continue;
+            if (targetX[t] < minX || targetX[t] > maxX ||
+                targetY[t] < minY || targetY[t] > maxY ||
+                targetZ[t] < minZ || targetZ[t] > maxZ) {
+                continue;
+            }
+            if (!targets[t]->isAlive()) continue;
+
+            Ogre::Vector3 capsuleBottom(targetX[t], targetY[t] - CAPSULE_HALF_HEIGHT, targetZ[t]);
+            Ogre::Vector3 capsuleTop(targetX[t], targetY[t] + CAPSULE_HALF_HEIGHT, targetZ[t]);
+
+            if (segmentSegmentDistanceSq(from, to, capsuleBottom, capsuleTop) <= hitRadius * hitRadius) {
+                applyHit(i, targets[t]);
+                applySplash(i, targets, targets[t]);
+                dead[i] = 1;
+                break;
+            }
+        }
+
+        // Hitting the arena floor ends the projectile
+        if (!dead[i] && posY[i] <= 0.0f) {
+            applySplash(i, targets, nullptr);
+            dead[i] = 1;
+        }
+    }
+}
+
+void ProjectileSystem::applyHit(size_t i, Character* target) {
+    target->takeDamage(damage[i], owner[i]);
+    if (fireDPS[i] > 0.0f) {
+        target->applyFireDamage(fireDPS[i], fireDuration[i]);
+    }
+}
+
+void ProjectileSystem::applySplash(size_t i, const std::vector<Character*>& targets,
+                                   Character* directHit) {
+    if (splashRadius[i] <= 0.0f) return;
+
+    Ogre::Vector3 center(posX[i], posY[i], posZ[i]);
+    float radiusSq = splashRadius[i] * splashRadius[i];
+
+    for (size_t t = 0; t < targets.size(); t++) {
+        if (targets[t] == directHit || targetTeam[t] == team[i] || !targets[t]->isAlive()) continue;
+
+        Ogre::Vector3 p(targetX[t], targetY[t], targetZ[t]);
+        if (center.squaredDistance(p) <= radiusSq) {
+            // Splash deals half damage
+            targets[t]->takeDamage(damage[i] * 0.5f, owner[i]);
+        }
+    }
+}
+
+void ProjectileSystem::kill(size_t i) {
+    size_t last = --activeCount;
+    if (i == last) return;
+
+    posX[i] = posX[last];
+    posY[i] = posY[last];
+    posZ[i] = posZ[last];
+    prevX[i] = prevX[last];
+    prevY[i] = prevY[last];
+    prevZ[i] = prevZ[last];
+    velX[i] = velX[last];
+    velY[i] = velY[last];
+    velZ[i] = velZ[last];
+    damage[i] = damage[last];
+    radius[i] = radius[last];
+    lifetime[i] = lifetime[last];
+    gravity[i] = gravity[last];
+    fireDPS[i] = fireDPS[last];
+    fireDuration[i] = fireDuration[last];
+    splashRadius[i] = splashRadius[last];
+    scale[i] = scale[last];
+    color[i] = color[last];
+    owner[i] = owner[last];
+    team[i] = team[last];
+    dead[i] = dead[last];
+}
+
+void ProjectileSystem::updateRendering() {
+    if (!batch) return;
+
+    if (!graphics) {
+        batch->beginUpdate();
+        for (size_t i = 0; i < activeCount; i++) {
+            batch->addInstance(Ogre::Vector3(posX[i], posY[i], posZ[i]),
+                               Ogre::Quaternion::IDENTITY, scale[i], color[i]);
+        }
+        batch->commit();
+        return;
+    }
+
+    // Packed here and uploaded by the render thread with this frame
+    std::vector<float>& data = graphics->getFramePacket().uploadInstances(batch.get(), activeCount);
+    for (size_t i = 0; i < activeCount; i++) {
+        InstanceBatch::packInstance(&data[i * InstanceBatch::FLOATS_PER_INSTANCE],
+                                    Ogre::Vector3(posX[i], posY[i], posZ[i]),
+                                    Ogre::Quaternion::IDENTITY, scale[i], color[i]);
+    }
+}
+
+} // namespace BVA
@@ -0,0 +1,404 @@
+#include "graphics/AnimationClip.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace BVA {
+
+namespace {
+
+// Keys are dropped while interpolation stays within these of the samples
+const float ROTATION_TOLERANCE = Ogre::Degree(0.5f).valueRadians();
+constexpr float ROOT_TOLERANCE = 0.001f;
+
+constexpr float QUANT_SCALE = 32767.0f;
+
+const AnimationClipInfo CLIP_INFO[] = {
+    {"idle", 2.0f, true},
+    {"run", 0.6f, true},
+    {"attack", 0.5f, false},
+    {"windup", 1.0f, false},
+    {"ability", 0.8f, false},
+    {"hit", 0.3f, false},
+    {"death", 1.2f, false},
+};
+static_assert(std::size(CLIP_INFO) == static_cast<size_t>(AnimationClipId::Count), "one entry per clip");
+
+int16_t quantize(float value, float range) {
+    float scaled = std::round(value / range * QUANT_SCALE);
+    return static_cast<int16_t>(std::clamp(scaled, -QUANT_SCALE, QUANT_SCALE));
+}
+
+float dequantize(int16_t value, float range) {
+    return static_cast<float>(value) * (range / QUANT_SCALE);
+}
+
+Ogre::Quaternion nlerp(const Ogre::Quaternion& a, const Ogre::Quaternion& b, float t) {
+    // Keys are hemisphere-aligned when built, so no sign flip is needed
+    Ogre::Quaternion q = a * (1.0f - t) + b * t;
+    q.normalise();
+    return q;
+}
+
+// Smooth 0..1 ramp over [start, end] of t
+float ease(float t, float start, float end) {
+    float x = std::clamp((t - start) / (end - start), 0.0f, 1.0f);
+    return x * x * (3.0f - 2.0f * x);
+}
+
+Ogre::Quaternion pitch(float degrees) {
+    return Ogre::Quaternion(Ogre::Degree(degrees), Ogre::Vector3::UNIT_X);
+}
+
+Ogre::Quaternion roll(float degrees) {
+    return Ogre::Quaternion(Ogre::Degree(degrees), Ogre::Vector3::UNIT_Z);
+}
+
+Ogre::Quaternion yaw(float degrees) {
+    return Ogre::Quaternion(Ogre::Degree(degrees), Ogre::Vector3::UNIT_Y);
+}
+
+// Greedy reduction over one track: from each kept key, extend the span as
+// far as interpolating its ends reproduces every frame in between
+template <typename Value, typename Lerp, typename Fits>
+void reduceTrack(const std::vector<Value>& frames, Lerp&& lerp, Fits&& fits, std::vector<uint16_t>& keptFrames) {
+    const size_t count = frames.size();
+    size_t key = 0;
+    keptFrames.push_back(0);
+
+    while (key + 1 < count) {
+        size_t end = key + 1;
+        while (end + 1 < count) {
+            size_t candidate = end + 1;
+            bool ok = true;
+            for (size_t i = key + 1; i < candidate && ok; i++) {
+                float t = static_cast<float>(i - key) / static_cast<float>(candidate - key);
+                ok = fits(lerp(frames[key], frames[candidate], t), frames[i]);
+            }
+            if (!ok) break;
+            end = candidate;
+        }
+        keptFrames.push_back(static_cast<uint16_t>(end));
+        key = end;
+    }
+}
+
+// Index of the key span holding frame, and the blend factor within it
+size_t findSpan(const uint16_t* frames, size_t count, float frame, float& t) {
+    if (count < 2) {
+        t = 0.0f;
+        return 0;
+    }
+
+    const uint16_t* upper = std::upper_bound(frames + 1, frames + count, frame,
+                                             [](float f, uint16_t key) { return f < static_cast<float>(key); });
+    size_t span = std::min(static_cast<size_t>(upper - frames), count - 1) - 1;
+
+    float start = frames[span];
+    float end = frames[span + 1];
+    t = std::clamp((frame - start) / (end - start), 0.0f, 1.0f);
+    return span;
+}
+
+} // namespace
+
+int HumanoidSkeleton::parent(int bone) {
+    switch (static_cast<HumanoidBone>(bone)) {
+        case HumanoidBone::Root: return -1;
+        case HumanoidBone::Spine:
+        case HumanoidBone::LegLeft:
+        case HumanoidBone::LegRight: return static_cast<int>(HumanoidBone::Root);
+        default: return static_cast<int>(HumanoidBone::Spine);
+    }
+}
+
+Ogre::Vector3 HumanoidSkeleton::joint(int bone) {
+    // Matches buildStylizedHumanoid at height 2: hips at the origin, torso
+    // up to 1, shoulders at 0.7 and +-0.3, legs at +-0.15
+    switch (static_cast<HumanoidBone>(bone)) {
+        case HumanoidBone::Head: return Ogre::Vector3(0.0f, 1.0f, 0.0f);
+        case HumanoidBone::ArmLeft: return Ogre::Vector3(-0.3f, 0.7f, 0.0f);
+        case HumanoidBone::ArmRight: return Ogre::Vector3(0.3f, 0.7f, 0.0f);
+        case HumanoidBone::LegLeft: return Ogre::Vector3(-0.15f, 0.0f, 0.0f);
+        case HumanoidBone::LegRight: return Ogre::Vector3(0.15f, 0.0f, 0.0f);
+        default: return Ogre::Vector3::ZERO;
+    }
+}
+
+const AnimationClipInfo& getAnimationClipInfo(AnimationClipId clip) {
+    size_t index = std::min(static_cast<size_t>(clip), std::size(CLIP_INFO) - 1);
+    return CLIP_INFO[index];
+}
+
+AnimationClipId findAnimationClip(const std::string& name) {
+    for (size_t i = 0; i < std::size(CLIP_INFO); i++) {
+        if (name == CLIP_INFO[i].name) {
+            return static_cast<AnimationClipId>(i);
+        }
+    }
+    return AnimationClipId::Count;
+}
+
+void Pose::setIdentity() {
+    std::fill(std::begin(qx), std::end(qx), 0.0f);
+    std::fill(std::begin(qy), std::end(qy), 0.0f);
+    std::fill(std::begin(qz), std::end(qz), 0.0f);
+    std::fill(std::begin(qw), std::end(qw), 1.0f);
+    rootOffset = Ogre::Vector3::ZERO;
+}
+
+void Pose::setRotation(HumanoidBone bone, const Ogre::Quaternion& q) {
+    int i = static_cast<int>(bone);
+    qx[i] = q.x;
+    qy[i] = q.y;
+    qz[i] = q.z;
+    qw[i] = q.w;
+}
+
+AnimationClip AnimationClip::build(float length, bool loop, const Sampler& sampler) {
+    AnimationClip clip;
+    clip.length = std::max(length, 0.0f);
+    clip.loop = loop;
+
+    size_t frameCount = std::max<size_t>(2, static_cast<size_t>(std::ceil(clip.length * SAMPLE_RATE)) + 1);
+    frameCount = std::min<size_t>(frameCount, UINT16_MAX);
+    clip.frameCount = static_cast<uint16_t>(frameCount);
+
+    std::vector<Pose> poses(frameCount);
+    for (size_t f = 0; f < frameCount; f++) {
+        poses[f].setIdentity();
+        sampler(clip.length * static_cast<float>(f) / static_cast<float>(frameCount - 1), poses[f]);
+    }
+
+    // Reduction works on quantized values so the tolerance covers both errors
+    const float cosHalfTolerance = std::cos(ROTATION_TOLERANCE * 0.5f);
+    auto toQuaternion = [](const RotationKey& key) {
+        return Ogre::Quaternion(dequantize(key[3], 1.0f), dequantize(key[0], 1.0f),
+                                dequantize(key[1], 1.0f), dequantize(key[2], 1.0f));
+    };
+
+    std::vector<RotationKey> rotations(frameCount);
+    std::vector<Ogre::Quaternion> quaternions(frameCount);
+    std::vector<uint16_t> kept;
+
+    for (int bone = 0; bone < HUMANOID_BONE_COUNT; bone++) {
+        Ogre::Quaternion previous = Ogre::Quaternion::IDENTITY;
+        for (size_t f = 0; f < frameCount; f++) {
+            const Pose& pose = poses[f];
+            Ogre::Quaternion q(pose.qw[bone], pose.qx[bone], pose.qy[bone], pose.qz[bone]);
+            q.normalise();
+            // Same hemisphere as the previous frame, so plain nlerp between
+            // any two keys takes the short way round
+            if (f > 0 && q.Dot(previous) < 0.0f) {
+                q = -q;
+            }
+            previous = q;
+
+            rotations[f] = {quantize(q.x, 1.0f), quantize(q.y, 1.0f), quantize(q.z, 1.0f), quantize(q.w, 1.0f)};
+            quaternions[f] = toQuaternion(rotations[f]);
+        }
+
+        kept.clear();
+        reduceTrack(quaternions, nlerp,
+                    [cosHalfTolerance](const Ogre::Quaternion& a, const Ogre::Quaternion& b) {
+                        return std::abs(a.Dot(b)) >= cosHalfTolerance;
+                    },
+                    kept);
+
+        Track& track = clip.rotationTracks[bone];
+        track.first = static_cast<uint16_t>(clip.rotationKeys.size());
+        track.count = static_cast<uint16_t>(kept.size());
+        for (uint16_t f : kept) {
+            clip.rotationFrames.push_back(f);
+            clip.rotationKeys.push_back(rotations[f]);
+        }
+    }
+
+    std::vector<RootKey> offsets(frameCount);
+    std::vector<Ogre::Vector3> positions(frameCount);
+    for (size_t f = 0; f < frameCount; f++) {
+        const Ogre::Vector3& offset = poses[f].rootOffset;
+        offsets[f] = {quantize(offset.x, ROOT_RANGE), quantize(offset.y, ROOT_RANGE), quantize(offset.z, ROOT_RANGE)};
+        positions[f] = Ogre::Vector3(dequantize(offsets[f][0], ROOT_RANGE), dequantize(offsets[f][1], ROOT_RANGE),
+                                     dequantize(offsets[f][2], ROOT_RANGE));
+    }
+
+    kept.clear();
+    reduceTrack(positions,
+                [](const Ogre::Vector3& a, const Ogre::Vector3& b, float t) { return a + (b - a) * t; },
+                [](const Ogre::Vector3& a, const Ogre::Vector3& b) {
+                    return a.squaredDistance(b) <= ROOT_TOLERANCE * ROOT_TOLERANCE;
+                },
+                kept);
+
+    clip.rootTrack.first = 0;
+    clip.rootTrack.count = static_cast<uint16_t>(kept.size());
+    for (uint16_t f : kept) {
+        clip.rootFrames.push_back(f);
+        clip.rootKeys.push_back(offsets[f]);
+    }
+
+    clip.sampledKeys = frameCount * (HUMANOID_BONE_COUNT + 1);
+    return clip;
+}
+
+void AnimationClip::sample(float time, Pose& pose) const {
+    pose.setIdentity();
+    if (frameCount < 2) return;
+
+    if (length <= 0.0f) {
+        time = 0.0f;
+    } else if (loop) {
+        time = std::fmod(time, length);
+        if (time < 0.0f) time += length;
+    } else {
+        time = std::clamp(time, 0.0f, length);
+    }
+
+    float frame = length > 0.0f ? time / length * static_cast<float>(frameCount - 1) : 0.0f;
+    float t;
+
+    for (int bone = 0; bone < HUMANOID_BONE_COUNT; bone++) {
+        const Track& track = rotationTracks[bone];
+        if (track.count == 0) continue;
+
+        size_t span = findSpan(&rotationFrames[track.first], track.count, frame, t);
+        const RotationKey& a = rotationKeys[track.first + span];
+        const RotationKey& b = rotationKeys[track.first + std::min<size_t>(span + 1, track.count - 1)];
+
+        float x = dequantize(a[0], 1.0f) * (1.0f - t) + dequantize(b[0], 1.0f) * t;
+        float y = dequantize(a[1], 1.0f) * (1.0f - t) + dequantize(b[1], 1.0f) * t;
+        float z = dequantize(a[2], 1.0f) * (1.0f - t) + dequantize(b[2], 1.0f) * t;
+        float w = dequantize(a[3], 1.0f) * (1.0f - t) + dequantize(b[3], 1.0f) * t;
+        float invLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+
+        pose.qx[bone] = x * invLength;
+        pose.qy[bone] = y * invLength;
+        pose.qz[bone] = z * invLength;
+        pose.qw[bone] = w * invLength;
+    }
+
+    if (rootTrack.count > 0) {
+        size_t span = findSpan(rootFrames.data(), rootTrack.count, frame, t);
+        const RootKey& a = rootKeys[span];
+        const RootKey& b = rootKeys[std::min<size_t>(span + 1, rootTrack.count - 1)];
+        for (int axis = 0; axis < 3; axis++) {
+            pose.rootOffset[axis] = dequantize(a[axis], ROOT_RANGE) * (1.0f - t) + dequantize(b[axis], ROOT_RANGE) * t;
+        }
+    }
+}
+
+size_t AnimationClip::getByteSize() const {
+    return sizeof(AnimationClip) + rotationFrames.size() * sizeof(uint16_t) +
+           rotationKeys.size() * sizeof(RotationKey) + rootFrames.size() * sizeof(uint16_t) +
+           rootKeys.size() * sizeof(RootKey);
+}
+
+AnimationClip AnimationClip::buildHumanoid(AnimationClipId id) {
+    const AnimationClipInfo& info = getAnimationClipInfo(id);
+    const float length = info.length;
+
+    // The humanoid faces +Z. Positive pitch leans the spine forward and
+    // swings a hanging limb backward.
+    Sampler sampler;
+    switch (id) {
+        case AnimationClipId::Idle:
+            sampler = [length](float time, Pose& pose) {
+                float breath = std::sin(2.0f * Ogre::Math::PI * time / length);
+                pose.setRotation(HumanoidBone::Spine, pitch(2.0f * breath));
+                pose.setRotation(HumanoidBone::Head, pitch(-1.5f * breath));
+                pose.setRotation(HumanoidBone::ArmLeft, roll(-4.0f - 2.0f * breath));
+                pose.setRotation(HumanoidBone::ArmRight, roll(4.0f + 2.0f * breath));
+                pose.rootOffset.y = 0.015f * breath;
+            };
+            break;
+
+        case AnimationClipId::Run:
+            sampler = [length](float time, Pose& pose) {
+                float phase = 2.0f * Ogre::Math::PI * time / length;
+                float stride = std::sin(phase);
+                pose.setRotation(HumanoidBone::Spine, pitch(12.0f) * yaw(6.0f * stride));
+                pose.setRotation(HumanoidBone::Head, pitch(-8.0f));
+                pose.setRotation(HumanoidBone::LegLeft, pitch(35.0f * stride));
+                pose.setRotation(HumanoidBone::LegRight, pitch(-35.0f * stride));
+                pose.setRotation(HumanoidBone::ArmLeft, pitch(-30.0f * stride));
+                pose.setRotation(HumanoidBone::ArmRight, pitch(30.0f * stride));
+                pose.rootOffset.y = 0.06f * std::abs(std::cos(phase));
+            };
+            break;
+
+        case AnimationClipId::Attack:
+            sampler = [length](float time, Pose& pose) {
+                float t = time / length;
+                // Raise, strike, recover
+                float raise = ease(t, 0.0f, 0.3f) * (1.0f - ease(t, 0.3f, 0.5f));
+                float strike = ease(t, 0.3f, 0.5f) * (1.0f - ease(t, 0.6f, 1.0f));
+                pose.setRotation(HumanoidBone::ArmRight, pitch(-150.0f * raise - 70.0f * strike));
+                pose.setRotation(HumanoidBone::Spine, yaw(-20.0f * raise + 25.0f * strike) * pitch(10.0f * strike));
+                pose.setRotation(HumanoidBone::ArmLeft, pitch(20.0f * strike));
+            };
+            break;
+
+        case AnimationClipId::Windup:
+            // Ends on the held pose the attack starts from
+            sampler = [length](float time, Pose& pose) {
+                float t = ease(time / length, 0.0f, 1.0f);
+                pose.setRotation(HumanoidBone::Spine, pitch(-15.0f * t));
+                pose.setRotation(HumanoidBone::Head, pitch(10.0f * t));
+                pose.setRotation(HumanoidBone::ArmLeft, pitch(-160.0f * t) * roll(-15.0f * t));
+                pose.setRotation(HumanoidBone::ArmRight, pitch(-160.0f * t) * roll(15.0f * t));
+                pose.setRotation(HumanoidBone::LegLeft, pitch(-15.0f * t));
+                pose.setRotation(HumanoidBone::LegRight, pitch(15.0f * t));
+                pose.rootOffset.y = -0.1f * t;
+            };
+            break;
+
+        case AnimationClipId::Ability:
+            sampler = [length](float time, Pose& pose) {
+                float t = time / length;
+                float spread = ease(t, 0.0f, 0.35f) * (1.0f - ease(t, 0.7f, 1.0f));
+                pose.setRotation(HumanoidBone::ArmLeft, roll(-85.0f * spread));
+                pose.setRotation(HumanoidBone::ArmRight, roll(85.0f * spread));
+                pose.setRotation(HumanoidBone::Head, pitch(-20.0f * spread));
+                pose.setRotation(HumanoidBone::Spine, pitch(-8.0f * spread));
+                pose.rootOffset.y = 0.15f * std::sin(Ogre::Math::PI * t);
+            };
+            break;
+
+        case AnimationClipId::Hit:
+            sampler = [length](float time, Pose& pose) {
+                float t = time / length;
+                float recoil = ease(t, 0.0f, 0.25f) * (1.0f - ease(t, 0.25f, 1.0f));
+                pose.setRotation(HumanoidBone::Spine, pitch(-20.0f * recoil));
+                pose.setRotation(HumanoidBone::Head, pitch(-15.0f * recoil));
+                pose.setRotation(HumanoidBone::ArmLeft, pitch(-25.0f * recoil) * roll(-20.0f * recoil));
+                pose.setRotation(HumanoidBone::ArmRight, pitch(-25.0f * recoil) * roll(20.0f * recoil));
+                pose.rootOffset.z = -0.1f * recoil;
+            };
+            break;
+
+        case AnimationClipId::Death:
+            // Falls onto its back and stays there (the clip clamps)
+            sampler = [length](float time, Pose& pose) {
+                float t = ease(time / length, 0.0f, 1.0f);
+                float buckle = ease(time / length, 0.0f, 0.4f);
+                pose.setRotation(HumanoidBone::Spine, pitch(-85.0f * t));
+                pose.setRotation(HumanoidBone::Head, pitch(20.0f * buckle));
+                pose.setRotation(HumanoidBone::ArmLeft, roll(-60.0f * t));
+                pose.setRotation(HumanoidBone::ArmRight, roll(60.0f * t));
+                pose.setRotation(HumanoidBone::LegLeft, pitch(-80.0f * t));
+                pose.setRotation(HumanoidBone::LegRight, pitch(-70.0f * t));
+                pose.rootOffset.y = -0.85f * t;
+                pose.rootOffset.z = -0.3f * t;
+            };
+            break;
+
+        default:
+            sampler = [](float, Pose&) {};
+            break;
+    }
+
+    return build(length, info.loop, sampler);
+}
+
+} // namespace BVA
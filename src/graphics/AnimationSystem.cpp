@@ -0,0 +1,382 @@
+#include "graphics/AnimationSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace BVA {
+
+namespace {
+
+static_assert(POSE_BONES == 8, "pose blending works on one 8-wide batch");
+
+void advanceClock(float& time, float dt, float speed, bool loop, float length) {
+    time += dt * speed;
+    if (length <= 0.0f) {
+        time = 0.0f;
+    } else if (loop) {
+        time = std::fmod(time, length);
+    } else {
+        time = std::min(time, length);
+    }
+}
+
+// out = nlerp(from, to, weight) per bone, taking the short way round;
+// out may be `to`
+void blendPoses(const Pose& from, const Pose& to, float weight, Pose& out) {
+#if defined(__AVX2__)
+    __m256 ax = _mm256_load_ps(from.qx);
+    __m256 ay = _mm256_load_ps(from.qy);
+    __m256 az = _mm256_load_ps(from.qz);
+    __m256 aw = _mm256_load_ps(from.qw);
+    __m256 bx = _mm256_load_ps(to.qx);
+    __m256 by = _mm256_load_ps(to.qy);
+    __m256 bz = _mm256_load_ps(to.qz);
+    __m256 bw = _mm256_load_ps(to.qw);
+
+    __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)),
+                               _mm256_add_ps(_mm256_mul_ps(az, bz), _mm256_mul_ps(aw, bw)));
+    // Negate the target weight where the rotations lie in opposite hemispheres
+    __m256 sign = _mm256_and_ps(dot, _mm256_set1_ps(-0.0f));
+    __m256 wa = _mm256_set1_ps(1.0f - weight);
+    __m256 wb = _mm256_xor_ps(_mm256_set1_ps(weight), sign);
+
+    __m256 x = _mm256_add_ps(_mm256_mul_ps(ax, wa), _mm256_mul_ps(bx, wb));
+    __m256 y = _mm256_add_ps(_mm256_mul_ps(ay, wa), _mm256_mul_ps(by, wb));
+    __m256 z = _mm256_add_ps(_mm256_mul_ps(az, wa), _mm256_mul_ps(bz, wb));
+    __m256 w = _mm256_add_ps(_mm256_mul_ps(aw, wa), _mm256_mul_ps(bw, wb));
+
+    __m256 lengthSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+                                    _mm256_add_ps(_mm256_mul_ps(z, z), _mm256_mul_ps(w, w)));
+    __m256 invLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSq));
+
+    _mm256_store_ps(out.qx, _mm256_mul_ps(x, invLength));
+    _mm256_store_ps(out.qy, _mm256_mul_ps(y, invLength));
+    _mm256_store_ps(out.qz, _mm256_mul_ps(z, invLength));
+    _mm256_store_ps(out.qw, _mm256_mul_ps(w, invLength));
+#else
+    for (int i = 0; i < POSE_BONES; i++) {
+        float dot = from.qx[i] * to.qx[i] + from.qy[i] * to.qy[i] + from.qz[i] * to.qz[i] + from.qw[i] * to.qw[i];
+        float wa = 1.0f - weight;
+        float wb = dot < 0.0f ? -weight : weight;
+
+        float x = from.qx[i] * wa + to.qx[i] * wb;
+        float y = from.qy[i] * wa + to.qy[i] * wb;
+        float z = from.qz[i] * wa + to.qz[i] * wb;
+        float w = from.qw[i] * wa + to.qw[i] * wb;
+        float invLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+
+        out.qx[i] = x * invLength;
+        out.qy[i] = y * invLength;
+        out.qz[i] = z * invLength;
+        out.qw[i] = w * invLength;
+    }
+#endif
+    out.rootOffset = from.rootOffset + (to.rootOffset - from.rootOffset) * weight;
+}
+
+// Rows of the 3x4 matrix taking bind-pose model space to posed model space
+void writeSkinMatrix(float* dst, const Ogre::Matrix3& rotation, const Ogre::Vector3& translation) {
+    for (int row = 0; row < 3; row++) {
+        dst[row * 4 + 0] = rotation[row][0];
+        dst[row * 4 + 1] = rotation[row][1];
+        dst[row * 4 + 2] = rotation[row][2];
+        dst[row * 4 + 3] = translation[row];
+    }
+}
+
+} // namespace
+
+AnimationSystem::AnimationSystem() {
+    for (int bone = 0; bone < POSE_BONES; bone++) {
+        writeSkinMatrix(&bindPose[bone * 12], Ogre::Matrix3::IDENTITY, Ogre::Vector3::ZERO);
+    }
+    paletteData.resize(static_cast<size_t>(MAX_PALETTE_ROWS) * PALETTE_WIDTH * 4, 0.0f);
+    paletteInstances.reserve(MAX_PALETTE_ROWS);
+}
+
+AnimationSystem::~AnimationSystem() {
+    shutdown();
+}
+
+bool AnimationSystem::initialize(unsigned threadCount) {
+    size_t keys = 0;
+    size_t sampledKeys = 0;
+    for (size_t i = 0; i < clips.size(); i++) {
+        clips[i] = AnimationClip::buildHumanoid(static_cast<AnimationClipId>(i));
+        keys += clips[i].getKeyCount();
+        sampledKeys += clips[i].getSampledKeyCount();
+    }
+
+    paletteTexture = Ogre::TextureManager::getSingleton().createManual(
+        PALETTE_TEXTURE, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D,
+        PALETTE_WIDTH, MAX_PALETTE_ROWS, 0, Ogre::PF_FLOAT32_RGBA, Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+    if (!paletteTexture) {
+        std::cerr << "Failed to create bone palette texture" << std::endl;
+        return false;
+    }
+
+    if (threadCount == 0) {
+        unsigned cores = std::thread::hardware_concurrency();
+        threadCount = cores > 2 ? std::min(cores - 2, 4u) : 0;
+    }
+    stopping = false;
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.emplace_back(&AnimationSystem::workerMain, this);
+    }
+
+    std::cout << "Animation: " << clips.size() << " clips, " << keys << " of " << sampledKeys
+              << " keys kept (" << getClipBytes() / 1024.0f << " KB), " << workers.size()
+              << " pose workers" << std::endl;
+    return true;
+}
+
+void AnimationSystem::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    if (paletteTexture) {
+        Ogre::TextureManager::getSingleton().remove(paletteTexture);
+        paletteTexture.reset();
+    }
+
+    instances.clear();
+    skins.clear();
+    freeSlots.clear();
+}
+
+int AnimationSystem::addInstance() {
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<int>(instances.size());
+        instances.emplace_back();
+        skins.emplace_back();
+    }
+
+    instances[slot] = Instance();
+    instances[slot].used = true;
+    skins[slot] = bindPose;
+    return slot;
+}
+
+void AnimationSystem::removeInstance(int instance) {
+    if (instance < 0 || instance >= static_cast<int>(instances.size()) || !instances[instance].used) return;
+
+    instances[instance].used = false;
+    freeSlots.push_back(instance);
+}
+
+void AnimationSystem::play(int id, AnimationClipId clip, bool loop, float speed, float blendTime) {
+    if (id < 0 || id >= static_cast<int>(instances.size()) || clip == AnimationClipId::Count) return;
+
+    Instance& instance = instances[id];
+    if (!instance.used) return;
+
+    if (loop && instance.loop && instance.clip == clip) {
+        instance.speed = speed;
+        return;
+    }
+
+    instance.fromClip = instance.clip;
+    instance.fromTime = instance.time;
+    instance.fromSpeed = instance.speed;
+    instance.fromLoop = instance.loop;
+
+    instance.clip = clip;
+    instance.time = 0.0f;
+    instance.speed = speed;
+    instance.loop = loop;
+    instance.blend = blendTime > 0.0f ? 0.0f : 1.0f;
+    instance.blendRate = blendTime > 0.0f ? 1.0f / blendTime : 0.0f;
+    instance.dirty = true;
+}
+
+void AnimationSystem::update(float dt) {
+    for (Instance& instance : instances) {
+        if (!instance.used) continue;
+
+        advanceClock(instance.time, dt, instance.speed, instance.loop, getClip(instance.clip).getLength());
+        if (instance.blend < 1.0f) {
+            advanceClock(instance.fromTime, dt, instance.fromSpeed, instance.fromLoop,
+                         getClip(instance.fromClip).getLength());
+            instance.blend = std::min(1.0f, instance.blend + instance.blendRate * dt);
+        }
+    }
+}
+
+void AnimationSystem::beginPalette(const Ogre::Camera* camera) {
+    frameIndex++;
+    paletteRows = 0;
+    paletteInstances.clear();
+    dueInstances.clear();
+
+    if (camera) {
+        cameraPosition = camera->getDerivedPosition();
+        screenScale = 1.0f / std::max(Ogre::Math::Tan(camera->getFOVy() * 0.5f), 0.001f);
+    }
+}
+
+int AnimationSystem::addToPalette(int id, const Ogre::Vector3& position, float radius) {
+    if (paletteRows >= MAX_PALETTE_ROWS) return -1;
+
+    int row = static_cast<int>(paletteRows++);
+    if (id < 0 || id >= static_cast<int>(instances.size()) || !instances[id].used) {
+        paletteInstances.push_back(-1);
+        return row;
+    }
+    paletteInstances.push_back(id);
+
+    Instance& instance = instances[id];
+    if (instance.paletteFrame == frameIndex) return row;
+    instance.paletteFrame = frameIndex;
+
+    float distance = std::max(cameraPosition.distance(position), 0.001f);
+    float screenSize = radius * screenScale / distance;
+    uint64_t interval = screenSize >= FULL_RATE_SCREEN_SIZE ? 1 : screenSize >= HALF_RATE_SCREEN_SIZE ? 2 : 4;
+
+    // Staggered by instance so reduced-rate characters spread over frames
+    if (instance.dirty || (frameIndex + static_cast<uint64_t>(id)) % interval == 0) {
+        instance.dirty = false;
+        dueInstances.push_back(id);
+    }
+    return row;
+}
+
+void AnimationSystem::commitPalette() {
+    evaluated = dueInstances.size();
+    runEvaluations();
+
+    for (size_t row = 0; row < paletteRows; row++) {
+        int id = paletteInstances[row];
+        const SkinRow& skin = id >= 0 ? skins[id] : bindPose;
+        std::copy(skin.begin(), skin.end(), paletteData.begin() + row * skin.size());
+    }
+
+    if (!paletteTexture || paletteRows == 0) return;
+
+    uint32_t rows = static_cast<uint32_t>(paletteRows);
+    Ogre::PixelBox box(Ogre::Box(0, 0, PALETTE_WIDTH, rows), Ogre::PF_FLOAT32_RGBA, paletteData.data());
+    paletteTexture->getBuffer()->blitFromMemory(box, Ogre::Box(0, 0, PALETTE_WIDTH, rows));
+}
+
+void AnimationSystem::evaluate(int id) {
+    const Instance& instance = instances[id];
+
+    Pose pose;
+    getClip(instance.clip).sample(instance.time, pose);
+    if (instance.blend < 1.0f) {
+        Pose from;
+        getClip(instance.fromClip).sample(instance.fromTime, from);
+        blendPoses(from, pose, instance.blend, pose);
+    }
+
+    // Local rotations to model space; parents always precede their children
+    std::array<Ogre::Quaternion, HUMANOID_BONE_COUNT> rotations;
+    std::array<Ogre::Vector3, HUMANOID_BONE_COUNT> joints;
+
+    SkinRow& skin = skins[id];
+    for (int bone = 0; bone < HUMANOID_BONE_COUNT; bone++) {
+        Ogre::Quaternion local(pose.qw[bone], pose.qx[bone], pose.qy[bone], pose.qz[bone]);
+        Ogre::Vector3 bindJoint = HumanoidSkeleton::joint(bone);
+        int parent = HumanoidSkeleton::parent(bone);
+
+        if (parent < 0) {
+            rotations[bone] = local;
+            joints[bone] = bindJoint + pose.rootOffset;
+        } else {
+            rotations[bone] = rotations[parent] * local;
+            joints[bone] = joints[parent] + rotations[parent] * (bindJoint - HumanoidSkeleton::joint(parent));
+        }
+
+        Ogre::Matrix3 rotation;
+        rotations[bone].ToRotationMatrix(rotation);
+        writeSkinMatrix(&skin[bone * 12], rotation, joints[bone] - rotation * bindJoint);
+    }
+}
+
+void AnimationSystem::runEvaluations() {
+    nextJob = 0;
+    if (workers.empty() || dueInstances.size() < MIN_PARALLEL_POSES) {
+        drainJobs();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobGeneration++;
+        workersBusy = workers.size();
+    }
+    jobReady.notify_all();
+
+    drainJobs();
+
+    std::unique_lock<std::mutex> lock(jobMutex);
+    jobDone.wait(lock, [this] { return workersBusy == 0; });
+}
+
+void AnimationSystem::drainJobs() {
+    const size_t count = dueInstances.size();
+    for (size_t first = nextJob.fetch_add(JOB_BATCH); first < count; first = nextJob.fetch_add(JOB_BATCH)) {
+        size_t last = std::min(first + JOB_BATCH, count);
+        for (size_t i = first; i < last; i++) {
+            evaluate(dueInstances[i]);
+        }
+    }
+}
+
+void AnimationSystem::workerMain() {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobReady.wait(lock, [this, seen] { return stopping || jobGeneration != seen; });
+            if (stopping) return;
+            seen = jobGeneration;
+        }
+
+        drainJobs();
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            workersBusy--;
+        }
+        jobDone.notify_one();
+    }
+}
+
+void AnimationSystem::bindPalette(Ogre::Pass* pass) {
+    Ogre::TextureUnitState* unit = pass->createTextureUnitState(PALETTE_TEXTURE);
+    unit->setTextureFiltering(Ogre::TFO_NONE);
+    unit->setTextureAddressingMode(Ogre::TextureUnitState::TAM_CLAMP);
+
+    auto params = pass->getVertexProgramParameters();
+    params->setNamedConstant("bonePalette", static_cast<int>(pass->getTextureUnitStateIndex(unit)));
+    params->setNamedAutoConstant("boneRowBase", Ogre::GpuProgramParameters::ACT_CUSTOM, BONE_ROW_PARAM);
+}
+
+const AnimationClip& AnimationSystem::getClip(AnimationClipId clip) const {
+    return clips[std::min(static_cast<size_t>(clip), clips.size() - 1)];
+}
+
+size_t AnimationSystem::getClipBytes() const {
+    size_t bytes = 0;
+    for (const AnimationClip& clip : clips) {
+        bytes += clip.getByteSize();
+    }
+    return bytes;
+}
+
+} // namespace BVA
@@ -0,0 +1,130 @@
+#include "graphics/CameraController.hpp"
+#include "graphics/NoiseGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace BVA {
+
+namespace {
+
+// The noise lattice wraps every NOISE_PERIOD cells, so time wraps with it
+// without a seam (and never grows large enough to lose precision)
+constexpr int NOISE_PERIOD = 256;
+constexpr uint32_t NOISE_SEED = 0x5eed;
+
+} // namespace
+
+CameraController::CameraController(Ogre::Camera* cam) : camera(cam) {
+    // The camera as GraphicsEngine set it up, looking at the arena centre
+    Ogre::Vector3 offset = camera->getPosition();
+    baseDistance = std::max(1.0f, offset.length());
+    distance = baseDistance;
+    viewDirection = offset.isZeroLength() ? Ogre::Vector3::UNIT_Z : offset.normalisedCopy();
+
+    // Camera looks down -Z, so +Z points from the focus to the camera
+    Ogre::Vector3 xAxis = Ogre::Vector3::UNIT_Y.crossProduct(viewDirection).normalisedCopy();
+    Ogre::Vector3 yAxis = viewDirection.crossProduct(xAxis);
+    rigOrientation.FromAxes(xAxis, yAxis, viewDirection);
+    rigPosition = focus + viewDirection * distance;
+}
+
+void CameraController::update(float dt) {
+    time = std::fmod(time + dt, NOISE_PERIOD / SHAKE_FREQUENCY);
+
+    // Linear fade per second, not per call
+    for (TraumaSource& source : sources) {
+        source.trauma = std::max(0.0f, source.trauma - source.decayPerSecond * dt);
+    }
+
+    updateRig(dt);
+    applyShake();
+}
+
+void CameraController::setTargets(const std::vector<Ogre::Vector3>& positions) {
+    targets.assign(positions.begin(), positions.end());
+}
+
+void CameraController::addTrauma(float trauma, float duration) {
+    if (trauma <= 0.0f || duration <= 0.0f) return;
+
+    // A free slot, else the weakest source if this one is stronger
+    TraumaSource* slot = &sources[0];
+    for (TraumaSource& source : sources) {
+        if (source.trauma < slot->trauma) slot = &source;
+    }
+    trauma = std::min(trauma, 1.0f);
+    if (slot->trauma >= trauma) return;
+
+    slot->trauma = trauma;
+    slot->decayPerSecond = trauma / duration;
+}
+
+void CameraController::clearShake() {
+    sources.fill(TraumaSource{});
+}
+
+float CameraController::getTrauma() const {
+    float total = 0.0f;
+    for (const TraumaSource& source : sources) {
+        total += source.trauma;
+    }
+    return std::min(total, 1.0f);
+}
+
+void CameraController::updateRig(float dt) {
+    Ogre::Vector3 goalFocus = Ogre::Vector3::ZERO;
+    float goalDistance = baseDistance;
+
+    if (!targets.empty()) {
+        for (const Ogre::Vector3& target : targets) {
+            goalFocus += target;
+        }
+        goalFocus /= static_cast<float>(targets.size());
+
+        float radius = 0.0f;
+        for (const Ogre::Vector3& target : targets) {
+            radius = std::max(radius, target.distance(goalFocus));
+        }
+
+        // Back off until a sphere around every target fits the narrower FOV
+        Ogre::Radian fovY = camera->getFOVy();
+        Ogre::Radian fovX = 2.0f * Ogre::Math::ATan(Ogre::Math::Tan(fovY * 0.5f) * camera->getAspectRatio());
+        float halfFov = std::min(fovX, fovY).valueRadians() * 0.5f;
+        goalDistance = std::max(baseDistance, (radius + FRAME_MARGIN) / std::sin(halfFov));
+    }
+
+    // The same fraction of the gap closes per second at any frame rate
+    float blend = 1.0f - std::exp(-FOLLOW_SHARPNESS * dt);
+    focus += (goalFocus - focus) * blend;
+    distance += (goalDistance - distance) * blend;
+    rigPosition = focus + viewDirection * distance;
+}
+
+void CameraController::applyShake() {
+    float shake = getTrauma();
+    shake *= shake;
+
+    if (shake <= 0.0f) {
+        camera->setPosition(rigPosition);
+        camera->setOrientation(rigOrientation);
+        return;
+    }
+
+    // One noise row per channel; smooth over time, unlike per-tick rand()
+    float x = time * SHAKE_FREQUENCY;
+    auto channel = [x](int index) {
+        return NoiseGenerator::gradientNoise(x, index * 3.0f + 0.5f, NOISE_PERIOD, NOISE_SEED);
+    };
+
+    Ogre::Vector3 offset(channel(0), channel(1), channel(2));
+    Ogre::Degree yaw(channel(3) * MAX_SHAKE_ANGLE * shake);
+    Ogre::Degree pitch(channel(4) * MAX_SHAKE_ANGLE * shake);
+    Ogre::Degree roll(channel(5) * MAX_SHAKE_ANGLE * shake);
+
+    camera->setPosition(rigPosition + rigOrientation * (offset * MAX_SHAKE_OFFSET * shake));
+    camera->setOrientation(rigOrientation * Ogre::Quaternion(yaw, Ogre::Vector3::UNIT_Y) *
+                           Ogre::Quaternion(pitch, Ogre::Vector3::UNIT_X) *
+                           Ogre::Quaternion(roll, Ogre::Vector3::UNIT_Z));
+}
+
+} // namespace BVA
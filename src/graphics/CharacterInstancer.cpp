@@ -0,0 +1,254 @@
+#include "graphics/CharacterInstancer.hpp"
+#include "graphics/AnimationSystem.hpp"
+#include "graphics/ProceduralGenerator.hpp"
+#include "graphics/ShadowCascades.hpp"
+#include "graphics/VisibilityCuller.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace BVA {
+
+// Instance ids: group index in the high bits, slot in the low 16
+namespace {
+
+constexpr int SLOT_BITS = 16;
+constexpr int SLOT_MASK = (1 << SLOT_BITS) - 1;
+
+// Raised arms and lunges reach this far past the bind-pose bounds
+constexpr float POSE_MARGIN = 0.5f;
+
+} // namespace
+
+CharacterInstancer::CharacterInstancer(Ogre::SceneManager* sm, ShadowCascades* shadowCascades,
+                                       VisibilityCuller* visibilityCuller, AnimationSystem* animationSystem)
+    : sceneManager(sm), shadows(shadowCascades), culler(visibilityCuller), animations(animationSystem) {}
+
+CharacterInstancer::~CharacterInstancer() {
+    shutdown();
+}
+
+bool CharacterInstancer::initialize() {
+    mesh = ProceduralMeshGenerator::getCharacterMesh();
+    if (!mesh) {
+        std::cerr << "Failed to build shared character mesh" << std::endl;
+        return false;
+    }
+
+    const Ogre::AxisAlignedBox& bounds = mesh->getBounds();
+    posedBounds.setExtents(bounds.getMinimum() - Ogre::Vector3(POSE_MARGIN),
+                           bounds.getMaximum() + Ogre::Vector3(POSE_MARGIN));
+    meshRadius = mesh->getBoundingSphereRadius();
+    lodCount = mesh->getNumLodLevels();
+
+    std::cout << "Character instancer initialized" << std::endl;
+    return true;
+}
+
+void CharacterInstancer::shutdown() {
+    for (auto& group : groups) {
+        if (culler) {
+            for (const Instance& instance : group->instances) {
+                if (instance.used) {
+                    culler->removeEntity(instance.cullEntity);
+                }
+            }
+        }
+        if (shadows) {
+            for (auto& batch : group->batches) {
+                shadows->removeCaster(batch.get());
+            }
+        }
+        if (group->batchNode) {
+            group->batchNode->detachAllObjects();
+            sceneManager->destroySceneNode(group->batchNode);
+        }
+    }
+    groups.clear();
+    groupIndices.clear();
+    mesh.reset();
+    lodCount = 1;
+}
+
+void CharacterInstancer::update(const Ogre::Camera* camera) {
+    // Ogre's screen_ratio_pixel_count value for a sphere of radius r at
+    // distance d is lodScale * r^2 / d^2 (its area over the viewport's)
+    float lodScale = 0.0f;
+    Ogre::Vector3 cameraPosition = Ogre::Vector3::ZERO;
+    if (camera && lodCount > 1 && camera->getProjectionType() == Ogre::PT_PERSPECTIVE) {
+        const Ogre::Matrix4& projection = camera->getProjectionMatrix();
+        lodScale = Ogre::Math::PI * projection[0][0] * projection[1][1] / 4.0f;
+        cameraPosition = camera->getDerivedPosition();
+    }
+    const Ogre::LodStrategy* strategy = mesh ? mesh->getLodStrategy() : nullptr;
+
+    for (auto& group : groups) {
+        // Pick every instance's level first, then fill the batches one level
+        // at a time so each batch's palette rows stay consecutive
+        instanceLods.assign(group->instances.size(), NOT_DRAWN);
+        for (size_t i = 0; i < group->instances.size(); i++) {
+            const Instance& instance = group->instances[i];
+            if (!instance.used || !instance.visible) continue;
+            if (culler && !culler->isVisible(instance.cullEntity)) continue;
+
+            unsigned short lod = 0;
+            if (lodScale > 0.0f && strategy) {
+                float radius = meshRadius * instance.node->_getDerivedScale().x;
+                float distanceSq = instance.node->_getDerivedPosition().squaredDistance(cameraPosition);
+                float ratio = distanceSq > 0.0f ? lodScale * radius * radius / distanceSq : 1.0f;
+                lod = mesh->getLodIndex(strategy->transformUserValue(ratio));
+            }
+            instanceLods[i] = static_cast<uint8_t>(std::min<size_t>(lod, group->batches.size() - 1));
+        }
+
+        for (size_t level = 0; level < group->batches.size(); level++) {
+            InstanceBatch* batch = group->batches[level].get();
+            batch->beginUpdate();
+            int firstRow = -1;
+
+            for (size_t i = 0; i < group->instances.size(); i++) {
+                if (instanceLods[i] != level) continue;
+                if (batch->getInstanceCount() >= batch->getMaxInstances()) break;
+
+                // Uniform scale only (characters never scale non-uniformly)
+                const Instance& instance = group->instances[i];
+                Ogre::Vector3 position = instance.node->_getDerivedPosition();
+                float scale = instance.node->_getDerivedScale().x;
+
+                // The shader finds an instance's bones at firstRow + gl_InstanceID
+                if (animations) {
+                    int row = animations->addToPalette(instance.animation, position, meshRadius * scale);
+                    if (row < 0) break;  // Palette full
+                    if (firstRow < 0) firstRow = row;
+                }
+
+                batch->addInstance(position, instance.node->_getDerivedOrientation(), scale, instance.colour);
+            }
+
+            if (animations) {
+                batch->setCustomParameter(AnimationSystem::BONE_ROW_PARAM,
+                                          Ogre::Vector4(static_cast<float>(std::max(firstRow, 0)), 0.0f, 0.0f, 0.0f));
+            }
+            batch->commit();
+        }
+    }
+}
+
+CharacterInstancer::Group& CharacterInstancer::getGroup(const std::string& name) {
+    auto it = groupIndices.find(name);
+    if (it != groupIndices.end()) {
+        return *groups[it->second];
+    }
+
+    auto group = std::make_unique<Group>();
+    group->name = name;
+    group->batchNode = sceneManager->getRootSceneNode()->createChildSceneNode();
+    createBatches(*group, INITIAL_CAPACITY);
+
+    groupIndices[name] = groups.size();
+    groups.push_back(std::move(group));
+    return *groups.back();
+}
+
+void CharacterInstancer::createBatches(Group& group, size_t capacity) {
+    for (auto& batch : group.batches) {
+        if (shadows) {
+            shadows->removeCaster(batch.get());
+        }
+        group.batchNode->detachObject(batch.get());
+    }
+    group.batches.clear();
+
+    // Any instance can land on any level, so every level gets full capacity
+    for (size_t level = 0; level < lodCount; level++) {
+        auto batch = std::make_unique<InstanceBatch>(
+            "CharacterBatch_" + group.name + "_" + std::to_string(capacity) + "_lod" + std::to_string(level),
+            mesh, "CharacterInstancedMaterial", capacity, static_cast<unsigned short>(level));
+        batch->setCastShadows(true);
+        group.batchNode->attachObject(batch.get());
+
+        if (shadows) {
+            shadows->addCaster(batch.get(), true);
+        }
+        group.batches.push_back(std::move(batch));
+    }
+}
+
+int CharacterInstancer::addInstance(const std::string& group, Ogre::SceneNode* node,
+                                    const Ogre::ColourValue& colour, int animation) {
+    if (!node || !mesh) return INVALID_INSTANCE;
+
+    Group& target = getGroup(group);
+
+    int slot;
+    if (!target.freeSlots.empty()) {
+        slot = target.freeSlots.back();
+        target.freeSlots.pop_back();
+    } else {
+        slot = static_cast<int>(target.instances.size());
+        if (slot > SLOT_MASK) return INVALID_INSTANCE;
+        target.instances.emplace_back();
+
+        // Grow the batch on registration, never during the frame
+        size_t capacity = target.batches.front()->getMaxInstances();
+        if (target.instances.size() > capacity) {
+            createBatches(target, capacity * 2);
+        }
+    }
+
+    Instance& instance = target.instances[slot];
+    instance.node = node;
+    instance.colour = colour;
+    instance.animation = animation;
+    instance.visible = true;
+    instance.used = true;
+    instance.cullEntity = culler ? culler->addEntity(node, posedBounds) : VisibilityCuller::INVALID_ENTITY;
+
+    return static_cast<int>(groupIndices[group] << SLOT_BITS) | slot;
+}
+
+CharacterInstancer::Instance* CharacterInstancer::findInstance(int instanceId) {
+    if (instanceId < 0) return nullptr;
+
+    size_t groupIndex = static_cast<size_t>(instanceId >> SLOT_BITS);
+    size_t slot = static_cast<size_t>(instanceId & SLOT_MASK);
+    if (groupIndex >= groups.size() || slot >= groups[groupIndex]->instances.size()) {
+        return nullptr;
+    }
+
+    Instance& instance = groups[groupIndex]->instances[slot];
+    return instance.used ? &instance : nullptr;
+}
+
+void CharacterInstancer::removeInstance(int instanceId) {
+    Instance* instance = findInstance(instanceId);
+    if (!instance) return;
+
+    if (culler) {
+        culler->removeEntity(instance->cullEntity);
+    }
+    instance->used = false;
+    instance->node = nullptr;
+    instance->cullEntity = VisibilityCuller::INVALID_ENTITY;
+    instance->animation = -1;
+    groups[instanceId >> SLOT_BITS]->freeSlots.push_back(instanceId & SLOT_MASK);
+}
+
+void CharacterInstancer::setInstanceVisible(int instanceId, bool visible) {
+    if (Instance* instance = findInstance(instanceId)) {
+        instance->visible = visible;
+    }
+}
+
+void CharacterInstancer::setInstanceColour(int instanceId, const Ogre::ColourValue& colour) {
+    if (Instance* instance = findInstance(instanceId)) {
+        instance->colour = colour;
+    }
+}
+
+const InstanceBatch* CharacterInstancer::getBatch(const std::string& group, size_t lod) const {
+    auto it = groupIndices.find(group);
+    if (it == groupIndices.end() || lod >= groups[it->second]->batches.size()) return nullptr;
+    return groups[it->second]->batches[lod].get();
+}
+
+} // namespace BVA
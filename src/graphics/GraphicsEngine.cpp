@@ -11,10 +11,23 @@
 // limitations under the License.
 
 #include "graphics/GraphicsEngine.hpp"
+#include "graphics/AnimationSystem.hpp"
+#include "graphics/CameraController.hpp"
 #include "graphics/PostProcessManager.hpp"
 #include "graphics/ParticleManager.hpp"
 #include "graphics/LightingManager.hpp"
+#include "graphics/LightClusters.hpp"
+#include "graphics/ShadowCascades.hpp"
+#include "graphics/CharacterInstancer.hpp"
+#include "graphics/InstanceBatch.hpp"
+#include "graphics/LevelGeometry.hpp"
+#include "graphics/RenderThread.hpp"
+#include "graphics/ShaderCache.hpp"
+#include "graphics/VisibilityCuller.hpp"
 #include "graphics/ProceduralGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 
 namespace BVA {
@@ -26,6 +39,46 @@ GraphicsEngine::~GraphicsEngine() {
 }
 
 bool GraphicsEngine::initialize() {
+    renderThread = std::make_unique<RenderThread>();
+    renderThread->start([this](FramePacket& packet) { renderFrame(packet); });
+
+    // The window and its context belong to the thread that creates them
+    bool initialized = false;
+    renderThread->runAndWait([this, &initialized] { initialized = setup(); });
+    return initialized;
+}
+
+void GraphicsEngine::shutdown() {
+    if (!renderThread) return;
+
+    renderThread->runAndWait([this] { teardown(); });
+    renderThread->stop();
+    renderThread.reset();
+}
+
+FramePacket& GraphicsEngine::getFramePacket() {
+    return renderThread->getPacket();
+}
+
+void GraphicsEngine::submitFrame(float dt) {
+    if (renderThread) {
+        renderThread->submit(dt);
+    }
+}
+
+void GraphicsEngine::runOnRenderThread(std::function<void()> task) {
+    if (renderThread) {
+        renderThread->runAndWait(std::move(task));
+    } else {
+        task();
+    }
+}
+
+float GraphicsEngine::getRenderWaitMs() const {
+    return renderThread ? renderThread->getLastWaitMs() : 0.0f;
+}
+
+bool GraphicsEngine::setup() {
     // Create Ogre root
     root = new Ogre::Root("plugins.cfg", "ogre.cfg", "ogre.log");
 
@@ -43,11 +96,19 @@ bool GraphicsEngine::initialize() {
         return false;
     }
 
+    // Clips and the bone palette, before the materials that sample it
+    animations = std::make_unique<AnimationSystem>();
+    if (!animations->initialize()) {
+        std::cerr << "Failed to initialize animation system!" << std::endl;
+        return false;
+    }
+
     // Set up resources
     setupResources();
 
     // Create scene manager
     sceneManager = root->createSceneManager(Ogre::ST_GENERIC, "MainSceneManager");
+    ProceduralMeshGenerator::initialize(sceneManager);
 
     // Set up RT Shader System
     if (Ogre::RTShader::ShaderGenerator::initialize()) {
@@ -57,13 +118,11 @@ bool GraphicsEngine::initialize() {
 
     // Set up camera
     setupCamera();
+    cameraController = std::make_unique<CameraController>(camera);
 
     // Set up viewport
     setupViewport();
 
-    // Set up PBR shaders
-    setupPBRShaders();
-
     // Create subsystems
     postProcess = std::make_unique<PostProcessManager>(viewport, sceneManager);
     if (!postProcess->initialize()) {
@@ -71,28 +130,74 @@ bool GraphicsEngine::initialize() {
         return false;
     }
 
-    particles = std::make_unique<ParticleManager>(sceneManager);
+    particles = std::make_unique<ParticleManager>(sceneManager, camera);
     if (!particles->initialize()) {
         std::cerr << "Failed to initialize particle manager!" << std::endl;
         return false;
     }
 
-    lighting = std::make_unique<LightingManager>(sceneManager);
+    lighting = std::make_unique<LightingManager>(sceneManager, camera);
     if (!lighting->initialize()) {
         std::cerr << "Failed to initialize lighting manager!" << std::endl;
         return false;
     }
 
+    // Lit materials bind the light clusters and shadow cascades
+    setupPBRShaders();
+
+    culler = std::make_unique<VisibilityCuller>();
+    characterInstancer = std::make_unique<CharacterInstancer>(sceneManager, lighting->getShadows(), culler.get(),
+                                                              animations.get());
+    if (!characterInstancer->initialize()) {
+        std::cerr << "Failed to initialize character instancer!" << std::endl;
+        return false;
+    }
+
+    levelGeometry = std::make_unique<LevelGeometry>(sceneManager, lighting->getShadows());
+
     // Create initial scene
     createScene();
 
-    // Initialize resources
-    Ogre::ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
+    // The menu only needs the shared shaders; level groups are initialised
+    // as levels stream in
+    Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
+    for (const char* group : {Ogre::ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME,
+                              Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME}) {
+        if (!rgm.isResourceGroupInitialised(group)) {
+            rgm.initialiseResourceGroup(group);
+        }
+    }
+
+    // Program binaries from earlier runs; permutations are warmed while a
+    // level streams in (LevelStreamer)
+    shaderCache = std::make_unique<ShaderCache>(shaderGenerator);
+    shaderCache->initialize("cache/shaders");
 
     return true;
 }
 
-void GraphicsEngine::shutdown() {
+void GraphicsEngine::teardown() {
+    if (shaderCache) {
+        shaderCache->shutdown();
+        shaderCache.reset();
+    }
+
+    if (levelGeometry) {
+        levelGeometry->unload();
+        levelGeometry.reset();
+    }
+
+    if (characterInstancer) {
+        characterInstancer->shutdown();
+        characterInstancer.reset();
+    }
+    culler.reset();
+
+    if (animations) {
+        animations->shutdown();
+        animations.reset();
+    }
+
     if (lighting) {
         lighting->shutdown();
         lighting.reset();
@@ -108,6 +213,8 @@ void GraphicsEngine::shutdown() {
         postProcess.reset();
     }
 
+    cameraController.reset();
+
     if (shaderGenerator) {
         Ogre::RTShader::ShaderGenerator::destroy();
         shaderGenerator = nullptr;
@@ -119,14 +226,78 @@ void GraphicsEngine::shutdown() {
     }
 }
 
-void GraphicsEngine::render() {
-    if (root && !window->isClosed()) {
-        Ogre::WindowEventUtilities::messagePump();
-        root->renderOneFrame();
+void GraphicsEngine::setGraphicsQuality(GraphicsQuality quality) {
+    // Rebuilds the compositor, so it waits for the render thread
+    runOnRenderThread([this, quality]() {
+        if (postProcess) {
+            postProcess->setGraphicsQuality(quality);
+        }
+        if (particles) {
+            particles->setGraphicsQuality(quality);
+        }
+    });
+}
+
+void GraphicsEngine::renderFrame(FramePacket& packet) {
+    // Apply the simulation's changes by kind, as documented on FramePacket:
+    // positions, then instance uploads, then commands in submission order,
+    // then the camera (culled nodes only take their position once they are
+    // visible again)
+    for (const FramePacket::NodePosition& moved : packet.positions) {
+        if (!culler || !culler->moveNode(moved.node, moved.position)) {
+            moved.node->setPosition(moved.position);
+        }
+    }
+    for (const FramePacket::InstanceUpload& upload : packet.uploads) {
+        if (!upload.batch) continue;
+        upload.batch->assignInstances(upload.data.data(), upload.count);
+        upload.batch->commit();
+    }
+    for (const auto& command : packet.commands) {
+        command();
+    }
+    if (cameraController) {
+        if (packet.cameraTargetsSet) {
+            cameraController->setTargets(packet.cameraTargets);
+        }
+        for (const FramePacket::CameraShake& shake : packet.cameraShakes) {
+            cameraController->addTrauma(shake.trauma, shake.duration);
+        }
+    }
+
+    if (!packet.render || !root) return;
+    if (window->isClosed()) {
+        windowClosed = true;
+        return;
+    }
+
+    Ogre::WindowEventUtilities::messagePump();
+    update(packet.dt);
+
+    // Ogre exposes no GPU timers, so the render call's wall time (which
+    // waits on the GPU when it is the bottleneck) drives dynamic resolution
+    auto start = std::chrono::steady_clock::now();
+    root->renderOneFrame();
+    if (postProcess) {
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        postProcess->reportFrameTime(elapsed.count());
     }
 }
 
 void GraphicsEngine::update(float dt) {
+    // Everything below sees this frame's camera
+    if (cameraController) {
+        cameraController->update(dt);
+    }
+    // Before the rest, so only visible entities are moved and gathered below
+    if (culler) {
+        culler->cull(camera);
+    }
+    // Palette rows are reserved by the instancer below
+    if (animations) {
+        animations->update(dt);
+        animations->beginPalette(camera);
+    }
     if (postProcess) {
         postProcess->update(dt);
     }
@@ -136,13 +307,65 @@ void GraphicsEngine::update(float dt) {
     if (lighting) {
         lighting->update(dt);
     }
+    if (characterInstancer) {
+        characterInstancer->update(camera);
+    }
+    if (animations) {
+        animations->commitPalette();
+    }
+}
+
+namespace {
+
+std::string levelResourceGroup(const std::string& sceneName) {
+    return "Level/" + sceneName;
+}
+
+} // namespace
+
+void GraphicsEngine::prepareLevelResources(const std::string& sceneName) {
+    std::string group = levelResourceGroup(sceneName);
+    std::string directory = "assets/levels/" + sceneName;
+
+    std::error_code ec;
+    if (sceneName.empty() || !std::filesystem::is_directory(directory, ec)) return;
+    if (std::find(levelResourceGroups.begin(), levelResourceGroups.end(), group) != levelResourceGroups.end()) {
+        return;
+    }
+
+    Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
+    rgm.createResourceGroup(group);
+    rgm.addResourceLocation(directory, "FileSystem", group);
+    rgm.initialiseResourceGroup(group);
+    rgm.loadResourceGroup(group);
+    levelResourceGroups.push_back(group);
+
+    std::cout << "Level resources loaded: " << group << std::endl;
+}
+
+void GraphicsEngine::activateLevelResources(const std::string& sceneName) {
+    std::string current = levelResourceGroup(sceneName);
+    Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
+
+    for (auto it = levelResourceGroups.begin(); it != levelResourceGroups.end();) {
+        if (*it == current) {
+            ++it;
+            continue;
+        }
+        rgm.destroyResourceGroup(*it);
+        it = levelResourceGroups.erase(it);
+    }
 }
 
 void GraphicsEngine::setupResources() {
     Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
 
-    // Initialize procedural generators
-    ProceduralMeshGenerator::initialize(sceneManager);
+    // Custom GLSL programs
+    rgm.addResourceLocation("shaders", "FileSystem",
+                            Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    // Initialize procedural generators (mesh generator needs the scene manager,
+    // so it is initialized once that exists)
     ProceduralTextureGenerator::initialize();
     ProceduralAudioGenerator::initialize();
 
@@ -150,8 +373,14 @@ void GraphicsEngine::setupResources() {
     ProceduralTextureGenerator::createCharacterMaterial("CharacterMaterial", Ogre::ColourValue(0.8f, 0.8f, 0.9f));
     ProceduralTextureGenerator::createGlowingMaterial("GlowingMaterial", Ogre::ColourValue(0.5f, 0.8f, 1.0f));
     ProceduralTextureGenerator::createEnergyMaterial("EnergyMaterial", Ogre::ColourValue(0.3f, 0.7f, 1.0f));
-    ProceduralTextureGenerator::createMetallicMaterial("ArenaMaterial", Ogre::ColourValue(0.2f, 0.2f, 0.3f));
     ProceduralTextureGenerator::createGlowingMaterial("SkyMaterial", Ogre::ColourValue(0.3f, 0.5f, 0.8f));
+    ProceduralTextureGenerator::createShadowCasterMaterial("ShadowCasterMaterial", false);
+    ProceduralTextureGenerator::createShadowCasterMaterial("InstancedShadowCasterMaterial", true);
+    ProceduralTextureGenerator::createShadowCasterMaterial("SkinnedShadowCasterMaterial", true, true);
+    ProceduralTextureGenerator::createInstancedMaterial("ProjectileInstancedMaterial", true);
+    ProceduralTextureGenerator::createInstancedMaterial("CharacterInstancedMaterial", false, true);
+    ProceduralTextureGenerator::createParticleMaterial("SimulatedParticleMaterial");
+    // Arena and prop materials need the lighting manager (setupPBRShaders)
 }
 
 void GraphicsEngine::setupCamera() {
@@ -172,39 +401,70 @@ void GraphicsEngine::setupPBRShaders() {
     // Set up modern rendering pipeline
     sceneManager->setAmbientLight(Ogre::ColourValue(0.3f, 0.3f, 0.35f));
 
-    // Enable shadows
-    sceneManager->setShadowTechnique(Ogre::SHADOWTYPE_TEXTURE_MODULATIVE_INTEGRATED);
-    sceneManager->setShadowTextureSize(2048);
-    sceneManager->setShadowTextureCount(3);
+    // Level surfaces; their vertex colours carry the albedo
+    createPBRMaterial("ArenaMaterial", 0.6f, 0.35f);
+    createPBRMaterial("ArenaWallMaterial", 0.0f, 0.5f, 3.0f);
+    createPBRMaterial("PropMaterial", 0.1f, 0.7f);
+
+    // The instanced and particle programs walk the same clusters
+    if (LightClusterGrid* clusters = lighting->getClusters()) {
+        for (const char* name : {"ProjectileInstancedMaterial", "CharacterInstancedMaterial",
+                                 "SimulatedParticleMaterial"}) {
+            Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(name);
+            if (material) {
+                clusters->bindToPass(material->getTechnique(0)->getPass(0));
+            }
+        }
+    }
+
+    // Characters receive the sun's cascades too; projectiles glow unlit
+    if (ShadowCascades* shadows = lighting->getShadows()) {
+        Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName("CharacterInstancedMaterial");
+        if (material) {
+            shadows->bindToPass(material->getTechnique(0)->getPass(0));
+        }
+    }
+
+    // Shadows are set up by LightingManager (ShadowCascades)
 }
 
 void GraphicsEngine::createScene() {
-    // Create procedural arena
-    Ogre::ManualObject* arena = ProceduralMeshGenerator::createArena("MainArena", 50.0f);
-    Ogre::SceneNode* arenaNode = sceneManager->getRootSceneNode()->createChildSceneNode();
-    arenaNode->attachObject(arena);
+    // Bare arena until a level is loaded; its static geometry registers
+    // itself with the shadow cascades
+    levelGeometry->load("");
 
     // Create procedural sky dome
     Ogre::ManualObject* sky = ProceduralMeshGenerator::createSkyDome("SkyDome");
     Ogre::SceneNode* skyNode = sceneManager->getRootSceneNode()->createChildSceneNode();
     skyNode->attachObject(sky);
+    sky->setCastShadows(false);
+
+    // Cascades are fitted to the arena, with headroom for jumps and
+    // projectiles above the walls
+    if (ShadowCascades* shadows = lighting->getShadows()) {
+        Ogre::AxisAlignedBox shadowBounds = levelGeometry->getBounds();
+        shadowBounds.merge(shadowBounds.getMaximum() + Ogre::Vector3(0.0f, 10.0f, 0.0f));
+        shadows->setBounds(shadowBounds);
+    }
 
-    // Create main directional light (sun)
-    Ogre::Light* sunLight = sceneManager->createLight("SunLight");
-    sunLight->setType(Ogre::Light::LT_DIRECTIONAL);
-    sunLight->setDirection(Ogre::Vector3(-0.5f, -1.0f, -0.3f).normalisedCopy());
-    sunLight->setDiffuseColour(Ogre::ColourValue(1.0f, 0.95f, 0.9f));
-    sunLight->setSpecularColour(Ogre::ColourValue(1.0f, 1.0f, 1.0f));
+    // Scene lights go through the lighting manager so the point lights are
+    // clustered for PBR materials
+    Ogre::Vector3 sunDirection(-0.5f, -1.0f, -0.3f);
+    lighting->createDirectionalLight(sunDirection, Ogre::ColourValue(1.0f, 0.95f, 0.9f))
+        ->setSpecularColour(Ogre::ColourValue(1.0f, 1.0f, 1.0f));
+
+    // Entities hidden below the floor are skipped, unless their
+    // shadow could still reach the view
+    for (const auto& quad : ProceduralMeshGenerator::getArenaOccluders(50.0f)) {
+        culler->addOccluder(quad);
+    }
+    culler->setShadowDirection(sunDirection);
 
     // Add point lights for dramatic effect
     for (int i = 0; i < 4; i++) {
         float angle = i * M_PI / 2.0f;
         float radius = 20.0f;
 
-        Ogre::Light* light = sceneManager->createLight("PointLight" + std::to_string(i));
-        light->setType(Ogre::Light::LT_POINT);
-        light->setPosition(Ogre::Vector3(cos(angle) * radius, 5.0f, sin(angle) * radius));
-
         // Colored lights for atmosphere
         Ogre::ColourValue colors[] = {
             Ogre::ColourValue(1.0f, 0.3f, 0.3f),  // Red
@@ -213,9 +473,9 @@ void GraphicsEngine::createScene() {
             Ogre::ColourValue(1.0f, 1.0f, 0.3f)   // Yellow
         };
 
-        light->setDiffuseColour(colors[i]);
+        Ogre::Light* light = lighting->createPointLight(
+            Ogre::Vector3(cos(angle) * radius, 5.0f, sin(angle) * radius), colors[i], 50.0f);
         light->setSpecularColour(Ogre::ColourValue::White);
-        light->setAttenuation(50.0f, 1.0f, 0.045f, 0.0075f);
     }
 }
 
@@ -229,38 +489,52 @@ Ogre::Entity* GraphicsEngine::createEntity(const std::string& meshName) {
     return sceneManager->createEntity(entityName, meshName);
 }
 
-Ogre::MaterialPtr GraphicsEngine::createPBRMaterial(const std::string& name,
-                                                     const std::string& albedoTexture,
-                                                     const std::string& normalTexture,
-                                                     const std::string& metallicTexture,
-                                                     const std::string& roughnessTexture) {
+Ogre::MaterialPtr GraphicsEngine::createPBRMaterial(const std::string& name, float metallic, float roughness,
+                                                     float emissive) {
     Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().create(name, "General");
     Ogre::Pass* pass = material->getTechnique(0)->getPass(0);
 
-    // Set up PBR textures
-    if (!albedoTexture.empty()) {
-        Ogre::TextureUnitState* albedo = pass->createTextureUnitState(albedoTexture);
-        albedo->setTextureAddressingMode(Ogre::TextureUnitState::TAM_WRAP);
+    // PBR.vert/PBR.frag: main light per pass, point and spot lights from
+    // the light clusters
+    auto& programManager = Ogre::HighLevelGpuProgramManager::getSingleton();
+    const std::string& group = Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+    if (!programManager.resourceExists("PBRVP", group)) {
+        auto vp = programManager.createProgram("PBRVP", group, "glsl", Ogre::GPT_VERTEX_PROGRAM);
+        vp->setSourceFile("PBR.vert");
+        auto fp = programManager.createProgram("PBRFP", group, "glsl", Ogre::GPT_FRAGMENT_PROGRAM);
+        fp->setSourceFile("PBR.frag");
     }
 
-    if (!normalTexture.empty()) {
-        Ogre::TextureUnitState* normal = pass->createTextureUnitState(normalTexture);
-        normal->setTextureAddressingMode(Ogre::TextureUnitState::TAM_WRAP);
+    pass->setVertexProgram("PBRVP");
+    pass->setFragmentProgram("PBRFP");
+    pass->setMaxSimultaneousLights(1);
+
+    auto vpParams = pass->getVertexProgramParameters();
+    vpParams->setNamedAutoConstant("worldViewProj", Ogre::GpuProgramParameters::ACT_WORLDVIEWPROJ_MATRIX);
+    vpParams->setNamedAutoConstant("world", Ogre::GpuProgramParameters::ACT_WORLD_MATRIX);
+    vpParams->setNamedAutoConstant("worldView", Ogre::GpuProgramParameters::ACT_WORLDVIEW_MATRIX);
+    vpParams->setNamedAutoConstant("lightPos", Ogre::GpuProgramParameters::ACT_LIGHT_POSITION, 0);
+    vpParams->setNamedAutoConstant("cameraPos", Ogre::GpuProgramParameters::ACT_CAMERA_POSITION);
+
+    auto fpParams = pass->getFragmentProgramParameters();
+    fpParams->setNamedAutoConstant("lightColor", Ogre::GpuProgramParameters::ACT_LIGHT_DIFFUSE_COLOUR, 0);
+    fpParams->setNamedAutoConstant("time", Ogre::GpuProgramParameters::ACT_TIME);
+    fpParams->setNamedConstant("metallic", metallic);
+    fpParams->setNamedConstant("roughness", roughness);
+    fpParams->setNamedConstant("emissive", emissive);
+
+    if (emissive > 0.0f) {
+        pass->setSceneBlending(Ogre::SBT_ADD);
+        pass->setDepthWriteEnabled(false);
     }
 
-    if (!metallicTexture.empty()) {
-        Ogre::TextureUnitState* metallic = pass->createTextureUnitState(metallicTexture);
+    if (lighting && lighting->getClusters()) {
+        lighting->getClusters()->bindToPass(pass);
     }
-
-    if (!roughnessTexture.empty()) {
-        Ogre::TextureUnitState* roughness = pass->createTextureUnitState(roughnessTexture);
+    if (lighting && lighting->getShadows()) {
+        lighting->getShadows()->bindToPass(pass);
     }
 
-    // Enable lighting
-    pass->setLightingEnabled(true);
-    pass->setSpecular(Ogre::ColourValue::White);
-    pass->setShininess(32.0f);
-
     return material;
 }
 
@@ -0,0 +1,128 @@
+#include "graphics/InstanceBatch.hpp"
+#include <iostream>
+#include <algorithm>
+
+namespace BVA {
+
+InstanceBatch::InstanceBatch(const std::string& name, const Ogre::MeshPtr& sourceMesh,
+                             const std::string& materialName, size_t capacity, unsigned short lod)
+    : Ogre::SimpleRenderable(name), mesh(sourceMesh), maxInstances(capacity) {
+    Ogre::SubMesh* subMesh = mesh->getSubMesh(0);
+    Ogre::VertexData* sourceData = subMesh->useSharedVertices ? mesh->sharedVertexData
+                                                              : subMesh->vertexData;
+
+    // Share the mesh's vertex buffers, but give the batch its own declaration
+    // so the instance stream can be appended without touching the mesh
+    mRenderOp.vertexData = sourceData->clone(false);
+    // LOD levels index the same vertices; levels the mesh lacks fall back
+    // to the coarsest one it has
+    lodIndex = std::min<unsigned short>(lod, static_cast<unsigned short>(subMesh->mLodFaceList.size()));
+    mRenderOp.indexData = lodIndex == 0 ? subMesh->indexData : subMesh->mLodFaceList[lodIndex - 1];
+    mRenderOp.useIndexes = subMesh->indexData && subMesh->indexData->indexCount > 0;
+    mRenderOp.operationType = subMesh->operationType;
+    mRenderOp.numberOfInstances = 0;
+
+    // Instance data goes into the first free texture coordinate slots
+    Ogre::VertexDeclaration* decl = mRenderOp.vertexData->vertexDeclaration;
+    unsigned short firstTexCoord = 0;
+    while (decl->findElementBySemantic(Ogre::VES_TEXTURE_COORDINATES, firstTexCoord)) {
+        firstTexCoord++;
+    }
+
+    unsigned short source = mRenderOp.vertexData->vertexBufferBinding->getNextIndex();
+    size_t offset = 0;
+    for (unsigned short i = 0; i < 4; i++) {
+        decl->addElement(source, offset, Ogre::VET_FLOAT4,
+                         Ogre::VES_TEXTURE_COORDINATES, firstTexCoord + i);
+        offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT4);
+    }
+
+    instanceBuffer = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        offset, maxInstances, Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+    instanceBuffer->setIsInstanceData(true);
+    instanceBuffer->setInstanceDataStepRate(1);
+    mRenderOp.vertexData->vertexBufferBinding->setBinding(source, instanceBuffer);
+
+    instanceData.resize(maxInstances * FLOATS_PER_INSTANCE, 0.0f);
+    meshRadius = mesh->getBoundingSphereRadius();
+
+    setMaterial(Ogre::MaterialManager::getSingleton().getByName(materialName));
+    setBoundingBox(Ogre::AxisAlignedBox::BOX_NULL);
+    setCastShadows(false);
+    setVisible(false);
+}
+
+InstanceBatch::~InstanceBatch() {
+    // Index data belongs to the mesh; only the cloned vertex data is ours
+    delete mRenderOp.vertexData;
+    mRenderOp.vertexData = nullptr;
+    mRenderOp.indexData = nullptr;
+}
+
+void InstanceBatch::beginUpdate() {
+    instanceCount = 0;
+}
+
+bool InstanceBatch::addInstance(const Ogre::Vector3& position, const Ogre::Quaternion& orientation,
+                                float scale, const Ogre::ColourValue& colour) {
+    if (instanceCount >= maxInstances) return false;
+
+    packInstance(&instanceData[instanceCount * FLOATS_PER_INSTANCE], position, orientation, scale, colour);
+    instanceCount++;
+    return true;
+}
+
+void InstanceBatch::packInstance(float* dst, const Ogre::Vector3& position,
+                                 const Ogre::Quaternion& orientation, float scale,
+                                 const Ogre::ColourValue& colour) {
+    Ogre::Matrix3 rotation;
+    orientation.ToRotationMatrix(rotation);
+
+    for (int row = 0; row < 3; row++) {
+        dst[row * 4 + 0] = rotation[row][0] * scale;
+        dst[row * 4 + 1] = rotation[row][1] * scale;
+        dst[row * 4 + 2] = rotation[row][2] * scale;
+        dst[row * 4 + 3] = position[row];
+    }
+    dst[12] = colour.r;
+    dst[13] = colour.g;
+    dst[14] = colour.b;
+    dst[15] = colour.a;
+}
+
+void InstanceBatch::assignInstances(const float* data, size_t count) {
+    instanceCount = std::min(count, maxInstances);
+    std::copy(data, data + instanceCount * FLOATS_PER_INSTANCE, instanceData.begin());
+}
+
+void InstanceBatch::commit() {
+    mRenderOp.numberOfInstances = instanceCount;
+
+    if (instanceCount == 0) {
+        setVisible(false);
+        return;
+    }
+
+    // Bounds enclose every instance so Ogre culls the batch as a whole
+    Ogre::AxisAlignedBox bounds;
+    for (size_t i = 0; i < instanceCount; i++) {
+        const float* src = &instanceData[i * FLOATS_PER_INSTANCE];
+        float scale = Ogre::Vector3(src[0], src[4], src[8]).length();
+        Ogre::Vector3 center(src[3], src[7], src[11]);
+        Ogre::Vector3 extent(meshRadius * scale);
+        bounds.merge(center - extent);
+        bounds.merge(center + extent);
+    }
+    setBoundingBox(bounds);
+    boundingRadius = bounds.getHalfSize().length();
+
+    instanceBuffer->writeData(0, instanceCount * FLOATS_PER_INSTANCE * sizeof(float),
+                              instanceData.data(), true);
+    setVisible(true);
+}
+
+Ogre::Real InstanceBatch::getSquaredViewDepth(const Ogre::Camera* cam) const {
+    return mBox.getCenter().squaredDistance(cam->getDerivedPosition());
+}
+
+} // namespace BVA
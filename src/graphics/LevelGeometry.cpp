@@ -0,0 +1,318 @@
+#include "graphics/LevelGeometry.hpp"
+#include "graphics/ProceduralGenerator.hpp"
+#include "graphics/ShadowCascades.hpp"
+#include "core/AssetBaker.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+namespace BVA {
+
+const AssetBaker* LevelGeometry::baked = nullptr;
+
+namespace {
+
+// Bump when layouts or the placement rules change, so cached ones are rebuilt
+constexpr uint32_t LEVEL_LAYOUT_VERSION = 1;
+
+constexpr float ARENA_SIZE = 50.0f;
+
+// Props stand in a ring between the fighting area and the arena edge
+struct PropGroup {
+    PropKind kind;
+    int count;
+    float minRadius;
+    float maxRadius;
+};
+
+struct SceneLayout {
+    const char* sceneName;
+    std::vector<PropGroup> props;
+};
+
+const SceneLayout SCENE_LAYOUTS[] = {
+    {"classroom_scene", {{PropKind::Desk, 24, 15.0f, 22.0f}, {PropKind::Shelf, 6, 22.0f, 23.5f}}},
+    {"cafeteria_scene", {{PropKind::Table, 10, 16.0f, 22.0f}, {PropKind::Bench, 14, 15.0f, 23.0f},
+                         {PropKind::Crate, 6, 22.0f, 23.5f}}},
+    {"gym_scene", {{PropKind::Bench, 16, 18.0f, 23.0f}, {PropKind::Crate, 8, 16.0f, 23.0f}}},
+    {"library_scene", {{PropKind::Shelf, 20, 17.0f, 23.5f}, {PropKind::Table, 4, 15.0f, 18.0f}}},
+    {"janitor_scene", {{PropKind::Crate, 30, 15.0f, 23.5f}, {PropKind::Shelf, 4, 22.0f, 23.5f}}},
+    {"final_scene", {{PropKind::Pillar, 8, 19.0f, 21.0f}}},
+};
+
+// Radius each prop keeps clear around itself (before scaling)
+float propFootprint(PropKind kind) {
+    switch (kind) {
+        case PropKind::Desk: return 0.8f;
+        case PropKind::Table: return 1.2f;
+        case PropKind::Shelf: return 1.0f;
+        case PropKind::Crate: return 0.6f;
+        case PropKind::Pillar: return 0.7f;
+        case PropKind::Bench: return 1.1f;
+        case PropKind::Count: break;
+    }
+    return 1.0f;
+}
+
+const SceneLayout* findLayout(const std::string& sceneName) {
+    for (const SceneLayout& layout : SCENE_LAYOUTS) {
+        if (sceneName == layout.sceneName) return &layout;
+    }
+    return nullptr;
+}
+
+std::string layoutKey(const std::string& sceneName) {
+    return "level/" + sceneName;
+}
+
+// Same scene, same layout: the placement seed comes from the scene name
+uint32_t seedFromName(const std::string& name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+LevelGeometry::LevelGeometry(Ogre::SceneManager* sm, ShadowCascades* shadowCascades)
+    : sceneManager(sm), shadows(shadowCascades) {}
+
+LevelGeometry::~LevelGeometry() {
+    discardPrepared();
+    unload();
+}
+
+void LevelGeometry::registerBakeJobs(AssetBaker& assets) {
+    baked = &assets;
+
+    for (const SceneLayout& layout : SCENE_LAYOUTS) {
+        std::string sceneName = layout.sceneName;
+        assets.addJob(layoutKey(sceneName), "", LEVEL_LAYOUT_VERSION,
+                      [sceneName]() { return buildLayout(sceneName); });
+    }
+}
+
+std::vector<uint8_t> LevelGeometry::buildLayout(const std::string& sceneName) {
+    std::vector<PropPlacement> placements;
+
+    if (const SceneLayout* layout = findLayout(sceneName)) {
+        std::mt19937 rng(seedFromName(sceneName));
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        for (const PropGroup& group : layout->props) {
+            float footprint = propFootprint(group.kind);
+
+            for (int i = 0; i < group.count; i++) {
+                // A few tries for a spot clear of the props placed so far
+                for (int attempt = 0; attempt < 16; attempt++) {
+                    float angle = unit(rng) * Ogre::Math::TWO_PI;
+                    float radius = group.minRadius + unit(rng) * (group.maxRadius - group.minRadius);
+                    float scale = 0.9f + unit(rng) * 0.2f;
+                    float x = std::cos(angle) * radius;
+                    float z = std::sin(angle) * radius;
+
+                    bool clear = true;
+                    for (const PropPlacement& other : placements) {
+                        float dx = other.position[0] - x;
+                        float dz = other.position[2] - z;
+                        float spacing = (footprint + propFootprint(static_cast<PropKind>(other.kind))) * 1.1f;
+                        if (dx * dx + dz * dz < spacing * spacing) {
+                            clear = false;
+                            break;
+                        }
+                    }
+                    if (!clear) continue;
+
+                    // Furniture faces the arena centre, snapped to right angles
+                    float yaw = std::round((angle + Ogre::Math::HALF_PI) / Ogre::Math::HALF_PI) * Ogre::Math::HALF_PI;
+                    placements.push_back({static_cast<uint32_t>(group.kind), {x, 0.0f, z}, yaw, scale});
+                    break;
+                }
+            }
+        }
+    }
+
+    LevelLayoutHeader header{LEVEL_LAYOUT_MAGIC, static_cast<uint32_t>(placements.size()), ARENA_SIZE};
+    std::vector<uint8_t> data(sizeof(header) + placements.size() * sizeof(PropPlacement));
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), placements.data(), placements.size() * sizeof(PropPlacement));
+    return data;
+}
+
+bool LevelGeometry::validate(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(LevelLayoutHeader)) return false;
+
+    const auto* header = reinterpret_cast<const LevelLayoutHeader*>(data);
+    if (header->magic != LEVEL_LAYOUT_MAGIC || header->arenaSize <= 0.0f) return false;
+    if (sizeof(LevelLayoutHeader) + size_t(header->propCount) * sizeof(PropPlacement) != size) return false;
+
+    const auto* placements = reinterpret_cast<const PropPlacement*>(data + sizeof(LevelLayoutHeader));
+    for (uint32_t i = 0; i < header->propCount; i++) {
+        if (placements[i].kind >= static_cast<uint32_t>(PropKind::Count)) return false;
+    }
+    return true;
+}
+
+const LevelLayoutHeader* LevelGeometry::resolveLayout(const std::string& name, std::vector<uint8_t>& built) {
+    // Baked layouts are used in place; anything else is laid out here
+    BakedAsset asset = baked && findLayout(name) ? baked->get(layoutKey(name)) : BakedAsset{};
+    if (validate(asset.data, asset.size)) {
+        return reinterpret_cast<const LevelLayoutHeader*>(asset.data);
+    }
+    built = buildLayout(name);
+    return reinterpret_cast<const LevelLayoutHeader*>(built.data());
+}
+
+void LevelGeometry::prefetch(const std::string& name) {
+    std::vector<uint8_t> built;
+    const LevelLayoutHeader* header = resolveLayout(name, built);
+    const auto* placements = reinterpret_cast<const PropPlacement*>(header + 1);
+
+    std::vector<PropKind> kinds;
+    for (uint32_t i = 0; i < header->propCount; i++) {
+        PropKind kind = static_cast<PropKind>(placements[i].kind);
+        if (std::find(kinds.begin(), kinds.end(), kind) == kinds.end()) {
+            kinds.push_back(kind);
+        }
+    }
+    ProceduralMeshGenerator::waitForLevelMeshes(header->arenaSize, kinds);
+}
+
+bool LevelGeometry::load(const std::string& name) {
+    return prepare(name) && activate();
+}
+
+bool LevelGeometry::prepare(const std::string& name) {
+    beginPrepare(name);
+    return continuePrepare(SIZE_MAX);
+}
+
+void LevelGeometry::beginPrepare(const std::string& name) {
+    discardPrepared();
+
+    pendingLayout = resolveLayout(name, pendingLayoutData);
+    nextProp = 0;
+
+    pending = sceneManager->createStaticGeometry("LevelGeometry/" + (name.empty() ? "Arena" : name) + "/" +
+                                                 std::to_string(buildCounter++));
+    pending->setRegionDimensions(Ogre::Vector3(REGION_SIZE, REGION_SIZE * 4.0f, REGION_SIZE));
+    pending->setCastShadows(true);
+    pendingSceneName = name;
+    pendingPropCount = pendingLayout->propCount;
+
+    addPending(ProceduralMeshGenerator::getArenaFloorMesh(pendingLayout->arenaSize), Ogre::Vector3::ZERO,
+               Ogre::Quaternion::IDENTITY, 1.0f);
+    addPending(ProceduralMeshGenerator::getArenaWallMesh(pendingLayout->arenaSize), Ogre::Vector3::ZERO,
+               Ogre::Quaternion::IDENTITY, 1.0f);
+}
+
+bool LevelGeometry::continuePrepare(size_t maxProps) {
+    if (!pending || !pendingLayout) return true;
+
+    const auto* placements = reinterpret_cast<const PropPlacement*>(pendingLayout + 1);
+    size_t count = std::min<size_t>(maxProps, pendingLayout->propCount - nextProp);
+    for (size_t i = 0; i < count; i++, nextProp++) {
+        const PropPlacement& prop = placements[nextProp];
+        addPending(ProceduralMeshGenerator::getPropMesh(static_cast<PropKind>(prop.kind)),
+                   Ogre::Vector3(prop.position[0], prop.position[1], prop.position[2]),
+                   Ogre::Quaternion(Ogre::Radian(prop.yaw), Ogre::Vector3::UNIT_Y), prop.scale);
+    }
+    if (nextProp < pendingLayout->propCount) return false;
+
+    // The build copies the geometry, so the entities go away right after it
+    pending->build();
+    pending->setVisible(false);
+    destroyPendingEntities();
+
+    pendingLayout = nullptr;
+    pendingLayoutData.clear();
+    return true;
+}
+
+void LevelGeometry::addPending(const Ogre::MeshPtr& mesh, const Ogre::Vector3& position,
+                               const Ogre::Quaternion& orientation, float scale) {
+    // One entity per mesh, added once per placement
+    Ogre::Entity* entity = nullptr;
+    for (Ogre::Entity* existing : pendingEntities) {
+        if (existing->getMesh() == mesh) {
+            entity = existing;
+            break;
+        }
+    }
+    if (!entity) {
+        entity = sceneManager->createEntity(mesh);
+        pendingEntities.push_back(entity);
+    }
+    pending->addEntity(entity, position, orientation, Ogre::Vector3(scale));
+}
+
+void LevelGeometry::destroyPendingEntities() {
+    for (Ogre::Entity* entity : pendingEntities) {
+        sceneManager->destroyEntity(entity);
+    }
+    pendingEntities.clear();
+}
+
+bool LevelGeometry::activate() {
+    if (!hasPrepared()) return false;
+
+    unload();
+    geometry = pending;
+    sceneName = std::move(pendingSceneName);
+    propCount = pendingPropCount;
+    pending = nullptr;
+    pendingSceneName.clear();
+    pendingPropCount = 0;
+
+    geometry->setVisible(true);
+
+    bounds.setNull();
+    auto it = geometry->getRegionIterator();
+    while (it.hasMoreElements()) {
+        Ogre::StaticGeometry::Region* region = it.getNext();
+        regions.push_back(region);
+        bounds.merge(region->getWorldBoundingBox(true));
+        if (shadows) {
+            shadows->addCaster(region, false);
+        }
+    }
+
+    std::cout << "Level geometry: " << (sceneName.empty() ? "arena" : sceneName) << ", " << propCount
+              << " props in " << regions.size() << " regions" << std::endl;
+    return true;
+}
+
+void LevelGeometry::discardPrepared() {
+    if (!pending) return;
+
+    destroyPendingEntities();
+    pendingLayout = nullptr;
+    pendingLayoutData.clear();
+    sceneManager->destroyStaticGeometry(pending);
+    pending = nullptr;
+    pendingSceneName.clear();
+    pendingPropCount = 0;
+}
+
+void LevelGeometry::unload() {
+    if (!geometry) return;
+
+    if (shadows) {
+        for (Ogre::MovableObject* region : regions) {
+            shadows->removeCaster(region);
+        }
+    }
+    regions.clear();
+
+    sceneManager->destroyStaticGeometry(geometry);
+    geometry = nullptr;
+    bounds.setNull();
+    sceneName.clear();
+    propCount = 0;
+}
+
+} // namespace BVA
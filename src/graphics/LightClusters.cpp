@@ -0,0 +1,304 @@
+#include "graphics/LightClusters.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iostream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace BVA {
+
+namespace {
+
+constexpr int LIGHT_ROWS = 4;
+const char* SHARED_PARAMS_NAME = "ClusteredLighting";
+
+static_assert(LightClusterGrid::TILE_COUNT % 8 == 0, "slices must start on a SIMD batch");
+static_assert(LightClusterGrid::MAX_LIGHTS <= 256, "hits pack the light index in 8 bits");
+
+Ogre::TexturePtr createFloatTexture(const std::string& name, int width, int height, Ogre::PixelFormat format) {
+    return Ogre::TextureManager::getSingleton().createManual(
+        name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D,
+        width, height, 0, format, Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+}
+
+} // namespace
+
+LightClusterGrid::LightClusterGrid() {
+    for (auto* bounds : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+        bounds->resize(CLUSTER_COUNT, 0.0f);
+    }
+    lightData.resize(MAX_LIGHTS * LIGHT_ROWS * 4, 0.0f);
+    clusterData.resize(CLUSTER_COUNT * 2, 0.0f);
+    indexData.resize(MAX_INDICES, 0.0f);
+    clusterCounts.resize(CLUSTER_COUNT, 0);
+    clusterOffsets.resize(CLUSTER_COUNT, 0);
+    hits.reserve(MAX_INDICES);
+}
+
+LightClusterGrid::~LightClusterGrid() {
+    shutdown();
+}
+
+bool LightClusterGrid::initialize() {
+    lightTexture = createFloatTexture("ClusterLights", static_cast<int>(MAX_LIGHTS), LIGHT_ROWS, Ogre::PF_FLOAT32_RGBA);
+    gridTexture = createFloatTexture("ClusterGrid", TILE_COUNT, SLICES, Ogre::PF_FLOAT32_GR);
+    indexTexture = createFloatTexture("ClusterLightIndices", INDEX_TEXTURE_WIDTH,
+                                      static_cast<int>(MAX_INDICES / INDEX_TEXTURE_WIDTH), Ogre::PF_FLOAT32_R);
+    if (!lightTexture || !gridTexture || !indexTexture) {
+        std::cerr << "Failed to create light cluster textures" << std::endl;
+        return false;
+    }
+
+    // Shared by every clustered material, so one update covers them all
+    auto& programManager = Ogre::GpuProgramManager::getSingleton();
+    sharedParams = programManager.createSharedParameters(SHARED_PARAMS_NAME);
+    sharedParams->addConstantDefinition("clusterParams", Ogre::GCT_FLOAT4);
+
+    std::cout << "Light clusters: " << TILES_X << "x" << TILES_Y << "x" << SLICES
+              << ", up to " << MAX_LIGHTS << " lights" << std::endl;
+    return true;
+}
+
+void LightClusterGrid::shutdown() {
+    auto& textureManager = Ogre::TextureManager::getSingleton();
+    for (Ogre::TexturePtr* texture : {&lightTexture, &gridTexture, &indexTexture}) {
+        if (*texture) {
+            textureManager.remove(*texture);
+            texture->reset();
+        }
+    }
+    sharedParams.reset();
+}
+
+int LightClusterGrid::sliceForDepth(float depth) const {
+    if (depth <= CLUSTER_NEAR) return 0;
+    int slice = static_cast<int>(std::log(depth) * sliceScale + sliceBias);
+    return std::min(std::max(slice, 0), SLICES - 1);
+}
+
+void LightClusterGrid::buildClusterBounds(const Ogre::Camera* camera) {
+    float fovY = camera->getFOVy().valueRadians();
+    float aspect = camera->getAspectRatio();
+    float nearDistance = camera->getNearClipDistance();
+    float farDistance = camera->getFarClipDistance();
+
+    // Only rebuilt when the projection changes
+    if (fovY == boundsFovY && aspect == boundsAspect &&
+        nearDistance == boundsNear && farDistance == boundsFar) {
+        return;
+    }
+    boundsFovY = fovY;
+    boundsAspect = aspect;
+    boundsNear = nearDistance;
+    boundsFar = farDistance;
+
+    float logRange = std::log(CLUSTER_FAR / CLUSTER_NEAR);
+    sliceScale = SLICES / logRange;
+    sliceBias = -SLICES * std::log(CLUSTER_NEAR) / logRange;
+
+    float tanY = std::tan(fovY * 0.5f);
+    float tanX = tanY * aspect;
+
+    for (int slice = 0; slice < SLICES; slice++) {
+        // Slice 0 reaches down to the near plane and the last one out to the
+        // far plane, matching the clamping in sliceForDepth and ClusteredLighting.glsl
+        float near = slice == 0 ? nearDistance
+                                : CLUSTER_NEAR * std::pow(CLUSTER_FAR / CLUSTER_NEAR, float(slice) / SLICES);
+        float far = slice == SLICES - 1 ? std::max(farDistance, CLUSTER_FAR)
+                                        : CLUSTER_NEAR * std::pow(CLUSTER_FAR / CLUSTER_NEAR, float(slice + 1) / SLICES);
+
+        for (int ty = 0; ty < TILES_Y; ty++) {
+            float y0 = -1.0f + 2.0f * ty / TILES_Y;
+            float y1 = -1.0f + 2.0f * (ty + 1) / TILES_Y;
+
+            for (int tx = 0; tx < TILES_X; tx++) {
+                float x0 = -1.0f + 2.0f * tx / TILES_X;
+                float x1 = -1.0f + 2.0f * (tx + 1) / TILES_X;
+
+                // The tile's frustum is widest at whichever depth is further
+                // from the axis, so take the extremes over both depths
+                int c = slice * TILE_COUNT + ty * TILES_X + tx;
+                minX[c] = std::min(x0 * tanX * near, x0 * tanX * far);
+                maxX[c] = std::max(x1 * tanX * near, x1 * tanX * far);
+                minY[c] = std::min(y0 * tanY * near, y0 * tanY * far);
+                maxY[c] = std::max(y1 * tanY * near, y1 * tanY * far);
+                minZ[c] = -far;   // Ogre cameras look down -Z
+                maxZ[c] = -near;
+            }
+        }
+    }
+}
+
+void LightClusterGrid::assignLights(const Ogre::Matrix4& view, const std::vector<ClusterLight>& lights) {
+    hits.clear();
+
+    for (size_t i = 0; i < lightCount; i++) {
+        const ClusterLight& light = lights[i];
+        Ogre::Vector3 centre = view * light.position;
+        float radius = light.range;
+        float depth = -centre.z;
+
+        if (depth + radius < boundsNear) continue;  // Behind the camera
+
+        int firstSlice = sliceForDepth(depth - radius);
+        int lastSlice = sliceForDepth(depth + radius);
+        float radiusSq = radius * radius;
+
+        for (int slice = firstSlice; slice <= lastSlice; slice++) {
+            int first = slice * TILE_COUNT;
+            int c = first;
+
+#if defined(__AVX2__)
+            // Sphere/AABB: squared distance from the centre to the box
+            const __m256 cx = _mm256_set1_ps(centre.x);
+            const __m256 cy = _mm256_set1_ps(centre.y);
+            const __m256 cz = _mm256_set1_ps(centre.z);
+            const __m256 r2 = _mm256_set1_ps(radiusSq);
+            const __m256 zero = _mm256_setzero_ps();
+
+            auto axisDistance = [&zero](__m256 centreAxis, const float* lo, const float* hi) {
+                __m256 below = _mm256_sub_ps(_mm256_loadu_ps(lo), centreAxis);
+                __m256 above = _mm256_sub_ps(centreAxis, _mm256_loadu_ps(hi));
+                __m256 d = _mm256_max_ps(_mm256_max_ps(below, above), zero);
+                return _mm256_mul_ps(d, d);
+            };
+
+            for (; c < first + TILE_COUNT; c += 8) {
+                __m256 distSq = _mm256_add_ps(
+                    _mm256_add_ps(axisDistance(cx, &minX[c], &maxX[c]), axisDistance(cy, &minY[c], &maxY[c])),
+                    axisDistance(cz, &minZ[c], &maxZ[c]));
+                int mask = _mm256_movemask_ps(_mm256_cmp_ps(distSq, r2, _CMP_LE_OQ));
+
+                while (mask) {
+                    int bit = std::countr_zero(static_cast<unsigned>(mask));
+                    hits.push_back(static_cast<uint32_t>(c + bit) << 8 | static_cast<uint32_t>(i));
+                    mask &= mask - 1;
+                }
+            }
+#endif
+
+            for (; c < first + TILE_COUNT; c++) {
+                auto axis = [](float v, float lo, float hi) {
+                    float d = std::max(std::max(lo - v, v - hi), 0.0f);
+                    return d * d;
+                };
+                float distSq = axis(centre.x, minX[c], maxX[c]) + axis(centre.y, minY[c], maxY[c]) +
+                               axis(centre.z, minZ[c], maxZ[c]);
+                if (distSq <= radiusSq) {
+                    hits.push_back(static_cast<uint32_t>(c) << 8 | static_cast<uint32_t>(i));
+                }
+            }
+        }
+    }
+
+    // Lights later in the list lose out if the index texture is full
+    if (hits.size() > MAX_INDICES) {
+        hits.resize(MAX_INDICES);
+    }
+
+    // Counting sort by cluster into compact per-cluster lists
+    std::fill(clusterCounts.begin(), clusterCounts.end(), 0);
+    for (uint32_t hit : hits) {
+        clusterCounts[hit >> 8]++;
+    }
+
+    uint32_t offset = 0;
+    maxPerCluster = 0;
+    for (int c = 0; c < CLUSTER_COUNT; c++) {
+        clusterOffsets[c] = offset;
+        clusterData[c * 2 + 0] = static_cast<float>(offset);
+        clusterData[c * 2 + 1] = static_cast<float>(clusterCounts[c]);
+        offset += clusterCounts[c];
+        maxPerCluster = std::max(maxPerCluster, clusterCounts[c]);
+    }
+
+    for (uint32_t hit : hits) {
+        indexData[clusterOffsets[hit >> 8]++] = static_cast<float>(hit & 0xFF);
+    }
+    assignedIndices = hits.size();
+}
+
+void LightClusterGrid::packLights(const std::vector<ClusterLight>& lights) {
+    auto row = [this](int r, size_t light) { return &lightData[(r * MAX_LIGHTS + light) * 4]; };
+
+    for (size_t i = 0; i < lightCount; i++) {
+        const ClusterLight& light = lights[i];
+
+        float* p = row(0, i);
+        p[0] = light.position.x;
+        p[1] = light.position.y;
+        p[2] = light.position.z;
+        p[3] = light.range;
+
+        float* c = row(1, i);
+        c[0] = light.colour.r;
+        c[1] = light.colour.g;
+        c[2] = light.colour.b;
+        c[3] = light.spot ? 1.0f : 0.0f;
+
+        float* d = row(2, i);
+        d[0] = light.direction.x;
+        d[1] = light.direction.y;
+        d[2] = light.direction.z;
+        d[3] = light.cosOuter;
+
+        float* a = row(3, i);
+        a[0] = light.cosInner;
+        a[1] = light.linear;
+        a[2] = light.quadratic;
+        a[3] = 0.0f;
+    }
+}
+
+void LightClusterGrid::upload() {
+    if (!lightTexture) return;
+
+    lightTexture->getBuffer()->blitFromMemory(
+        Ogre::PixelBox(static_cast<uint32_t>(MAX_LIGHTS), LIGHT_ROWS, 1, Ogre::PF_FLOAT32_RGBA, lightData.data()));
+    gridTexture->getBuffer()->blitFromMemory(
+        Ogre::PixelBox(TILE_COUNT, SLICES, 1, Ogre::PF_FLOAT32_GR, clusterData.data()));
+
+    // Only the rows holding this frame's indices
+    uint32_t rows = static_cast<uint32_t>((assignedIndices + INDEX_TEXTURE_WIDTH - 1) / INDEX_TEXTURE_WIDTH);
+    if (rows > 0) {
+        Ogre::PixelBox indices(Ogre::Box(0, 0, INDEX_TEXTURE_WIDTH, rows), Ogre::PF_FLOAT32_R, indexData.data());
+        indexTexture->getBuffer()->blitFromMemory(indices, Ogre::Box(0, 0, INDEX_TEXTURE_WIDTH, rows));
+    }
+
+    sharedParams->setNamedConstant("clusterParams",
+                                   Ogre::Vector4(sliceScale, sliceBias, float(TILES_X), float(TILES_Y)));
+}
+
+void LightClusterGrid::update(const Ogre::Camera* camera, const std::vector<ClusterLight>& lights) {
+    if (!camera) return;
+
+    lightCount = std::min(lights.size(), MAX_LIGHTS);
+    buildClusterBounds(camera);
+    assignLights(camera->getViewMatrix(), lights);
+    packLights(lights);
+    upload();
+}
+
+void LightClusterGrid::bindToPass(Ogre::Pass* pass) const {
+    if (!lightTexture) return;
+
+    auto addUnit = [pass](const Ogre::TexturePtr& texture) {
+        Ogre::TextureUnitState* unit = pass->createTextureUnitState();
+        unit->setTexture(texture);
+        unit->setTextureFiltering(Ogre::TFO_NONE);
+        unit->setTextureAddressingMode(Ogre::TextureUnitState::TAM_CLAMP);
+        return static_cast<int>(pass->getTextureUnitStateIndex(unit));
+    };
+
+    auto params = pass->getFragmentProgramParameters();
+    params->setNamedConstant("clusterGrid", addUnit(gridTexture));
+    params->setNamedConstant("clusterLightIndices", addUnit(indexTexture));
+    params->setNamedConstant("clusterLights", addUnit(lightTexture));
+    params->setNamedAutoConstant("viewportSize", Ogre::GpuProgramParameters::ACT_VIEWPORT_SIZE);
+    params->addSharedParameters(SHARED_PARAMS_NAME);
+}
+
+} // namespace BVA
@@ -1,9 +1,14 @@
 #include "graphics/LightingManager.hpp"
+#include "graphics/LightClusters.hpp"
+#include "graphics/ShadowCascades.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace BVA {
 
-LightingManager::LightingManager(Ogre::SceneManager* sm) : sceneManager(sm) {}
+LightingManager::LightingManager(Ogre::SceneManager* sm, Ogre::Camera* cam)
+    : sceneManager(sm), camera(cam) {}
 
 LightingManager::~LightingManager() {
     shutdown();
@@ -16,30 +21,46 @@ bool LightingManager::initialize() {
     setAmbientLight(Ogre::ColourValue(0.3f, 0.3f, 0.35f));
 
     // Enable shadows by default
+    shadows = std::make_unique<ShadowCascades>(sceneManager, camera);
     setShadowEnabled(true);
     setShadowQuality(2048, 3);
 
+    temporaryLights.resize(TEMPORARY_LIGHT_POOL_SIZE);
+
+    clusters = std::make_unique<LightClusterGrid>();
+    if (!clusters->initialize()) {
+        std::cerr << "Clustered lighting unavailable" << std::endl;
+        clusters.reset();
+    }
+
     std::cout << "Lighting manager initialized" << std::endl;
     return true;
 }
 
 void LightingManager::shutdown() {
-    // Clean up temporary lights
-    for (auto& tempLight : temporaryLights) {
-        sceneManager->destroyLight(tempLight.light);
-        sceneManager->destroySceneNode(tempLight.node);
-    }
     temporaryLights.clear();
+    activeTemporaryLights = 0;
 
-    // Clean up persistent lights
+    // Clean up persistent lights and their nodes
     for (auto* light : persistentLights) {
         sceneManager->destroyLight(light);
     }
     persistentLights.clear();
+    for (auto* node : persistentNodes) {
+        sceneManager->destroySceneNode(node);
+    }
+    persistentNodes.clear();
+
+    clusters.reset();
+    shadows.reset();
 }
 
 void LightingManager::update(float dt) {
     updateTemporaryLights(dt);
+    updateClusters();
+    if (shadows) {
+        shadows->update();
+    }
 }
 
 Ogre::Light* LightingManager::createDirectionalLight(const Ogre::Vector3& direction,
@@ -75,6 +96,7 @@ Ogre::Light* LightingManager::createPointLight(const Ogre::Vector3& position,
     node->attachObject(light);
 
     persistentLights.push_back(light);
+    persistentNodes.push_back(node);
 
     std::cout << "Created point light: " << lightName << std::endl;
     return light;
@@ -101,36 +123,112 @@ Ogre::Light* LightingManager::createSpotLight(const Ogre::Vector3& position,
     node->attachObject(light);
 
     persistentLights.push_back(light);
+    persistentNodes.push_back(node);
 
     std::cout << "Created spot light: " << lightName << std::endl;
     return light;
 }
 
-Ogre::Light* LightingManager::createTemporaryLight(const Ogre::Vector3& position,
-                                                     const Ogre::ColourValue& color,
-                                                     float duration,
-                                                     float range) {
-    std::string lightName = "TempLight_" + std::to_string(lightCounter++);
+LightHandle LightingManager::createTemporaryLight(const Ogre::Vector3& position,
+                                                   const Ogre::ColourValue& color,
+                                                   float duration,
+                                                   float range,
+                                                   LightFade fade) {
+    if (temporaryLights.empty() || duration <= 0.0f) return {};
+
+    // First free slot, otherwise steal the dimmest live light (oldest on ties)
+    TemporaryLight* slot = nullptr;
+    for (TemporaryLight& tempLight : temporaryLights) {
+        if (!tempLight.active) {
+            slot = &tempLight;
+            break;
+        }
+        if (!slot) {
+            slot = &tempLight;
+            continue;
+        }
 
-    Ogre::Light* light = sceneManager->createLight(lightName);
-    light->setType(Ogre::Light::LT_POINT);
-    light->setDiffuseColour(color);
-    light->setSpecularColour(color);
-    light->setAttenuation(range, 1.0f, 0.09f, 0.032f);
+        float brightness = tempLight.intensity * (tempLight.colour.r + tempLight.colour.g + tempLight.colour.b);
+        float slotBrightness = slot->intensity * (slot->colour.r + slot->colour.g + slot->colour.b);
+        if (brightness < slotBrightness ||
+            (brightness == slotBrightness && tempLight.spawnSerial < slot->spawnSerial)) {
+            slot = &tempLight;
+        }
+    }
 
-    // Create node
-    Ogre::SceneNode* node = sceneManager->getRootSceneNode()->createChildSceneNode();
-    node->setPosition(position);
-    node->attachObject(light);
+    if (slot->active) {
+        release(*slot);
+    }
 
-    // Add to temporary lights
-    TemporaryLight tempLight;
-    tempLight.light = light;
-    tempLight.node = node;
-    tempLight.timeRemaining = duration;
-    temporaryLights.push_back(tempLight);
+    slot->colour = color;
+    slot->duration = duration;
+    slot->age = 0.0f;
+    slot->intensity = 1.0f;
+    slot->fade = fade;
+    slot->spawnSerial = spawnCounter++;
+    slot->active = true;
+    activeTemporaryLights++;
+
+    slot->position = position;
+    slot->range = range;
+
+    LightHandle handle;
+    handle.slot = static_cast<uint32_t>(slot - temporaryLights.data());
+    handle.serial = slot->spawnSerial;
+    return handle;
+}
 
-    return light;
+LightingManager::TemporaryLight* LightingManager::resolve(const LightHandle& handle) {
+    return const_cast<TemporaryLight*>(static_cast<const LightingManager*>(this)->resolve(handle));
+}
+
+const LightingManager::TemporaryLight* LightingManager::resolve(const LightHandle& handle) const {
+    if (!handle.isValid() || handle.slot >= temporaryLights.size()) return nullptr;
+
+    const TemporaryLight& tempLight = temporaryLights[handle.slot];
+    return (tempLight.active && tempLight.spawnSerial == handle.serial) ? &tempLight : nullptr;
+}
+
+bool LightingManager::isTemporaryLightActive(const LightHandle& handle) const {
+    return resolve(handle) != nullptr;
+}
+
+void LightingManager::moveTemporaryLight(const LightHandle& handle, const Ogre::Vector3& position) {
+    if (TemporaryLight* tempLight = resolve(handle)) {
+        tempLight->position = position;
+    }
+}
+
+void LightingManager::stopTemporaryLight(const LightHandle& handle) {
+    if (TemporaryLight* tempLight = resolve(handle)) {
+        release(*tempLight);
+    }
+}
+
+void LightingManager::release(TemporaryLight& tempLight) {
+    if (!tempLight.active) return;
+
+    tempLight.intensity = 0.0f;
+    tempLight.active = false;
+    activeTemporaryLights--;
+}
+
+float LightingManager::evaluateFade(LightFade fade, float t) {
+    t = std::min(std::max(t, 0.0f), 1.0f);
+
+    switch (fade) {
+        case LightFade::Linear:
+            return 1.0f - t;
+        case LightFade::EaseOut:
+            return 1.0f - t * t * t;
+        case LightFade::Flash: {
+            float remaining = 1.0f - t;
+            return remaining * remaining * remaining * remaining;
+        }
+        case LightFade::Constant:
+            return 1.0f;
+    }
+    return 0.0f;
 }
 
 void LightingManager::setAmbientLight(const Ogre::ColourValue& color) {
@@ -154,9 +252,10 @@ void LightingManager::setShadowTechnique(Ogre::ShadowTechnique technique) {
 }
 
 void LightingManager::setShadowQuality(int textureSize, int numCascades) {
-    sceneManager->setShadowTextureSize(textureSize);
-    sceneManager->setShadowTextureCount(numCascades);
     sceneManager->setShadowFarDistance(100.0f);
+    if (shadows) {
+        shadows->initialize(numCascades, textureSize);
+    }
 
     std::cout << "Shadow quality: " << textureSize << "x" << textureSize
               << " with " << numCascades << " cascades" << std::endl;
@@ -171,23 +270,63 @@ void LightingManager::setShadowEnabled(bool enabled) {
     std::cout << "Shadows: " << (enabled ? "ON" : "OFF") << std::endl;
 }
 
+void LightingManager::updateClusters() {
+    if (!clusters) return;
+
+    clusterLights.clear();
+
+    auto gather = [this](const Ogre::Light* light) {
+        if (!light->isVisible() || light->getType() == Ogre::Light::LT_DIRECTIONAL) return;
+
+        ClusterLight entry;
+        entry.position = light->getDerivedPosition();
+        entry.range = light->getAttenuationRange();
+        entry.colour = light->getDiffuseColour();
+        entry.direction = light->getDerivedDirection();
+        entry.linear = light->getAttenuationLinear();
+        entry.quadratic = light->getAttenuationQuadric();
+        entry.spot = light->getType() == Ogre::Light::LT_SPOTLIGHT;
+        entry.cosInner = std::cos(light->getSpotlightInnerAngle().valueRadians() * 0.5f);
+        entry.cosOuter = std::cos(light->getSpotlightOuterAngle().valueRadians() * 0.5f);
+        clusterLights.push_back(entry);
+    };
+
+    for (auto* light : persistentLights) {
+        gather(light);
+    }
+
+    // Temporary lights only exist as cluster entries
+    for (const TemporaryLight& tempLight : temporaryLights) {
+        if (!tempLight.active) continue;
+
+        ClusterLight entry;
+        entry.position = tempLight.position;
+        entry.range = tempLight.range;
+        entry.colour = tempLight.colour * tempLight.intensity;
+        entry.direction = Ogre::Vector3::NEGATIVE_UNIT_Z;
+        entry.cosInner = 1.0f;
+        entry.cosOuter = 1.0f;
+        entry.linear = TEMPORARY_LIGHT_LINEAR;
+        entry.quadratic = TEMPORARY_LIGHT_QUADRATIC;
+        entry.spot = false;
+        clusterLights.push_back(entry);
+    }
+
+    clusters->update(camera, clusterLights);
+}
+
 void LightingManager::updateTemporaryLights(float dt) {
-    auto it = temporaryLights.begin();
-    while (it != temporaryLights.end()) {
-        it->timeRemaining -= dt;
-
-        if (it->timeRemaining <= 0.0f) {
-            // Light expired, clean up
-            sceneManager->destroyLight(it->light);
-            sceneManager->destroySceneNode(it->node);
-            it = temporaryLights.erase(it);
-        } else {
-            // Fade out light intensity
-            float fadePercent = it->timeRemaining / 2.0f; // Assuming 2s max duration
-            Ogre::ColourValue currentColor = it->light->getDiffuseColour();
-            it->light->setDiffuseColour(currentColor * fadePercent);
-            ++it;
+    for (TemporaryLight& tempLight : temporaryLights) {
+        if (!tempLight.active) continue;
+
+        tempLight.age += dt;
+        if (tempLight.age >= tempLight.duration) {
+            release(tempLight);
+            continue;
         }
+
+        // Always from the spawn colour, so the fade does not compound
+        tempLight.intensity = evaluateFade(tempLight.fade, tempLight.age / tempLight.duration);
     }
 }
 
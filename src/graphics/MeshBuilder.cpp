@@ -0,0 +1,291 @@
+#include "graphics/MeshBuilder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+namespace BVA {
+
+namespace {
+
+// Weld tolerances (values are rounded to these steps before comparing)
+constexpr float POSITION_STEPS = 10000.0f;  // 0.1mm
+constexpr float NORMAL_STEPS = 1000.0f;
+constexpr float COLOUR_STEPS = 255.0f;
+constexpr float UV_STEPS = 10000.0f;
+
+std::int32_t quantize(float value, float steps) {
+    return static_cast<std::int32_t>(std::lround(value * steps));
+}
+
+// Serialized layout: header, vertices, indices (all levels of detail)
+struct SerializedHeader {
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    std::uint32_t lodCount;
+    std::uint32_t lodStarts[MeshBuilder::MAX_LOD_LEVELS];
+};
+
+static_assert(std::is_trivially_copyable_v<MeshBuilder::Vertex>, "vertices are copied as raw bytes");
+
+struct SerializedMesh {
+    SerializedHeader header;
+    const MeshBuilder::Vertex* vertices;
+    const MeshBuilder::Index* indices;
+};
+
+// Validates a blob and points into it; blobs come from the 8-byte aligned
+// cache payload, so the arrays are used in place
+bool parseSerialized(const uint8_t* data, size_t size, SerializedMesh& mesh) {
+    if (!data || size < sizeof(SerializedHeader)) return false;
+
+    SerializedHeader& header = mesh.header;
+    std::memcpy(&header, data, sizeof(header));
+    size_t vertexBytes = size_t(header.vertexCount) * sizeof(MeshBuilder::Vertex);
+    size_t indexBytes = size_t(header.indexCount) * sizeof(MeshBuilder::Index);
+    if (header.vertexCount > MeshBuilder::MAX_VERTICES || sizeof(header) + vertexBytes + indexBytes != size) {
+        return false;
+    }
+    if (header.lodCount == 0 || header.lodCount > MeshBuilder::MAX_LOD_LEVELS || header.lodStarts[0] != 0) {
+        return false;
+    }
+    for (uint32_t i = 1; i < header.lodCount; i++) {
+        if (header.lodStarts[i] < header.lodStarts[i - 1] || header.lodStarts[i] > header.indexCount) return false;
+    }
+
+    mesh.vertices = reinterpret_cast<const MeshBuilder::Vertex*>(data + sizeof(header));
+    mesh.indices = reinterpret_cast<const MeshBuilder::Index*>(data + sizeof(header) + vertexBytes);
+    for (size_t i = 0; i < header.indexCount; i++) {
+        if (mesh.indices[i] >= header.vertexCount) return false;
+    }
+    return true;
+}
+
+size_t levelIndexCount(const std::uint32_t* lodStarts, size_t lodCount, size_t indexCount, size_t level) {
+    if (level >= lodCount) return 0;
+    size_t end = level + 1 < lodCount ? lodStarts[level + 1] : indexCount;
+    return end - lodStarts[level];
+}
+
+} // namespace
+
+// ==================== TrigTable ====================
+
+TrigTable::TrigTable(int steps, float range) : sines(steps + 1), cosines(steps + 1) {
+    for (int i = 0; i <= steps; i++) {
+        float angle = range * i / steps;
+        sines[i] = std::sin(angle);
+        cosines[i] = std::cos(angle);
+    }
+}
+
+// ==================== MeshBuilder ====================
+
+MeshBuilder::MeshBuilder(size_t expectedVertices, size_t expectedIndices) {
+    vertices.reserve(expectedVertices);
+    indices.reserve(expectedIndices);
+    weldMap.reserve(expectedVertices);
+}
+
+size_t MeshBuilder::WeldKeyHash::operator()(const WeldKey& key) const {
+    // FNV-1a over the quantized components
+    size_t hash = 14695981039346656037ull;
+    for (std::int32_t value : key) {
+        hash ^= static_cast<std::uint32_t>(value);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+MeshBuilder::WeldKey MeshBuilder::makeKey(const Vertex& v) {
+    return {
+        quantize(v.position.x, POSITION_STEPS), quantize(v.position.y, POSITION_STEPS),
+        quantize(v.position.z, POSITION_STEPS),
+        quantize(v.normal.x, NORMAL_STEPS), quantize(v.normal.y, NORMAL_STEPS),
+        quantize(v.normal.z, NORMAL_STEPS),
+        quantize(v.colour.r, COLOUR_STEPS), quantize(v.colour.g, COLOUR_STEPS),
+        quantize(v.colour.b, COLOUR_STEPS), quantize(v.colour.a, COLOUR_STEPS),
+        quantize(v.uv.x, UV_STEPS), quantize(v.uv.y, UV_STEPS)
+    };
+}
+
+MeshBuilder::Index MeshBuilder::addVertex(const Ogre::Vector3& position, const Ogre::Vector3& normal,
+                                          const Ogre::ColourValue& colour, const Ogre::Vector2& uv) {
+    submittedVertices++;
+
+    Vertex vertex{position, normal, colour, uv};
+    WeldKey key = makeKey(vertex);
+
+    auto it = weldMap.find(key);
+    if (it != weldMap.end()) {
+        return it->second;
+    }
+
+    if (vertices.size() >= MAX_VERTICES) {
+        if (!overflowed) {
+            std::cerr << "MeshBuilder: more than " << MAX_VERTICES
+                      << " unique vertices, split the mesh" << std::endl;
+        }
+        overflowed = true;
+        return 0;
+    }
+
+    Index index = static_cast<Index>(vertices.size());
+    vertices.push_back(vertex);
+    weldMap.emplace(key, index);
+    return index;
+}
+
+MeshBuilder::Index MeshBuilder::addVertex(const Ogre::Vector3& position, const Ogre::Vector3& normal,
+                                          const Ogre::ColourValue& colour) {
+    Ogre::Vector2 uv = boneIndex >= 0 ? Ogre::Vector2(static_cast<float>(boneIndex), 0.0f)
+                                      : Ogre::Vector2(position.x, position.z);
+    return addVertex(position, normal, colour, uv);
+}
+
+void MeshBuilder::addTriangle(Index a, Index b, Index c) {
+    if (a == b || b == c || c == a) return;
+
+    indices.push_back(a);
+    indices.push_back(b);
+    indices.push_back(c);
+}
+
+void MeshBuilder::addQuad(Index a, Index b, Index c, Index d) {
+    addTriangle(a, b, c);
+    addTriangle(c, d, a);
+}
+
+void MeshBuilder::addFlatQuad(const Ogre::Vector3& v1, const Ogre::Vector3& v2, const Ogre::Vector3& v3,
+                              const Ogre::Vector3& v4, const Ogre::ColourValue& colour) {
+    Ogre::Vector3 normal = (v2 - v1).crossProduct(v3 - v1).normalisedCopy();
+
+    addQuad(addVertex(v1, normal, colour),
+            addVertex(v2, normal, colour),
+            addVertex(v3, normal, colour),
+            addVertex(v4, normal, colour));
+}
+
+bool MeshBuilder::beginLodLevel() {
+    if (lodCount >= MAX_LOD_LEVELS) return false;
+
+    lodStarts[lodCount++] = static_cast<std::uint32_t>(indices.size());
+    return true;
+}
+
+size_t MeshBuilder::getLodIndexCount(size_t level) const {
+    return levelIndexCount(lodStarts.data(), lodCount, indices.size(), level);
+}
+
+void MeshBuilder::clear() {
+    vertices.clear();
+    indices.clear();
+    weldMap.clear();
+    lodStarts.fill(0);
+    lodCount = 1;
+    submittedVertices = 0;
+    boneIndex = -1;
+    overflowed = false;
+}
+
+void MeshBuilder::commit(Ogre::ManualObject* obj, const std::string& material) const {
+    commitArrays(obj, material, vertices.data(), vertices.size(), indices.data(), getLodIndexCount(0));
+}
+
+void MeshBuilder::addLodLevels(const Ogre::MeshPtr& mesh, const std::vector<float>& screenRatios) const {
+    addLodArrays(mesh, screenRatios, indices.data(), indices.size(), lodStarts.data(), lodCount);
+}
+
+std::vector<uint8_t> MeshBuilder::serialize() const {
+    SerializedHeader header{};
+    header.vertexCount = static_cast<std::uint32_t>(vertices.size());
+    header.indexCount = static_cast<std::uint32_t>(indices.size());
+    header.lodCount = static_cast<std::uint32_t>(lodCount);
+    std::copy(lodStarts.begin(), lodStarts.end(), header.lodStarts);
+    size_t vertexBytes = vertices.size() * sizeof(Vertex);
+    size_t indexBytes = indices.size() * sizeof(Index);
+
+    std::vector<uint8_t> data(sizeof(header) + vertexBytes + indexBytes);
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), vertices.data(), vertexBytes);
+    std::memcpy(data.data() + sizeof(header) + vertexBytes, indices.data(), indexBytes);
+    return data;
+}
+
+bool MeshBuilder::commitSerialized(Ogre::ManualObject* obj, const std::string& material,
+                                   const uint8_t* data, size_t size) {
+    SerializedMesh blob;
+    if (!parseSerialized(data, size, blob)) return false;
+
+    const SerializedHeader& header = blob.header;
+    commitArrays(obj, material, blob.vertices, header.vertexCount, blob.indices,
+                 levelIndexCount(header.lodStarts, header.lodCount, header.indexCount, 0));
+    return true;
+}
+
+bool MeshBuilder::addSerializedLodLevels(const Ogre::MeshPtr& mesh, const std::vector<float>& screenRatios,
+                                         const uint8_t* data, size_t size) {
+    SerializedMesh blob;
+    if (!parseSerialized(data, size, blob)) return false;
+
+    addLodArrays(mesh, screenRatios, blob.indices, blob.header.indexCount, blob.header.lodStarts,
+                 blob.header.lodCount);
+    return true;
+}
+
+void MeshBuilder::commitArrays(Ogre::ManualObject* obj, const std::string& material,
+                               const Vertex* vertexData, size_t vertexCount,
+                               const Index* indexData, size_t indexCount) {
+    // Under 65536 vertices ManualObject keeps 16-bit indices
+    obj->estimateVertexCount(vertexCount);
+    obj->estimateIndexCount(indexCount);
+    obj->begin(material, Ogre::RenderOperation::OT_TRIANGLE_LIST);
+
+    for (size_t i = 0; i < vertexCount; i++) {
+        const Vertex& v = vertexData[i];
+        obj->position(v.position);
+        obj->normal(v.normal);
+        obj->colour(v.colour);
+        obj->textureCoord(v.uv);
+    }
+
+    for (size_t i = 0; i < indexCount; i++) {
+        obj->index(indexData[i]);
+    }
+
+    obj->end();
+}
+
+void MeshBuilder::addLodArrays(const Ogre::MeshPtr& mesh, const std::vector<float>& screenRatios,
+                               const Index* indexData, size_t indexCount,
+                               const std::uint32_t* starts, size_t levels) {
+    levels = std::min(levels, screenRatios.size() + 1);
+    if (!mesh || mesh->getNumSubMeshes() == 0 || levels < 2) return;
+
+    // Same 16-bit indices into the submesh's vertices as level 0
+    Ogre::SubMesh* subMesh = mesh->getSubMesh(0);
+    mesh->_setLodInfo(static_cast<unsigned short>(levels));
+
+    for (size_t level = 1; level < levels; level++) {
+        Ogre::MeshLodUsage usage;
+        usage.userValue = screenRatios[level - 1];
+        mesh->_setLodUsage(static_cast<unsigned short>(level), usage);
+
+        size_t count = levelIndexCount(starts, levels, indexCount, level);
+        auto* lodIndices = OGRE_NEW Ogre::IndexData();
+        lodIndices->indexStart = 0;
+        lodIndices->indexCount = count;
+        if (count > 0) {
+            lodIndices->indexBuffer = Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+                Ogre::HardwareIndexBuffer::IT_16BIT, count, Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+            lodIndices->indexBuffer->writeData(0, count * sizeof(Index), indexData + starts[level], true);
+        }
+        subMesh->mLodFaceList[level - 1] = lodIndices;
+    }
+
+    // Transforms the user values (screen area ratios) into strategy values
+    mesh->setLodStrategy(Ogre::LodStrategyManager::getSingleton().getStrategy("screen_ratio_pixel_count"));
+}
+
+} // namespace BVA
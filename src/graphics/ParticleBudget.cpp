@@ -0,0 +1,84 @@
+#include "graphics/ParticleBudget.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace BVA {
+
+namespace {
+
+// Indexed by GraphicsQuality
+const ParticleBudgetSettings BUDGET_PRESETS[] = {
+    //  pooled  simulated  cull    full   min
+    {   4000,    16384,    60.0f, 0.25f, 0.15f},  // Low
+    {  10000,    32768,    90.0f, 0.20f, 0.20f},  // Medium
+    {  25000,    65536,   130.0f, 0.15f, 0.25f},  // High
+    {  60000,   131072,   200.0f, 0.10f, 0.35f},  // Ultra
+};
+
+} // namespace
+
+ParticleBudget::ParticleBudget() {
+    setQuality(GraphicsQuality::High);
+}
+
+void ParticleBudget::setQuality(GraphicsQuality quality) {
+    settings = BUDGET_PRESETS[static_cast<int>(quality)];
+}
+
+void ParticleBudget::beginFrame(const Ogre::Camera* cam, size_t pooled, size_t simulated) {
+    camera = cam;
+    pooledParticles = pooled;
+    simulatedParticles = simulated;
+
+    if (camera) {
+        cameraPosition = camera->getDerivedPosition();
+        projectionScale = 1.0f / std::tan(camera->getFOVy().valueRadians() * 0.5f);
+    }
+
+    // Linear falloff from the soft limit to zero at the hard ceiling
+    float used = static_cast<float>(pooledParticles) / settings.maxPooledParticles;
+    pressure = std::min(1.0f, std::max(0.0f, (1.0f - used) / (1.0f - SOFT_LIMIT)));
+}
+
+ParticleBudget::EffectLOD ParticleBudget::evaluate(const Ogre::Vector3& position, float radius) const {
+    EffectLOD lod{false, true, pressure};
+    if (!camera) return lod;
+
+    float distance = position.distance(cameraPosition);
+    if (distance > settings.cullDistance + radius) {
+        lod.cull = true;
+        lod.emissionScale = 0.0f;
+        return lod;
+    }
+
+    // Off-screen emitters stop emitting; their live particles finish normally
+    if (!camera->isVisible(Ogre::Sphere(position, radius))) {
+        lod.visible = false;
+        lod.emissionScale = 0.0f;
+        return lod;
+    }
+
+    // Projected size as a fraction of the screen height
+    float screenSize = radius * projectionScale / std::max(distance, 0.001f);
+    float detail = std::min(1.0f, screenSize / settings.fullDetailScreenSize);
+    lod.emissionScale = pressure * std::max(settings.minEmissionScale, detail);
+    return lod;
+}
+
+size_t ParticleBudget::clampBurst(size_t requested, const Ogre::Vector3& position,
+                                  size_t liveSimulated) const {
+    if (liveSimulated >= settings.maxSimulatedParticles) return 0;
+
+    float scale = 1.0f;
+    if (camera) {
+        float distance = position.distance(cameraPosition);
+        if (distance > settings.cullDistance) return 0;
+        // Thin out far bursts; they cover few pixels anyway
+        scale = std::max(settings.minEmissionScale, 1.0f - distance / settings.cullDistance);
+    }
+
+    size_t scaled = static_cast<size_t>(requested * scale);
+    return std::min(scaled, settings.maxSimulatedParticles - liveSimulated);
+}
+
+} // namespace BVA
@@ -1,9 +1,54 @@
 #include "graphics/ParticleManager.hpp"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 namespace BVA {
 
-ParticleManager::ParticleManager(Ogre::SceneManager* sm) : sceneManager(sm) {}
+namespace {
+
+// Built-in effect templates, in ParticleEffect order
+struct EffectTemplate {
+    const char* name;
+    unsigned int quota;        // Max particles per system
+    float emissionRate;
+    float angle;
+    float timeToLive;
+    float velocity;
+    Ogre::ColourValue startColour;
+    Ogre::ColourValue endColour;
+    float scaleRate;
+    float duration;            // Default effect lifetime in seconds
+    size_t poolSize;           // Max simultaneous effects of this type
+};
+
+const EffectTemplate EFFECT_TEMPLATES[] = {
+    {"FireTemplate",       200, 100.0f,  30.0f, 2.0f,  50.0f, {1.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f},  50.0f, 2.0f, 16},
+    {"SmokeTemplate",      150,  40.0f,  25.0f, 3.0f,  15.0f, {0.5f, 0.5f, 0.5f}, {0.1f, 0.1f, 0.1f},  30.0f, 3.0f,  8},
+    {"ExplosionTemplate",  300, 600.0f, 180.0f, 1.0f, 120.0f, {1.0f, 0.8f, 0.2f}, {0.3f, 0.0f, 0.0f},  80.0f, 1.5f, 12},
+    {"ImpactTemplate",      60, 300.0f,  90.0f, 0.4f,  80.0f, {1.0f, 1.0f, 1.0f}, {0.6f, 0.6f, 0.6f},  20.0f, 0.5f, 48},
+    {"HealTemplate",       100,  60.0f,  20.0f, 1.5f,  20.0f, {0.3f, 1.0f, 0.3f}, {0.0f, 0.5f, 0.0f},  10.0f, 2.0f,  8},
+    {"BuffTemplate",       100,  50.0f,  40.0f, 1.5f,  15.0f, {1.0f, 0.9f, 0.3f}, {1.0f, 0.5f, 0.0f},  10.0f, 2.0f,  8},
+    {"DebuffTemplate",     100,  50.0f,  40.0f, 1.5f,  10.0f, {0.6f, 0.2f, 0.8f}, {0.2f, 0.0f, 0.3f},  10.0f, 2.0f,  8},
+    {"LightningTemplate",  120, 400.0f,  10.0f, 0.3f, 200.0f, {0.7f, 0.8f, 1.0f}, {0.2f, 0.3f, 1.0f},   0.0f, 0.5f,  8},
+    {"DustTemplate",        80,  80.0f,  60.0f, 1.0f,  10.0f, {0.6f, 0.5f, 0.4f}, {0.3f, 0.25f, 0.2f}, 40.0f, 1.0f, 16},
+    {"BloodTemplate",       60, 200.0f,  60.0f, 0.6f,  60.0f, {0.7f, 0.0f, 0.0f}, {0.3f, 0.0f, 0.0f},   5.0f, 0.8f, 16},
+    {"SparklesTemplate",   150,  80.0f, 180.0f, 1.2f,  30.0f, {1.0f, 1.0f, 1.0f}, {0.8f, 0.8f, 1.0f},   0.0f, 2.0f,  8},
+    {"AbilityTemplate",    200, 150.0f, 180.0f, 1.0f,  60.0f, {0.4f, 0.7f, 1.0f}, {0.0f, 0.2f, 0.6f},  30.0f, 2.0f,  8},
+};
+static_assert(sizeof(EFFECT_TEMPLATES) / sizeof(EFFECT_TEMPLATES[0]) == static_cast<size_t>(ParticleEffect::Count),
+              "EFFECT_TEMPLATES must list every ParticleEffect");
+
+std::string colourString(const Ogre::ColourValue& colour) {
+    return Ogre::StringConverter::toString(colour.r) + " " +
+           Ogre::StringConverter::toString(colour.g) + " " +
+           Ogre::StringConverter::toString(colour.b);
+}
+
+} // namespace
+
+ParticleManager::ParticleManager(Ogre::SceneManager* sm, Ogre::Camera* cam)
+    : sceneManager(sm), camera(cam) {}
 
 ParticleManager::~ParticleManager() {
     shutdown();
@@ -14,130 +59,332 @@ bool ParticleManager::initialize() {
 
     createParticleTemplates();
 
-    std::cout << "Particle manager initialized" << std::endl;
+    // Pre-create every built-in pool so combat never allocates effects
+    size_t systemCount = 0;
+    for (const auto& effectTemplate : EFFECT_TEMPLATES) {
+        EffectPool* pool = createPool(effectTemplate.name, effectTemplate.poolSize, effectTemplate.duration);
+        if (!pool) {
+            return false;
+        }
+        systemCount += pool->effects.size();
+    }
+
+    simulator = std::make_unique<ParticleSimulator>("CombatParticles", "SimulatedParticleMaterial",
+                                                    MAX_SIMULATED_PARTICLES);
+    simulatorNode = sceneManager->getRootSceneNode()->createChildSceneNode();
+    simulatorNode->attachObject(simulator.get());
+
+    std::cout << "Particle manager initialized (" << systemCount << " pooled systems)" << std::endl;
     return true;
 }
 
 void ParticleManager::shutdown() {
-    stopAllEffects();
+    destroyPools();
+
+    if (simulatorNode) {
+        simulatorNode->detachAllObjects();
+        sceneManager->destroySceneNode(simulatorNode);
+        simulatorNode = nullptr;
+    }
+    simulator.reset();
 }
 
 void ParticleManager::update(float dt) {
     updateActiveEffects(dt);
+
+    if (simulator) {
+        simulator->update(dt, camera);
+    }
 }
 
 void ParticleManager::createParticleTemplates() {
     // In a full implementation, these would be defined in .particle scripts
     // For now, we'll create them programmatically
+    Ogre::ParticleSystemManager& manager = Ogre::ParticleSystemManager::getSingleton();
 
-    std::cout << "Creating particle templates..." << std::endl;
+    for (const auto& effectTemplate : EFFECT_TEMPLATES) {
+        // A .particle script may already provide it
+        if (manager.getTemplate(effectTemplate.name)) continue;
 
-    // Example: Fire particle system
-    try {
-        Ogre::ParticleSystem* fireTemplate = sceneManager->createParticleSystem("FireTemplate", 200);
+        Ogre::ParticleSystem* system = manager.createTemplate(
+            effectTemplate.name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        system->setParticleQuota(effectTemplate.quota);
 
-        // Create emitter
-        Ogre::ParticleEmitter* emitter = fireTemplate->addEmitter("Point");
-        emitter->setParameter("emission_rate", "100");
-        emitter->setParameter("angle", "30");
-        emitter->setParameter("time_to_live", "2");
+        Ogre::ParticleEmitter* emitter = system->addEmitter("Point");
+        emitter->setParameter("emission_rate", Ogre::StringConverter::toString(effectTemplate.emissionRate));
+        emitter->setParameter("angle", Ogre::StringConverter::toString(effectTemplate.angle));
+        emitter->setParameter("time_to_live", Ogre::StringConverter::toString(effectTemplate.timeToLive));
         emitter->setParameter("direction", "0 1 0");
-        emitter->setParameter("velocity", "50");
+        emitter->setParameter("velocity", Ogre::StringConverter::toString(effectTemplate.velocity));
 
-        // Create affectors
-        Ogre::ParticleAffector* scaler = fireTemplate->addAffector("Scaler");
-        scaler->setParameter("rate", "50");
+        if (effectTemplate.scaleRate != 0.0f) {
+            Ogre::ParticleAffector* scaler = system->addAffector("Scaler");
+            scaler->setParameter("rate", Ogre::StringConverter::toString(effectTemplate.scaleRate));
+        }
 
-        Ogre::ParticleAffector* colorInterpolator = fireTemplate->addAffector("ColourInterpolator");
+        Ogre::ParticleAffector* colorInterpolator = system->addAffector("ColourInterpolator");
         colorInterpolator->setParameter("time0", "0");
-        colorInterpolator->setParameter("colour0", "1 1 0");
-        colorInterpolator->setParameter("time1", "0.5");
-        colorInterpolator->setParameter("colour1", "1 0 0");
-        colorInterpolator->setParameter("time2", "1");
-        colorInterpolator->setParameter("colour2", "0 0 0");
+        colorInterpolator->setParameter("colour0", colourString(effectTemplate.startColour));
+        colorInterpolator->setParameter("time1", "1");
+        colorInterpolator->setParameter("colour1", colourString(effectTemplate.endColour));
+    }
 
-        // Remove from scene, it's just a template
-        sceneManager->destroyParticleSystem(fireTemplate);
+    std::cout << "Particle templates created" << std::endl;
+}
 
-    } catch (const Ogre::Exception& e) {
-        std::cerr << "Could not create particle templates: " << e.what() << std::endl;
+ParticleManager::EffectPool* ParticleManager::createPool(const std::string& templateName, size_t size,
+                                                        float defaultDuration) {
+    Ogre::ParticleSystem* source = Ogre::ParticleSystemManager::getSingleton().getTemplate(templateName);
+    if (!source) {
+        std::cerr << "Unknown particle template: " << templateName << std::endl;
+        return nullptr;
     }
 
-    std::cout << "Particle templates created" << std::endl;
+    auto pool = std::make_unique<EffectPool>();
+    pool->templateName = templateName;
+
+    // Compile the template's base values once
+    EffectDescription& description = pool->description;
+    description.defaultDuration = defaultDuration;
+    description.width = source->getDefaultWidth();
+    description.height = source->getDefaultHeight();
+    for (unsigned short i = 0; i < source->getNumEmitters(); i++) {
+        Ogre::ParticleEmitter* emitter = source->getEmitter(i);
+        description.emitters.push_back({emitter->getEmissionRate(), emitter->getMinParticleVelocity(),
+                                        emitter->getMaxParticleVelocity()});
+    }
+    for (const auto& effectTemplate : EFFECT_TEMPLATES) {
+        if (templateName == effectTemplate.name) {
+            description.hasColourGradient = true;
+            description.startColour = effectTemplate.startColour;
+            description.endColour = effectTemplate.endColour;
+        }
+    }
+
+    pool->effects.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        PooledEffect& effect = pool->effects[i];
+        std::string name = "Effect_" + std::to_string(poolCounter) + "_" + std::to_string(i);
+        effect.system = sceneManager->createParticleSystem(name, templateName);
+        // Idle effects stay out of the scene graph so its traversal only
+        // visits live ones; spawning parents the node
+        effect.node = sceneManager->createSceneNode();
+        effect.node->attachObject(effect.system);
+
+        // Warm up once so the particle pool and render buffers exist
+        // before the first real spawn
+        effect.system->fastForward(0.5f);
+        effect.system->clear();
+        effect.system->setEmitting(false);
+
+        // Stop simulating once it has been off-screen for a second
+        effect.system->setNonVisibleUpdateTimeout(1.0f);
+    }
+    poolCounter++;
+
+    EffectPool* result = pool.get();
+    pools.push_back(std::move(pool));
+    poolsByTemplate[templateName] = result;
+    return result;
 }
 
-Ogre::ParticleSystem* ParticleManager::createEffect(ParticleEffect effect,
-                                                     const Ogre::Vector3& position,
-                                                     float duration) {
-    std::string effectName;
+EffectHandle ParticleManager::spawnFromPool(uint32_t poolIndex, const Ogre::Vector3& position,
+                                            const EffectParams& params) {
+    EffectPool& pool = *pools[poolIndex];
+    if (pool.effects.empty()) return {};
 
-    switch (effect) {
-        case ParticleEffect::Fire:
-            effectName = "FireTemplate";
-            break;
-        case ParticleEffect::Explosion:
-            effectName = "ExplosionTemplate";
-            break;
-        case ParticleEffect::Impact:
-            effectName = "ImpactTemplate";
-            break;
-        case ParticleEffect::Heal:
-            effectName = "HealTemplate";
-            break;
-        case ParticleEffect::Buff:
-            effectName = "BuffTemplate";
-            break;
-        case ParticleEffect::Sparkles:
-            effectName = "SparklesTemplate";
+    // First free slot, otherwise recycle the oldest live effect
+    PooledEffect* slot = nullptr;
+    for (PooledEffect& effect : pool.effects) {
+        if (!effect.active) {
+            slot = &effect;
             break;
-        case ParticleEffect::AbilityActivation:
-            effectName = "AbilityTemplate";
-            break;
-        default:
-            effectName = "FireTemplate";
+        }
+        if (!slot || effect.spawnSerial < slot->spawnSerial) {
+            slot = &effect;
+        }
     }
 
-    return createCustomEffect(effectName, position);
+    if (slot->active) {
+        release(*slot);
+    }
+
+    // Follow a moving node by parenting under it
+    Ogre::SceneNode* parent = params.attachTo ? params.attachTo : sceneManager->getRootSceneNode();
+    parent->addChild(slot->node);
+
+    applyParams(pool.description, *slot, params);
+
+    slot->system->clear();
+    slot->node->setPosition(position);
+    slot->timeRemaining = params.duration >= 0.0f ? params.duration : pool.description.defaultDuration;
+    slot->spawnSerial = spawnCounter++;
+    slot->active = true;
+    activeCount++;
+
+    EffectHandle handle;
+    handle.pool = poolIndex;
+    handle.slot = static_cast<uint32_t>(slot - pool.effects.data());
+    handle.serial = slot->spawnSerial;
+    return handle;
 }
 
-Ogre::ParticleSystem* ParticleManager::createCustomEffect(const std::string& templateName,
-                                                           const Ogre::Vector3& position) {
-    try {
-        // Create unique name for this effect instance
-        std::string effectId = "Effect_" + std::to_string(effectCounter++);
-
-        // Create particle system (fallback to simple system if template doesn't exist)
-        Ogre::ParticleSystem* particleSystem = nullptr;
-        try {
-            particleSystem = sceneManager->createParticleSystem(effectId, templateName);
-        } catch (...) {
-            // Create basic particle system
-            particleSystem = sceneManager->createParticleSystem(effectId, 100);
-            Ogre::ParticleEmitter* emitter = particleSystem->addEmitter("Point");
-            emitter->setParameter("emission_rate", "50");
-            emitter->setParameter("time_to_live", "1");
+void ParticleManager::applyParams(const EffectDescription& description, PooledEffect& effect,
+                                  const EffectParams& params) {
+    Ogre::ParticleSystem* system = effect.system;
+    system->setDefaultDimensions(description.width * params.scale, description.height * params.scale);
+
+    unsigned short emitterCount = std::min<unsigned short>(system->getNumEmitters(),
+                                                           static_cast<unsigned short>(description.emitters.size()));
+    for (unsigned short i = 0; i < emitterCount; i++) {
+        const EffectDescription::Emitter& base = description.emitters[i];
+        system->getEmitter(i)->setParticleVelocity(base.minVelocity * params.scale, base.maxVelocity * params.scale);
+    }
+
+    // Start at the budget's current pressure; LOD refines it next update
+    effect.scale = params.scale;
+    effect.emissionScale = params.emissionScale;
+    applyEmission(description, effect, params.emissionScale * budget.getPressure());
+
+    // Tinting the gradient needs string parameters, so only when it changes
+    if (params.tint != effect.appliedTint) {
+        if (description.hasColourGradient) {
+            for (unsigned short i = 0; i < system->getNumAffectors(); i++) {
+                Ogre::ParticleAffector* affector = system->getAffector(i);
+                if (affector->getType() == "ColourInterpolator") {
+                    affector->setParameter("colour0", colourString(description.startColour * params.tint));
+                    affector->setParameter("colour1", colourString(description.endColour * params.tint));
+                }
+            }
+        } else {
+            for (unsigned short i = 0; i < system->getNumEmitters(); i++) {
+                system->getEmitter(i)->setColour(params.tint);
+            }
         }
+        effect.appliedTint = params.tint;
+    }
+}
 
-        // Create scene node and attach
-        Ogre::SceneNode* node = sceneManager->getRootSceneNode()->createChildSceneNode();
-        node->setPosition(position);
-        node->attachObject(particleSystem);
+void ParticleManager::applyEmission(const EffectDescription& description, PooledEffect& effect, float emission) {
+    Ogre::ParticleSystem* system = effect.system;
+    unsigned short emitterCount = std::min<unsigned short>(system->getNumEmitters(),
+                                                           static_cast<unsigned short>(description.emitters.size()));
+    for (unsigned short i = 0; i < emitterCount; i++) {
+        system->getEmitter(i)->setEmissionRate(description.emitters[i].emissionRate * emission);
+    }
+    system->setEmitting(emission > 0.0f);
+    effect.appliedEmission = emission;
+}
 
-        // Add to active effects
-        ActiveEffect activeEffect;
-        activeEffect.system = particleSystem;
-        activeEffect.node = node;
-        activeEffect.timeRemaining = 2.0f; // Default duration
-        activeEffects.push_back(activeEffect);
+size_t ParticleManager::countPooledParticles() const {
+    size_t total = 0;
+    for (const auto& pool : pools) {
+        for (const PooledEffect& effect : pool->effects) {
+            if (effect.active) {
+                total += effect.system->getNumParticles();
+            }
+        }
+    }
+    return total;
+}
 
-        return particleSystem;
+ParticleManager::PooledEffect* ParticleManager::resolve(const EffectHandle& handle) const {
+    if (!handle.isValid() || handle.pool >= pools.size()) return nullptr;
 
-    } catch (const Ogre::Exception& e) {
-        std::cerr << "Failed to create particle effect: " << e.what() << std::endl;
-        return nullptr;
+    auto& effects = pools[handle.pool]->effects;
+    if (handle.slot >= effects.size()) return nullptr;
+
+    PooledEffect& effect = effects[handle.slot];
+    return (effect.active && effect.spawnSerial == handle.serial) ? &effect : nullptr;
+}
+
+void ParticleManager::release(PooledEffect& effect) {
+    if (!effect.active) return;
+
+    effect.system->setEmitting(false);
+    effect.system->clear();
+
+    // Out of the scene graph until it is spawned again
+    if (Ogre::SceneNode* parent = effect.node->getParentSceneNode()) {
+        parent->removeChild(effect.node);
+    }
+
+    effect.active = false;
+    activeCount--;
+}
+
+void ParticleManager::destroyPools() {
+    for (auto& pool : pools) {
+        for (PooledEffect& effect : pool->effects) {
+            release(effect);
+            sceneManager->destroyParticleSystem(effect.system);
+            sceneManager->destroySceneNode(effect.node);
+        }
+    }
+    pools.clear();
+    poolsByTemplate.clear();
+    activeCount = 0;
+}
+
+EffectHandle ParticleManager::playEffect(ParticleEffect effect, const Ogre::Vector3& position,
+                                         const EffectParams& params) {
+    size_t index = static_cast<size_t>(effect);
+    if (index >= static_cast<size_t>(ParticleEffect::Count) || index >= pools.size()) {
+        return {};
+    }
+    return spawnFromPool(static_cast<uint32_t>(index), position, params);
+}
+
+EffectHandle ParticleManager::playCustomEffect(const std::string& templateName, const Ogre::Vector3& position,
+                                               const EffectParams& params) {
+    auto it = poolsByTemplate.find(templateName);
+    EffectPool* pool = it != poolsByTemplate.end() ? it->second
+                                                   : createPool(templateName, CUSTOM_POOL_SIZE, 2.0f);
+    if (!pool) return {};
+
+    for (size_t i = 0; i < pools.size(); i++) {
+        if (pools[i].get() == pool) {
+            return spawnFromPool(static_cast<uint32_t>(i), position, params);
+        }
+    }
+    return {};
+}
+
+bool ParticleManager::isEffectActive(const EffectHandle& handle) const {
+    return resolve(handle) != nullptr;
+}
+
+void ParticleManager::stopEffect(const EffectHandle& handle) {
+    if (PooledEffect* effect = resolve(handle)) {
+        release(*effect);
     }
 }
 
+void ParticleManager::detachEffectsFrom(Ogre::SceneNode* node) {
+    for (auto& pool : pools) {
+        for (PooledEffect& effect : pool->effects) {
+            if (effect.active && effect.node->getParentSceneNode() == node) {
+                release(effect);
+            }
+        }
+    }
+}
+
+Ogre::ParticleSystem* ParticleManager::createEffect(ParticleEffect effect,
+                                                     const Ogre::Vector3& position,
+                                                     float duration) {
+    EffectParams params;
+    params.duration = duration;
+    PooledEffect* spawned = resolve(playEffect(effect, position, params));
+    return spawned ? spawned->system : nullptr;
+}
+
+Ogre::ParticleSystem* ParticleManager::createCustomEffect(const std::string& templateName,
+                                                           const Ogre::Vector3& position) {
+    PooledEffect* spawned = resolve(playCustomEffect(templateName, position));
+    return spawned ? spawned->system : nullptr;
+}
+
 void ParticleManager::playAbilityEffect(const std::string& characterName,
                                          const Ogre::Vector3& position) {
     // Create character-specific effect
@@ -148,70 +395,129 @@ void ParticleManager::playAbilityEffect(const std::string& characterName,
     // Customize based on character
     if (characterName == "Bas") {
         effectType = ParticleEffect::Explosion;
+        playShockwave(position, 8.0f);
     } else if (characterName == "Nitin") {
         effectType = ParticleEffect::Fire;
     } else if (characterName == "Fufinho") {
         effectType = ParticleEffect::Sparkles;
     }
 
-    createEffect(effectType, position, 2.0f);
+    playEffect(effectType, position);
 }
 
 void ParticleManager::playImpactEffect(const Ogre::Vector3& position, float intensity) {
-    createEffect(ParticleEffect::Impact, position, 0.5f);
+    // Short-lived: frees its pool slot after the default 0.5s
+    EffectParams params;
+    params.scale = std::max(0.25f, intensity);
+    params.emissionScale = std::max(0.25f, intensity);
+    playEffect(ParticleEffect::Impact, position, params);
 }
 
 void ParticleManager::playExplosionEffect(const Ogre::Vector3& position, float radius) {
-    auto* effect = createEffect(ParticleEffect::Explosion, position, 1.5f);
-    if (effect) {
-        // Scale based on radius
-        float scale = radius / 5.0f;
-        // Note: Would need to adjust emitter parameters here
-    }
+    // Templates are authored for a 5 unit radius
+    EffectParams params;
+    params.scale = radius / 5.0f;
+    playEffect(ParticleEffect::Explosion, position, params);
 }
 
 void ParticleManager::playHealEffect(const Ogre::Vector3& position) {
-    createEffect(ParticleEffect::Heal, position, 2.0f);
+    playEffect(ParticleEffect::Heal, position);
+}
+
+void ParticleManager::playShockwave(const Ogre::Vector3& position, float radius) {
+    // Flat expanding ring of dust plus a bright inner flash
+    ParticleBurst ring;
+    ring.position = position;
+    ring.spreadDegrees = 90.0f;
+    ring.verticalScale = 0.05f;
+    ring.lifetimeMin = 0.5f;
+    ring.lifetimeMax = 0.7f;
+    ring.speedMin = radius / ring.lifetimeMax;
+    ring.speedMax = radius / ring.lifetimeMin;
+    ring.sizeStart = 0.4f;
+    ring.sizeEnd = 1.2f;
+    ring.colourStart = Ogre::ColourValue(1.0f, 0.9f, 0.6f, 1.0f);
+    ring.colourEnd = Ogre::ColourValue(0.5f, 0.4f, 0.3f, 0.0f);
+    ring.gravity = 0.0f;
+    ring.drag = 0.5f;
+    ring.count = static_cast<size_t>(radius * 400.0f);
+    emitBurst(ring);
+
+    ParticleBurst flash;
+    flash.position = position;
+    flash.speedMin = 1.0f;
+    flash.speedMax = 4.0f;
+    flash.lifetimeMin = 0.2f;
+    flash.lifetimeMax = 0.4f;
+    flash.sizeStart = 0.8f;
+    flash.sizeEnd = 0.0f;
+    flash.colourStart = Ogre::ColourValue(1.0f, 1.0f, 0.9f, 1.0f);
+    flash.gravity = 0.0f;
+    flash.count = 256;
+    emitBurst(flash);
+}
+
+size_t ParticleManager::emitBurst(const ParticleBurst& burst) {
+    if (!simulator) return 0;
+
+    ParticleBurst budgeted = burst;
+    budgeted.count = budget.clampBurst(burst.count, burst.position, simulator->getParticleCount());
+    return budgeted.count > 0 ? simulator->emit(budgeted) : 0;
 }
 
 void ParticleManager::stopEffect(Ogre::ParticleSystem* effect) {
     if (!effect) return;
 
-    auto it = std::find_if(activeEffects.begin(), activeEffects.end(),
-                           [effect](const ActiveEffect& e) {
-                               return e.system == effect;
-                           });
-
-    if (it != activeEffects.end()) {
-        it->system->clear();
-        sceneManager->destroyParticleSystem(it->system);
-        sceneManager->destroySceneNode(it->node);
-        activeEffects.erase(it);
+    for (auto& pool : pools) {
+        for (PooledEffect& pooled : pool->effects) {
+            if (pooled.system == effect) {
+                release(pooled);
+                return;
+            }
+        }
     }
 }
 
 void ParticleManager::stopAllEffects() {
-    for (auto& effect : activeEffects) {
-        effect.system->clear();
-        sceneManager->destroyParticleSystem(effect.system);
-        sceneManager->destroySceneNode(effect.node);
+    for (auto& pool : pools) {
+        for (PooledEffect& effect : pool->effects) {
+            release(effect);
+        }
+    }
+    if (simulator) {
+        simulator->clear();
     }
-    activeEffects.clear();
 }
 
 void ParticleManager::updateActiveEffects(float dt) {
-    auto it = activeEffects.begin();
-    while (it != activeEffects.end()) {
-        it->timeRemaining -= dt;
-
-        if (it->timeRemaining <= 0.0f) {
-            // Effect expired, clean up
-            it->system->clear();
-            sceneManager->destroyParticleSystem(it->system);
-            sceneManager->destroySceneNode(it->node);
-            it = activeEffects.erase(it);
-        } else {
-            ++it;
+    budget.beginFrame(camera, activeCount > 0 ? countPooledParticles() : 0,
+                      simulator ? simulator->getParticleCount() : 0);
+    if (activeCount == 0) return;
+
+    for (auto& pool : pools) {
+        for (PooledEffect& effect : pool->effects) {
+            if (!effect.active) continue;
+
+            effect.timeRemaining -= dt;
+            if (effect.timeRemaining <= 0.0f) {
+                // Effect expired, back to the pool
+                release(effect);
+                continue;
+            }
+
+            float radius = std::max(effect.system->getBoundingRadius(), pool->description.width * effect.scale);
+            ParticleBudget::EffectLOD lod = budget.evaluate(effect.node->_getDerivedPosition(), radius);
+            if (lod.cull) {
+                release(effect);
+                continue;
+            }
+
+            // Only touch the emitters when the rate changes noticeably
+            float emission = effect.emissionScale * lod.emissionScale;
+            if (std::abs(emission - effect.appliedEmission) > 0.05f * effect.emissionScale ||
+                (emission == 0.0f) != (effect.appliedEmission == 0.0f)) {
+                applyEmission(pool->description, effect, emission);
+            }
         }
     }
 }
@@ -0,0 +1,389 @@
+#include "graphics/ParticleSimulator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace BVA {
+
+namespace {
+
+// Per particle: position (3 floats), colour (RGBA8), size (1 float)
+constexpr size_t INSTANCE_SIZE = 3 * sizeof(float) + sizeof(uint32_t) + sizeof(float);
+
+// Quad corners in texture space; Particle.vert centres them on the particle
+constexpr float CORNERS[4][2] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+constexpr uint16_t QUAD_INDICES[6] = {0, 1, 2, 0, 2, 3};
+
+uint32_t packColour(float r, float g, float b, float a) {
+    auto channel = [](float value) {
+        return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(r) | (channel(g) << 8) | (channel(b) << 16) | (channel(a) << 24);
+}
+
+} // namespace
+
+ParticleSimulator::ParticleSimulator(const std::string& name, const std::string& materialName,
+                                     size_t capacity)
+    : Ogre::SimpleRenderable(name), maxParticles(capacity) {
+    for (auto* array : {&posX, &posY, &posZ, &velX, &velY, &velZ, &age, &invLifetime, &gravity,
+                        &damping, &sizeStart, &sizeDelta, &colR, &colG, &colB, &colA,
+                        &colDR, &colDG, &colDB, &colDA, &size}) {
+        array->resize(maxParticles, 0.0f);
+    }
+    packedColour.resize(maxParticles, 0);
+
+    // Without a render system (the benchmark) only the simulation runs
+    if (Ogre::HardwareBufferManager::getSingletonPtr()) {
+        createBuffers(materialName);
+    }
+    setBoundingBox(Ogre::AxisAlignedBox::BOX_NULL);
+    setCastShadows(false);
+    setVisible(false);
+}
+
+ParticleSimulator::~ParticleSimulator() {
+    delete mRenderOp.vertexData;
+    delete mRenderOp.indexData;
+    mRenderOp.vertexData = nullptr;
+    mRenderOp.indexData = nullptr;
+}
+
+void ParticleSimulator::createBuffers(const std::string& materialName) {
+    // One instanced quad: the corners are a static stream, each particle is
+    // one record in the instance stream, and the shader expands the quad
+    // towards the camera
+    mRenderOp.vertexData = new Ogre::VertexData();
+    mRenderOp.vertexData->vertexStart = 0;
+    mRenderOp.vertexData->vertexCount = 4;
+
+    Ogre::VertexDeclaration* decl = mRenderOp.vertexData->vertexDeclaration;
+    decl->addElement(0, 0, Ogre::VET_FLOAT2, Ogre::VES_TEXTURE_COORDINATES, 0);
+
+    size_t offset = 0;
+    decl->addElement(1, offset, Ogre::VET_FLOAT3, Ogre::VES_POSITION);
+    offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT3);
+    decl->addElement(1, offset, Ogre::VET_UBYTE4_NORM, Ogre::VES_DIFFUSE);
+    offset += Ogre::VertexElement::getTypeSize(Ogre::VET_UBYTE4_NORM);
+    decl->addElement(1, offset, Ogre::VET_FLOAT1, Ogre::VES_TEXTURE_COORDINATES, 1);
+
+    Ogre::HardwareVertexBufferSharedPtr cornerBuffer = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        sizeof(CORNERS[0]), 4, Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    cornerBuffer->writeData(0, sizeof(CORNERS), CORNERS, true);
+    mRenderOp.vertexData->vertexBufferBinding->setBinding(0, cornerBuffer);
+
+    instanceBuffer = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        INSTANCE_SIZE, maxParticles, Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+    instanceBuffer->setIsInstanceData(true);
+    instanceBuffer->setInstanceDataStepRate(1);
+    mRenderOp.vertexData->vertexBufferBinding->setBinding(1, instanceBuffer);
+
+    mRenderOp.indexData = new Ogre::IndexData();
+    mRenderOp.indexData->indexStart = 0;
+    mRenderOp.indexData->indexCount = 6;
+    mRenderOp.indexData->indexBuffer = Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+        Ogre::HardwareIndexBuffer::IT_16BIT, 6, Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    mRenderOp.indexData->indexBuffer->writeData(0, sizeof(QUAD_INDICES), QUAD_INDICES, true);
+
+    mRenderOp.operationType = Ogre::RenderOperation::OT_TRIANGLE_LIST;
+    mRenderOp.useIndexes = true;
+    mRenderOp.numberOfInstances = 0;
+
+    material = Ogre::MaterialManager::getSingleton().getByName(materialName);
+    setMaterial(material);
+}
+
+float ParticleSimulator::random01() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (randomState >> 8) * (1.0f / 16777216.0f);
+}
+
+size_t ParticleSimulator::emit(const ParticleBurst& burst) {
+    size_t emitCount = std::min(burst.count, maxParticles - count);
+
+    // Basis around the emission direction for cone sampling
+    Ogre::Vector3 axis = burst.direction.normalisedCopy();
+    Ogre::Vector3 tangent = axis.perpendicular();
+    Ogre::Vector3 bitangent = axis.crossProduct(tangent);
+    float cosSpread = std::cos(Ogre::Degree(std::min(burst.spreadDegrees, 180.0f)).valueRadians());
+
+    for (size_t n = 0; n < emitCount; n++) {
+        size_t i = count++;
+
+        float cosTheta = 1.0f - random01() * (1.0f - cosSpread);
+        float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+        float phi = random01() * Ogre::Math::TWO_PI;
+        Ogre::Vector3 direction = axis * cosTheta +
+                                  (tangent * std::cos(phi) + bitangent * std::sin(phi)) * sinTheta;
+        direction.y *= burst.verticalScale;
+
+        float speed = burst.speedMin + (burst.speedMax - burst.speedMin) * random01();
+        float lifetime = burst.lifetimeMin + (burst.lifetimeMax - burst.lifetimeMin) * random01();
+
+        posX[i] = burst.position.x;
+        posY[i] = burst.position.y;
+        posZ[i] = burst.position.z;
+        velX[i] = direction.x * speed;
+        velY[i] = direction.y * speed;
+        velZ[i] = direction.z * speed;
+        age[i] = 0.0f;
+        invLifetime[i] = 1.0f / std::max(lifetime, 0.01f);
+        gravity[i] = burst.gravity;
+        damping[i] = burst.drag;
+        sizeStart[i] = burst.sizeStart;
+        sizeDelta[i] = burst.sizeEnd - burst.sizeStart;
+        colR[i] = burst.colourStart.r;
+        colG[i] = burst.colourStart.g;
+        colB[i] = burst.colourStart.b;
+        colA[i] = burst.colourStart.a;
+        colDR[i] = burst.colourEnd.r - burst.colourStart.r;
+        colDG[i] = burst.colourEnd.g - burst.colourStart.g;
+        colDB[i] = burst.colourEnd.b - burst.colourStart.b;
+        colDA[i] = burst.colourEnd.a - burst.colourStart.a;
+    }
+
+    return emitCount;
+}
+
+void ParticleSimulator::clear() {
+    count = 0;
+    mRenderOp.numberOfInstances = 0;
+    setVisible(false);
+}
+
+void ParticleSimulator::update(float dt, const Ogre::Camera* camera) {
+    if (count == 0) return;
+
+    integrate(dt);
+    removeExpired();
+
+    if (count == 0) {
+        clear();
+        return;
+    }
+
+    writeVertices();
+    updateBounds();
+
+    // Billboard axes for the vertex shader
+    if (camera && material) {
+        Ogre::Pass* pass = material->getTechnique(0)->getPass(0);
+        if (pass->hasVertexProgram()) {
+            auto params = pass->getVertexProgramParameters();
+            params->setNamedConstant("cameraRight", camera->getDerivedRight());
+            params->setNamedConstant("cameraUp", camera->getDerivedUp());
+        }
+    }
+    setVisible(true);
+}
+
+// Age, forces, size and colour gradients for every particle. The colour is
+// packed to RGBA8 here so writeInstances() is a plain copy.
+void ParticleSimulator::integrate(float dt) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 scale255 = _mm256_set1_ps(255.0f);
+
+    auto toByte = [&](__m256 value) {
+        value = _mm256_min_ps(_mm256_max_ps(value, zero), one);
+        return _mm256_cvtps_epi32(_mm256_mul_ps(value, scale255));
+    };
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 a = _mm256_add_ps(_mm256_loadu_ps(&age[i]), vdt);
+        _mm256_storeu_ps(&age[i], a);
+        __m256 t = _mm256_min_ps(_mm256_mul_ps(a, _mm256_loadu_ps(&invLifetime[i])), one);
+
+        // v = (v + g*dt) * max(0, 1 - drag*dt); p += v*dt
+        __m256 keep = _mm256_max_ps(zero, _mm256_sub_ps(one, _mm256_mul_ps(_mm256_loadu_ps(&damping[i]), vdt)));
+        __m256 vx = _mm256_mul_ps(_mm256_loadu_ps(&velX[i]), keep);
+        __m256 vy = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(&velY[i]),
+                                                _mm256_mul_ps(_mm256_loadu_ps(&gravity[i]), vdt)), keep);
+        __m256 vz = _mm256_mul_ps(_mm256_loadu_ps(&velZ[i]), keep);
+        _mm256_storeu_ps(&velX[i], vx);
+        _mm256_storeu_ps(&velY[i], vy);
+        _mm256_storeu_ps(&velZ[i], vz);
+        _mm256_storeu_ps(&posX[i], _mm256_add_ps(_mm256_loadu_ps(&posX[i]), _mm256_mul_ps(vx, vdt)));
+        _mm256_storeu_ps(&posY[i], _mm256_add_ps(_mm256_loadu_ps(&posY[i]), _mm256_mul_ps(vy, vdt)));
+        _mm256_storeu_ps(&posZ[i], _mm256_add_ps(_mm256_loadu_ps(&posZ[i]), _mm256_mul_ps(vz, vdt)));
+
+        _mm256_storeu_ps(&size[i], _mm256_add_ps(_mm256_loadu_ps(&sizeStart[i]),
+                                                 _mm256_mul_ps(_mm256_loadu_ps(&sizeDelta[i]), t)));
+
+        __m256i r = toByte(_mm256_add_ps(_mm256_loadu_ps(&colR[i]), _mm256_mul_ps(_mm256_loadu_ps(&colDR[i]), t)));
+        __m256i g = toByte(_mm256_add_ps(_mm256_loadu_ps(&colG[i]), _mm256_mul_ps(_mm256_loadu_ps(&colDG[i]), t)));
+        __m256i b = toByte(_mm256_add_ps(_mm256_loadu_ps(&colB[i]), _mm256_mul_ps(_mm256_loadu_ps(&colDB[i]), t)));
+        __m256i al = toByte(_mm256_add_ps(_mm256_loadu_ps(&colA[i]), _mm256_mul_ps(_mm256_loadu_ps(&colDA[i]), t)));
+        __m256i packed = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                                         _mm256_or_si256(_mm256_slli_epi32(b, 16), _mm256_slli_epi32(al, 24)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&packedColour[i]), packed);
+    }
+#endif
+
+    // Scalar path for the tail (and builds without AVX2)
+    for (; i < count; i++) {
+        age[i] += dt;
+        float t = std::min(age[i] * invLifetime[i], 1.0f);
+
+        float keep = std::max(0.0f, 1.0f - damping[i] * dt);
+        velX[i] *= keep;
+        velY[i] = (velY[i] + gravity[i] * dt) * keep;
+        velZ[i] *= keep;
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+        posZ[i] += velZ[i] * dt;
+
+        size[i] = sizeStart[i] + sizeDelta[i] * t;
+        packedColour[i] = packColour(colR[i] + colDR[i] * t, colG[i] + colDG[i] * t,
+                                     colB[i] + colDB[i] * t, colA[i] + colDA[i] * t);
+    }
+}
+
+// Swap-remove expired particles; order doesn't matter for additive blending
+void ParticleSimulator::removeExpired() {
+    size_t i = 0;
+    while (i < count) {
+        if (age[i] * invLifetime[i] < 1.0f) {
+            i++;
+            continue;
+        }
+
+        size_t last = --count;
+        if (i != last) {
+            for (auto* array : {&posX, &posY, &posZ, &velX, &velY, &velZ, &age, &invLifetime, &gravity,
+                                &damping, &sizeStart, &sizeDelta, &colR, &colG, &colB, &colA,
+                                &colDR, &colDG, &colDB, &colDA, &size}) {
+                (*array)[i] = (*array)[last];
+            }
+            packedColour[i] = packedColour[last];
+        }
+    }
+}
+
+void ParticleSimulator::writeVertices() {
+    auto* dst = static_cast<uint8_t*>(instanceBuffer->lock(0, count * INSTANCE_SIZE,
+                                                           Ogre::HardwareBuffer::HBL_DISCARD));
+    writeInstances(dst);
+    instanceBuffer->unlock();
+    mRenderOp.numberOfInstances = count;
+}
+
+void ParticleSimulator::writeInstances(uint8_t* dst) const {
+    for (size_t i = 0; i < count; i++, dst += INSTANCE_SIZE) {
+        float position[3] = {posX[i], posY[i], posZ[i]};
+        std::memcpy(dst, position, sizeof(position));
+        std::memcpy(dst + sizeof(position), &packedColour[i], sizeof(uint32_t));
+        std::memcpy(dst + sizeof(position) + sizeof(uint32_t), &size[i], sizeof(float));
+    }
+}
+
+void ParticleSimulator::updateBounds() {
+    float maxSize = 0.0f;
+    Ogre::Vector3 minimum(posX[0], posY[0], posZ[0]);
+    Ogre::Vector3 maximum = minimum;
+
+    size_t i = 0;
+#if defined(__AVX2__)
+    if (count >= 8) {
+        __m256 minX = _mm256_loadu_ps(&posX[0]), maxX = minX;
+        __m256 minY = _mm256_loadu_ps(&posY[0]), maxY = minY;
+        __m256 minZ = _mm256_loadu_ps(&posZ[0]), maxZ = minZ;
+        __m256 maxS = _mm256_loadu_ps(&size[0]);
+        for (i = 8; i + 8 <= count; i += 8) {
+            __m256 x = _mm256_loadu_ps(&posX[i]);
+            __m256 y = _mm256_loadu_ps(&posY[i]);
+            __m256 z = _mm256_loadu_ps(&posZ[i]);
+            minX = _mm256_min_ps(minX, x);
+            maxX = _mm256_max_ps(maxX, x);
+            minY = _mm256_min_ps(minY, y);
+            maxY = _mm256_max_ps(maxY, y);
+            minZ = _mm256_min_ps(minZ, z);
+            maxZ = _mm256_max_ps(maxZ, z);
+            maxS = _mm256_max_ps(maxS, _mm256_loadu_ps(&size[i]));
+        }
+
+        float lanes[7][8];
+        _mm256_storeu_ps(lanes[0], minX);
+        _mm256_storeu_ps(lanes[1], minY);
+        _mm256_storeu_ps(lanes[2], minZ);
+        _mm256_storeu_ps(lanes[3], maxX);
+        _mm256_storeu_ps(lanes[4], maxY);
+        _mm256_storeu_ps(lanes[5], maxZ);
+        _mm256_storeu_ps(lanes[6], maxS);
+        for (int lane = 0; lane < 8; lane++) {
+            minimum.makeFloor(Ogre::Vector3(lanes[0][lane], lanes[1][lane], lanes[2][lane]));
+            maximum.makeCeil(Ogre::Vector3(lanes[3][lane], lanes[4][lane], lanes[5][lane]));
+            maxSize = std::max(maxSize, lanes[6][lane]);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        Ogre::Vector3 p(posX[i], posY[i], posZ[i]);
+        minimum.makeFloor(p);
+        maximum.makeCeil(p);
+        maxSize = std::max(maxSize, size[i]);
+    }
+
+    // Quads extend up to one size from their centre
+    Ogre::AxisAlignedBox bounds(minimum - Ogre::Vector3(maxSize), maximum + Ogre::Vector3(maxSize));
+    setBoundingBox(bounds);
+    boundingRadius = bounds.getHalfSize().length();
+}
+
+Ogre::Real ParticleSimulator::getSquaredViewDepth(const Ogre::Camera* cam) const {
+    return mBox.getCenter().squaredDistance(cam->getDerivedPosition());
+}
+
+void ParticleSimulator::runBenchmark(size_t particleCount, int frames) {
+    ParticleSimulator simulator("ParticleBenchmark", "", particleCount);
+
+    // Long-lived, so the count holds for the whole run
+    ParticleBurst burst;
+    burst.lifetimeMin = 1000.0f;
+    burst.lifetimeMax = 1000.0f;
+    burst.drag = 0.5f;
+    burst.count = particleCount;
+    simulator.emit(burst);
+
+    std::vector<uint8_t> instances(particleCount * INSTANCE_SIZE);
+    double simulateMs = 0.0;
+    double writeMs = 0.0;
+    for (int frame = 0; frame < frames; frame++) {
+        auto start = std::chrono::steady_clock::now();
+        simulator.integrate(1.0f / 60.0f);
+        simulator.removeExpired();
+        auto simulated = std::chrono::steady_clock::now();
+        simulator.writeInstances(instances.data());
+        simulator.updateBounds();
+        auto written = std::chrono::steady_clock::now();
+
+        simulateMs += std::chrono::duration<double, std::milli>(simulated - start).count();
+        writeMs += std::chrono::duration<double, std::milli>(written - simulated).count();
+    }
+
+    std::cout << "Particle benchmark (" << simulator.getParticleCount() << " particles, " << frames << " frames"
+#if defined(__AVX2__)
+              << ", AVX2"
+#else
+              << ", no AVX2"
+#endif
+              << ")" << std::endl;
+    std::cout << "  simulate " << simulateMs / frames << " ms, instance data and bounds " << writeMs / frames
+              << " ms (" << instances.size() / 1024.0 << " KB), total " << (simulateMs + writeMs) / frames
+              << " ms/frame" << std::endl;
+}
+
+} // namespace BVA
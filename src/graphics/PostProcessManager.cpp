@@ -1,8 +1,49 @@
 #include "graphics/PostProcessManager.hpp"
+#include "graphics/AnimationSystem.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace BVA {
 
+namespace {
+
+const char* CHAIN_NAME = "PostProcess/Chain";
+const char* DEPTH_SCHEME = "PostProcessDepth";
+
+// Dynamic resolution tuning. Every scale change rebuilds the compositor
+// chain (new render targets), so the scale only moves one of a few fixed
+// tiers at a time, and a band between stepping down and stepping up keeps
+// it from flipping back and forth.
+constexpr float SCALE_TIERS[] = {0.5f, 0.6f, 0.7f, 0.8f, 1.0f};
+constexpr float SCALE_SETTLE_TIME = 0.5f;   // Seconds ignored after a change (chain rebuild, new cost)
+constexpr float MIN_TIER_TIME = 2.0f;       // Seconds at a tier before stepping up
+constexpr float STEP_DOWN_LOAD = 1.1f;      // Over budget by this much steps down
+constexpr float STEP_UP_LOAD = 0.85f;       // Next tier's estimated frame time must fit this share
+constexpr float MIN_PROBE_INTERVAL = 4.0f;
+constexpr float MAX_PROBE_INTERVAL = 32.0f;
+
+// Nearest tiers strictly above and below a scale (the scale itself when
+// there is none)
+float tierAbove(float scale) {
+    for (float tier : SCALE_TIERS) {
+        if (tier > scale + 0.001f) return tier;
+    }
+    return scale;
+}
+
+float tierBelow(float scale) {
+    float below = scale;
+    for (float tier : SCALE_TIERS) {
+        if (tier < scale - 0.001f) below = tier;
+    }
+    return below;
+}
+
+constexpr float SSAO_RADIUS = 1.5f;
+
+} // namespace
+
 PostProcessManager::PostProcessManager(Ogre::Viewport* vp, Ogre::SceneManager* sm)
     : viewport(vp), sceneManager(sm) {}
 
@@ -17,63 +58,454 @@ bool PostProcessManager::initialize() {
 
     // Set default quality
     setGraphicsQuality(GraphicsQuality::High);
+    buildChain();
 
     std::cout << "Post-process manager initialized" << std::endl;
     return true;
 }
 
 void PostProcessManager::shutdown() {
-    // Cleanup compositors if needed
+    destroyChain();
+
+    if (depthListener) {
+        Ogre::MaterialManager::getSingleton().removeListener(depthListener.get(), DEPTH_SCHEME);
+        depthListener.reset();
+    }
 }
 
 void PostProcessManager::update(float dt) {
-    updateScreenShake(dt);
+    time += dt;
+
+    // Effect toggles only mark the chain, so a preset rebuilds it once
+    if (chainDirty) {
+        buildChain();
+    }
 }
 
 void PostProcessManager::createCompositors() {
-    // Note: In a real implementation, you would create Ogre compositor scripts
-    // For now, we'll use simplified approach
-
     std::cout << "Creating post-process compositor chain..." << std::endl;
 
-    // Compositor chain would be:
-    // 1. HDR rendering
-    // 2. Bloom
-    // 3. SSAO
-    // 4. Tone mapping
-    // 5. FXAA/MSAA
+    createMaterials();
+
+    // Objects render into the depth target through this scheme
+    depthListener = std::make_unique<DepthSchemeListener>();
+    Ogre::MaterialManager::getSingleton().addListener(depthListener.get(), DEPTH_SCHEME);
+}
+
+void PostProcessManager::createMaterials() {
+    auto& programManager = Ogre::HighLevelGpuProgramManager::getSingleton();
+    auto& materialManager = Ogre::MaterialManager::getSingleton();
+    const std::string& group = Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+
+    auto createProgram = [&](const std::string& name, const std::string& file, Ogre::GpuProgramType type) {
+        if (!programManager.resourceExists(name, group)) {
+            programManager.createProgram(name, group, "glsl", type)->setSourceFile(file);
+        }
+    };
+
+    createProgram("PostQuadVP", "PostQuad.vert", Ogre::GPT_VERTEX_PROGRAM);
+
+    // Fullscreen pass; samplers are bound to the compositor inputs in order
+    struct Sampler {
+        const char* name;
+        bool point;  // Depth must not be filtered across edges
+    };
+    auto createQuadMaterial = [&](const std::string& name, const std::string& program,
+                                  const std::string& file, std::initializer_list<Sampler> samplers) {
+        createProgram(program, file, Ogre::GPT_FRAGMENT_PROGRAM);
+
+        Ogre::MaterialPtr mat = materialManager.create(name, group);
+        Ogre::Pass* pass = mat->getTechnique(0)->getPass(0);
+        pass->setVertexProgram("PostQuadVP");
+        pass->setFragmentProgram(program);
+        pass->setDepthCheckEnabled(false);
+        pass->setDepthWriteEnabled(false);
+        pass->setCullingMode(Ogre::CULL_NONE);
+        pass->setLightingEnabled(false);
+
+        pass->getVertexProgramParameters()->setNamedAutoConstant(
+            "worldViewProj", Ogre::GpuProgramParameters::ACT_WORLDVIEWPROJ_MATRIX);
+
+        auto fpParams = pass->getFragmentProgramParameters();
+        for (const Sampler& sampler : samplers) {
+            Ogre::TextureUnitState* unit = pass->createTextureUnitState();
+            unit->setTextureAddressingMode(Ogre::TextureUnitState::TAM_CLAMP);
+            unit->setTextureFiltering(sampler.point ? Ogre::TFO_NONE : Ogre::TFO_BILINEAR);
+            fpParams->setNamedConstant(sampler.name, static_cast<int>(pass->getTextureUnitStateIndex(unit)));
+        }
+        return fpParams;
+    };
+
+    createQuadMaterial("PostProcess/BloomBright", "BloomBrightFP", "BloomBright.frag", {{"sceneTexture", false}});
+    createQuadMaterial("PostProcess/BloomDownsample", "BloomDownsampleFP", "BloomDownsample.frag",
+                       {{"sourceTexture", false}});
+    createQuadMaterial("PostProcess/BloomBlurH", "BloomBlurFP", "BloomBlur.frag", {{"sourceTexture", false}})
+        ->setNamedConstant("direction", Ogre::Vector2(1.0f, 0.0f));
+    createQuadMaterial("PostProcess/BloomBlurV", "BloomBlurFP", "BloomBlur.frag", {{"sourceTexture", false}})
+        ->setNamedConstant("direction", Ogre::Vector2(0.0f, 1.0f));
+    createQuadMaterial("PostProcess/BloomUpsample", "BloomUpsampleFP", "BloomUpsample.frag",
+                       {{"levelTexture", false}, {"coarserTexture", false}});
+    createQuadMaterial("PostProcess/SSAO", "SSAOFP", "SSAO.frag", {{"depthTexture", true}});
+    createQuadMaterial("PostProcess/Composite", "PostProcessFP", "PostProcess.frag",
+                       {{"sceneTexture", false}, {"bloomTexture", false},
+                        {"ssaoTexture", true}, {"depthTexture", true}});
+
+    // Linear view depth for SSAO and motion blur
+    createProgram("ViewDepthVP", "ViewDepth.vert", Ogre::GPT_VERTEX_PROGRAM);
+    createProgram("InstancedViewDepthVP", "InstancedViewDepth.vert", Ogre::GPT_VERTEX_PROGRAM);
+    if (!programManager.resourceExists("SkinnedInstancedViewDepthVP", group)) {
+        auto vp = programManager.createProgram("SkinnedInstancedViewDepthVP", group, "glsl", Ogre::GPT_VERTEX_PROGRAM);
+        vp->setSourceFile("InstancedViewDepth.vert");
+        vp->setParameter("preprocessor_defines", "SKINNED=1");
+    }
+    createProgram("ViewDepthFP", "ViewDepth.frag", Ogre::GPT_FRAGMENT_PROGRAM);
+
+    for (bool instanced : {false, true}) {
+        Ogre::MaterialPtr mat = materialManager.create(
+            instanced ? "PostProcess/InstancedViewDepth" : "PostProcess/ViewDepth", group);
+        Ogre::Pass* pass = mat->getTechnique(0)->getPass(0);
+        pass->setVertexProgram(instanced ? "InstancedViewDepthVP" : "ViewDepthVP");
+        pass->setFragmentProgram("ViewDepthFP");
+        pass->setLightingEnabled(false);
+
+        auto vpParams = pass->getVertexProgramParameters();
+        if (instanced) {
+            vpParams->setNamedAutoConstant("viewProj", Ogre::GpuProgramParameters::ACT_VIEWPROJ_MATRIX);
+            vpParams->setNamedAutoConstant("view", Ogre::GpuProgramParameters::ACT_VIEW_MATRIX);
+        } else {
+            vpParams->setNamedAutoConstant("worldViewProj", Ogre::GpuProgramParameters::ACT_WORLDVIEWPROJ_MATRIX);
+            vpParams->setNamedAutoConstant("worldView", Ogre::GpuProgramParameters::ACT_WORLDVIEW_MATRIX);
+        }
+    }
+
+    // Animated characters: the instanced depth pass plus their bone palette
+    Ogre::MaterialPtr skinned = materialManager.create("PostProcess/SkinnedInstancedViewDepth", group);
+    Ogre::Pass* skinnedPass = skinned->getTechnique(0)->getPass(0);
+    skinnedPass->setVertexProgram("SkinnedInstancedViewDepthVP");
+    skinnedPass->setFragmentProgram("ViewDepthFP");
+    skinnedPass->setLightingEnabled(false);
+    auto skinnedParams = skinnedPass->getVertexProgramParameters();
+    skinnedParams->setNamedAutoConstant("viewProj", Ogre::GpuProgramParameters::ACT_VIEWPROJ_MATRIX);
+    skinnedParams->setNamedAutoConstant("view", Ogre::GpuProgramParameters::ACT_VIEW_MATRIX);
+    AnimationSystem::bindPalette(skinnedPass);
+}
+
+Ogre::Technique* PostProcessManager::DepthSchemeListener::handleSchemeNotFound(
+    unsigned short, const Ogre::String&, Ogre::Material* originalMaterial, unsigned short,
+    const Ogre::Renderable*) {
+    if (!originalMaterial || originalMaterial->getNumTechniques() == 0) return nullptr;
+
+    // Transparent and additive surfaces (particles, glows, sky) stay out of
+    // the depth buffer
+    Ogre::Technique* original = originalMaterial->getTechnique(0);
+    if (original->getNumPasses() == 0) return nullptr;
+    Ogre::Pass* pass = original->getPass(0);
+    if (pass->isTransparent() || !pass->getDepthWriteEnabled()) return nullptr;
+
+    bool instanced = originalMaterial->getName().find("Instanced") != std::string::npos;
+    bool skinned = pass->hasVertexProgram() && pass->getVertexProgramName() == "SkinnedInstancedVP";
+    const char* depthMaterial = skinned     ? "PostProcess/SkinnedInstancedViewDepth"
+                                : instanced ? "PostProcess/InstancedViewDepth"
+                                            : "PostProcess/ViewDepth";
+    Ogre::MaterialPtr depth = Ogre::MaterialManager::getSingleton().getByName(depthMaterial);
+    return depth ? depth->getTechnique(0) : nullptr;
+}
+
+void PostProcessManager::buildChain() {
+    destroyChain();
+    chainDirty = false;
+
+    bool needsDepth = ssaoEnabled || motionBlurEnabled;
+    bool needsChain = bloomEnabled || hdrEnabled || needsDepth || aaEnabled || renderScale < 1.0f;
+    if (!needsChain || !viewport) {
+        std::cout << "Post-process chain: off" << std::endl;
+        return;
+    }
+
+    auto& manager = Ogre::CompositorManager::getSingleton();
+    compositor = manager.create(CHAIN_NAME, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Ogre::CompositionTechnique* technique = compositor->createTechnique();
+
+    // Sizes are fractions of the viewport, so resizes are handled by Ogre
+    auto addTexture = [technique](const std::string& name, float factor, Ogre::PixelFormat format, int fsaa = 0) {
+        Ogre::CompositionTechnique::TextureDefinition* def = technique->createTextureDefinition(name);
+        def->width = 0;
+        def->height = 0;
+        def->widthFactor = factor;
+        def->heightFactor = factor;
+        def->formatList.push_back(format);
+        def->fsaa = fsaa;
+    };
+
+    auto addQuad = [technique](const std::string& output, const std::string& material,
+                               std::initializer_list<std::string> inputs, Ogre::uint32 id = 0) {
+        Ogre::CompositionTargetPass* target = technique->createTargetPass();
+        target->setOutputName(output);
+        target->setInputMode(Ogre::CompositionTargetPass::IM_NONE);
+
+        Ogre::CompositionPass* pass = target->createPass();
+        pass->setType(Ogre::CompositionPass::PT_RENDERQUAD);
+        pass->setMaterialName(material);
+        pass->setIdentifier(id);
+
+        size_t index = 0;
+        for (const std::string& input : inputs) {
+            pass->setInput(index++, input);
+        }
+    };
+
+    // Scene at the render scale; bloom stays in HDR when the scene is
+    Ogre::PixelFormat colourFormat = hdrEnabled ? Ogre::PF_FLOAT16_RGB : Ogre::PF_A8R8G8B8;
+    addTexture("scene", renderScale, colourFormat, aaEnabled ? aaSamples : 0);
+    Ogre::CompositionTargetPass* sceneTarget = technique->createTargetPass();
+    sceneTarget->setOutputName("scene");
+    sceneTarget->setInputMode(Ogre::CompositionTargetPass::IM_PREVIOUS);
+
+    if (needsDepth) {
+        addTexture("depth", renderScale, Ogre::PF_FLOAT32_R);
+
+        Ogre::CompositionTargetPass* depthTarget = technique->createTargetPass();
+        depthTarget->setOutputName("depth");
+        depthTarget->setInputMode(Ogre::CompositionTargetPass::IM_NONE);
+        depthTarget->setMaterialScheme(DEPTH_SCHEME);
+        depthTarget->setShadowsEnabled(false);
+
+        // Empty pixels read as far away
+        Ogre::CompositionPass* clear = depthTarget->createPass();
+        clear->setType(Ogre::CompositionPass::PT_CLEAR);
+        clear->setClearColour(Ogre::ColourValue(10000.0f, 0.0f, 0.0f, 1.0f));
+
+        Ogre::CompositionPass* render = depthTarget->createPass();
+        render->setType(Ogre::CompositionPass::PT_RENDERSCENE);
+    }
+
+    if (ssaoEnabled) {
+        addTexture("ssao", renderScale * 0.5f, Ogre::PF_FLOAT16_GR);
+        addQuad("ssao", "PostProcess/SSAO", {"depth"}, PASS_SSAO);
+    }
+
+    // Bloom mip chain: bright pass at half size, downsample, blur every level
+    // separably, then accumulate from the smallest level back up
+    std::string bloomResult;
+    if (bloomEnabled) {
+        float factor = renderScale;
+        for (int i = 0; i < bloomLevels; i++) {
+            factor *= 0.5f;
+            addTexture("bloom" + std::to_string(i), factor, colourFormat);
+            addTexture("bloomTemp" + std::to_string(i), factor, colourFormat);
+        }
+
+        addQuad("bloom0", "PostProcess/BloomBright", {"scene"}, PASS_BLOOM_BRIGHT);
+        for (int i = 1; i < bloomLevels; i++) {
+            addQuad("bloom" + std::to_string(i), "PostProcess/BloomDownsample", {"bloom" + std::to_string(i - 1)});
+        }
+        for (int i = 0; i < bloomLevels; i++) {
+            std::string level = "bloom" + std::to_string(i);
+            std::string temp = "bloomTemp" + std::to_string(i);
+            addQuad(temp, "PostProcess/BloomBlurH", {level});
+            addQuad(level, "PostProcess/BloomBlurV", {temp});
+        }
+
+        bloomResult = "bloom" + std::to_string(bloomLevels - 1);
+        for (int i = bloomLevels - 2; i >= 0; i--) {
+            std::string temp = "bloomTemp" + std::to_string(i);
+            addQuad(temp, "PostProcess/BloomUpsample", {"bloom" + std::to_string(i), bloomResult});
+            bloomResult = temp;
+        }
+    }
+
+    // Composite to the viewport at full resolution; inputs keep fixed units
+    Ogre::CompositionTargetPass* output = technique->getOutputTargetPass();
+    output->setInputMode(Ogre::CompositionTargetPass::IM_NONE);
+    Ogre::CompositionPass* composite = output->createPass();
+    composite->setType(Ogre::CompositionPass::PT_RENDERQUAD);
+    composite->setMaterialName("PostProcess/Composite");
+    composite->setIdentifier(PASS_COMPOSITE);
+    composite->setInput(0, "scene");
+    if (bloomEnabled) composite->setInput(1, bloomResult);
+    if (ssaoEnabled) composite->setInput(2, "ssao");
+    if (needsDepth) composite->setInput(3, "depth");
+
+    chain = manager.addCompositor(viewport, CHAIN_NAME);
+    if (!chain) {
+        std::cerr << "Failed to create post-process chain" << std::endl;
+        destroyChain();
+        return;
+    }
+    chain->addListener(this);
+    manager.setCompositorEnabled(viewport, CHAIN_NAME, true);
+
+    std::cout << "Post-process chain: scale " << renderScale
+              << (bloomEnabled ? ", bloom x" + std::to_string(bloomLevels) : "")
+              << (ssaoEnabled ? ", SSAO" : "") << (motionBlurEnabled ? ", motion blur" : "")
+              << (hdrEnabled ? ", HDR" : "") << std::endl;
+}
+
+void PostProcessManager::destroyChain() {
+    if (!chain && !compositor) return;
+
+    auto& manager = Ogre::CompositorManager::getSingleton();
+    if (chain) {
+        chain->removeListener(this);
+        manager.removeCompositor(viewport, CHAIN_NAME);
+        chain = nullptr;
+    }
+    if (compositor) {
+        manager.remove(compositor);
+        compositor.reset();
+    }
+}
+
+void PostProcessManager::notifyMaterialRender(Ogre::uint32 passId, Ogre::MaterialPtr& material) {
+    Ogre::Camera* camera = viewport->getCamera();
+    if (!camera) return;
+
+    auto params = material->getTechnique(0)->getPass(0)->getFragmentProgramParameters();
+    float tanY = std::tan(camera->getFOVy().valueRadians() * 0.5f);
+    float tanX = tanY * camera->getAspectRatio();
+
+    switch (passId) {
+        case PASS_BLOOM_BRIGHT:
+            params->setNamedConstant("threshold", hdrEnabled ? 1.0f : 0.8f);
+            break;
+
+        case PASS_SSAO:
+            params->setNamedConstant("projParams", Ogre::Vector4(tanX, tanY, SSAO_RADIUS, float(ssaoSamples)));
+            params->setNamedConstant("time", time);
+            break;
+
+        case PASS_COMPOSITE: {
+            params->setNamedConstant("effects", Ogre::Vector4(bloomEnabled ? 1.0f : 0.0f, ssaoEnabled ? 1.0f : 0.0f,
+                                                              motionBlurEnabled ? 1.0f : 0.0f,
+                                                              hdrEnabled ? 1.0f : 0.0f));
+            params->setNamedConstant("time", time);
+            params->setNamedConstant("bloomStrength", bloomIntensity);
+            params->setNamedConstant("exposure", exposure);
+            params->setNamedConstant("gamma", gamma);
+            params->setNamedConstant("saturation", saturation);
+            params->setNamedConstant("contrast", contrast);
+            params->setNamedConstant("projParams", Ogre::Vector4(tanX, tanY, 0.0f, 0.0f));
+
+            Ogre::Matrix4 view = camera->getViewMatrix();
+            params->setNamedConstant("viewToPrevClip", previousViewProj * view.inverseAffine());
+            previousViewProj = camera->getProjectionMatrix() * view;
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void PostProcessManager::setRenderScale(float scale) {
+    scale = std::round(std::max(0.25f, std::min(1.0f, scale)) * 20.0f) / 20.0f;
+    if (scale == renderScale) return;
+
+    renderScale = scale;
+    chainDirty = true;
+}
 
-    // This requires compositor scripts in resources/compositors/
+void PostProcessManager::setDynamicResolution(bool enabled, float frameBudgetMs) {
+    dynamicResolution = enabled;
+    frameBudget = frameBudgetMs;
+    averageFrameTime = 0.0f;
+    std::cout << "Dynamic resolution: " << (enabled ? "ON" : "OFF")
+              << " (budget " << frameBudgetMs << " ms)" << std::endl;
+}
+
+void PostProcessManager::reportFrameTime(float milliseconds) {
+    updateDynamicResolution(milliseconds);
+}
+
+void PostProcessManager::updateDynamicResolution(float milliseconds) {
+    if (!dynamicResolution) return;
+
+    // Frames right after a change pay for the rebuild; let them pass
+    timeSinceScaleChange += milliseconds * 0.001f;
+    if (timeSinceScaleChange < SCALE_SETTLE_TIME) return;
+
+    averageFrameTime = averageFrameTime == 0.0f ? milliseconds : averageFrameTime * 0.9f + milliseconds * 0.1f;
+
+    float lower = tierBelow(renderScale);
+    float higher = tierAbove(renderScale);
+
+    // Frame time scales with the pixel count at most, so this is the worst
+    // case for the next tier up
+    float ratio = higher / renderScale;
+    bool headroom = averageFrameTime * ratio * ratio < frameBudget * STEP_UP_LOAD;
+
+    if (averageFrameTime > frameBudget * STEP_DOWN_LOAD) {
+        if (lower >= renderScale || lower < minRenderScale - 0.001f) return;
+
+        // A probe that went over budget waits longer before the next one
+        if (probing) {
+            probeInterval = std::min(probeInterval * 2.0f, MAX_PROBE_INTERVAL);
+        }
+        probing = false;
+        setRenderScale(lower);
+    } else if (higher > renderScale && timeSinceScaleChange > MIN_TIER_TIME &&
+               (headroom || timeSinceScaleChange > probeInterval)) {
+        // Room for the next tier, or (under vsync, where the frame time sits
+        // at the budget) a probe after staying within budget long enough
+        probing = !headroom;
+        setRenderScale(higher);
+    } else {
+        if (probing && timeSinceScaleChange > MIN_PROBE_INTERVAL) {
+            probing = false;
+            probeInterval = MIN_PROBE_INTERVAL;
+        }
+        return;
+    }
+
+    timeSinceScaleChange = 0.0f;
+    averageFrameTime = 0.0f;
 }
 
 void PostProcessManager::setBloomEnabled(bool enabled) {
+    if (bloomEnabled != enabled) {
+        chainDirty = true;
+    }
     bloomEnabled = enabled;
     std::cout << "Bloom: " << (enabled ? "ON" : "OFF") << std::endl;
 }
 
 void PostProcessManager::setHDREnabled(bool enabled) {
+    if (hdrEnabled != enabled) {
+        chainDirty = true;
+    }
     hdrEnabled = enabled;
     std::cout << "HDR: " << (enabled ? "ON" : "OFF") << std::endl;
 }
 
 void PostProcessManager::setSSAOEnabled(bool enabled) {
+    if (ssaoEnabled != enabled) {
+        chainDirty = true;
+    }
     ssaoEnabled = enabled;
     std::cout << "SSAO: " << (enabled ? "ON" : "OFF") << std::endl;
 }
 
 void PostProcessManager::setMotionBlurEnabled(bool enabled) {
+    if (motionBlurEnabled != enabled) {
+        chainDirty = true;
+    }
     motionBlurEnabled = enabled;
     std::cout << "Motion Blur: " << (enabled ? "ON" : "OFF") << std::endl;
 }
 
 void PostProcessManager::setAntiAliasingEnabled(bool enabled, int samples) {
+    if (aaEnabled != enabled || (enabled && aaSamples != samples)) {
+        chainDirty = true;
+    }
     aaEnabled = enabled;
+    aaSamples = samples;
     std::cout << "Anti-aliasing: " << (enabled ? "ON" : "OFF")
               << " (samples: " << samples << ")" << std::endl;
 }
 
 void PostProcessManager::setGraphicsQuality(GraphicsQuality quality) {
     currentQuality = quality;
+    int levels = bloomLevels;
 
     switch (quality) {
         case GraphicsQuality::Low:
@@ -82,6 +514,7 @@ void PostProcessManager::setGraphicsQuality(GraphicsQuality quality) {
             setSSAOEnabled(false);
             setMotionBlurEnabled(false);
             setAntiAliasingEnabled(false);
+            minRenderScale = 0.5f;
             break;
 
         case GraphicsQuality::Medium:
@@ -90,6 +523,8 @@ void PostProcessManager::setGraphicsQuality(GraphicsQuality quality) {
             setSSAOEnabled(false);
             setMotionBlurEnabled(false);
             setAntiAliasingEnabled(true, 2);
+            minRenderScale = 0.6f;
+            levels = 3;
             break;
 
         case GraphicsQuality::High:
@@ -98,6 +533,9 @@ void PostProcessManager::setGraphicsQuality(GraphicsQuality quality) {
             setSSAOEnabled(true);
             setMotionBlurEnabled(false);
             setAntiAliasingEnabled(true, 4);
+            minRenderScale = 0.7f;
+            levels = 4;
+            ssaoSamples = 8;
             break;
 
         case GraphicsQuality::Ultra:
@@ -106,9 +544,18 @@ void PostProcessManager::setGraphicsQuality(GraphicsQuality quality) {
             setSSAOEnabled(true);
             setMotionBlurEnabled(true);
             setAntiAliasingEnabled(true, 8);
+            minRenderScale = 0.8f;
+            levels = 5;
+            ssaoSamples = 12;
             break;
     }
 
+    if (levels != bloomLevels) {
+        bloomLevels = levels;
+        chainDirty = true;
+    }
+    setRenderScale(std::max(renderScale, minRenderScale));
+
     std::cout << "Graphics quality set to: " << static_cast<int>(quality) << std::endl;
 }
 
@@ -132,49 +579,4 @@ void PostProcessManager::setContrast(float con) {
     contrast = std::max(0.5f, std::min(2.0f, con));
 }
 
-void PostProcessManager::addScreenShake(float intensity, float duration) {
-    shakeIntensity = intensity;
-    shakeDuration = duration;
-}
-
-void PostProcessManager::updateScreenShake(float dt) {
-    if (shakeDuration > 0.0f) {
-        shakeDuration -= dt;
-
-        // Apply screen shake to camera
-        if (sceneManager && sceneManager->hasCamera("MainCamera")) {
-            Ogre::Camera* cam = sceneManager->getCamera("MainCamera");
-
-            // Random shake offset
-            float offsetX = (rand() / (float)RAND_MAX - 0.5f) * shakeIntensity;
-            float offsetY = (rand() / (float)RAND_MAX - 0.5f) * shakeIntensity;
-            float offsetZ = (rand() / (float)RAND_MAX - 0.5f) * shakeIntensity;
-
-            // Store original position on first shake
-            static bool hasOriginal = false;
-            if (!hasOriginal) {
-                originalCameraPosition = cam->getPosition();
-                hasOriginal = true;
-            }
-
-            // Apply shake
-            cam->setPosition(originalCameraPosition + Ogre::Vector3(offsetX, offsetY, offsetZ));
-
-            // Decrease intensity over time
-            shakeIntensity *= 0.95f;
-        }
-
-        if (shakeDuration <= 0.0f) {
-            shakeDuration = 0.0f;
-            shakeIntensity = 0.0f;
-
-            // Restore original camera position
-            if (sceneManager && sceneManager->hasCamera("MainCamera")) {
-                Ogre::Camera* cam = sceneManager->getCamera("MainCamera");
-                cam->setPosition(originalCameraPosition);
-            }
-        }
-    }
-}
-
 } // namespace BVA
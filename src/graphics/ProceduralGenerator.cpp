@@ -11,46 +11,220 @@
 // limitations under the License.
 
 #include "graphics/ProceduralGenerator.hpp"
+#include "graphics/MeshBuilder.hpp"
+#include "graphics/NoiseGenerator.hpp"
+#include "graphics/AnimationClip.hpp"
+#include "graphics/AnimationSystem.hpp"
+#include "core/AssetBaker.hpp"
+#include "audio/AudioEngine.hpp"
 #include <AL/al.h>
 #include <AL/alc.h>
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iterator>
 
 namespace BVA {
 
 // ==================== Procedural Mesh Generator ====================
 
 Ogre::SceneManager* ProceduralMeshGenerator::sm = nullptr;
+const AssetBaker* ProceduralMeshGenerator::baked = nullptr;
+
+namespace {
+
+// Bump when any generator's geometry changes, so cached meshes are rebuilt
+constexpr uint32_t MESH_GENERATOR_VERSION = 2;
+
+// Parameters of the meshes baked at startup
+constexpr float CHARACTER_MESH_HEIGHT = 2.0f;
+constexpr float CHARACTER_MESH_BASE = 1.0f / 1.2f;
+constexpr float ARENA_SIZE = 50.0f;
+constexpr float ARENA_WALL_HEIGHT = 5.0f;
+
+// Humanoid levels of detail: prism sides per level, and the screen area
+// ratio below which each coarser level takes over
+constexpr int HUMANOID_LOD_SIDES[] = {6, 4, 3};
+constexpr int HUMANOID_LOD_COUNT = static_cast<int>(std::size(HUMANOID_LOD_SIDES));
+const std::vector<float> HUMANOID_LOD_RATIOS = {0.01f, 0.002f};
+
+Ogre::ColourValue characterMeshColour() {
+    return Ogre::ColourValue(CHARACTER_MESH_BASE, CHARACTER_MESH_BASE, CHARACTER_MESH_BASE);
+}
+
+std::string arenaKey(float size) {
+    return "mesh/Arena/" + std::to_string(size);
+}
+
+const char* const PROP_NAMES[] = {"Desk", "Table", "Shelf", "Crate", "Pillar", "Bench"};
+static_assert(std::size(PROP_NAMES) == static_cast<size_t>(PropKind::Count), "PROP_NAMES out of sync");
+
+std::string propKey(PropKind kind) {
+    return std::string("mesh/Prop/") + getPropName(kind);
+}
+
+// Axis-aligned box between two corners, flat shaded. The bottom face is
+// left out: props stand on the floor.
+void addBox(MeshBuilder& builder, const Ogre::Vector3& lo, const Ogre::Vector3& hi,
+            const Ogre::ColourValue& color) {
+    // Top
+    builder.addFlatQuad(Ogre::Vector3(lo.x, hi.y, lo.z), Ogre::Vector3(lo.x, hi.y, hi.z),
+                        Ogre::Vector3(hi.x, hi.y, hi.z), Ogre::Vector3(hi.x, hi.y, lo.z), color);
+    // +Z, -Z
+    builder.addFlatQuad(Ogre::Vector3(lo.x, lo.y, hi.z), Ogre::Vector3(hi.x, lo.y, hi.z),
+                        Ogre::Vector3(hi.x, hi.y, hi.z), Ogre::Vector3(lo.x, hi.y, hi.z), color);
+    builder.addFlatQuad(Ogre::Vector3(hi.x, lo.y, lo.z), Ogre::Vector3(lo.x, lo.y, lo.z),
+                        Ogre::Vector3(lo.x, hi.y, lo.z), Ogre::Vector3(hi.x, hi.y, lo.z), color);
+    // +X, -X
+    builder.addFlatQuad(Ogre::Vector3(hi.x, lo.y, hi.z), Ogre::Vector3(hi.x, lo.y, lo.z),
+                        Ogre::Vector3(hi.x, hi.y, lo.z), Ogre::Vector3(hi.x, hi.y, hi.z), color);
+    builder.addFlatQuad(Ogre::Vector3(lo.x, lo.y, lo.z), Ogre::Vector3(lo.x, lo.y, hi.z),
+                        Ogre::Vector3(lo.x, hi.y, hi.z), Ogre::Vector3(lo.x, hi.y, lo.z), color);
+}
+
+// Prism between two heights with one side per step of `ring`, flat shaded.
+// xSign mirrors the profile for left-hand limbs.
+void addPrism(MeshBuilder& builder, const TrigTable& ring, float centreX, float xSign,
+              float radius, float y1, float y2, const Ogre::ColourValue& color) {
+    for (int i = 0; i < ring.getSteps(); i++) {
+        float x1 = centreX + xSign * radius * ring.cos(i);
+        float x2 = centreX + xSign * radius * ring.cos(i + 1);
+        float z1 = radius * ring.sin(i);
+        float z2 = radius * ring.sin(i + 1);
+
+        builder.addFlatQuad(Ogre::Vector3(x1, y1, z1), Ogre::Vector3(x2, y1, z2),
+                            Ogre::Vector3(x2, y2, z2), Ogre::Vector3(x1, y2, z1), color);
+    }
+}
+
+// Latitude/longitude grid over [0, rings] of `latitude`, one shared vertex
+// per grid point (seam and pole vertices are welded by the builder)
+template <typename VertexFn>
+void addSphereGrid(MeshBuilder& builder, const TrigTable& latitude, const TrigTable& longitude,
+                   int rings, VertexFn&& makeVertex) {
+    const int segments = longitude.getSteps();
+    std::vector<MeshBuilder::Index> previous(segments + 1);
+    std::vector<MeshBuilder::Index> current(segments + 1);
+
+    for (int r = 0; r <= rings; r++) {
+        for (int s = 0; s <= segments; s++) {
+            Ogre::Vector3 dir(latitude.sin(r) * longitude.cos(s), latitude.cos(r),
+                              latitude.sin(r) * longitude.sin(s));
+            current[s] = makeVertex(r, dir);
+        }
+
+        if (r > 0) {
+            for (int s = 0; s < segments; s++) {
+                builder.addQuad(previous[s], previous[s + 1], current[s + 1], current[s]);
+            }
+        }
+        std::swap(previous, current);
+    }
+}
+
+} // namespace
+
+const char* getPropName(PropKind kind) {
+    size_t index = static_cast<size_t>(kind);
+    return index < std::size(PROP_NAMES) ? PROP_NAMES[index] : "";
+}
 
 void ProceduralMeshGenerator::initialize(Ogre::SceneManager* sceneManager) {
     sm = sceneManager;
 }
 
-void ProceduralMeshGenerator::addVertex(Ogre::ManualObject* obj, const Ogre::Vector3& pos,
-                                        const Ogre::Vector3& normal, const Ogre::ColourValue& color) {
-    obj->position(pos);
-    obj->normal(normal);
-    obj->colour(color);
-    obj->textureCoord(pos.x, pos.z);
+void ProceduralMeshGenerator::registerBakeJobs(AssetBaker& assets) {
+    baked = &assets;
+
+    auto bake = [](auto build) {
+        return [build]() {
+            MeshBuilder builder;
+            build(builder);
+            return builder.serialize();
+        };
+    };
+
+    assets.addJob("mesh/Character", "height=2;base=1/1.2;skinned;lods=3", MESH_GENERATOR_VERSION, bake([](MeshBuilder& b) {
+        buildHumanoidLods(b, characterMeshColour(), CHARACTER_MESH_HEIGHT, true);
+    }));
+    assets.addJob("mesh/Projectile", "white", MESH_GENERATOR_VERSION, bake([](MeshBuilder& b) {
+        buildProjectile(b, Ogre::ColourValue::White);
+    }));
+    assets.addJob(arenaKey(ARENA_SIZE) + "/Floor", "", MESH_GENERATOR_VERSION, bake([](MeshBuilder& b) {
+        buildArenaFloor(b, ARENA_SIZE);
+    }));
+    assets.addJob(arenaKey(ARENA_SIZE) + "/Walls", "", MESH_GENERATOR_VERSION, bake([](MeshBuilder& b) {
+        buildArenaWalls(b, ARENA_SIZE);
+    }));
+    for (size_t i = 0; i < static_cast<size_t>(PropKind::Count); i++) {
+        PropKind kind = static_cast<PropKind>(i);
+        assets.addJob(propKey(kind), "", MESH_GENERATOR_VERSION, bake([kind](MeshBuilder& b) {
+            buildProp(b, kind);
+        }));
+    }
+    assets.addJob("mesh/SkyDome", "", MESH_GENERATOR_VERSION, bake([](MeshBuilder& b) {
+        buildSkyDome(b);
+    }));
+}
+
+Ogre::ManualObject* ProceduralMeshGenerator::createBakedObject(const std::string& name, const std::string& material,
+                                                               const std::string& key,
+                                                               const std::function<void(MeshBuilder&)>& build) {
+    auto* obj = sm->createManualObject(name);
+
+    BakedAsset asset = baked ? baked->get(key) : BakedAsset{};
+    if (asset && MeshBuilder::commitSerialized(obj, material, asset.data, asset.size)) {
+        return obj;
+    }
+
+    // Not baked (or a corrupt blob): build it here
+    MeshBuilder builder;
+    build(builder);
+    builder.commit(obj, material);
+    return obj;
 }
 
-void ProceduralMeshGenerator::addQuad(Ogre::ManualObject* obj, const Ogre::Vector3& v1,
-                                     const Ogre::Vector3& v2, const Ogre::Vector3& v3,
-                                     const Ogre::Vector3& v4, const Ogre::ColourValue& color) {
-    Ogre::Vector3 normal = (v2 - v1).crossProduct(v3 - v1).normalisedCopy();
+Ogre::MeshPtr ProceduralMeshGenerator::createBakedMesh(const std::string& meshName, const std::string& material,
+                                                       const std::string& key,
+                                                       const std::function<void(MeshBuilder&)>& build,
+                                                       const std::vector<float>& lodRatios) {
+    auto* obj = sm->createManualObject(meshName + "Source");
+
+    BakedAsset asset = baked ? baked->get(key) : BakedAsset{};
+    bool fromBlob = asset && MeshBuilder::commitSerialized(obj, material, asset.data, asset.size);
+
+    MeshBuilder builder;
+    if (!fromBlob) {
+        build(builder);
+        builder.commit(obj, material);
+    }
 
-    addVertex(obj, v1, normal, color);
-    addVertex(obj, v2, normal, color);
-    addVertex(obj, v3, normal, color);
-    addVertex(obj, v4, normal, color);
+    Ogre::MeshPtr mesh = obj->convertToMesh(meshName);
+    sm->destroyManualObject(obj);
+
+    if (fromBlob) {
+        MeshBuilder::addSerializedLodLevels(mesh, lodRatios, asset.data, asset.size);
+    } else {
+        builder.addLodLevels(mesh, lodRatios);
+    }
+    return mesh;
 }
 
-Ogre::ManualObject* ProceduralMeshGenerator::createStylizedHumanoid(const std::string& name,
-                                                                     const Ogre::ColourValue& color,
-                                                                     float height) {
-    auto* obj = sm->createManualObject(name);
-    obj->begin("CharacterMaterial", Ogre::RenderOperation::OT_TRIANGLE_LIST);
+void ProceduralMeshGenerator::buildStylizedHumanoid(MeshBuilder& builder, const Ogre::ColourValue& color,
+                                                   float height, bool skinned, int lod) {
+    static const TrigTable rings[] = {TrigTable(HUMANOID_LOD_SIDES[0], 2.0f * M_PI),
+                                      TrigTable(HUMANOID_LOD_SIDES[1], 2.0f * M_PI),
+                                      TrigTable(HUMANOID_LOD_SIDES[2], 2.0f * M_PI)};
+    const TrigTable& ring = rings[std::clamp(lod, 0, HUMANOID_LOD_COUNT - 1)];
+
+    auto setBone = [&builder, skinned](HumanoidBone bone) {
+        if (skinned) {
+            builder.setBoneIndex(static_cast<int>(bone));
+        }
+    };
 
     float w = height * 0.3f;  // Width
     float h = height;         // Height
@@ -61,92 +235,61 @@ Ogre::ManualObject* ProceduralMeshGenerator::createStylizedHumanoid(const std::s
     Ogre::ColourValue bodyColor = color * 1.1f;
 
     // Front face
-    addVertex(obj, Ogre::Vector3(-w/2, 0, d/2), Ogre::Vector3(0, 0, 1), bodyColor);
-    addVertex(obj, Ogre::Vector3(w/2, 0, d/2), Ogre::Vector3(0, 0, 1), bodyColor);
-    addVertex(obj, Ogre::Vector3(w/2, bodyH, d/2), Ogre::Vector3(0, 0, 1), bodyColor);
-    addVertex(obj, Ogre::Vector3(-w/2, bodyH, d/2), Ogre::Vector3(0, 0, 1), bodyColor);
-    obj->quad(0, 1, 2, 3);
-
-    // Head (stylized cube)
+    setBone(HumanoidBone::Spine);
+    Ogre::Vector3 front(0, 0, 1);
+    builder.addQuad(builder.addVertex(Ogre::Vector3(-w/2, 0, d/2), front, bodyColor),
+                    builder.addVertex(Ogre::Vector3(w/2, 0, d/2), front, bodyColor),
+                    builder.addVertex(Ogre::Vector3(w/2, bodyH, d/2), front, bodyColor),
+                    builder.addVertex(Ogre::Vector3(-w/2, bodyH, d/2), front, bodyColor));
+
+    // Head (stylized prism block, hexagonal at full detail)
     float headSize = h * 0.2f;
-    float headY = bodyH;
-    Ogre::ColourValue headColor = color * 1.2f;
-
-    for (int i = 0; i < 6; i++) {
-        float angle = i * M_PI / 3.0f;
-        float nextAngle = (i + 1) * M_PI / 3.0f;
-        float r = headSize;
-
-        Ogre::Vector3 v1(r * cos(angle), headY, r * sin(angle));
-        Ogre::Vector3 v2(r * cos(nextAngle), headY, r * sin(nextAngle));
-        Ogre::Vector3 v3(r * cos(nextAngle), headY + headSize, r * sin(nextAngle));
-        Ogre::Vector3 v4(r * cos(angle), headY + headSize, r * sin(angle));
+    setBone(HumanoidBone::Head);
+    addPrism(builder, ring, 0.0f, 1.0f, headSize, bodyH, bodyH + headSize, color * 1.2f);
 
-        addQuad(obj, v1, v2, v3, v4, headColor);
-    }
-
-    // Arms (stylized cylinders)
+    // Arms (stylized cylinders, left one mirrored)
     float armW = w * 0.15f;
     float armL = bodyH * 0.8f;
+    float shoulderY = bodyH * 0.7f;
     Ogre::ColourValue armColor = color * 0.9f;
 
-    // Left arm
-    for (int i = 0; i < 6; i++) {
-        float angle = i * M_PI / 3.0f;
-        float nextAngle = (i + 1) * M_PI / 3.0f;
-
-        Ogre::Vector3 v1(-w/2 - armW * cos(angle), bodyH * 0.7f, armW * sin(angle));
-        Ogre::Vector3 v2(-w/2 - armW * cos(nextAngle), bodyH * 0.7f, armW * sin(nextAngle));
-        Ogre::Vector3 v3(-w/2 - armW * cos(nextAngle), bodyH * 0.7f - armL, armW * sin(nextAngle));
-        Ogre::Vector3 v4(-w/2 - armW * cos(angle), bodyH * 0.7f - armL, armW * sin(angle));
-
-        addQuad(obj, v1, v2, v3, v4, armColor);
-    }
-
-    // Right arm (mirrored)
-    for (int i = 0; i < 6; i++) {
-        float angle = i * M_PI / 3.0f;
-        float nextAngle = (i + 1) * M_PI / 3.0f;
-
-        Ogre::Vector3 v1(w/2 + armW * cos(angle), bodyH * 0.7f, armW * sin(angle));
-        Ogre::Vector3 v2(w/2 + armW * cos(nextAngle), bodyH * 0.7f, armW * sin(nextAngle));
-        Ogre::Vector3 v3(w/2 + armW * cos(nextAngle), bodyH * 0.7f - armL, armW * sin(nextAngle));
-        Ogre::Vector3 v4(w/2 + armW * cos(angle), bodyH * 0.7f - armL, armW * sin(angle));
-
-        addQuad(obj, v1, v2, v3, v4, armColor);
-    }
+    setBone(HumanoidBone::ArmLeft);
+    addPrism(builder, ring, -w/2, -1.0f, armW, shoulderY, shoulderY - armL, armColor);
+    setBone(HumanoidBone::ArmRight);
+    addPrism(builder, ring, w/2, 1.0f, armW, shoulderY, shoulderY - armL, armColor);
 
     // Legs
     float legW = w * 0.2f;
     float legL = h * 0.5f;
 
-    // Left leg
-    for (int i = 0; i < 6; i++) {
-        float angle = i * M_PI / 3.0f;
-        float nextAngle = (i + 1) * M_PI / 3.0f;
-
-        Ogre::Vector3 v1(-w/4 + legW * cos(angle), 0, legW * sin(angle));
-        Ogre::Vector3 v2(-w/4 + legW * cos(nextAngle), 0, legW * sin(nextAngle));
-        Ogre::Vector3 v3(-w/4 + legW * cos(nextAngle), -legL, legW * sin(nextAngle));
-        Ogre::Vector3 v4(-w/4 + legW * cos(angle), -legL, legW * sin(angle));
+    setBone(HumanoidBone::LegLeft);
+    addPrism(builder, ring, -w/4, 1.0f, legW, 0.0f, -legL, armColor);
+    setBone(HumanoidBone::LegRight);
+    addPrism(builder, ring, w/4, 1.0f, legW, 0.0f, -legL, armColor);
 
-        addQuad(obj, v1, v2, v3, v4, armColor);
+    if (skinned) {
+        builder.setBoneIndex(-1);
     }
+}
 
-    // Right leg
-    for (int i = 0; i < 6; i++) {
-        float angle = i * M_PI / 3.0f;
-        float nextAngle = (i + 1) * M_PI / 3.0f;
-
-        Ogre::Vector3 v1(w/4 + legW * cos(angle), 0, legW * sin(angle));
-        Ogre::Vector3 v2(w/4 + legW * cos(nextAngle), 0, legW * sin(nextAngle));
-        Ogre::Vector3 v3(w/4 + legW * cos(nextAngle), -legL, legW * sin(nextAngle));
-        Ogre::Vector3 v4(w/4 + legW * cos(angle), -legL, legW * sin(angle));
-
-        addQuad(obj, v1, v2, v3, v4, armColor);
+void ProceduralMeshGenerator::buildHumanoidLods(MeshBuilder& builder, const Ogre::ColourValue& color,
+                                               float height, bool skinned) {
+    for (int lod = 0; lod < HUMANOID_LOD_COUNT; lod++) {
+        if (lod > 0) {
+            builder.beginLodLevel();
+        }
+        buildStylizedHumanoid(builder, color, height, skinned, lod);
     }
+}
 
-    obj->end();
+Ogre::ManualObject* ProceduralMeshGenerator::createStylizedHumanoid(const std::string& name,
+                                                                     const Ogre::ColourValue& color,
+                                                                     float height) {
+    MeshBuilder builder(128, 192);
+    buildStylizedHumanoid(builder, color, height);
+
+    auto* obj = sm->createManualObject(name);
+    builder.commit(obj, "CharacterMaterial");
     return obj;
 }
 
@@ -161,200 +304,533 @@ Ogre::ManualObject* ProceduralMeshGenerator::createBossMesh(const std::string& n
     return createStylizedHumanoid(name, color, 3.0f * scale);
 }
 
-Ogre::ManualObject* ProceduralMeshGenerator::createWeaponEffect(const std::string& name,
-                                                                 const Ogre::ColourValue& color) {
-    auto* obj = sm->createManualObject(name);
-    obj->begin("EnergyMaterial", Ogre::RenderOperation::OT_TRIANGLE_LIST);
-
-    // Create energy blade/trail effect
+void ProceduralMeshGenerator::buildWeaponEffect(MeshBuilder& builder, const Ogre::ColourValue& color) {
+    // Energy blade/trail: a tapering strip, each row shared by two segments
     int segments = 12;
     float length = 2.0f;
     float width = 0.3f;
+    Ogre::Vector3 normal(0, 0, 1);
 
-    for (int i = 0; i < segments; i++) {
-        float t = (float)i / segments;
-        float nextT = (float)(i + 1) / segments;
+    MeshBuilder::Index prevLeft = 0;
+    MeshBuilder::Index prevRight = 0;
 
-        float y1 = t * length;
-        float y2 = nextT * length;
-        float w1 = width * (1.0f - t);
-        float w2 = width * (1.0f - nextT);
+    for (int i = 0; i <= segments; i++) {
+        float t = (float)i / segments;
+        float y = t * length;
+        float w = width * (1.0f - t);
 
         Ogre::ColourValue c = color;
         c.a = 1.0f - t * 0.8f;
 
-        addVertex(obj, Ogre::Vector3(-w1, y1, 0), Ogre::Vector3(0, 0, 1), c);
-        addVertex(obj, Ogre::Vector3(w1, y1, 0), Ogre::Vector3(0, 0, 1), c);
-
-        c.a = 1.0f - nextT * 0.8f;
-        addVertex(obj, Ogre::Vector3(w2, y2, 0), Ogre::Vector3(0, 0, 1), c);
-        addVertex(obj, Ogre::Vector3(-w2, y2, 0), Ogre::Vector3(0, 0, 1), c);
+        MeshBuilder::Index left = builder.addVertex(Ogre::Vector3(-w, y, 0), normal, c);
+        MeshBuilder::Index right = builder.addVertex(Ogre::Vector3(w, y, 0), normal, c);
 
-        int base = i * 4;
-        obj->quad(base, base + 1, base + 2, base + 3);
+        if (i > 0) {
+            builder.addQuad(prevLeft, prevRight, right, left);
+        }
+        prevLeft = left;
+        prevRight = right;
     }
+}
+
+Ogre::ManualObject* ProceduralMeshGenerator::createWeaponEffect(const std::string& name,
+                                                                 const Ogre::ColourValue& color) {
+    MeshBuilder builder(26, 72);
+    buildWeaponEffect(builder, color);
 
-    obj->end();
+    auto* obj = sm->createManualObject(name);
+    builder.commit(obj, "EnergyMaterial");
     return obj;
 }
 
+void ProceduralMeshGenerator::buildProjectile(MeshBuilder& builder, const Ogre::ColourValue& color) {
+    // Glowing sphere-like projectile
+    const int segments = 16;
+    const int rings = 8;
+    const float radius = 0.3f;
+    static const TrigTable latitude(rings, M_PI);
+    static const TrigTable longitude(segments, 2.0f * M_PI);
+
+    addSphereGrid(builder, latitude, longitude, rings, [&](int, const Ogre::Vector3& dir) {
+        return builder.addVertex(dir * radius, dir, color);
+    });
+}
+
 Ogre::ManualObject* ProceduralMeshGenerator::createProjectile(const std::string& name,
                                                                const Ogre::ColourValue& color) {
+    MeshBuilder builder(160, 768);
+    buildProjectile(builder, color);
+
     auto* obj = sm->createManualObject(name);
-    obj->begin("GlowingMaterial", Ogre::RenderOperation::OT_TRIANGLE_LIST);
-
-    // Create glowing sphere-like projectile
-    int segments = 16;
-    int rings = 8;
-    float radius = 0.3f;
-
-    for (int r = 0; r < rings; r++) {
-        for (int s = 0; s < segments; s++) {
-            float theta1 = r * M_PI / rings;
-            float theta2 = (r + 1) * M_PI / rings;
-            float phi1 = s * 2 * M_PI / segments;
-            float phi2 = (s + 1) * 2 * M_PI / segments;
-
-            Ogre::Vector3 v1(radius * sin(theta1) * cos(phi1), radius * cos(theta1), radius * sin(theta1) * sin(phi1));
-            Ogre::Vector3 v2(radius * sin(theta1) * cos(phi2), radius * cos(theta1), radius * sin(theta1) * sin(phi2));
-            Ogre::Vector3 v3(radius * sin(theta2) * cos(phi2), radius * cos(theta2), radius * sin(theta2) * sin(phi2));
-            Ogre::Vector3 v4(radius * sin(theta2) * cos(phi1), radius * cos(theta2), radius * sin(theta2) * sin(phi1));
-
-            addQuad(obj, v1, v2, v3, v4, color);
-        }
+    builder.commit(obj, "GlowingMaterial");
+    return obj;
+}
+
+Ogre::MeshPtr ProceduralMeshGenerator::getProjectileMesh() {
+    const std::string meshName = "ProjectileMesh";
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().getByName(meshName);
+    if (mesh) {
+        return mesh;
     }
 
-    obj->end();
-    return obj;
+    // White base colour, tinted per instance
+    return createBakedMesh(meshName, "GlowingMaterial", "mesh/Projectile",
+                           [](MeshBuilder& b) { buildProjectile(b, Ogre::ColourValue::White); });
 }
 
-Ogre::ManualObject* ProceduralMeshGenerator::createArena(const std::string& name, float size) {
-    auto* obj = sm->createManualObject(name);
-    obj->begin("ArenaMaterial", Ogre::RenderOperation::OT_TRIANGLE_LIST);
+Ogre::MeshPtr ProceduralMeshGenerator::getCharacterMesh() {
+    const std::string meshName = "CharacterMesh";
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().getByName(meshName);
+    if (mesh) {
+        return mesh;
+    }
+
+    // The humanoid shades its parts at 0.9-1.2x the base colour; bake that
+    // relative shading (head at full white) and tint per instance. Parts are
+    // tagged with their bone for the animated instanced material. The
+    // coarser prisms become the mesh's screen-size LOD levels.
+    return createBakedMesh(meshName, "CharacterMaterial", "mesh/Character",
+        [](MeshBuilder& b) { buildHumanoidLods(b, characterMeshColour(), CHARACTER_MESH_HEIGHT, true); },
+        HUMANOID_LOD_RATIOS);
+}
+
+void ProceduralMeshGenerator::buildArena(MeshBuilder& builder, float size) {
+    buildArenaFloor(builder, size);
+    buildArenaWalls(builder, size);
+}
 
-    // Create stylized arena floor with grid pattern
+void ProceduralMeshGenerator::buildArenaFloor(MeshBuilder& builder, float size) {
+    // Arena floor: one shared-vertex grid instead of a quad per cell
     int divisions = 20;
     float cellSize = size / divisions;
+    Ogre::Vector3 up(0, 1, 0);
 
-    for (int x = 0; x < divisions; x++) {
-        for (int z = 0; z < divisions; z++) {
-            float x1 = (x - divisions/2) * cellSize;
-            float x2 = (x + 1 - divisions/2) * cellSize;
-            float z1 = (z - divisions/2) * cellSize;
-            float z2 = (z + 1 - divisions/2) * cellSize;
+    std::vector<MeshBuilder::Index> previous(divisions + 1);
+    std::vector<MeshBuilder::Index> current(divisions + 1);
 
-            // Checkerboard pattern
+    for (int x = 0; x <= divisions; x++) {
+        for (int z = 0; z <= divisions; z++) {
+            // Checkerboard parity, with glow along the even grid lines
             Ogre::ColourValue color = ((x + z) % 2 == 0) ?
                 Ogre::ColourValue(0.2f, 0.2f, 0.3f) :
                 Ogre::ColourValue(0.15f, 0.15f, 0.25f);
 
-            // Add glow to grid lines
             if (x % 2 == 0 || z % 2 == 0) {
                 color += Ogre::ColourValue(0.05f, 0.1f, 0.2f);
             }
 
-            Ogre::Vector3 v1(x1, 0, z1);
-            Ogre::Vector3 v2(x2, 0, z1);
-            Ogre::Vector3 v3(x2, 0, z2);
-            Ogre::Vector3 v4(x1, 0, z2);
+            Ogre::Vector3 pos((x - divisions/2) * cellSize, 0, (z - divisions/2) * cellSize);
+            current[z] = builder.addVertex(pos, up, color);
+        }
 
-            addQuad(obj, v1, v2, v3, v4, color);
+        if (x > 0) {
+            for (int z = 0; z < divisions; z++) {
+                builder.addQuad(previous[z], previous[z + 1], current[z + 1], current[z]);
+            }
         }
+        std::swap(previous, current);
     }
+}
 
+void ProceduralMeshGenerator::buildArenaWalls(MeshBuilder& builder, float size) {
     // Arena walls with energy effect
-    float wallHeight = 5.0f;
     Ogre::ColourValue wallColor(0.1f, 0.3f, 0.5f, 0.3f);
 
     // North wall
-    addQuad(obj,
+    builder.addFlatQuad(
         Ogre::Vector3(-size/2, 0, size/2),
         Ogre::Vector3(size/2, 0, size/2),
-        Ogre::Vector3(size/2, wallHeight, size/2),
-        Ogre::Vector3(-size/2, wallHeight, size/2),
+        Ogre::Vector3(size/2, ARENA_WALL_HEIGHT, size/2),
+        Ogre::Vector3(-size/2, ARENA_WALL_HEIGHT, size/2),
         wallColor);
+}
 
-    obj->end();
-    return obj;
+std::vector<std::array<Ogre::Vector3, 4>> ProceduralMeshGenerator::getArenaOccluders(float size) {
+    // Must match buildArenaFloor. The wall uses the emissive, additive
+    // ArenaWallMaterial and is see-through, so it hides nothing.
+    float half = size / 2;
+    return {
+        {Ogre::Vector3(-half, 0, -half), Ogre::Vector3(half, 0, -half),
+         Ogre::Vector3(half, 0, half), Ogre::Vector3(-half, 0, half)},
+    };
 }
 
-Ogre::ManualObject* ProceduralMeshGenerator::createSkyDome(const std::string& name) {
-    auto* obj = sm->createManualObject(name);
-    obj->begin("SkyMaterial", Ogre::RenderOperation::OT_TRIANGLE_LIST);
-
-    // Create gradient sky dome
-    int segments = 32;
-    int rings = 16;
-    float radius = 500.0f;
-
-    for (int r = 0; r < rings / 2; r++) {  // Only top half for dome
-        for (int s = 0; s < segments; s++) {
-            float theta1 = r * M_PI / rings;
-            float theta2 = (r + 1) * M_PI / rings;
-            float phi1 = s * 2 * M_PI / segments;
-            float phi2 = (s + 1) * 2 * M_PI / segments;
-
-            // Gradient from dark blue to cyan
-            float t1 = (float)r / (rings / 2);
-            float t2 = (float)(r + 1) / (rings / 2);
-            Ogre::ColourValue color1 = Ogre::ColourValue(0.1f, 0.2f, 0.4f) * (1.0f - t1) + Ogre::ColourValue(0.3f, 0.5f, 0.8f) * t1;
-            Ogre::ColourValue color2 = Ogre::ColourValue(0.1f, 0.2f, 0.4f) * (1.0f - t2) + Ogre::ColourValue(0.3f, 0.5f, 0.8f) * t2;
-
-            Ogre::Vector3 v1(radius * sin(theta1) * cos(phi1), radius * cos(theta1), radius * sin(theta1) * sin(phi1));
-            Ogre::Vector3 v2(radius * sin(theta1) * cos(phi2), radius * cos(theta1), radius * sin(theta1) * sin(phi2));
-            Ogre::Vector3 v3(radius * sin(theta2) * cos(phi2), radius * cos(theta2), radius * sin(theta2) * sin(phi2));
-            Ogre::Vector3 v4(radius * sin(theta2) * cos(phi1), radius * cos(theta2), radius * sin(theta2) * sin(phi1));
-
-            Ogre::Vector3 normal = Ogre::Vector3::ZERO - v1;
-            normal.normalise();
-
-            addVertex(obj, v1, normal, color1);
-            addVertex(obj, v2, normal, color1);
-            addVertex(obj, v3, normal, color2);
-            addVertex(obj, v4, normal, color2);
-
-            int base = (r * segments + s) * 4;
-            obj->quad(base, base + 1, base + 2, base + 3);
+Ogre::MeshPtr ProceduralMeshGenerator::getArenaFloorMesh(float size) {
+    const std::string key = arenaKey(size) + "/Floor";
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().getByName(key);
+    if (mesh) {
+        return mesh;
+    }
+    return createBakedMesh(key, "ArenaMaterial", key, [size](MeshBuilder& b) { buildArenaFloor(b, size); });
+}
+
+Ogre::MeshPtr ProceduralMeshGenerator::getArenaWallMesh(float size) {
+    const std::string key = arenaKey(size) + "/Walls";
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().getByName(key);
+    if (mesh) {
+        return mesh;
+    }
+    return createBakedMesh(key, "ArenaWallMaterial", key, [size](MeshBuilder& b) { buildArenaWalls(b, size); });
+}
+
+void ProceduralMeshGenerator::buildProp(MeshBuilder& builder, PropKind kind) {
+    // Origin at the centre of the footprint, on the floor
+    static const TrigTable hex(6, 2.0f * M_PI);
+    Ogre::ColourValue wood(0.45f, 0.3f, 0.2f);
+    Ogre::ColourValue metal(0.35f, 0.38f, 0.42f);
+
+    auto addLegs = [&builder](float halfX, float halfZ, float height, float width, const Ogre::ColourValue& color) {
+        for (float sx : {-1.0f, 1.0f}) {
+            for (float sz : {-1.0f, 1.0f}) {
+                Ogre::Vector3 corner(sx * (halfX - width), 0.0f, sz * (halfZ - width));
+                addBox(builder, corner - Ogre::Vector3(width, 0.0f, width),
+                       corner + Ogre::Vector3(width, height, width), color);
+            }
         }
+    };
+
+    switch (kind) {
+        case PropKind::Desk:
+            addBox(builder, Ogre::Vector3(-0.6f, 0.72f, -0.35f), Ogre::Vector3(0.6f, 0.78f, 0.35f), wood);
+            addLegs(0.6f, 0.35f, 0.72f, 0.03f, metal);
+            break;
+        case PropKind::Table:
+            addBox(builder, Ogre::Vector3(-1.0f, 0.72f, -0.5f), Ogre::Vector3(1.0f, 0.8f, 0.5f), wood);
+            addLegs(1.0f, 0.5f, 0.72f, 0.05f, metal);
+            break;
+        case PropKind::Shelf:
+            addBox(builder, Ogre::Vector3(-0.8f, 0.0f, -0.2f), Ogre::Vector3(0.8f, 2.2f, 0.2f), wood * 0.8f);
+            break;
+        case PropKind::Crate:
+            addBox(builder, Ogre::Vector3(-0.4f, 0.0f, -0.4f), Ogre::Vector3(0.4f, 0.8f, 0.4f), wood * 1.2f);
+            break;
+        case PropKind::Pillar:
+            addPrism(builder, hex, 0.0f, 1.0f, 0.5f, 0.0f, ARENA_WALL_HEIGHT, metal);
+            break;
+        case PropKind::Bench:
+            addBox(builder, Ogre::Vector3(-1.0f, 0.4f, -0.2f), Ogre::Vector3(1.0f, 0.48f, 0.2f), wood);
+            addLegs(1.0f, 0.2f, 0.4f, 0.04f, metal);
+            break;
+        case PropKind::Count:
+            break;
     }
+}
 
-    obj->end();
-    return obj;
+Ogre::MeshPtr ProceduralMeshGenerator::getPropMesh(PropKind kind) {
+    const std::string key = propKey(kind);
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().getByName(key);
+    if (mesh) {
+        return mesh;
+    }
+    return createBakedMesh(key, "PropMaterial", key, [kind](MeshBuilder& b) { buildProp(b, kind); });
+}
+
+void ProceduralMeshGenerator::waitForLevelMeshes(float arenaSize, const std::vector<PropKind>& props) {
+    if (!baked) return;
+
+    baked->get(arenaKey(arenaSize) + "/Floor");
+    baked->get(arenaKey(arenaSize) + "/Walls");
+    for (PropKind kind : props) {
+        baked->get(propKey(kind));
+    }
+}
+
+void ProceduralMeshGenerator::buildSkyDome(MeshBuilder& builder) {
+    // Gradient sky dome (top half of a 16-ring sphere)
+    const int segments = 32;
+    const int rings = 16;
+    const float radius = 500.0f;
+    static const TrigTable latitude(rings, M_PI);
+    static const TrigTable longitude(segments, 2.0f * M_PI);
+
+    // Gradient from dark blue to cyan, one colour per ring
+    addSphereGrid(builder, latitude, longitude, rings / 2, [&](int r, const Ogre::Vector3& dir) {
+        float t = (float)r / (rings / 2);
+        Ogre::ColourValue color = Ogre::ColourValue(0.1f, 0.2f, 0.4f) * (1.0f - t) +
+                                  Ogre::ColourValue(0.3f, 0.5f, 0.8f) * t;
+        return builder.addVertex(dir * radius, -dir, color);
+    });
+}
+
+Ogre::ManualObject* ProceduralMeshGenerator::createSkyDome(const std::string& name) {
+    return createBakedObject(name, "SkyMaterial", "mesh/SkyDome",
+                             [](MeshBuilder& b) { buildSkyDome(b); });
+}
+
+void ProceduralMeshGenerator::runBenchmark(int iterations) {
+    struct Generator {
+        const char* name;
+        std::function<void(MeshBuilder&)> build;
+    };
+
+    const Generator generators[] = {
+        {"Humanoid", [](MeshBuilder& b) { buildHumanoidLods(b, Ogre::ColourValue::White, 2.0f, true); }},
+        {"WeaponEffect", [](MeshBuilder& b) { buildWeaponEffect(b, Ogre::ColourValue::White); }},
+        {"Projectile", [](MeshBuilder& b) { buildProjectile(b, Ogre::ColourValue::White); }},
+        {"Arena", [](MeshBuilder& b) { buildArena(b, 50.0f); }},
+        {"Desk", [](MeshBuilder& b) { buildProp(b, PropKind::Desk); }},
+        {"SkyDome", [](MeshBuilder& b) { buildSkyDome(b); }},
+    };
+
+    std::cout << "Mesh generator benchmark (" << iterations << " builds each)" << std::endl;
+
+    MeshBuilder builder;
+    for (const Generator& generator : generators) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            builder.clear();
+            generator.build(builder);
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        size_t vertexBytes = builder.getVertexCount() * sizeof(MeshBuilder::Vertex);
+        size_t indexBytes = builder.getIndexCount() * sizeof(MeshBuilder::Index);
+
+        std::cout << "  " << generator.name
+                  << ": " << builder.getVertexCount() << " vertices (" << builder.getSubmittedVertexCount()
+                  << " submitted), " << builder.getIndexCount() / 3 << " triangles, "
+                  << (vertexBytes + indexBytes) / 1024.0 << " KB, "
+                  << elapsed.count() / iterations << " us/build" << std::endl;
+
+        if (builder.getLodLevelCount() > 1) {
+            std::cout << "    triangles per LOD:";
+            for (size_t level = 0; level < builder.getLodLevelCount(); level++) {
+                std::cout << " " << builder.getLodIndexCount(level) / 3;
+            }
+            std::cout << std::endl;
+        }
+    }
 }
 
 // ==================== Procedural Texture Generator ====================
 
+const AssetBaker* ProceduralTextureGenerator::baked = nullptr;
+
+namespace {
+
+// Bump when any texture generator changes, so cached textures are rebuilt
+constexpr uint32_t TEXTURE_GENERATOR_VERSION = 1;
+
+constexpr int GRADIENT_TEXTURE_SIZE = 256;
+constexpr int PATTERN_TEXTURE_SIZE = 512;
+
+uint8_t toByte(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// Same name, same texture: the noise seed comes from the texture name
+uint32_t seedFromName(const std::string& name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+// Name, size and colours: a request only uses the baked pixels when it
+// would generate exactly the same ones
+std::string textureKey(const char* kind, const std::string& name, int width, int height,
+                       std::initializer_list<Ogre::ColourValue> colours = {}) {
+    std::string key = std::string("tex/") + kind + "/" + name + "/" + std::to_string(width) + "x" +
+                      std::to_string(height);
+    for (const Ogre::ColourValue& colour : colours) {
+        key += ";" + Ogre::StringConverter::toString(colour);
+    }
+    return key;
+}
+
+// The standard texture set baked at startup; the colours follow the sky
+// dome and the arena floor
+struct BakedNoiseTexture {
+    const char* name;
+    int width;
+    int height;
+};
+
+struct BakedColourTexture {
+    const char* name;
+    Ogre::ColourValue color1;
+    Ogre::ColourValue color2 = Ogre::ColourValue::White;  // Gradients only
+};
+
+const BakedNoiseTexture BAKED_NOISE_TEXTURES[] = {
+    {"Noise", 256, 256},
+};
+
+const BakedColourTexture BAKED_GRADIENT_TEXTURES[] = {
+    {"SkyGradient", Ogre::ColourValue(0.3f, 0.5f, 0.8f), Ogre::ColourValue(0.1f, 0.2f, 0.4f)},
+};
+
+const BakedColourTexture BAKED_PATTERN_TEXTURES[] = {
+    {"ArenaPanels", Ogre::ColourValue(0.2f, 0.2f, 0.3f)},
+};
+
+} // namespace
+
 void ProceduralTextureGenerator::initialize() {
     // Initialize materials
 }
 
-float ProceduralTextureGenerator::perlinNoise(float x, float y) {
-    int xi = (int)x;
-    int yi = (int)y;
-    float xf = x - xi;
-    float yf = y - yi;
+void ProceduralTextureGenerator::registerBakeJobs(AssetBaker& assets) {
+    baked = &assets;
 
-    float u = xf * xf * (3.0f - 2.0f * xf);
-    float v = yf * yf * (3.0f - 2.0f * yf);
+    for (const BakedNoiseTexture& texture : BAKED_NOISE_TEXTURES) {
+        std::string name = texture.name;
+        int width = texture.width;
+        int height = texture.height;
+        assets.addJob(textureKey("noise", name, width, height), "", TEXTURE_GENERATOR_VERSION,
+                      [name, width, height] { return buildNoiseTexture(name, width, height); });
+    }
+    for (const BakedColourTexture& texture : BAKED_GRADIENT_TEXTURES) {
+        std::string name = texture.name;
+        Ogre::ColourValue color1 = texture.color1;
+        Ogre::ColourValue color2 = texture.color2;
+        assets.addJob(textureKey("gradient", name, GRADIENT_TEXTURE_SIZE, GRADIENT_TEXTURE_SIZE, {color1, color2}),
+                      "", TEXTURE_GENERATOR_VERSION,
+                      [name, color1, color2] { return buildGradientTexture(name, color1, color2); });
+    }
+    for (const BakedColourTexture& texture : BAKED_PATTERN_TEXTURES) {
+        std::string name = texture.name;
+        Ogre::ColourValue color = texture.color1;
+        assets.addJob(textureKey("pattern", name, PATTERN_TEXTURE_SIZE, PATTERN_TEXTURE_SIZE, {color}),
+                      "", TEXTURE_GENERATOR_VERSION,
+                      [name, color] { return buildPatternTexture(name, color); });
+    }
+}
 
-    float n00 = smoothNoise(xi, yi);
-    float n10 = smoothNoise(xi + 1, yi);
-    float n01 = smoothNoise(xi, yi + 1);
-    float n11 = smoothNoise(xi + 1, yi + 1);
+Ogre::TexturePtr ProceduralTextureGenerator::createTexture(const std::string& name, int width, int height,
+                                                           const uint8_t* rgba) {
+    Ogre::TexturePtr texture = Ogre::TextureManager::getSingleton().createManual(
+        name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D,
+        width, height, Ogre::MIP_DEFAULT, Ogre::PF_BYTE_RGBA, Ogre::TU_DEFAULT);
 
-    float nx0 = n00 * (1 - u) + n10 * u;
-    float nx1 = n01 * (1 - u) + n11 * u;
+    Ogre::PixelBox pixels(width, height, 1, Ogre::PF_BYTE_RGBA, const_cast<uint8_t*>(rgba));
+    texture->getBuffer()->blitFromMemory(pixels);
+    return texture;
+}
 
-    return nx0 * (1 - v) + nx1 * v;
+Ogre::TexturePtr ProceduralTextureGenerator::createBakedTexture(const std::string& name, const std::string& key,
+                                                                int width, int height,
+                                                                const std::function<std::vector<uint8_t>()>& build) {
+    BakedAsset asset = baked ? baked->get(key) : BakedAsset{};
+    if (asset && asset.size == static_cast<size_t>(width) * height * 4) {
+        return createTexture(name, width, height, asset.data);
+    }
+
+    // Not baked (other parameters, or a corrupt blob): generate it here
+    std::vector<uint8_t> rgba = build();
+    return createTexture(name, width, height, rgba.data());
+}
+
+Ogre::TexturePtr ProceduralTextureGenerator::generateNoiseTexture(const std::string& name, int width, int height) {
+    return createBakedTexture(name, textureKey("noise", name, width, height), width, height,
+                              [&] { return buildNoiseTexture(name, width, height); });
 }
 
-float ProceduralTextureGenerator::smoothNoise(int x, int y) {
-    static std::mt19937 rng(12345);
-    static std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+Ogre::TexturePtr ProceduralTextureGenerator::generateGradientTexture(const std::string& name,
+                                                                     const Ogre::ColourValue& color1,
+                                                                     const Ogre::ColourValue& color2) {
+    const int size = GRADIENT_TEXTURE_SIZE;
+    return createBakedTexture(name, textureKey("gradient", name, size, size, {color1, color2}), size, size,
+                              [&] { return buildGradientTexture(name, color1, color2); });
+}
+
+Ogre::TexturePtr ProceduralTextureGenerator::generatePatternTexture(const std::string& name,
+                                                                    const Ogre::ColourValue& color) {
+    const int size = PATTERN_TEXTURE_SIZE;
+    return createBakedTexture(name, textureKey("pattern", name, size, size, {color}), size, size,
+                              [&] { return buildPatternTexture(name, color); });
+}
+
+std::vector<uint8_t> ProceduralTextureGenerator::buildNoiseTexture(const std::string& name, int width, int height) {
+    NoiseParams params;
+    params.seed = seedFromName(name);
+
+    std::vector<float> noise(static_cast<size_t>(width) * height);
+    NoiseGenerator::fill(noise.data(), width, height, params);
+
+    // fBm bunches up around 0.5; stretch it to use the full range
+    std::vector<uint8_t> rgba(noise.size() * 4);
+    for (size_t i = 0; i < noise.size(); i++) {
+        uint8_t value = toByte((noise[i] - 0.5f) * 2.0f + 0.5f);
+        rgba[i * 4 + 0] = value;
+        rgba[i * 4 + 1] = value;
+        rgba[i * 4 + 2] = value;
+        rgba[i * 4 + 3] = 255;
+    }
+
+    return rgba;
+}
+
+std::vector<uint8_t> ProceduralTextureGenerator::buildGradientTexture(const std::string& name,
+                                                                      const Ogre::ColourValue& color1,
+                                                                      const Ogre::ColourValue& color2) {
+    const int size = GRADIENT_TEXTURE_SIZE;
+
+    // Low-frequency noise breaks up banding in the vertical gradient
+    NoiseParams params;
+    params.frequency = 2.0f;
+    params.octaves = 3;
+    params.seed = seedFromName(name);
+
+    std::vector<float> noise(size * size);
+    NoiseGenerator::fill(noise.data(), size, size, params);
+
+    std::vector<uint8_t> rgba(noise.size() * 4);
+    for (int y = 0; y < size; y++) {
+        float t = (y + 0.5f) / size;
+        Ogre::ColourValue row = color1 * (1.0f - t) + color2 * t;
+
+        for (int x = 0; x < size; x++) {
+            size_t i = static_cast<size_t>(y) * size + x;
+            float shade = 1.0f + (noise[i] - 0.5f) * 0.08f;
+            rgba[i * 4 + 0] = toByte(row.r * shade);
+            rgba[i * 4 + 1] = toByte(row.g * shade);
+            rgba[i * 4 + 2] = toByte(row.b * shade);
+            rgba[i * 4 + 3] = toByte(row.a);
+        }
+    }
+
+    return rgba;
+}
+
+std::vector<uint8_t> ProceduralTextureGenerator::buildPatternTexture(const std::string& name,
+                                                                     const Ogre::ColourValue& color) {
+    const int size = PATTERN_TEXTURE_SIZE;
+    const int panel = 64;  // Panel size in pixels (the texture holds 8x8)
+
+    // Weathered panels: fBm grime, darker seams and a lit bevel on each edge
+    NoiseParams params;
+    params.frequency = 8.0f;
+    params.octaves = 6;
+    params.seed = seedFromName(name);
+
+    std::vector<float> noise(size * size);
+    NoiseGenerator::fill(noise.data(), size, size, params);
+
+    std::vector<uint8_t> rgba(noise.size() * 4);
+    for (int y = 0; y < size; y++) {
+        int py = y % panel;
+        for (int x = 0; x < size; x++) {
+            int px = x % panel;
+            size_t i = static_cast<size_t>(y) * size + x;
+
+            float shade = 0.75f + (noise[i] - 0.5f) * 0.6f;
+            int edge = std::min(std::min(px, panel - 1 - px), std::min(py, panel - 1 - py));
+            if (edge == 0) {
+                shade *= 0.45f;  // Seam
+            } else if (edge < 3 && (px < 3 || py < 3)) {
+                shade *= 1.25f;  // Bevel catching the light
+            }
+
+            rgba[i * 4 + 0] = toByte(color.r * shade);
+            rgba[i * 4 + 1] = toByte(color.g * shade);
+            rgba[i * 4 + 2] = toByte(color.b * shade);
+            rgba[i * 4 + 3] = toByte(color.a);
+        }
+    }
 
-    int n = x + y * 57;
-    n = (n << 13) ^ n;
-    return 1.0f - ((n * (n * n * 15731 + 789221) + 1376312589) & 0x7fffffff) / 1073741824.0f;
+    return rgba;
 }
 
 Ogre::MaterialPtr ProceduralTextureGenerator::createCharacterMaterial(const std::string& name,
@@ -389,32 +865,148 @@ Ogre::MaterialPtr ProceduralTextureGenerator::createGlowingMaterial(const std::s
     return mat;
 }
 
-Ogre::MaterialPtr ProceduralTextureGenerator::createMetallicMaterial(const std::string& name,
-                                                                      const Ogre::ColourValue& color) {
+Ogre::MaterialPtr ProceduralTextureGenerator::createEnergyMaterial(const std::string& name,
+                                                                    const Ogre::ColourValue& color) {
     Ogre::MaterialPtr mat = Ogre::MaterialManager::getSingleton().create(name,
         Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
 
     Ogre::Pass* pass = mat->getTechnique(0)->getPass(0);
-    pass->setDiffuse(color * 0.7f);
-    pass->setAmbient(color * 0.3f);
-    pass->setSpecular(Ogre::ColourValue::White);
-    pass->setShininess(128.0f);
-    pass->setLightingEnabled(true);
+    pass->setDiffuse(color);
+    pass->setEmissive(color * 3.0f);
+    pass->setSceneBlending(Ogre::SBT_ADD);
+    pass->setDepthWriteEnabled(false);
+    pass->setLightingEnabled(false);
 
     return mat;
 }
 
-Ogre::MaterialPtr ProceduralTextureGenerator::createEnergyMaterial(const std::string& name,
-                                                                    const Ogre::ColourValue& color) {
-    Ogre::MaterialPtr mat = Ogre::MaterialManager::getSingleton().create(name,
-        Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+Ogre::MaterialPtr ProceduralTextureGenerator::createInstancedMaterial(const std::string& name,
+                                                                       bool glowing, bool skinned) {
+    auto& programManager = Ogre::HighLevelGpuProgramManager::getSingleton();
+    const std::string& group = Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+
+    // Shader programs are shared by every instanced material
+    if (!programManager.resourceExists("InstancedVP", group)) {
+        auto vp = programManager.createProgram("InstancedVP", group, "glsl", Ogre::GPT_VERTEX_PROGRAM);
+        vp->setSourceFile("Instanced.vert");
+        auto fp = programManager.createProgram("InstancedFP", group, "glsl", Ogre::GPT_FRAGMENT_PROGRAM);
+        fp->setSourceFile("Instanced.frag");
+    }
+    if (skinned && !programManager.resourceExists("SkinnedInstancedVP", group)) {
+        auto vp = programManager.createProgram("SkinnedInstancedVP", group, "glsl", Ogre::GPT_VERTEX_PROGRAM);
+        vp->setSourceFile("Instanced.vert");
+        vp->setParameter("preprocessor_defines", "SKINNED=1");
+    }
+
+    Ogre::MaterialPtr mat = Ogre::MaterialManager::getSingleton().create(name, group);
 
     Ogre::Pass* pass = mat->getTechnique(0)->getPass(0);
-    pass->setDiffuse(color);
-    pass->setEmissive(color * 3.0f);
-    pass->setSceneBlending(Ogre::SBT_ADD);
+    pass->setVertexProgram(skinned ? "SkinnedInstancedVP" : "InstancedVP");
+    pass->setFragmentProgram("InstancedFP");
+
+    auto vpParams = pass->getVertexProgramParameters();
+    vpParams->setNamedAutoConstant("viewProj", Ogre::GpuProgramParameters::ACT_VIEWPROJ_MATRIX);
+    vpParams->setNamedAutoConstant("view", Ogre::GpuProgramParameters::ACT_VIEW_MATRIX);
+    vpParams->setNamedAutoConstant("cameraPos", Ogre::GpuProgramParameters::ACT_CAMERA_POSITION);
+    if (skinned) {
+        AnimationSystem::bindPalette(pass);
+    }
+
+    // The clustered lights are bound by GraphicsEngine once LightingManager
+    // exists
+    auto fpParams = pass->getFragmentProgramParameters();
+    fpParams->setNamedAutoConstant("lightDir", Ogre::GpuProgramParameters::ACT_LIGHT_DIRECTION, 0);
+    fpParams->setNamedAutoConstant("lightColor", Ogre::GpuProgramParameters::ACT_LIGHT_DIFFUSE_COLOUR, 0);
+    fpParams->setNamedAutoConstant("ambientColor", Ogre::GpuProgramParameters::ACT_AMBIENT_LIGHT_COLOUR);
+    fpParams->setNamedConstant("emissive", glowing ? 1.0f : 0.0f);
+
+    // The instance stream (and bone palette) has to be applied in the shadow
+    // pass too
+    const char* shadowCaster = skinned ? "SkinnedShadowCasterMaterial" : "InstancedShadowCasterMaterial";
+    if (glowing) {
+        pass->setSceneBlending(Ogre::SBT_ADD);
+        pass->setDepthWriteEnabled(false);
+    } else if (Ogre::MaterialManager::getSingleton().resourceExists(shadowCaster, group)) {
+        mat->getTechnique(0)->setShadowCasterMaterial(shadowCaster);
+    }
+
+    return mat;
+}
+
+Ogre::MaterialPtr ProceduralTextureGenerator::createShadowCasterMaterial(const std::string& name,
+                                                                          bool instanced, bool skinned) {
+    auto& programManager = Ogre::HighLevelGpuProgramManager::getSingleton();
+    const std::string& group = Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+
+    // Skinning only exists for the instanced path
+    skinned = skinned && instanced;
+    const char* vertexProgram = skinned ? "SkinnedInstancedShadowCasterVP"
+                                : instanced ? "InstancedShadowCasterVP" : "ShadowCasterVP";
+    if (!programManager.resourceExists(vertexProgram, group)) {
+        auto vp = programManager.createProgram(vertexProgram, group, "glsl", Ogre::GPT_VERTEX_PROGRAM);
+        vp->setSourceFile(instanced ? "InstancedShadowCaster.vert" : "ShadowCaster.vert");
+        if (skinned) {
+            vp->setParameter("preprocessor_defines", "SKINNED=1");
+        }
+    }
+    if (!programManager.resourceExists("ShadowCasterFP", group)) {
+        auto fp = programManager.createProgram("ShadowCasterFP", group, "glsl", Ogre::GPT_FRAGMENT_PROGRAM);
+        fp->setSourceFile("ShadowCaster.frag");
+    }
+
+    Ogre::MaterialPtr mat = Ogre::MaterialManager::getSingleton().create(name, group);
+
+    Ogre::Pass* pass = mat->getTechnique(0)->getPass(0);
+    pass->setVertexProgram(vertexProgram);
+    pass->setFragmentProgram("ShadowCasterFP");
+    pass->setLightingEnabled(false);
+
+    auto vpParams = pass->getVertexProgramParameters();
+    if (instanced) {
+        vpParams->setNamedAutoConstant("viewProj", Ogre::GpuProgramParameters::ACT_VIEWPROJ_MATRIX);
+    } else {
+        vpParams->setNamedAutoConstant("worldViewProj", Ogre::GpuProgramParameters::ACT_WORLDVIEWPROJ_MATRIX);
+    }
+    if (skinned) {
+        AnimationSystem::bindPalette(pass);
+    }
+
+    return mat;
+}
+
+Ogre::MaterialPtr ProceduralTextureGenerator::createParticleMaterial(const std::string& name) {
+    auto& programManager = Ogre::HighLevelGpuProgramManager::getSingleton();
+    const std::string& group = Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+
+    if (!programManager.resourceExists("ParticleVP", group)) {
+        auto vp = programManager.createProgram("ParticleVP", group, "glsl", Ogre::GPT_VERTEX_PROGRAM);
+        vp->setSourceFile("Particle.vert");
+        auto fp = programManager.createProgram("ParticleFP", group, "glsl", Ogre::GPT_FRAGMENT_PROGRAM);
+        fp->setSourceFile("Particle.frag");
+    }
+
+    Ogre::MaterialPtr mat = Ogre::MaterialManager::getSingleton().create(name, group);
+
+    Ogre::Pass* pass = mat->getTechnique(0)->getPass(0);
+    pass->setVertexProgram("ParticleVP");
+    pass->setFragmentProgram("ParticleFP");
+
+    // cameraRight/cameraUp are set per frame by ParticleSimulator; the
+    // clustered lights are bound by GraphicsEngine
+    auto vpParams = pass->getVertexProgramParameters();
+    vpParams->setNamedAutoConstant("worldViewProj", Ogre::GpuProgramParameters::ACT_WORLDVIEWPROJ_MATRIX);
+    vpParams->setNamedAutoConstant("world", Ogre::GpuProgramParameters::ACT_WORLD_MATRIX);
+    vpParams->setNamedAutoConstant("worldView", Ogre::GpuProgramParameters::ACT_WORLDVIEW_MATRIX);
+    vpParams->setNamedAutoConstant("cameraPos", Ogre::GpuProgramParameters::ACT_CAMERA_POSITION);
+
+    auto fpParams = pass->getFragmentProgramParameters();
+    fpParams->setNamedAutoConstant("time", Ogre::GpuProgramParameters::ACT_TIME);
+
+    // Additive, but weighted by alpha so the soft edge and fade-out show
+    pass->setSceneBlending(Ogre::SBF_SOURCE_ALPHA, Ogre::SBF_ONE);
     pass->setDepthWriteEnabled(false);
     pass->setLightingEnabled(false);
+    pass->setCullingMode(Ogre::CULL_NONE);
 
     return mat;
 }
@@ -434,13 +1026,69 @@ void ProceduralAudioGenerator::shutdown() {
     audioBuffers.clear();
 }
 
+namespace {
+
+// Bump when any sound generator changes, so cached samples are rebuilt
+constexpr uint32_t AUDIO_GENERATOR_VERSION = 1;
+
+struct BakedSound {
+    const char* name;
+    const char* params;
+    std::vector<short> (*generate)();
+};
+
+const BakedSound BAKED_SOUNDS[] = {
+    {"proc/hit", "pitch=1", [] { return ProceduralAudioGenerator::generateHitSound(); }},
+    {"proc/explosion", "", [] { return ProceduralAudioGenerator::generateExplosionSound(); }},
+    {"proc/laser", "", [] { return ProceduralAudioGenerator::generateLaserSound(); }},
+    {"proc/powerup", "", [] { return ProceduralAudioGenerator::generatePowerUpSound(); }},
+    {"proc/footstep", "", [] { return ProceduralAudioGenerator::generateFootstepSound(); }},
+    {"proc/battle", "beats=64", [] { return ProceduralAudioGenerator::generateBattleMusic(); }},
+    {"proc/victory", "", [] { return ProceduralAudioGenerator::generateVictoryMusic(); }},
+    {"proc/menu", "", [] { return ProceduralAudioGenerator::generateMenuMusic(); }},
+};
+
+} // namespace
+
+void ProceduralAudioGenerator::registerBakeJobs(AssetBaker& assets) {
+    for (const BakedSound& sound : BAKED_SOUNDS) {
+        auto generate = sound.generate;
+        assets.addJob(sound.name, sound.params, AUDIO_GENERATOR_VERSION,
+                      [generate]() { return AssetBaker::toBytes(generate()); });
+    }
+}
+
+void ProceduralAudioGenerator::loadBakedSounds(const AssetBaker& assets, AudioEngine& audio) {
+    for (const BakedSound& sound : BAKED_SOUNDS) {
+        loadBakedSound(assets, audio, sound.name);
+    }
+}
+
+std::vector<std::string> ProceduralAudioGenerator::getBakedSoundNames() {
+    std::vector<std::string> names;
+    for (const BakedSound& sound : BAKED_SOUNDS) {
+        names.push_back(sound.name);
+    }
+    return names;
+}
+
+bool ProceduralAudioGenerator::loadBakedSound(const AssetBaker& assets, AudioEngine& audio,
+                                              const std::string& name) {
+    BakedAsset asset = assets.get(name);
+    if (!asset) return false;
+
+    return audio.loadSamples(name, reinterpret_cast<const short*>(asset.data), asset.size / sizeof(short),
+                             SAMPLE_RATE) != nullptr;
+}
+
 float ProceduralAudioGenerator::generateWave(float frequency, float time, float phase) {
     return sin(2.0f * M_PI * frequency * time + phase);
 }
 
 float ProceduralAudioGenerator::generateNoise() {
-    static std::mt19937 rng(std::random_device{}());
-    static std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    // Per thread, sounds are generated on the asset baker's workers
+    thread_local std::mt19937 rng(std::random_device{}());
+    thread_local std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
     return dist(rng);
 }
 
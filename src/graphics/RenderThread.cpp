@@ -0,0 +1,143 @@
+#include "graphics/RenderThread.hpp"
+#include "graphics/InstanceBatch.hpp"
+#include <chrono>
+#include <iostream>
+
+namespace BVA {
+
+std::vector<float>& FramePacket::uploadInstances(InstanceBatch* batch, size_t count) {
+    // Reuse a slot (and its buffer) left over from an earlier frame
+    for (InstanceUpload& upload : uploads) {
+        if (upload.batch == batch || upload.batch == nullptr) {
+            upload.batch = batch;
+            upload.count = count;
+            upload.data.resize(count * InstanceBatch::FLOATS_PER_INSTANCE);
+            return upload.data;
+        }
+    }
+
+    uploads.push_back({batch, count, std::vector<float>(count * InstanceBatch::FLOATS_PER_INSTANCE)});
+    return uploads.back().data;
+}
+
+void FramePacket::clear() {
+    dt = 0.0f;
+    render = false;
+    positions.clear();
+    commands.clear();
+    cameraTargets.clear();
+    cameraTargetsSet = false;
+    cameraShakes.clear();
+    // Upload buffers stay allocated; a null batch marks the slot free
+    for (InstanceUpload& upload : uploads) {
+        upload.batch = nullptr;
+        upload.count = 0;
+    }
+}
+
+RenderThread::RenderThread() {}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start(FrameFunction apply) {
+    if (isRunning()) return;
+
+    applyFrame = std::move(apply);
+    stopping = false;
+    pending = false;
+    thread = std::thread(&RenderThread::threadMain, this);
+
+    // Later isRenderThread() checks from the simulation must see the id
+    std::unique_lock<std::mutex> lock(mutex);
+    packetDone.wait(lock, [this] { return renderThreadId != std::thread::id(); });
+}
+
+void RenderThread::stop() {
+    if (!isRunning()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    packetReady.notify_one();
+    thread.join();
+
+    renderThreadId = std::thread::id();
+    packets[0].clear();
+    packets[1].clear();
+}
+
+void RenderThread::submit(float dt) {
+    if (!isRunning()) {
+        getPacket().clear();
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    handOver(dt, true);
+    std::chrono::duration<float, std::milli> waited = std::chrono::steady_clock::now() - start;
+    lastWaitMs = waited.count();
+}
+
+void RenderThread::runAndWait(std::function<void()> task) {
+    if (!isRunning() || isRenderThread()) {
+        task();
+        return;
+    }
+
+    getPacket().enqueue(std::move(task));
+    handOver(0.0f, false);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    packetDone.wait(lock, [this] { return !pending; });
+}
+
+void RenderThread::handOver(float dt, bool render) {
+    std::unique_lock<std::mutex> lock(mutex);
+    // The other packet is free once the previous frame has been drawn
+    packetDone.wait(lock, [this] { return !pending; });
+
+    FramePacket& packet = packets[writeIndex];
+    packet.dt = dt;
+    packet.render = render;
+
+    writeIndex ^= 1;
+    pending = true;
+    lock.unlock();
+    packetReady.notify_one();
+}
+
+void RenderThread::threadMain() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        renderThreadId = std::this_thread::get_id();
+    }
+    packetDone.notify_all();
+
+    while (true) {
+        FramePacket* packet;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            packetReady.wait(lock, [this] { return pending || stopping; });
+            if (!pending) break;
+            packet = &packets[writeIndex ^ 1];
+        }
+
+        try {
+            applyFrame(*packet);
+        } catch (const std::exception& e) {
+            std::cerr << "Render thread: " << e.what() << std::endl;
+        }
+        packet->clear();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = false;
+        }
+        packetDone.notify_all();
+    }
+}
+
+} // namespace BVA
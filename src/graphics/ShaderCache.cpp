@@ -0,0 +1,242 @@
+#include "graphics/ShaderCache.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace BVA {
+
+namespace {
+
+const char* WARMUP_TARGET = "ShaderWarmupTarget";
+
+// Program binaries are only valid for the driver that produced them; Ogre
+// rejects stale ones by source hash and falls back to compiling
+std::string microcodeFileName() {
+    std::string name = Ogre::Root::getSingleton().getRenderSystem()->getName();
+    for (char& c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c))) c = '_';
+    }
+    return "microcode_" + name + ".bin";
+}
+
+} // namespace
+
+ShaderCache::ShaderCache(Ogre::RTShader::ShaderGenerator* generator) : shaderGenerator(generator) {}
+
+ShaderCache::~ShaderCache() {
+    shutdown();
+}
+
+bool ShaderCache::initialize(const std::string& cacheDirectory) {
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory + "/rtss", ec);
+    if (ec) {
+        std::cerr << "Shader cache directory unavailable: " << cacheDirectory << std::endl;
+    }
+
+    // Generated RTSS sources are reused instead of regenerated
+    if (shaderGenerator && !ec) {
+        shaderGenerator->setShaderCachePath(cacheDirectory + "/rtss/");
+    }
+
+    auto& programs = Ogre::GpuProgramManager::getSingleton();
+    if (programs.canGetCompiledShaderBuffer()) {
+        programs.setSaveMicrocodesToCache(true);
+        microcodePath = cacheDirectory + "/" + microcodeFileName();
+
+        if (std::filesystem::exists(microcodePath, ec)) {
+            std::ifstream* file = OGRE_NEW_T(std::ifstream, Ogre::MEMCATEGORY_GENERAL)(
+                microcodePath, std::ios::binary);
+            Ogre::DataStreamPtr stream(OGRE_NEW Ogre::FileStreamDataSource(microcodePath, file, true));
+            programs.loadMicrocodeCache(stream);
+        }
+    }
+
+    if (!createTarget()) {
+        std::cerr << "Shader warmup target unavailable; shaders compile on first use" << std::endl;
+    }
+
+    std::cout << "Shader cache initialized"
+              << (microcodePath.empty() ? " (no program binaries on this driver)" : "") << std::endl;
+    return true;
+}
+
+void ShaderCache::shutdown() {
+    destroyTarget();
+
+    auto* programs = Ogre::GpuProgramManager::getSingletonPtr();
+    if (programs && !microcodePath.empty() && programs->isCacheDirty()) {
+        std::fstream* file = OGRE_NEW_T(std::fstream, Ogre::MEMCATEGORY_GENERAL)(
+            microcodePath, std::ios::binary | std::ios::out | std::ios::trunc);
+        bool opened = file->is_open();
+        Ogre::DataStreamPtr stream(OGRE_NEW Ogre::FileStreamDataSource(microcodePath, file, true));
+        if (opened) {
+            programs->saveMicrocodeCache(stream);
+        }
+    }
+    microcodePath.clear();
+    warmed.clear();
+}
+
+bool ShaderCache::createTarget() {
+    auto& root = Ogre::Root::getSingleton();
+    warmupScene = root.createSceneManager(Ogre::ST_GENERIC, "ShaderWarmupScene");
+    warmupCamera = warmupScene->createCamera("ShaderWarmupCamera");
+
+    // Lit passes (per-light iteration) are skipped without a light
+    warmupScene->getRootSceneNode()->attachObject(warmupScene->createLight("ShaderWarmupLight"));
+
+    quad = OGRE_NEW Ogre::Rectangle2D(true);
+    quad->setCorners(-1.0f, 1.0f, 1.0f, -1.0f);
+    quad->setBoundingBox(Ogre::AxisAlignedBox::BOX_INFINITE);
+    warmupScene->getRootSceneNode()->attachObject(quad);
+
+    target = Ogre::TextureManager::getSingleton().createManual(
+        WARMUP_TARGET, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D,
+        TARGET_SIZE, TARGET_SIZE, 0, Ogre::PF_BYTE_RGBA, Ogre::TU_RENDERTARGET);
+    if (!target) return false;
+
+    Ogre::RenderTexture* renderTarget = target->getBuffer()->getRenderTarget();
+    renderTarget->setAutoUpdated(false);
+    viewport = renderTarget->addViewport(warmupCamera);
+    viewport->setOverlaysEnabled(false);
+    viewport->setShadowsEnabled(false);
+    viewport->setSkiesEnabled(false);
+    return true;
+}
+
+void ShaderCache::destroyTarget() {
+    if (target) {
+        target->getBuffer()->getRenderTarget()->removeAllViewports();
+        Ogre::TextureManager::getSingleton().remove(target);
+        target.reset();
+        viewport = nullptr;
+    }
+    if (quad) {
+        quad->detachFromParent();
+        OGRE_DELETE quad;
+        quad = nullptr;
+    }
+    if (warmupScene) {
+        Ogre::Root::getSingleton().destroySceneManager(warmupScene);
+        warmupScene = nullptr;
+        warmupCamera = nullptr;
+    }
+}
+
+std::string ShaderCache::permutationKey(const Ogre::Technique* technique, const Ogre::Pass* pass) {
+    return technique->getSchemeName() + "|" +
+           (pass->hasVertexProgram() ? pass->getVertexProgramName() : "") + "|" +
+           (pass->hasFragmentProgram() ? pass->getFragmentProgramName() : "");
+}
+
+void ShaderCache::generateShaders(Ogre::Material* material) {
+    if (!shaderGenerator) return;
+
+    const std::string& rtssScheme = Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME;
+    for (const Ogre::Technique* technique : material->getTechniques()) {
+        if (technique->getSchemeName() == rtssScheme) return;  // Already generated
+    }
+
+    bool needsShaders = false;
+    for (const Ogre::Technique* technique : material->getTechniques()) {
+        for (const Ogre::Pass* pass : technique->getPasses()) {
+            needsShaders = needsShaders || !pass->hasVertexProgram() || !pass->hasFragmentProgram();
+        }
+    }
+    if (!needsShaders) return;
+
+    if (shaderGenerator->createShaderBasedTechnique(*material, Ogre::MaterialManager::DEFAULT_SCHEME_NAME,
+                                                    rtssScheme)) {
+        shaderGenerator->validateMaterial(rtssScheme, material->getName(), material->getGroup());
+    }
+}
+
+bool ShaderCache::warmMaterial(const Ogre::MaterialPtr& material) {
+    generateShaders(material.get());
+    material->load();  // Compiles every program the material references
+
+    bool drew = false;
+    for (const Ogre::Technique* technique : material->getSupportedTechniques()) {
+        bool fresh = false;
+        for (const Ogre::Pass* pass : technique->getPasses()) {
+            if (!pass->hasVertexProgram() || !pass->hasFragmentProgram()) continue;
+            fresh = warmed.insert(permutationKey(technique, pass)).second || fresh;
+        }
+        if (!fresh || !viewport) continue;
+
+        // Drawing the technique links its program pairs
+        viewport->setMaterialScheme(technique->getSchemeName());
+        quad->setMaterial(material);
+        target->getBuffer()->getRenderTarget()->update(false);
+        drew = true;
+    }
+    return drew;
+}
+
+std::vector<std::string> ShaderCache::allMaterialNames() {
+    std::vector<std::string> names;
+    auto it = Ogre::MaterialManager::getSingleton().getResourceIterator();
+    while (it.hasMoreElements()) {
+        names.push_back(it.getNext()->getName());
+    }
+    return names;
+}
+
+size_t ShaderCache::warmup() {
+    return warmup(allMaterialNames());
+}
+
+size_t ShaderCache::warmup(const std::vector<std::string>& materialNames) {
+    beginWarmup(materialNames);
+    continueWarmup(SIZE_MAX);
+    return warmed.size() - warmedBefore;
+}
+
+void ShaderCache::beginWarmup() {
+    beginWarmup(allMaterialNames());
+}
+
+void ShaderCache::beginWarmup(const std::vector<std::string>& materialNames) {
+    queued = materialNames;
+    nextQueued = 0;
+    warmedBefore = warmed.size();
+    queuedMs = 0.0f;
+    warming = true;
+}
+
+bool ShaderCache::continueWarmup(size_t maxMaterials) {
+    if (!warming) return true;
+
+    auto start = std::chrono::steady_clock::now();
+
+    size_t count = std::min(maxMaterials, queued.size() - nextQueued);
+    for (size_t i = 0; i < count; i++, nextQueued++) {
+        Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(queued[nextQueued]);
+        if (material) {
+            warmMaterial(material);
+        }
+    }
+
+    // Only the time spent warming counts, not the frames in between
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    queuedMs += elapsed.count();
+    if (nextQueued < queued.size()) return false;
+
+    lastWarmupMs = queuedMs;
+    queued.clear();
+    nextQueued = 0;
+    warming = false;
+
+    size_t compiled = warmed.size() - warmedBefore;
+    if (compiled > 0) {
+        std::cout << "Shader warmup: " << compiled << " permutations in " << lastWarmupMs << " ms ("
+                  << warmed.size() << " total)" << std::endl;
+    }
+    return true;
+}
+
+} // namespace BVA
@@ -0,0 +1,402 @@
+#include "graphics/ShadowCascades.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace BVA {
+
+namespace {
+
+const char* SHARED_PARAMS_NAME = "ShadowCascades";
+
+// Without bounds, how far behind a cascade (towards the light) casters are
+// still picked up
+constexpr float UNBOUNDED_CASTER_REACH = 50.0f;
+
+// Cascade radii are rounded up to this step so the shadow camera size stays
+// constant while the view rotates
+constexpr float RADIUS_STEP = 1.0f / 16.0f;
+
+} // namespace
+
+// ==================== CameraSetup ====================
+
+void ShadowCascades::CameraSetup::getShadowCamera(const Ogre::SceneManager*, const Ogre::Camera*,
+                                                  const Ogre::Viewport*, const Ogre::Light* light,
+                                                  Ogre::Camera* texCam, size_t iteration) const {
+    owner.setupShadowCamera(light, texCam, iteration);
+}
+
+// ==================== ShadowCascades ====================
+
+ShadowCascades::ShadowCascades(Ogre::SceneManager* sm, Ogre::Camera* cam)
+    : sceneManager(sm), camera(cam), lightRotation(Ogre::Matrix3::IDENTITY) {}
+
+ShadowCascades::~ShadowCascades() {
+    shutdown();
+}
+
+bool ShadowCascades::initialize(int count, int size) {
+    cascadeCount = std::min(std::max(count, 1), MAX_CASCADES);
+    textureSize = size;
+
+    // Depth-only float maps rendered with the caster materials; every shadow
+    // texture belongs to the sun, point and spot lights are clustered instead
+    sceneManager->setShadowTextureSettings(textureSize, cascadeCount, Ogre::PF_FLOAT32_R);
+    sceneManager->setShadowTextureCountPerLightType(Ogre::Light::LT_DIRECTIONAL, cascadeCount);
+    sceneManager->setShadowTextureCountPerLightType(Ogre::Light::LT_POINT, 0);
+    sceneManager->setShadowTextureCountPerLightType(Ogre::Light::LT_SPOTLIGHT, 0);
+    sceneManager->setShadowTextureSelfShadow(true);
+    sceneManager->setShadowCasterRenderBackFaces(false);
+
+    Ogre::MaterialPtr casterMaterial = Ogre::MaterialManager::getSingleton().getByName("ShadowCasterMaterial");
+    if (casterMaterial) {
+        sceneManager->setShadowTextureCasterMaterial(casterMaterial);
+    }
+
+    // Called again when the shadow quality changes; casters stay registered
+    if (!cameraSetup) {
+        cameraSetup = Ogre::ShadowCameraSetupPtr(new CameraSetup(*this));
+        sceneManager->setShadowCameraSetup(cameraSetup);
+        sceneManager->addListener(this);
+    }
+
+    auto& programManager = Ogre::GpuProgramManager::getSingleton();
+    auto sharedParams = programManager.getSharedParameters(SHARED_PARAMS_NAME);
+    if (!sharedParams) {
+        sharedParams = programManager.createSharedParameters(SHARED_PARAMS_NAME);
+        sharedParams->addConstantDefinition("cascadeSplits", Ogre::GCT_FLOAT4);
+        sharedParams->addConstantDefinition("shadowParams", Ogre::GCT_FLOAT4);
+    }
+
+    for (Cascade& cascade : cascades) {
+        cascade = Cascade();
+    }
+
+    std::cout << "Shadow cascades: " << cascadeCount << " x " << textureSize << "x" << textureSize << std::endl;
+    return true;
+}
+
+void ShadowCascades::shutdown() {
+    if (!cameraSetup) return;
+
+    // Hand the owners their settings back
+    for (Caster& caster : casters) {
+        caster.object->setCastShadows(caster.castShadows);
+    }
+    casters.clear();
+    movedBounds.clear();
+
+    sceneManager->removeListener(this);
+    sceneManager->setShadowCameraSetup(Ogre::ShadowCameraSetupPtr(new Ogre::DefaultShadowCameraSetup()));
+    cameraSetup.reset();
+}
+
+void ShadowCascades::setBounds(const Ogre::AxisAlignedBox& newBounds) {
+    bounds = newBounds;
+    for (Cascade& cascade : cascades) {
+        cascade.valid = false;
+    }
+}
+
+void ShadowCascades::addCaster(Ogre::MovableObject* object, bool dynamic) {
+    if (!object) return;
+
+    Caster caster;
+    caster.object = object;
+    caster.bounds = object->getWorldBoundingBox(true);
+    caster.dynamic = dynamic;
+    caster.castShadows = object->getCastShadows();
+    casters.push_back(caster);
+
+    // New shadows appear in whatever cascades the caster touches
+    movedBounds.push_back(caster.bounds);
+}
+
+void ShadowCascades::removeCaster(Ogre::MovableObject* object) {
+    auto it = std::find_if(casters.begin(), casters.end(),
+                           [object](const Caster& caster) { return caster.object == object; });
+    if (it == casters.end()) return;
+
+    it->object->setCastShadows(it->castShadows);
+    movedBounds.push_back(it->bounds);
+    casters.erase(it);
+}
+
+void ShadowCascades::update() {
+    if (!cameraSetup || !camera) return;
+
+    // Only the part of the view range that can see the bounds needs shadows
+    float nearDistance = camera->getNearClipDistance();
+    float farDistance = sceneManager->getShadowFarDistance();
+    if (bounds.isFinite()) {
+        Ogre::Vector3 eye = camera->getDerivedPosition();
+        float reach = 0.0f;
+        for (int i = 0; i < 8; i++) {
+            reach = std::max(reach, eye.distance(bounds.getCorner(static_cast<Ogre::AxisAlignedBox::CornerEnum>(i))));
+        }
+        farDistance = std::min(farDistance, reach);
+    }
+    farDistance = std::max(farDistance, nearDistance * 2.0f);
+
+    // Practical split scheme: blend of logarithmic and uniform splits
+    float previous = nearDistance;
+    for (int i = 0; i < cascadeCount; i++) {
+        float t = float(i + 1) / cascadeCount;
+        float logSplit = nearDistance * std::pow(farDistance / nearDistance, t);
+        float uniformSplit = nearDistance + (farDistance - nearDistance) * t;
+
+        cascades[i].nearSplit = previous;
+        cascades[i].farSplit = splitLambda * logSplit + (1.0f - splitLambda) * uniformSplit;
+        previous = cascades[i].farSplit;
+    }
+
+    // Static casters count as moved when their bounds change; dynamic ones
+    // whenever they are shown
+    for (Caster& caster : casters) {
+        caster.castShadows = caster.object->getCastShadows();
+
+        Ogre::AxisAlignedBox current = caster.object->getWorldBoundingBox(true);
+        if (caster.dynamic) {
+            if (caster.object->isVisible() && caster.castShadows) {
+                movedBounds.push_back(current);
+            }
+        } else if (current != caster.bounds) {
+            movedBounds.push_back(caster.bounds);
+            movedBounds.push_back(current);
+        }
+        caster.bounds = current;
+    }
+
+    float splits[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < cascadeCount; i++) {
+        splits[i] = cascades[i].farSplit;
+    }
+
+    auto sharedParams = Ogre::GpuProgramManager::getSingleton().getSharedParameters(SHARED_PARAMS_NAME);
+    sharedParams->setNamedConstant("cascadeSplits", Ogre::Vector4(splits[0], splits[1], splits[2], splits[3]));
+    sharedParams->setNamedConstant("shadowParams",
+                                   Ogre::Vector4(float(cascadeCount), 0.0015f, 1.0f / textureSize, 0.0f));
+}
+
+Ogre::AxisAlignedBox ShadowCascades::toLightSpace(const Ogre::AxisAlignedBox& worldBounds) const {
+    // Centre and half extents through the rotation and its absolute value
+    Ogre::Vector3 centre = lightRotation * worldBounds.getCenter();
+    Ogre::Vector3 half = worldBounds.getHalfSize();
+
+    Ogre::Vector3 extent;
+    for (int row = 0; row < 3; row++) {
+        extent[row] = std::abs(lightRotation[row][0]) * half.x +
+                      std::abs(lightRotation[row][1]) * half.y +
+                      std::abs(lightRotation[row][2]) * half.z;
+    }
+    return Ogre::AxisAlignedBox(centre - extent, centre + extent);
+}
+
+void ShadowCascades::fitCascade(Cascade& cascade, const Ogre::Vector3* corners) const {
+    // Bounding sphere of the frustum slice: its size does not depend on the
+    // view direction, so the window only ever translates
+    Ogre::Vector3 centre = Ogre::Vector3::ZERO;
+    for (int i = 0; i < 8; i++) {
+        centre += corners[i];
+    }
+    centre /= 8.0f;
+
+    float radius = 0.0f;
+    for (int i = 0; i < 8; i++) {
+        radius = std::max(radius, centre.distance(corners[i]));
+    }
+    radius = std::ceil(radius / RADIUS_STEP) * RADIUS_STEP;
+
+    Ogre::Vector3 lightCentre = lightRotation * centre;
+    float texel = 2.0f * radius / textureSize;
+
+    Ogre::AxisAlignedBox fitted;
+    bool bounded = bounds.isFinite();
+    if (bounded) {
+        fitted = toLightSpace(bounds);
+    }
+
+    for (int axis = 0; axis < 2; axis++) {
+        // Move in whole texels so rasterization does not swim
+        float snapped = std::floor(lightCentre[axis] / texel) * texel;
+
+        if (bounded && fitted.getMaximum()[axis] - fitted.getMinimum()[axis] <= 2.0f * radius) {
+            // Bounds fit inside the sphere: cover them exactly (never moves)
+            cascade.minimum[axis] = fitted.getMinimum()[axis];
+            cascade.maximum[axis] = fitted.getMaximum()[axis];
+            continue;
+        }
+
+        if (bounded) {
+            // Keep the window inside the bounds; they are static, so the
+            // clamped position is as stable as a snapped one
+            snapped = std::min(std::max(snapped, fitted.getMinimum()[axis] + radius),
+                               fitted.getMaximum()[axis] - radius);
+        }
+        cascade.minimum[axis] = snapped - radius;
+        cascade.maximum[axis] = snapped + radius;
+    }
+
+    // Depth: everything inside the bounds can cast onto the slice
+    if (bounded) {
+        cascade.minimum.z = fitted.getMinimum().z;
+        cascade.maximum.z = fitted.getMaximum().z;
+    } else {
+        cascade.minimum.z = lightCentre.z - radius;
+        cascade.maximum.z = lightCentre.z + radius + UNBOUNDED_CASTER_REACH;
+    }
+
+    cascade.texelSize = std::max(cascade.maximum.x - cascade.minimum.x,
+                                 cascade.maximum.y - cascade.minimum.y) / textureSize;
+}
+
+void ShadowCascades::setupShadowCamera(const Ogre::Light* light, Ogre::Camera* texCam, size_t iteration) {
+    Cascade& cascade = cascades[std::min<size_t>(iteration, cascadeCount - 1)];
+
+    Ogre::Vector3 direction = light->getDerivedDirection().normalisedCopy();
+    if (!direction.positionEquals(lightDirection, 1e-6f)) {
+        lightDirection = direction;
+
+        // Light space looks down -Z along the light
+        Ogre::Vector3 zAxis = -direction;
+        Ogre::Vector3 up = std::abs(zAxis.y) > 0.99f ? Ogre::Vector3::UNIT_Z : Ogre::Vector3::UNIT_Y;
+        Ogre::Vector3 xAxis = up.crossProduct(zAxis).normalisedCopy();
+        Ogre::Vector3 yAxis = zAxis.crossProduct(xAxis);
+        lightRotation = Ogre::Matrix3(xAxis.x, xAxis.y, xAxis.z,
+                                      yAxis.x, yAxis.y, yAxis.z,
+                                      zAxis.x, zAxis.y, zAxis.z);
+
+        for (Cascade& c : cascades) {
+            c.valid = false;
+        }
+    }
+
+    // Slice corners along the rays through the far plane corners
+    const auto& frustum = camera->getWorldSpaceCorners();
+    Ogre::Vector3 eye = camera->getDerivedPosition();
+    float farClip = camera->getFarClipDistance();
+    Ogre::Vector3 corners[8];
+    for (int i = 0; i < 4; i++) {
+        Ogre::Vector3 ray = (frustum[4 + i] - eye) / farClip;
+        corners[i] = eye + ray * cascade.nearSplit;
+        corners[4 + i] = eye + ray * cascade.farSplit;
+    }
+    fitCascade(cascade, corners);
+
+    // Camera sits just above the top of the depth range, looking down it
+    Ogre::Vector3 lightCentre((cascade.minimum.x + cascade.maximum.x) * 0.5f,
+                              (cascade.minimum.y + cascade.maximum.y) * 0.5f,
+                              cascade.maximum.z + 1.0f);
+    Ogre::Matrix3 toWorld = lightRotation.Transpose();
+
+    texCam->setProjectionType(Ogre::PT_ORTHOGRAPHIC);
+    texCam->setOrthoWindow(cascade.maximum.x - cascade.minimum.x, cascade.maximum.y - cascade.minimum.y);
+    texCam->setNearClipDistance(1.0f);
+    texCam->setFarClipDistance(cascade.maximum.z - cascade.minimum.z + 1.0f);
+    texCam->setPosition(toWorld * lightCentre);
+    texCam->setOrientation(Ogre::Quaternion(toWorld));
+}
+
+bool ShadowCascades::overlapsCascade(const Cascade& cascade, const Ogre::AxisAlignedBox& worldBounds) const {
+    if (worldBounds.isNull()) return false;
+    if (worldBounds.isInfinite()) return true;
+
+    Ogre::AxisAlignedBox box = toLightSpace(worldBounds);
+    for (int axis = 0; axis < 3; axis++) {
+        if (box.getMaximum()[axis] < cascade.minimum[axis] || box.getMinimum()[axis] > cascade.maximum[axis]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Ogre::Viewport* ShadowCascades::getShadowViewport(size_t iteration) const {
+    const Ogre::TexturePtr& texture = sceneManager->getShadowTexture(iteration);
+    if (!texture) return nullptr;
+
+    Ogre::RenderTarget* target = texture->getBuffer()->getRenderTarget();
+    return target->getNumViewports() > 0 ? target->getViewport(0) : nullptr;
+}
+
+void ShadowCascades::shadowTextureCasterPreViewProj(Ogre::Light* light, Ogre::Camera* shadowCamera,
+                                                    size_t iteration) {
+    if (light->getType() != Ogre::Light::LT_DIRECTIONAL || iteration >= size_t(cascadeCount)) return;
+
+    Cascade& cascade = cascades[iteration];
+    Ogre::Matrix4 viewProj = shadowCamera->getProjectionMatrix() * shadowCamera->getViewMatrix();
+
+    bool dirty = !cascade.valid || viewProj != cascade.renderedViewProj;
+    for (size_t i = 0; !dirty && i < movedBounds.size(); i++) {
+        dirty = overlapsCascade(cascade, movedBounds[i]);
+    }
+
+    // An unchanged cascade keeps last frame's texture
+    if (Ogre::Viewport* viewport = getShadowViewport(iteration)) {
+        viewport->setAutoUpdated(dirty);
+    }
+    cascade.rendered = dirty;
+    if (!dirty) return;
+
+    cascade.valid = true;
+    cascade.renderedViewProj = viewProj;
+
+    // Drop casters that miss this cascade, and in the coarser cascades the
+    // ones too small to leave a visible shadow
+    float minimumSize = iteration > 0 ? cascade.texelSize * MIN_CASTER_TEXELS : 0.0f;
+    for (Caster& caster : casters) {
+        if (!caster.castShadows) continue;
+
+        bool visible = overlapsCascade(cascade, caster.bounds);
+        if (visible && minimumSize > 0.0f) {
+            Ogre::Vector3 size = toLightSpace(caster.bounds).getSize();
+            visible = std::max(size.x, size.y) >= minimumSize;
+        }
+
+        caster.object->setCastShadows(visible);
+        if (!visible) {
+            castersCulledThisFrame++;
+        }
+    }
+}
+
+void ShadowCascades::shadowTexturesUpdated(size_t) {
+    for (Caster& caster : casters) {
+        caster.object->setCastShadows(caster.castShadows);
+    }
+
+    int rendered = 0;
+    for (int i = 0; i < cascadeCount; i++) {
+        if (cascades[i].rendered) {
+            rendered++;
+        }
+        cascades[i].rendered = false;
+    }
+
+    cascadesRendered = rendered;
+    castersCulled = castersCulledThisFrame;
+    castersCulledThisFrame = 0;
+    movedBounds.clear();
+}
+
+void ShadowCascades::bindToPass(Ogre::Pass* pass) const {
+    if (!cameraSetup) return;
+
+    auto params = pass->getFragmentProgramParameters();
+    for (int i = 0; i < cascadeCount; i++) {
+        // Filled with the i-th shadow texture when the pass is rendered
+        Ogre::TextureUnitState* unit = pass->createTextureUnitState();
+        unit->setContentType(Ogre::TextureUnitState::CONTENT_SHADOW);
+        unit->setTextureAddressingMode(Ogre::TextureUnitState::TAM_BORDER);
+        unit->setTextureBorderColour(Ogre::ColourValue::White);
+        unit->setTextureFiltering(Ogre::TFO_NONE);
+
+        std::string index = std::to_string(i);
+        params->setNamedConstant("shadowMap" + index, static_cast<int>(pass->getTextureUnitStateIndex(unit)));
+        params->setNamedAutoConstant("texViewProj" + index,
+                                     Ogre::GpuProgramParameters::ACT_TEXTURE_VIEWPROJ_MATRIX, i);
+    }
+    params->addSharedParameters(SHARED_PARAMS_NAME);
+}
+
+} // namespace BVA
@@ -0,0 +1,356 @@
+#include "graphics/VisibilityCuller.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace BVA {
+
+namespace {
+
+// Occlusion buffer pixel coordinates of a view-space point
+Ogre::Vector2 toOcclusionPixel(const Ogre::Matrix4& projection, const Ogre::Vector3& viewPoint) {
+    Ogre::Vector4 clip = projection * Ogre::Vector4(viewPoint.x, viewPoint.y, viewPoint.z, 1.0f);
+    float invW = 1.0f / clip.w;
+    return Ogre::Vector2((clip.x * invW * 0.5f + 0.5f) * VisibilityCuller::OCCLUSION_WIDTH,
+                         (0.5f - clip.y * invW * 0.5f) * VisibilityCuller::OCCLUSION_HEIGHT);
+}
+
+} // namespace
+
+VisibilityCuller::VisibilityCuller() {
+    occlusionDepth.resize(OCCLUSION_WIDTH * OCCLUSION_HEIGHT, FLT_MAX);
+}
+
+VisibilityCuller::~VisibilityCuller() {}
+
+int VisibilityCuller::addEntity(Ogre::SceneNode* node, const Ogre::AxisAlignedBox& localBounds) {
+    if (!node || nodeEntities.count(node)) return INVALID_ENTITY;
+
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<int>(entities.size());
+        entities.emplace_back();
+
+        size_t padded = (entities.size() + 7) & ~size_t(7);
+        for (auto* bounds : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+            bounds->resize(padded, 0.0f);
+        }
+        inFrustum.resize(padded, 0);
+    }
+
+    Entity& entity = entities[slot];
+    entity.node = node;
+    entity.position = node->getPosition();
+    if (localBounds.isFinite()) {
+        entity.centre = localBounds.getCenter();
+        entity.halfSize = localBounds.getHalfSize();
+    } else {
+        entity.centre = Ogre::Vector3::ZERO;
+        entity.halfSize = Ogre::Vector3(0.5f, 0.5f, 0.5f);
+    }
+    entity.used = true;
+    entity.visible = true;
+    entity.positionDirty = false;
+
+    nodeEntities[node] = slot;
+    entityCount++;
+    return slot;
+}
+
+void VisibilityCuller::removeEntity(int id) {
+    if (id < 0 || static_cast<size_t>(id) >= entities.size() || !entities[id].used) return;
+
+    // Leave the node where the simulation last put it
+    Entity& entity = entities[id];
+    if (entity.positionDirty) {
+        entity.node->setPosition(entity.position);
+    }
+
+    nodeEntities.erase(entity.node);
+    entity = Entity();
+    freeSlots.push_back(id);
+    entityCount--;
+}
+
+bool VisibilityCuller::moveNode(Ogre::SceneNode* node, const Ogre::Vector3& position) {
+    auto it = nodeEntities.find(node);
+    if (it == nodeEntities.end()) return false;
+
+    Entity& entity = entities[it->second];
+    entity.position = position;
+    if (entity.visible) {
+        node->setPosition(position);
+        entity.positionDirty = false;
+    } else {
+        entity.positionDirty = true;
+    }
+    return true;
+}
+
+bool VisibilityCuller::isVisible(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= entities.size() || !entities[id].used) return true;
+    return entities[id].visible;
+}
+
+void VisibilityCuller::addOccluder(const OccluderQuad& quad) {
+    occluders.push_back(quad);
+}
+
+void VisibilityCuller::cull(const Ogre::Camera* camera) {
+    visibleCount = 0;
+    frustumCulled = 0;
+    occluded = 0;
+    if (entityCount == 0) return;
+
+    gatherBounds();
+    frustumTest(camera);
+
+    Ogre::Matrix4 view = camera->getViewMatrix();
+    const Ogre::Matrix4& projection = camera->getProjectionMatrix();
+    float nearDistance = camera->getNearClipDistance();
+
+    bool useOcclusion = occlusionEnabled && !occluders.empty();
+    if (useOcclusion) {
+        rasterizeOccluders(view, projection, nearDistance);
+    }
+
+    for (size_t i = 0; i < entities.size(); i++) {
+        Entity& entity = entities[i];
+        if (!entity.used) continue;
+
+        bool visible = inFrustum[i] != 0;
+        if (!visible) {
+            frustumCulled++;
+        } else if (useOcclusion && isOccluded(i, view, projection, nearDistance)) {
+            visible = false;
+            occluded++;
+        }
+
+        entity.visible = visible;
+        if (!visible) continue;
+
+        visibleCount++;
+        if (entity.positionDirty) {
+            entity.node->setPosition(entity.position);
+            entity.positionDirty = false;
+        }
+    }
+}
+
+void VisibilityCuller::gatherBounds() {
+    for (size_t i = 0; i < entities.size(); i++) {
+        const Entity& entity = entities[i];
+        if (!entity.used) {
+            minX[i] = minY[i] = minZ[i] = maxX[i] = maxY[i] = maxZ[i] = 0.0f;
+            continue;
+        }
+
+        Ogre::Vector3 scale = entity.node->getScale();
+        Ogre::Vector3 centre = entity.position + entity.centre * scale;
+        Ogre::Vector3 half = entity.halfSize * Ogre::Vector3(std::abs(scale.x), std::abs(scale.y), std::abs(scale.z));
+
+        // A rotated node gets the box around its bounding sphere
+        if (entity.node->getOrientation() != Ogre::Quaternion::IDENTITY) {
+            centre = entity.position + entity.node->getOrientation() * (entity.centre * scale);
+            half = Ogre::Vector3(half.length());
+        }
+
+        Ogre::Vector3 lo = centre - half;
+        Ogre::Vector3 hi = centre + half;
+        if (shadowDirection.y < -0.05f && hi.y > 0.0f) {
+            Ogre::Vector3 sweep = shadowDirection * (hi.y / -shadowDirection.y);
+            lo.makeFloor(lo + sweep);
+            hi.makeCeil(hi + sweep);
+        }
+
+        minX[i] = lo.x; minY[i] = lo.y; minZ[i] = lo.z;
+        maxX[i] = hi.x; maxY[i] = hi.y; maxZ[i] = hi.z;
+    }
+}
+
+void VisibilityCuller::frustumTest(const Ogre::Camera* camera) {
+    // Planes face inwards; an infinite far plane tests nothing
+    const Ogre::Plane* frustumPlanes = camera->getFrustumPlanes();
+    std::array<Ogre::Plane, 6> planes;
+    size_t planeCount = 0;
+    for (int p = 0; p < 6; p++) {
+        if (p == Ogre::FRUSTUM_PLANE_FAR && camera->getFarClipDistance() == 0.0f) continue;
+        planes[planeCount++] = frustumPlanes[p];
+    }
+
+    // Per plane, the box corner furthest along the normal decides: if even
+    // that one is behind the plane the whole box is outside
+    struct PlaneTest {
+        const float* x;
+        const float* y;
+        const float* z;
+        float nx, ny, nz, d;
+    };
+    std::array<PlaneTest, 6> tests;
+    for (size_t p = 0; p < planeCount; p++) {
+        const Ogre::Plane& plane = planes[p];
+        tests[p] = {plane.normal.x >= 0.0f ? maxX.data() : minX.data(),
+                    plane.normal.y >= 0.0f ? maxY.data() : minY.data(),
+                    plane.normal.z >= 0.0f ? maxZ.data() : minZ.data(),
+                    plane.normal.x, plane.normal.y, plane.normal.z, plane.d};
+    }
+
+    const size_t count = inFrustum.size();
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256 zero = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        __m256 outside = _mm256_setzero_ps();
+        for (size_t p = 0; p < planeCount; p++) {
+            const PlaneTest& t = tests[p];
+            __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(t.x + i), _mm256_set1_ps(t.nx)),
+                              _mm256_mul_ps(_mm256_loadu_ps(t.y + i), _mm256_set1_ps(t.ny))),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(t.z + i), _mm256_set1_ps(t.nz)),
+                              _mm256_set1_ps(t.d)));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero, _CMP_LT_OQ));
+        }
+
+        int mask = _mm256_movemask_ps(outside);
+        for (int bit = 0; bit < 8; bit++) {
+            inFrustum[i + bit] = (mask & (1 << bit)) ? 0 : 1;
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        bool outside = false;
+        for (size_t p = 0; p < planeCount && !outside; p++) {
+            const PlaneTest& t = tests[p];
+            outside = t.x[i] * t.nx + t.y[i] * t.ny + t.z[i] * t.nz + t.d < 0.0f;
+        }
+        inFrustum[i] = outside ? 0 : 1;
+    }
+}
+
+void VisibilityCuller::rasterizeOccluders(const Ogre::Matrix4& view, const Ogre::Matrix4& projection,
+                                          float nearDistance) {
+    std::fill(occlusionDepth.begin(), occlusionDepth.end(), FLT_MAX);
+
+    for (const OccluderQuad& quad : occluders) {
+        std::array<Ogre::Vector2, 4> screen;
+        std::array<float, 4> invDepth;
+        float farthest = 0.0f;
+        bool clipped = false;
+
+        for (int k = 0; k < 4; k++) {
+            Ogre::Vector3 viewPoint = view * quad[k];
+            float depth = -viewPoint.z;
+            if (depth < nearDistance) {
+                // Only fully visible occluders; clipping one is not worth it
+                clipped = true;
+                break;
+            }
+            screen[k] = toOcclusionPixel(projection, viewPoint);
+            invDepth[k] = 1.0f / depth;
+            farthest = std::max(farthest, depth);
+        }
+        if (clipped) continue;
+
+        // Winding and size; edge-on quads cover nothing
+        float area = 0.0f;
+        for (int k = 0; k < 4; k++) {
+            const Ogre::Vector2& a = screen[k];
+            const Ogre::Vector2& b = screen[(k + 1) & 3];
+            area += a.x * b.y - b.x * a.y;
+        }
+        if (std::abs(area) < 1e-3f) continue;
+        float winding = area > 0.0f ? 1.0f : -1.0f;
+
+        // 1/depth is affine in screen space across a planar polygon
+        const Ogre::Vector2& p0 = screen[0];
+        const Ogre::Vector2& p1 = screen[1];
+        const Ogre::Vector2& p2 = screen[2];
+        float det = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+        if (std::abs(det) < 1e-6f) continue;
+        float gradX = ((invDepth[1] - invDepth[0]) * (p2.y - p0.y) - (invDepth[2] - invDepth[0]) * (p1.y - p0.y)) / det;
+        float gradY = ((invDepth[2] - invDepth[0]) * (p1.x - p0.x) - (invDepth[1] - invDepth[0]) * (p2.x - p0.x)) / det;
+        float base = invDepth[0] - gradX * p0.x - gradY * p0.y;
+
+        auto inside = [&screen, winding](float x, float y) {
+            for (int k = 0; k < 4; k++) {
+                const Ogre::Vector2& a = screen[k];
+                const Ogre::Vector2& b = screen[(k + 1) & 3];
+                if (winding * ((b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x)) < 0.0f) return false;
+            }
+            return true;
+        };
+
+        float minPx = std::min({screen[0].x, screen[1].x, screen[2].x, screen[3].x});
+        float maxPx = std::max({screen[0].x, screen[1].x, screen[2].x, screen[3].x});
+        float minPy = std::min({screen[0].y, screen[1].y, screen[2].y, screen[3].y});
+        float maxPy = std::max({screen[0].y, screen[1].y, screen[2].y, screen[3].y});
+        int x0 = std::max(0, static_cast<int>(std::floor(minPx)));
+        int x1 = std::min(OCCLUSION_WIDTH, static_cast<int>(std::ceil(maxPx)));
+        int y0 = std::max(0, static_cast<int>(std::floor(minPy)));
+        int y1 = std::min(OCCLUSION_HEIGHT, static_cast<int>(std::ceil(maxPy)));
+
+        for (int y = y0; y < y1; y++) {
+            for (int x = x0; x < x1; x++) {
+                // Conservative: the pixel must be fully covered, and it
+                // stores the farthest depth over its area
+                float fx = static_cast<float>(x);
+                float fy = static_cast<float>(y);
+                if (!inside(fx, fy) || !inside(fx + 1.0f, fy) ||
+                    !inside(fx, fy + 1.0f) || !inside(fx + 1.0f, fy + 1.0f)) {
+                    continue;
+                }
+
+                float nearestInv = base + std::min(0.0f, gradX) + std::min(0.0f, gradY) + gradX * fx + gradY * fy;
+                float depth = nearestInv > 0.0f ? std::min(1.0f / nearestInv, farthest) : farthest;
+
+                float& stored = occlusionDepth[y * OCCLUSION_WIDTH + x];
+                stored = std::min(stored, depth);
+            }
+        }
+    }
+}
+
+bool VisibilityCuller::isOccluded(size_t slot, const Ogre::Matrix4& view, const Ogre::Matrix4& projection,
+                                  float nearDistance) const {
+    Ogre::AxisAlignedBox box(minX[slot], minY[slot], minZ[slot], maxX[slot], maxY[slot], maxZ[slot]);
+
+    float nearest = FLT_MAX;
+    Ogre::Vector2 lo(FLT_MAX, FLT_MAX);
+    Ogre::Vector2 hi(-FLT_MAX, -FLT_MAX);
+    for (int c = 0; c < 8; c++) {
+        Ogre::Vector3 viewPoint = view * box.getCorner(static_cast<Ogre::AxisAlignedBox::CornerEnum>(c));
+        float depth = -viewPoint.z;
+        // Straddling the near plane: too close to judge
+        if (depth < nearDistance) return false;
+
+        Ogre::Vector2 pixel = toOcclusionPixel(projection, viewPoint);
+        lo.makeFloor(pixel);
+        hi.makeCeil(pixel);
+        nearest = std::min(nearest, depth);
+    }
+
+    int x0 = std::max(0, static_cast<int>(std::floor(lo.x)));
+    int x1 = std::min(OCCLUSION_WIDTH, static_cast<int>(std::ceil(hi.x)));
+    int y0 = std::max(0, static_cast<int>(std::floor(lo.y)));
+    int y1 = std::min(OCCLUSION_HEIGHT, static_cast<int>(std::ceil(hi.y)));
+    if (x0 >= x1 || y0 >= y1) return false;
+
+    for (int y = y0; y < y1; y++) {
+        const float* row = &occlusionDepth[y * OCCLUSION_WIDTH];
+        for (int x = x0; x < x1; x++) {
+            if (row[x] >= nearest) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace BVA
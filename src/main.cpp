@@ -1,9 +1,63 @@
 #include "core/Engine.hpp"
+#include "core/ReplaySystem.hpp"
+#include "graphics/GraphicsEngine.hpp"
+#include "graphics/PostProcessManager.hpp"
+#include "graphics/ProceduralGenerator.hpp"
+#include "graphics/NoiseGenerator.hpp"
+#include "graphics/ParticleSimulator.hpp"
 #include <iostream>
 #include <exception>
+#include <optional>
+#include <string>
+
+namespace {
+
+// --quality=low|medium|high|ultra; High when not given
+std::optional<BVA::GraphicsQuality> parseQuality(int argc, char** argv) {
+    const std::string prefix = "--quality=";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) != 0) continue;
+
+        std::string tier = arg.substr(prefix.size());
+        if (tier == "low") return BVA::GraphicsQuality::Low;
+        if (tier == "medium") return BVA::GraphicsQuality::Medium;
+        if (tier == "high") return BVA::GraphicsQuality::High;
+        if (tier == "ultra") return BVA::GraphicsQuality::Ultra;
+        std::cerr << "Unknown graphics quality '" << tier << "', using high" << std::endl;
+    }
+    return std::nullopt;
+}
+
+// --replay=<file> or --replay <file>: watch a recorded match
+std::optional<std::string> parseReplay(int argc, char** argv) {
+    const std::string prefix = "--replay=";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) == 0) return arg.substr(prefix.size());
+        if (arg == "--replay" && i + 1 < argc) return std::string(argv[i + 1]);
+    }
+    return std::nullopt;
+}
+
+} // namespace
 
 int main(int argc, char** argv) {
     try {
+        // Generator timings only, no window or engine
+        if (argc > 1 && std::string(argv[1]) == "--mesh-benchmark") {
+            BVA::ProceduralMeshGenerator::runBenchmark();
+            return 0;
+        }
+        if (argc > 1 && std::string(argv[1]) == "--texture-benchmark") {
+            BVA::NoiseGenerator::runBenchmark();
+            return 0;
+        }
+        if (argc > 1 && std::string(argv[1]) == "--particle-benchmark") {
+            BVA::ParticleSimulator::runBenchmark();
+            return 0;
+        }
+
         std::cout << "=== Bas Veeg Arc 3D ===" << std::endl;
         std::cout << "Version 1.0.0" << std::endl;
         std::cout << "Initializing..." << std::endl;
@@ -15,6 +69,16 @@ int main(int argc, char** argv) {
             return 1;
         }
 
+        if (auto quality = parseQuality(argc, argv)) {
+            engine.getGraphics()->setGraphicsQuality(*quality);
+        }
+
+        if (auto replayPath = parseReplay(argc, argv)) {
+            if (!engine.getReplay()->startPlayback(*replayPath)) {
+                std::cerr << "Could not play replay " << *replayPath << "; starting normally" << std::endl;
+            }
+        }
+
         std::cout << "Engine initialized successfully" << std::endl;
         std::cout << "Starting game loop..." << std::endl;
 
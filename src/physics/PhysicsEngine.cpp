@@ -204,4 +204,20 @@ btVector3 PhysicsBody::getVelocity() const {
     return rigidBody->getLinearVelocity();
 }
 
+void PhysicsBody::setEnabled(bool enable) {
+    if (enabled == enable) return;
+    enabled = enable;
+
+    int flags = rigidBody->getCollisionFlags();
+    if (enable) {
+        rigidBody->setCollisionFlags(flags & ~btCollisionObject::CF_NO_CONTACT_RESPONSE);
+        rigidBody->forceActivationState(ACTIVE_TAG);
+        rigidBody->activate(true);
+    } else {
+        rigidBody->setCollisionFlags(flags | btCollisionObject::CF_NO_CONTACT_RESPONSE);
+        rigidBody->setLinearVelocity(btVector3(0, 0, 0));
+        rigidBody->forceActivationState(DISABLE_SIMULATION);
+    }
+}
+
 } // namespace BVA
@@ -1,5 +1,9 @@
 #include "ui/UIManager.hpp"
 #include "gameplay/Character.hpp"
+#include "core/Engine.hpp"
+#include "graphics/GraphicsEngine.hpp"
+#include "graphics/PostProcessManager.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace BVA {
@@ -367,6 +371,15 @@ void UIManager::hideSettings() {
 
 void UIManager::updateGraphicsSetting(const std::string& setting, int value) {
     std::cout << "Graphics setting '" << setting << "' set to " << value << std::endl;
+
+    // Quality is the settings menu's index into Low, Medium, High, Ultra
+    if (setting == "quality") {
+        int tier = std::clamp(value, static_cast<int>(GraphicsQuality::Low),
+                              static_cast<int>(GraphicsQuality::Ultra));
+        if (GraphicsEngine* graphics = Engine::getInstance().getGraphics()) {
+            graphics->setGraphicsQuality(static_cast<GraphicsQuality>(tier));
+        }
+    }
 }
 
 void UIManager::showVictoryScreen(int score, float time) {
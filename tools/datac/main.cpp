@@ -0,0 +1,14 @@
+// Offline game data compiler: gamedata.txt -> gamedata.bin
+// Run by the build; the game also recompiles on load when the source is newer.
+
+#include "core/GameData.hpp"
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <definitions.txt> <output.bin>" << std::endl;
+        return 1;
+    }
+
+    return BVA::GameData::compileFile(argv[1], argv[2]) ? 0 : 1;
+}